@@ -87,6 +87,9 @@ ExternalProject_Add(
 	INSTALL_COMMAND ${CMAKE_COMMAND} -E copy
 		${PROJECT_BINARY_DIR}/dep_stb-prefix/src/dep_stb/stb_image.h
 		${DEP_INSTALL_DIR}/include/stb/stb_image.h
+	COMMAND ${CMAKE_COMMAND} -E copy
+		${PROJECT_BINARY_DIR}/dep_stb-prefix/src/dep_stb/stb_image_write.h
+		${DEP_INSTALL_DIR}/include/stb/stb_image_write.h
 	)
 set(DEP_LIST ${DEP_LIST} dep_stb)
 
@@ -109,12 +112,21 @@ ExternalProject_Add(
 	TEST_COMMAND ""
 )
 set(DEP_LIST ${DEP_LIST} dep_assimp)
-set(DEP_LIBS ${DEP_LIBS}
-    $<$<CONFIG:Debug>:assimp-vc143-mtd>
-    $<$<CONFIG:Release>:assimp-vc143-mt>
-    $<$<CONFIG:Debug>:zlibstaticd>
-    $<$<CONFIG:Release>:zlibstatic>
-)
+if(MSVC)
+    set(DEP_LIBS ${DEP_LIBS}
+        $<$<CONFIG:Debug>:assimp-vc143-mtd>
+        $<$<CONFIG:Release>:assimp-vc143-mt>
+        $<$<CONFIG:Debug>:zlibstaticd>
+        $<$<CONFIG:Release>:zlibstatic>
+    )
+else()
+    # MSVC 가 아니면 assimp 이름에 toolset 이 붙지 않고, zlib 은 libz 로 설치된다.
+    set(DEP_LIBS ${DEP_LIBS}
+        $<$<CONFIG:Debug>:assimpd>
+        $<$<CONFIG:Release>:assimp>
+        z
+    )
+endif()
 	
 # yaml-cpp
 ExternalProject_Add(
@@ -166,7 +178,13 @@ set(MONO_LIB_DEBUG ${DEP_INSTALL_DIR}/lib/libmono-static-sgen-debug.lib)
 set(MONO_LIB_RELEASE ${DEP_INSTALL_DIR}/lib/libmono-static-sgen.lib)
 
 # CMake에서 빌드 타입에 따라 올바른 라이브러리를 링크
-set(DEP_LIBS ${DEP_LIBS} 
-    $<$<CONFIG:Debug>:${MONO_LIB_DEBUG}>
-    $<$<CONFIG:Release>:${MONO_LIB_RELEASE}>
-)
+if(WIN32)
+    set(DEP_LIBS ${DEP_LIBS} 
+        $<$<CONFIG:Debug>:${MONO_LIB_DEBUG}>
+        $<$<CONFIG:Release>:${MONO_LIB_RELEASE}>
+    )
+else()
+    # 미리 빌드된 mono 는 Windows lib 뿐이라서 시스템에 설치된 mono 를 링크한다.
+    find_library(MONO_LIB NAMES monosgen-2.0 mono-2.0 PATH_SUFFIXES mono/lib REQUIRED)
+    set(DEP_LIBS ${DEP_LIBS} ${MONO_LIB})
+endif()
@@ -32,6 +32,16 @@ struct ApplicationSpecification
 	std::string m_Name = "ALEngine";
 	std::string m_WorkingDirectory;
 	ApplicationCommandLineArgs m_CommandLineArgs;
+
+	// window / ImGui 없이 offscreen 으로만 그린다. (benchmark, CI)
+	bool m_Headless = false;
+	uint32_t m_HeadlessWidth = 1280;
+	uint32_t m_HeadlessHeight = 720;
+
+	// 지연 시간 / 처리량 선택 (배포 환경마다 정한다)
+	uint32_t m_FramesInFlight = DEFAULT_FRAMES_IN_FLIGHT;	    // 1 이면 지연이 가장 짧다.
+	float m_TargetFrameMs = 0.0f;							    // 0 이면 제한하지 않는다.
+	VkPresentModeKHR m_PresentMode = VK_PRESENT_MODE_MAILBOX_KHR; // 지원하지 않으면 FIFO
 };
 
 class App
@@ -71,7 +81,7 @@ class App
 
 	std::unique_ptr<Window> m_Window;
 	std::unique_ptr<Renderer> m_Renderer;
-	ImGuiLayer *m_ImGuiLayer;
+	ImGuiLayer *m_ImGuiLayer = nullptr;
 
 	LayerStack m_LayerStack;
 
@@ -4,7 +4,7 @@
 #include "Core/App.h"
 #include "Core/Base.h"
 
-#ifdef AL_PLATFORM_WINDOWS
+#if defined(AL_PLATFORM_WINDOWS) || defined(AL_PLATFORM_LINUX)
 
 extern ale::App *ale::createApp(ApplicationCommandLineArgs args);
 
@@ -20,6 +20,10 @@ int main(int argc, char **argv)
 			argv[1] = "./projects/AfterLife.alproj";
 		}
 		auto app = ale::createApp({argc, argv});
+		if (!app)
+		{
+			return 1;
+		}
 		app->run();
 		delete app;
 	}
@@ -0,0 +1,88 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include "Core/Base.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ale
+{
+using JobFunction = std::function<void()>;
+using ParallelForFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+class JobCounter;
+
+struct Job
+{
+	JobFunction m_Function;
+	JobCounter *m_Counter = nullptr;
+	bool m_MainThread = false;
+};
+
+// 아직 끝나지 않은 job 개수를 세는 카운터
+// 0이 되는 순간 이 카운터에 걸어둔 후속 job(dependency)들이 스케줄링된다.
+class JobCounter
+{
+  public:
+	JobCounter() = default;
+	JobCounter(const JobCounter &) = delete;
+	JobCounter &operator=(const JobCounter &) = delete;
+
+	bool isDone() const
+	{
+		return m_Count.load(std::memory_order_acquire) == 0;
+	}
+
+	int32_t getCount() const
+	{
+		return m_Count.load(std::memory_order_acquire);
+	}
+
+  private:
+	std::atomic<int32_t> m_Count{0};
+	std::mutex m_Mutex;
+	std::vector<Job> m_Continuations;
+
+	friend class JobSystem;
+};
+
+/*
+	고정 크기 worker pool 기반 job system
+	- worker 마다 deque 를 가지고, 자기 deque 는 뒤에서(LIFO) 꺼내고 다른 worker 의 deque 는 앞에서 훔쳐온다.
+	- main thread 도 0번 슬롯으로 참여하며, wait() 중에는 job 을 직접 처리한다.
+	- Mono(스크립트) 호출과 Vulkan queue submit 은 main thread 에서만 해야 하므로 executeOnMainThread 를 사용한다.
+*/
+class JobSystem
+{
+  public:
+	static void init(uint32_t workerCount = 0);
+	static void shutDown();
+
+	static void execute(JobFunction job, JobCounter *counter = nullptr);
+	static void executeAfter(JobCounter &dependency, JobFunction job, JobCounter *counter = nullptr);
+	static void executeOnMainThread(JobFunction job, JobCounter *counter = nullptr);
+	static void parallelFor(uint32_t count, uint32_t grainSize, const ParallelForFunction &job);
+
+	static void wait(JobCounter &counter);
+	static void processMainThreadJobs();
+
+	static bool isInitialized();
+	static bool isMainThread();
+	static uint32_t getWorkerCount();
+	static uint32_t getThreadIndex();
+
+	static void runSchedulingBenchmark(uint32_t jobCount = 100000);
+
+  private:
+	static void schedule(Job &&job);
+	static void finishJob(Job &job);
+	static bool tryRunJob(uint32_t threadIndex);
+	static void workerLoop(uint32_t threadIndex);
+};
+
+} // namespace ale
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef WINDOW_H
 #define WINDOW_H
 
-#include "ALpch.h"
+#include "alpch.h"
 #include "Core/Base.h"
 #include "Events/Event.h"
 #include <GLFW/glfw3.h>
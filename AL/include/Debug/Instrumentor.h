@@ -101,6 +101,36 @@ class Instrumentor
 		}
 	}
 
+	// GPU 작업은 CPU thread 와 섞이지 않도록 별도 process(pid 1) 의 GPU track 에 기록한다.
+	void writeGpuProfile(const std::string &name, FloatingPointMicroseconds start, FloatingPointMicroseconds elapsedTime)
+	{
+		std::stringstream json;
+
+		json << std::setprecision(3) << std::fixed;
+		json << ",{";
+		json << "\"cat\":\"gpu\",";
+		json << "\"dur\":" << elapsedTime.count() << ',';
+		json << "\"name\":\"" << name << "\",";
+		json << "\"ph\":\"X\",";
+		json << "\"pid\":1,";
+		json << "\"tid\":0,";
+		json << "\"ts\":" << start.count();
+		json << "}";
+
+		std::lock_guard lock(m_Mutex);
+		if (m_CurrentSession)
+		{
+			m_OutputStream << json.str();
+			m_OutputStream.flush();
+		}
+	}
+
+	bool isSessionActive()
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_CurrentSession != nullptr;
+	}
+
 	static Instrumentor &get()
 	{
 		static Instrumentor instance;
@@ -120,6 +150,7 @@ class Instrumentor
 	void writeHeader()
 	{
 		m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
+		m_OutputStream << ",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
 		m_OutputStream.flush();
 	}
 
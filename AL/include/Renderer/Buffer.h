@@ -3,11 +3,15 @@
 
 #include "Core/Base.h"
 #include "Renderer/Common.h"
+#include "Renderer/MemoryAllocator.h"
+#include "Renderer/UploadManager.h"
 #include "Renderer/VulkanContext.h"
 #include "Renderer/VulkanUtil.h"
 
 #include "assimp/texture.h"
 
+#include <atomic>
+
 namespace ale
 {
 class Buffer
@@ -18,53 +22,61 @@ class Buffer
 
   protected:
 	VkBuffer m_buffer;
-	VkDeviceMemory m_bufferMemory;
+	MemoryAllocation m_allocation;
 
 	VkDevice m_device;
 	VkPhysicalDevice m_physicalDevice;
-	VkCommandPool m_commandPool;
-	VkQueue m_graphicsQueue;
 
 	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer,
-					  VkDeviceMemory &bufferMemory);
-	void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
-	VkCommandBuffer beginSingleTimeCommands();
-	void endSingleTimeCommands(VkCommandBuffer commandBuffer);
+					  MemoryAllocation &allocation, AllocationStrategy strategy = AllocationStrategy::GENERAL);
 };
 
+// 여러 mesh 의 정점을 이어 담는 공용 vertex buffer (MeshPool 의 page)
 class VertexBuffer : public Buffer
 {
   public:
-	static std::unique_ptr<VertexBuffer> createVertexBuffer(std::vector<Vertex> &vertices);
+	static std::unique_ptr<VertexBuffer> createVertexBuffer(uint32_t vertexCapacity);
 	~VertexBuffer() = default;
 
 	void cleanup();
 
+	// firstVertex 위치부터 vertices 를 채운다. (UploadManager 의 다음 batch 에서 복사)
+	void updateVertexBuffer(const std::vector<Vertex> &vertices, uint32_t firstVertex);
 	void bind(VkCommandBuffer commandBuffer);
 
+	uint32_t getCapacity()
+	{
+		return m_capacity;
+	}
+
   private:
-	void initVertexBuffer(std::vector<Vertex> &vertices);
+	uint32_t m_capacity = 0;
+
+	void initVertexBuffer(uint32_t vertexCapacity);
 };
 
+// 여러 mesh 의 index 를 이어 담는 공용 index buffer (MeshPool 의 page)
 class IndexBuffer : public Buffer
 {
   public:
-	static std::unique_ptr<IndexBuffer> createIndexBuffer(std::vector<uint32_t> &indices);
+	static std::unique_ptr<IndexBuffer> createIndexBuffer(uint32_t indexCapacity);
 	~IndexBuffer() = default;
 
 	void cleanup();
 
+	// firstIndex 위치부터 indices 를 채운다. index 값은 mesh 기준이고 vertexOffset 은 draw 에서 더한다.
+	void updateIndexBuffer(const std::vector<uint32_t> &indices, uint32_t firstIndex);
 	void bind(VkCommandBuffer commandBuffer);
 
-	uint32_t getIndexCount()
+	uint32_t getCapacity()
 	{
-		return m_indexCount;
+		return m_capacity;
 	}
 
   private:
-	uint32_t m_indexCount;
+	uint32_t m_capacity = 0;
 
-	void initIndexBuffer(std::vector<uint32_t> &indices);
+	void initIndexBuffer(uint32_t indexCapacity);
 };
 
 class ImageBuffer : public Buffer
@@ -88,25 +100,172 @@ class ImageBuffer : public Buffer
 	{
 		return textureImage;
 	}
-	VkDeviceMemory getImageMemory()
+	const MemoryAllocation &getImageAllocation()
 	{
-		return textureImageMemory;
+		return textureImageAllocation;
 	}
 
   private:
 	uint32_t mipLevels;
 	VkImage textureImage;
-	VkDeviceMemory textureImageMemory;
+	MemoryAllocation textureImageAllocation;
 
 	bool initImageBuffer(std::string path, bool flipVertically);
 	bool initMaterialImageBuffer(std::string path, bool flipVertically);
 	void initImageBufferFromMemory(const aiTexture *texture);
 	void initDefaultImageBuffer(glm::vec4 color);
 	void initDefaultSingleChannelImageBuffer(float value);
-	void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout,
-							   uint32_t mipLevels);
-	void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
-	void generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
+};
+
+// instance 별 데이터(InstanceData)를 담는 vertex buffer
+// 매 프레임 CPU 에서 다시 채우므로 host visible 메모리를 계속 map 해둔다.
+class InstanceBuffer : public Buffer
+{
+  public:
+	static std::unique_ptr<InstanceBuffer> createInstanceBuffer(uint32_t instanceCapacity);
+	// GPU culling 결과(보이는 instance 만 batch 순서로 압축)를 compute shader 가 채우는 device local buffer
+	static std::unique_ptr<InstanceBuffer> createCulledInstanceBuffer(uint32_t instanceCapacity);
+	~InstanceBuffer() = default;
+
+	void cleanup();
+
+	void updateInstanceBuffer(const InstanceData *data, uint32_t instanceCount);
+	void bind(VkCommandBuffer commandBuffer);
+
+	VkBuffer getBuffer()
+	{
+		return m_buffer;
+	}
+	uint32_t getCapacity()
+	{
+		return m_capacity;
+	}
+
+  private:
+	void *m_mappedMemory = nullptr;
+	uint32_t m_capacity = 0;
+
+	void initInstanceBuffer(uint32_t instanceCapacity, bool hostVisible);
+};
+
+// vkCmdDrawIndexedIndirect 가 읽는 draw command 배열
+// CPU 가 매 프레임 batch 별 command 를 채우고, GPU culling 이 instanceCount 를 채운다.
+// host visible 로 두어 이전 프레임의 culling 결과(보인 instance 수)를 fence 이후 그대로 읽을 수 있게 한다.
+class IndirectBuffer : public Buffer
+{
+  public:
+	static std::unique_ptr<IndirectBuffer> createIndirectBuffer(uint32_t commandCapacity);
+	~IndirectBuffer() = default;
+
+	void cleanup();
+
+	VkDrawIndexedIndirectCommand *getCommands()
+	{
+		return m_commands;
+	}
+	VkBuffer getBuffer()
+	{
+		return m_buffer;
+	}
+	uint32_t getCapacity()
+	{
+		return m_capacity;
+	}
+
+  private:
+	VkDrawIndexedIndirectCommand *m_commands = nullptr;
+	uint32_t m_capacity = 0;
+
+	void initIndirectBuffer(uint32_t commandCapacity);
+};
+
+// vertex shader 에서 읽는 storage buffer (skinning 행렬 palette 등)
+// 프레임마다 CPU 에서 필요한 만큼만 다시 채우므로 host visible 메모리를 계속 map 해둔다.
+class StorageBuffer : public Buffer
+{
+  public:
+	static std::unique_ptr<StorageBuffer> createStorageBuffer(VkDeviceSize bufferSize);
+	~StorageBuffer() = default;
+
+	void cleanup();
+
+	void updateStorageBuffer(const void *data, VkDeviceSize size);
+
+	VkBuffer getBuffer()
+	{
+		return m_buffer;
+	}
+	VkDeviceSize getSize()
+	{
+		return m_size;
+	}
+
+  private:
+	void *m_mappedMemory = nullptr;
+	VkDeviceSize m_size = 0;
+
+	void initStorageBuffer(VkDeviceSize bufferSize);
+};
+
+// GPU 가 복사해 넣은 내용을 CPU 에서 읽는 buffer (headless 프레임 캡처 등)
+class ReadbackBuffer : public Buffer
+{
+  public:
+	static std::unique_ptr<ReadbackBuffer> createReadbackBuffer(VkDeviceSize bufferSize);
+	~ReadbackBuffer() = default;
+
+	void cleanup();
+
+	VkBuffer getBuffer()
+	{
+		return m_buffer;
+	}
+	const void *getData()
+	{
+		return m_mappedMemory;
+	}
+
+  private:
+	void *m_mappedMemory = nullptr;
+
+	void initReadbackBuffer(VkDeviceSize bufferSize);
+};
+
+// 프레임마다 처음부터 다시 채우는 uniform buffer
+// 하나의 큰 버퍼를 계속 map 해두고 앞에서부터 선형으로 잘라 쓰며, 잘라낸 위치는 dynamic offset 으로 넘긴다.
+// 여러 thread 에서 secondary command buffer 를 기록하며 동시에 push 하므로 offset 은 atomic 으로 증가시킨다.
+class UniformRingBuffer : public Buffer
+{
+  public:
+	static std::unique_ptr<UniformRingBuffer> createUniformRingBuffer(VkDeviceSize bufferSize);
+	~UniformRingBuffer() = default;
+
+	void cleanup();
+
+	void reset();
+	uint32_t push(const void *data, VkDeviceSize size);
+	VkDeviceSize getAlignedSize(VkDeviceSize size);
+
+	VkBuffer getBuffer()
+	{
+		return m_buffer;
+	}
+	VkDeviceSize getSize()
+	{
+		return m_size;
+	}
+	VkDeviceSize getUsedSize()
+	{
+		return m_offset.load(std::memory_order_relaxed);
+	}
+
+  private:
+	void *m_mappedMemory = nullptr;
+	VkDeviceSize m_size = 0;
+	std::atomic<VkDeviceSize> m_offset{0};
+	VkDeviceSize m_alignment = 256;
+
+	void initUniformRingBuffer(VkDeviceSize bufferSize);
 };
 
 class UniformBuffer : public Buffer
@@ -123,9 +282,9 @@ class UniformBuffer : public Buffer
 	{
 		return m_buffer;
 	}
-	VkDeviceMemory getBufferMemory()
+	const MemoryAllocation &getAllocation()
 	{
-		return m_bufferMemory;
+		return m_allocation;
 	}
 
   private:
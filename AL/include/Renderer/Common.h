@@ -29,8 +29,9 @@
 
 namespace ale
 {
-// 동시에 처리할 최대 프레임 수
-const int MAX_FRAMES_IN_FLIGHT = 2;
+// 동시에 처리할 최대 프레임 수 (프레임별 resource 의 개수, 실제로 쓰는 수는 Renderer::setFramesInFlight 로 정한다)
+const int MAX_FRAMES_IN_FLIGHT = 3;
+const int DEFAULT_FRAMES_IN_FLIGHT = 2;
 
 // 검증 레이어 설정
 const std::vector<const char *> validationLayers = {"VK_LAYER_KHRONOS_validation"};
@@ -58,6 +59,7 @@ struct QueueFamilyIndices
 {
 	std::optional<uint32_t> graphicsFamily;
 	std::optional<uint32_t> presentFamily;
+	std::optional<uint32_t> transferFamily; // graphics 를 지원하지 않는 transfer 전용 queue family (없으면 비어 있음)
 
 	bool isComplete()
 	{
@@ -143,6 +145,42 @@ struct Vertex
 	}
 };
 
+// instancing 으로 그릴 때 instance 별로 전달되는 데이터 (vertex binding 1)
+struct InstanceData
+{
+	glm::mat4 model;
+	uint32_t boneOffset; // skinning palette 의 시작 index (bone storage buffer 기준), static mesh 는 사용하지 않음
+	uint32_t padding[3];
+
+	static VkVertexInputBindingDescription getBindingDescription()
+	{
+		VkVertexInputBindingDescription bindingDescription{};
+		bindingDescription.binding = 1;
+		bindingDescription.stride = sizeof(InstanceData);
+		bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE; // instance 마다 다음 데이터로 넘어감
+		return bindingDescription;
+	}
+
+	// mat4 는 vec4 4개의 location(6 ~ 9)을 차지, boneOffset 은 location 10
+	static std::array<VkVertexInputAttributeDescription, 5> getAttributeDescriptions()
+	{
+		std::array<VkVertexInputAttributeDescription, 5> attributeDescriptions{};
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			attributeDescriptions[i].binding = 1;
+			attributeDescriptions[i].location = 6 + i;
+			attributeDescriptions[i].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			attributeDescriptions[i].offset = offsetof(InstanceData, model) + sizeof(glm::vec4) * i;
+		}
+
+		attributeDescriptions[4].binding = 1;
+		attributeDescriptions[4].location = 10;
+		attributeDescriptions[4].format = VK_FORMAT_R32_UINT;
+		attributeDescriptions[4].offset = offsetof(InstanceData, boneOffset);
+		return attributeDescriptions;
+	}
+};
+
 struct UniformBufferObject
 {
 	alignas(16) glm::mat4 model;
@@ -161,29 +199,81 @@ struct UniformBufferObject
 // 	alignas(8) glm::vec2 padding; // 8바이트 (패딩)
 // };
   
-struct GeometryPassVertexUniformBufferObject {
-	alignas(16) glm::mat4 model;      // 64바이트
-	alignas(16) glm::mat4 view;       // 64바이트
-	alignas(16) glm::mat4 proj;       // 64바이트
-	glm::mat4 finalBonesMatrices[MAX_BONES];
-	alignas(4) bool heightFlag;       // 4바이트
-	alignas(4) float heightScale;     // 4바이트
-	alignas(8) glm::vec2 padding;     // 8바이트 (패딩)
+// geometry pass 의 uniform 은 프레임별 UniformRingBuffer 에서 dynamic offset 으로 할당된다.
+// model 행렬은 InstanceData 로 전달
+
+// pass 마다 한 번
+struct GeometryPassCameraUniformBufferObject
+{
+	alignas(16) glm::mat4 view;
+	alignas(16) glm::mat4 proj;
 };
 
-struct GeometryPassFragmentUniformBufferObject
+// GPU culling 모드에서 camera 에 그릴 후보 instance 하나 (GpuCulling.comp 의 CullInstance, std430)
+// 같은 index 의 InstanceData 를 batchIndex 번 indirect command 의 구간에 압축해서 복사한다.
+struct GpuCullInstance
 {
-	alignas(16) glm::vec4 albedoValue; // 16바이트 (정렬 우선순위)
-	alignas(4) float roughnessValue;
-	alignas(4) float metallicValue;
-	alignas(4) float aoValue;
+	glm::vec4 sphere; // world space 중심 + 반지름 (cull tree 의 leaf 와 같은 값)
+	uint32_t batchIndex;
+	uint32_t padding[3];
+};
 
-	alignas(4) bool albedoFlag;
-	alignas(4) bool normalFlag;
-	alignas(4) bool roughnessFlag;
-	alignas(4) bool metallicFlag;
-	alignas(4) bool aoFlag;
-	alignas(8) glm::vec2 padding; // 패딩 추가 (8바이트)
+// GpuCulling.comp push constant, plane 은 xyz = 바깥쪽 normal, w = distance (Frustum::cullingSphere 와 같은 기준)
+struct GpuCullingPushConstants
+{
+	glm::vec4 planes[6];
+	uint32_t instanceCount;
+	uint32_t padding[3];
+};
+
+// EnvironmentMap.glsl 의 push constant (skybox 전처리 compute pass 공용)
+struct EnvironmentMapPushConstants
+{
+	uint32_t faceSize;
+	float roughness;
+	uint32_t sampleCount;
+	float sourceFaceSize;
+};
+
+// Upscale.frag 의 push constant (scene color 중 내부 해상도 영역의 uv 범위)
+struct UpscalePushConstants
+{
+	glm::vec2 uvScale;
+	glm::vec2 texelSize;
+};
+
+// skinning 행렬은 프레임별 bone storage buffer 에 skeleton 마다 실제 bone 개수만큼 쌓고,
+// instance 의 boneOffset 으로 자기 palette 를 찾는다.
+
+// geometry pass 의 전역 texture 배열 크기 상한 (device limit 이 더 작으면 그 값을 쓴다)
+const uint32_t MAX_MATERIAL_TEXTURES = 1024;
+
+// MaterialData::flags 비트 (GeometryPass shader 의 MATERIAL_*_FLAG 와 같은 값)
+const uint32_t MATERIAL_ALBEDO_FLAG = 1 << 0;
+const uint32_t MATERIAL_NORMAL_FLAG = 1 << 1;
+const uint32_t MATERIAL_ROUGHNESS_FLAG = 1 << 2;
+const uint32_t MATERIAL_METALLIC_FLAG = 1 << 3;
+const uint32_t MATERIAL_AO_FLAG = 1 << 4;
+const uint32_t MATERIAL_HEIGHT_FLAG = 1 << 5;
+
+// 프레임마다 그릴 material 을 모아 올리는 material table 항목 (std430, vertex / fragment 공용)
+// texture 는 전역 texture 배열의 index 로 가리킨다.
+struct MaterialData
+{
+	alignas(16) glm::vec4 albedoValue;
+	float roughnessValue;
+	float metallicValue;
+	float aoValue;
+	float heightScale;
+
+	uint32_t albedoTexture;
+	uint32_t normalTexture;
+	uint32_t roughnessTexture;
+	uint32_t metallicTexture;
+	uint32_t aoTexture;
+	uint32_t heightTexture;
+	uint32_t flags;
+	uint32_t padding;
 };
 
 struct Light
@@ -196,8 +286,9 @@ struct Light
 	alignas(4) float outerCutoff;	 // 스포트라이트 외부 각도 (cosine 값)
 	alignas(4) uint32_t type;		 // 광원 타입 (0: 점광원, 1: 스포트라이트, 2: 방향성 광원)
 	alignas(4) uint32_t onShadowMap;
-	alignas(4) uint32_t padding;
-	alignas(8) glm::vec2 padding2;
+	alignas(4) uint32_t shadowMapIndex; // lighting pass 에서 샘플링할 shadow map slot (renderer 가 채움)
+	alignas(4) float range;				// 영향 범위 (renderer 가 채움, cluster 배정에 사용)
+	alignas(4) float padding;
 };
 
 // struct LightingPassUniformBufferObject
@@ -207,14 +298,17 @@ struct Light
 // 	alignas(16) glm::vec3 cameraPos;
 // };
 
+// light 목록 / cluster 별 light index 는 storage buffer 로 따로 넘긴다. (LightCluster 참고)
 struct LightingPassUniformBufferObject
 {
-	alignas(16) Light lights[16];	 // 최대 16개의 광원 정보
-	alignas(16) glm::vec3 cameraPos; // 카메라 위치
+	alignas(16) glm::mat4 cameraView; // cluster 의 depth slice 계산용
+	alignas(16) glm::vec3 cameraPos;  // 카메라 위치
 	alignas(16) glm::mat4 view[4][6];
 	alignas(16) glm::mat4 proj[4];
-	alignas(4) uint32_t numLights;	  // 활성화된 광원 개수
-	alignas(4) float ambientStrength; // 주변광 강도
+	alignas(16) glm::uvec4 clusterGrid; // cluster 개수 x, y, z / 모든 pixel 이 계산하는 light 수
+	alignas(16) glm::vec4 clusterParams; // tile 크기(pixel) x, y / depth slice scale, bias
+	alignas(4) uint32_t numLights;		 // 활성화된 광원 개수
+	alignas(4) float ambientStrength;	 // 주변광 강도
 	alignas(8) glm::vec2 padding;
 };
 
@@ -222,14 +316,12 @@ struct ShadowMapUniformBufferObject
 {
 	alignas(16) glm::mat4 proj;
 	alignas(16) glm::mat4 view;
-	alignas(16) glm::mat4 model;
 };
 
 struct ShadowCubeMapUniformBufferObject
 {
 	alignas(16) glm::mat4 proj;
 	alignas(16) glm::mat4 view[6];
-	alignas(16) glm::mat4 model;
 };
 
 struct ShadowCubeMapLayerIndex
@@ -237,12 +329,6 @@ struct ShadowCubeMapLayerIndex
 	alignas(4) uint32_t layerIndex;
 };
 
-struct SphericalMapUniformBufferObject
-{
-	alignas(16) glm::mat4 transform;
-	alignas(4) uint32_t layerIndex;
-};
-
 struct BackgroundUniformBufferObject
 {
 	alignas(16) glm::mat4 proj;
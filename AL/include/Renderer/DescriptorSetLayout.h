@@ -11,13 +11,16 @@ class DescriptorSetLayout
 {
   public:
 	static std::unique_ptr<DescriptorSetLayout> createDescriptorSetLayout();
+	static std::unique_ptr<DescriptorSetLayout> createGeometryPassFrameDescriptorSetLayout();
 	static std::unique_ptr<DescriptorSetLayout> createGeometryPassDescriptorSetLayout();
 	static std::unique_ptr<DescriptorSetLayout> createLightingPassDescriptorSetLayout();
 	static std::unique_ptr<DescriptorSetLayout> createShadowMapDescriptorSetLayout();
 	static std::unique_ptr<DescriptorSetLayout> createShadowCubeMapDescriptorSetLayout();
 	static std::unique_ptr<DescriptorSetLayout> createViewPortDescriptorSetLayout();
-	static std::unique_ptr<DescriptorSetLayout> createSphericalMapDescriptorSetLayout();
+	// skybox 전처리 compute pass (binding 0: 입력 sampler, binding 1: 출력 storage image)
+	static std::unique_ptr<DescriptorSetLayout> createEnvironmentMapDescriptorSetLayout();
 	static std::unique_ptr<DescriptorSetLayout> createBackgroundDescriptorSetLayout();
+	static std::unique_ptr<DescriptorSetLayout> createGpuCullingDescriptorSetLayout();
 
 	~DescriptorSetLayout() = default;
 
@@ -32,13 +35,15 @@ class DescriptorSetLayout
 	VkDescriptorSetLayout descriptorSetLayout;
 
 	void initDescriptorSetLayout();
+	void initGeometryPassFrameDescriptorSetLayout();
 	void initGeometryPassDescriptorSetLayout();
 	void initLightingPassDescriptorSetLayout();
 	void initShadowMapDescriptorSetLayout();
 	void initShadowCubeMapDescriptorSetLayout();
 	void initViewPortDescriptorSetLayout();
-	void initSphericalMapDescriptorSetLayout();
+	void initEnvironmentMapDescriptorSetLayout();
 	void initBackgroundDescriptorSetLayout();
+	void initGpuCullingDescriptorSetLayout();
 };
 } // namespace ale
 
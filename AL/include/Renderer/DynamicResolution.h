@@ -0,0 +1,77 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+namespace ale
+{
+/*
+	GPU 프레임 시간을 보고 G-buffer / lighting 을 그릴 내부 해상도의 scale 을 정한다.
+	- GPU 비용은 pixel 수 (scale^2) 에 비례한다고 보고, 목표 시간에 맞는 scale 을 한 번에 계산한다.
+	- 목표를 넘으면 바로 내리고, 여유가 충분할 때만 조금씩 올려서 경계에서 흔들리지 않게 한다.
+	- timestamp 결과는 frames in flight 만큼 늦게 오므로 scale 을 바꾼 뒤에는 그 결과가 나올 때까지 기다린다.
+*/
+class DynamicResolution
+{
+  public:
+	static constexpr float MIN_SCALE = 0.5f;
+	static constexpr float MAX_SCALE = 1.0f;
+
+	void setEnabled(bool enabled);
+	bool isEnabled()
+	{
+		return m_enabled;
+	}
+
+	void setTargetFrameMs(float targetMs)
+	{
+		m_targetMs = targetMs;
+	}
+	float getTargetFrameMs()
+	{
+		return m_targetMs;
+	}
+
+	void setScaleRange(float minScale, float maxScale);
+	float getMinScale()
+	{
+		return m_minScale;
+	}
+	float getMaxScale()
+	{
+		return m_maxScale;
+	}
+
+	// timestamp 결과가 몇 프레임 늦게 오는지 (Renderer 의 frames in flight)
+	void setLatencyFrames(uint32_t frames)
+	{
+		m_latencyFrames = frames;
+	}
+
+	// 매 프레임 GpuProfiler::getFrameMs 를 넘긴다. (0 이면 아직 결과가 없는 것)
+	void update(float gpuFrameMs);
+
+	float getScale()
+	{
+		return m_scale;
+	}
+	// displayExtent 에 scale 을 곱한 내부 해상도 (RENDER_EXTENT_ALIGNMENT pixel 단위, displayExtent 이하)
+	VkExtent2D getRenderExtent(VkExtent2D displayExtent);
+
+  private:
+	static constexpr uint32_t RENDER_EXTENT_ALIGNMENT = 8;
+
+	bool m_enabled = false;
+	float m_targetMs = 1000.0f / 60.0f;
+	float m_minScale = MIN_SCALE;
+	float m_maxScale = MAX_SCALE;
+	float m_scale = MAX_SCALE;
+	float m_filteredMs = 0.0f;
+	uint32_t m_cooldown = 0;
+	uint32_t m_latencyFrames = DEFAULT_FRAMES_IN_FLIGHT;
+};
+
+} // namespace ale
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef ENVIRONMENTMAP_H
+#define ENVIRONMENTMAP_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+#include "Renderer/MemoryAllocator.h"
+#include "Renderer/VulkanContext.h"
+
+#include <filesystem>
+
+namespace ale
+{
+/*
+	equirectangular skybox 로 background / IBL 에 쓸 cube map 을 만들고 디스크에 cache 하는 class
+	- specular: mip 0 은 원본 cube (background), mip i 는 roughness = i / (mip 수 - 1) 로 prefilter 한 결과
+	- irradiance: diffuse 용 작은 cube (cosine 가중 radiance 평균)
+	- 처음에는 compute shader 로 만들고 (equirect -> cube -> mip chain -> prefilter / irradiance), 결과를 GPU 에
+	  그대로 올릴 수 있는 형태 (RGBA16F, mip 별로 6 face 연속) 로 cache 폴더에 저장한다.
+	- cache key 는 원본 파일 내용 + 전처리 shader source + 설정 값의 hash 라서, 원본이나 shader 가 바뀌면
+	  다른 파일이 되고 이전 파일은 지운다. 다음 실행부터는 파일을 읽어 업로드만 한다.
+*/
+class EnvironmentMap
+{
+  public:
+	static constexpr VkFormat FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+	static constexpr uint32_t SPECULAR_MIP_LEVELS = 6;
+	static constexpr uint32_t IRRADIANCE_SIZE = 32;
+
+	static std::unique_ptr<EnvironmentMap> createEnvironmentMap(
+		const std::string &path, const std::string &cacheDirectory = "./cache/environment");
+
+	~EnvironmentMap() = default;
+
+	void cleanup();
+
+	VkImageView getSpecularImageView()
+	{
+		return m_specularImageView;
+	}
+	VkImageView getIrradianceImageView()
+	{
+		return m_irradianceImageView;
+	}
+	VkSampler getSampler()
+	{
+		return m_sampler;
+	}
+	uint32_t getFaceSize()
+	{
+		return m_faceSize;
+	}
+	bool isLoadedFromCache()
+	{
+		return m_loadedFromCache;
+	}
+	// cache 를 읽어 업로드했거나 새로 만드는 데 걸린 CPU 시간 (ms)
+	float getLoadMs()
+	{
+		return m_loadMs;
+	}
+
+	// 이 shader 들이 바뀌면 (hot reload) 새로 만들어야 한다.
+	static bool usesShader(const std::string &fileName);
+
+  private:
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t key;
+		uint32_t format;
+		uint32_t faceSize;
+		uint32_t specularMipLevels;
+		uint32_t irradianceSize;
+		uint64_t dataSize;
+	};
+
+	EnvironmentMap() = default;
+
+	void initEnvironmentMap(const std::string &path, const std::string &cacheDirectory);
+	void createImages(VkImageUsageFlags usage);
+	bool loadCache(const std::filesystem::path &cachePath, uint64_t key);
+	void bake(const std::string &path, const std::filesystem::path &cachePath, uint64_t key);
+	void saveCache(const std::filesystem::path &cachePath, uint64_t key, const void *data, VkDeviceSize dataSize);
+
+	static uint64_t makeKey(const std::vector<char> &source);
+	static VkDeviceSize getCubeDataSize(uint32_t faceSize, uint32_t mipLevels);
+
+  private:
+	uint32_t m_faceSize = 0;
+	bool m_loadedFromCache = false;
+	float m_loadMs = 0.0f;
+
+	VkImage m_specularImage = VK_NULL_HANDLE;
+	MemoryAllocation m_specularImageAllocation;
+	VkImageView m_specularImageView = VK_NULL_HANDLE;
+	VkImage m_irradianceImage = VK_NULL_HANDLE;
+	MemoryAllocation m_irradianceImageAllocation;
+	VkImageView m_irradianceImageView = VK_NULL_HANDLE;
+	VkSampler m_sampler = VK_NULL_HANDLE;
+};
+
+} // namespace ale
+
+#endif
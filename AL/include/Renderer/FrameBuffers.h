@@ -11,33 +11,13 @@ namespace ale
 class FrameBuffers
 {
   public:
-	static std::unique_ptr<FrameBuffers> createViewPortFrameBuffers(glm::vec2 viewPortSize, VkRenderPass renderPass);
 	static std::unique_ptr<FrameBuffers> createImGuiFrameBuffers(SwapChain *swapChain, VkRenderPass renderPass);
-	static std::unique_ptr<FrameBuffers> createShadowMapFrameBuffers(VkRenderPass renderPass);
-	static std::unique_ptr<FrameBuffers> createShadowCubeMapFrameBuffers(VkRenderPass renderPass);
-	static std::unique_ptr<FrameBuffers> createSphericalMapFrameBuffers(VkRenderPass renderPass);
-	static std::unique_ptr<FrameBuffers> createBackgroundFrameBuffers(glm::vec2 viewPortSize, VkRenderPass renderPass);
 
 	~FrameBuffers() = default;
 
 	void cleanup();
 
-	void initViewPortFrameBuffers(glm::vec2 viewPortSize, VkRenderPass renderPass);
 	void initImGuiFrameBuffers(SwapChain *swapChain, VkRenderPass renderPass);
-	void initShadowMapFrameBuffers(VkRenderPass renderPass);
-	void initShadowCubeMapFrameBuffers(VkRenderPass renderPass);
-	void initSphericalMapFrameBuffers(VkRenderPass renderPass);
-	void initBackgroundFrameBuffers(glm::vec2 viewPortSize, VkRenderPass renderPass);
-
-	VkFramebuffer &getSphericalMapFramebuffer()
-	{
-		return framebuffers[0];
-	}
-
-	VkImageView &getSphericalMapImageView()
-	{
-		return sphericalMapImageView;
-	}
 
 	std::vector<VkFramebuffer> &getFramebuffers()
 
@@ -45,80 +25,9 @@ class FrameBuffers
 		return framebuffers;
 	}
 
-	VkImage &getDepthImage()
-	{
-		return depthImage;
-	}
-	VkImageView &getDepthImageView()
-	{
-		return depthImageView;
-	}
-	VkImageView &getPositionImageView()
-	{
-		return positionImageView;
-	}
-	VkImageView &getNormalImageView()
-	{
-		return normalImageView;
-	}
-	VkImageView &getAlbedoImageView()
-	{
-		return albedoImageView;
-	}
-	VkImageView &getPbrImageView()
-	{
-		return pbrImageView;
-	}
-	VkImageView &getViewPortImageView()
-	{
-		return viewPortImageView;
-	}
-	VkImage &getViewPortImage()
-	{
-		return viewPortImage;
-	}
-	VkImageView &getBackgroundImageView()
-	{
-		return backgroundImageView;
-	}
-	VkImage &getBackgroundImage()
-	{
-		return backgroundImage;
-	}
-
   private:
-	VkImage depthImage;
-	VkDeviceMemory depthImageMemory;
-	VkImageView depthImageView;
-
-	VkImage positionImage;
-	VkDeviceMemory positionImageMemory;
-	VkImageView positionImageView;
-
-	VkImage normalImage;
-	VkDeviceMemory normalImageMemory;
-	VkImageView normalImageView;
-
-	VkImage albedoImage;
-	VkDeviceMemory albedoImageMemory;
-	VkImageView albedoImageView;
-
-	VkImage pbrImage;
-	VkDeviceMemory pbrImageMemory;
-	VkImageView pbrImageView;
-
-	VkImage viewPortImage;
-	VkDeviceMemory viewPortImageMemory;
-	VkImageView viewPortImageView;
-
-	VkImage sphericalMapImage;
-	VkDeviceMemory sphericalMapImageMemory;
-	VkImageView sphericalMapImageView;
-
-	VkImage backgroundImage;
-	VkDeviceMemory backgroundImageMemory;
-	VkImageView backgroundImageView;
-
+	// viewport 쪽 attachment (G-buffer, depth, shadow map, background) 는 RenderGraph 가,
+	// skybox cube map 은 EnvironmentMap 이 가진다.
 	std::vector<VkFramebuffer> framebuffers;
 };
 } // namespace ale
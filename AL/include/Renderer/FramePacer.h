@@ -0,0 +1,88 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+#include <chrono>
+
+namespace ale
+{
+// 최근 프레임들의 평균 (ms)
+struct FrameLatencyStats
+{
+	float frameMs = 0.0f;			// 입력을 읽는 간격
+	float pacingSleepMs = 0.0f;		// 목표 프레임 시간을 맞추려고 기다린 시간
+	float fenceWaitMs = 0.0f;		// frame slot 의 fence 대기 시간 (GPU 가 밀려 있으면 커진다)
+	float inputToSubmitMs = 0.0f;	// 입력을 읽은 뒤 command buffer 를 제출할 때까지
+	float inputToPresentMs = 0.0f;	// 입력을 읽은 뒤 present 를 요청할 때까지
+	float inputToGpuDoneMs = 0.0f;	// 입력을 읽은 뒤 그 프레임의 fence 가 signal 된 것을 확인할 때까지
+};
+
+/*
+	목표 프레임 시간에 맞춰 다음 프레임의 입력을 읽는 시점을 늦추고, 입력부터 화면까지의 지연 시간을 잰다.
+	- sleep 은 OS 해상도만큼 늦게 깨므로, 실제 sleep(1ms) 시간의 평균 + 표준편차를 추정해서 그보다 많이 남았을 때만
+	  sleep 하고 나머지는 yield 하면서 기다린다. (busy wait 은 마지막 1~2ms 뿐)
+	- 입력을 읽기 직전에 기다리므로 기다린 시간은 지연 시간에 들어가지 않는다.
+	- present 이후 실제로 화면에 나온 시각은 알 수 없으므로, 같은 frame slot 의 fence 를 다시 기다릴 때 본
+	  GPU 완료 시각을 화면 지연의 근사로 쓴다. (frames in flight 가 클수록 늦게 확인하므로 상한에 가깝다)
+*/
+class FramePacer
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	void cleanup();
+
+	// 0 이면 제한하지 않는다.
+	void setTargetFrameMs(float targetMs);
+	float getTargetFrameMs()
+	{
+		return m_targetMs;
+	}
+
+	// 입력을 읽기 (window event poll) 직전에 호출한다. 이전 프레임 시작부터 목표 시간이 지날 때까지 기다린다.
+	void waitForNextFrame();
+	// 입력을 읽은 직후 호출한다. 이번 프레임 지연 시간의 기준 시각
+	void markInputSampled();
+
+	// Renderer 가 frame slot 마다 호출한다.
+	void onFenceWaited(uint32_t frame, Clock::time_point waitStart);
+	void onSubmit(uint32_t frame);
+	void onPresent(uint32_t frame);
+	// frames in flight 를 바꾸는 등 device idle 을 기다린 뒤 호출한다. 아직 확인하지 않은 프레임을 버린다.
+	void resetFrames();
+
+	const FrameLatencyStats &getStats()
+	{
+		return m_stats;
+	}
+
+  private:
+	struct FrameRecord
+	{
+		Clock::time_point inputTime;
+		bool pending = false;
+	};
+
+	void sleepUntil(Clock::time_point deadline);
+	static void accumulate(float &average, float sampleMs);
+	static float toMs(Clock::duration duration);
+
+	float m_targetMs = 0.0f;
+	bool m_timerResolutionRequested = false;
+
+	Clock::time_point m_frameStart{};
+	Clock::time_point m_inputTime{};
+	FrameRecord m_frames[MAX_FRAMES_IN_FLIGHT];
+
+	// sleep(1ms) 가 실제로 걸리는 시간의 지수 이동 평균 / 분산 (처음에는 넉넉하게 2ms 로 본다)
+	float m_sleepMeanMs = 1.0f;
+	float m_sleepVariance = 1.0f;
+
+	FrameLatencyStats m_stats;
+};
+
+} // namespace ale
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+#include "Renderer/VulkanContext.h"
+
+#include <chrono>
+
+namespace ale
+{
+struct GpuTiming
+{
+	std::string name;
+	float lastMs = 0.0f;
+	float averageMs = 0.0f; // 최근 HISTORY_SIZE 프레임 평균
+};
+
+/*
+	pass 단위 GPU 시간을 timestamp query 로 잰다.
+	- 프레임마다 query pool 을 하나씩 두고, command buffer 시작에서 reset 한 뒤 pass 앞뒤로 timestamp 를 쓴다.
+	- 결과는 같은 프레임 slot 을 다시 쓸 때(fence 대기 후) 읽으므로 frames in flight 만큼 늦게 나오고 대기하지 않는다.
+	- 읽은 결과는 Instrumentor 세션이 열려 있으면 GPU track 으로 trace 에 같이 기록한다.
+*/
+class GpuProfiler
+{
+  public:
+	static constexpr uint32_t MAX_SCOPES = 32;
+	static constexpr uint32_t HISTORY_SIZE = 60;
+
+	static std::unique_ptr<GpuProfiler> createGpuProfiler();
+
+	~GpuProfiler() = default;
+
+	void cleanup();
+
+	// frame 의 fence 를 기다린 뒤, command buffer 기록 시작 직후 호출한다. 이전 결과를 읽고 query 를 reset 한다.
+	void beginFrame(VkCommandBuffer commandBuffer, uint32_t frame);
+	// vkQueueSubmit 직전에 호출한다. trace 에서 이 프레임의 GPU 시간을 CPU 시간축에 맞추는 기준이 된다.
+	void endFrame(uint32_t frame);
+	// frames in flight 를 바꿀 때 device idle 을 기다린 뒤 호출한다. 아직 읽지 않은 결과를 버린다.
+	void resetFrames();
+
+	// SECONDARY_COMMAND_BUFFERS 로 시작한 subpass 안에서는 호출할 수 없다.
+	uint32_t beginScope(VkCommandBuffer commandBuffer, const char *name);
+	void endScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+	bool isSupported()
+	{
+		return m_supported;
+	}
+	const std::vector<GpuTiming> &getTimings()
+	{
+		return m_timings;
+	}
+	float getTotalMs()
+	{
+		return m_totalMs;
+	}
+	// 가장 최근에 읽은 프레임의 첫 timestamp 부터 마지막 timestamp 까지의 시간 (평균 없음, dynamic resolution 용)
+	float getFrameMs()
+	{
+		return m_frameMs;
+	}
+
+  private:
+	struct Scope
+	{
+		const char *name;
+		uint32_t timingIndex;
+	};
+
+	struct FrameQueries
+	{
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+		std::vector<Scope> scopes;
+		uint32_t frame = 0;
+		std::chrono::steady_clock::time_point submitTime;
+	};
+
+	GpuProfiler() = default;
+
+	void initGpuProfiler();
+	void readResults(FrameQueries &frameQueries);
+	uint32_t getTimingIndex(const char *name);
+
+	bool m_supported = false;
+	float m_timestampPeriod = 1.0f; // tick 당 ns
+	uint64_t m_timestampMask = UINT64_MAX;
+
+	FrameQueries m_frames[MAX_FRAMES_IN_FLIGHT];
+	uint32_t m_currentFrame = 0;
+
+	std::vector<GpuTiming> m_timings;
+	std::vector<std::array<float, HISTORY_SIZE>> m_history;
+	std::vector<uint64_t> m_queryResults;
+	uint32_t m_historyIndex = 0;
+	uint32_t m_historyCount = 0;
+	float m_totalMs = 0.0f;
+	float m_frameMs = 0.0f;
+};
+
+} // namespace ale
+
+#endif
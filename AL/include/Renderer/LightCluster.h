@@ -0,0 +1,81 @@
+#ifndef LIGHTCLUSTER_H
+#define LIGHTCLUSTER_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+namespace ale
+{
+// cluster 하나가 참조하는 light index 구간 (LightingPass.frag 의 uvec2 와 같은 배치)
+struct LightClusterRange
+{
+	uint32_t offset;
+	uint32_t count;
+};
+
+/*
+	view space 를 화면 tile(x, y) 과 지수 간격의 depth slice(z) 로 나눈 cluster grid 에 light 를 나눠 담는다.
+	- lights 의 앞쪽 globalLightCount 개(directional / shadow map 을 쓰는 light)는 모든 pixel 이 계산하므로 건너뛴다.
+	- 나머지 point / spot light 는 영향 범위(range) 구와 cluster 의 view space AABB 가 겹치는지 검사한다.
+	- cluster AABB 는 projection / 화면 크기가 바뀔 때만 다시 계산하고, 겹침 검사는 depth slice 단위로 병렬 처리한다.
+*/
+class LightCluster
+{
+  public:
+	static constexpr uint32_t GRID_X = 16;
+	static constexpr uint32_t GRID_Y = 9;
+	static constexpr uint32_t GRID_Z = 24;
+	static constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+
+	// radiance 가 이 값 아래로 떨어지는 거리를 light 의 영향 범위로 쓴다. (shader 도 같은 거리에서 0 이 되도록 감쇠)
+	static constexpr float LIGHT_CUTOFF = 0.01f;
+	static float computeLightRange(const Light &light);
+
+	// projection 은 y 를 뒤집은 Vulkan 기준 (geometry pass 와 같은 행렬)
+	void build(const std::vector<Light> &lights, uint32_t globalLightCount, const glm::mat4 &view,
+			   const glm::mat4 &projection, const glm::vec2 &viewportSize);
+
+	const std::vector<LightClusterRange> &getClusters() const
+	{
+		return m_clusters;
+	}
+	const std::vector<uint32_t> &getLightIndices() const
+	{
+		return m_lightIndices;
+	}
+
+	glm::uvec4 getGrid(uint32_t globalLightCount) const
+	{
+		return glm::uvec4(GRID_X, GRID_Y, GRID_Z, globalLightCount);
+	}
+	// tile 크기(pixel) x, y / slice = log(depth) * scale + bias
+	glm::vec4 getParams() const
+	{
+		return glm::vec4(m_viewportSize.x / GRID_X, m_viewportSize.y / GRID_Y, m_sliceScale, m_sliceBias);
+	}
+
+  private:
+	void buildClusterBounds(const glm::mat4 &projection, const glm::vec2 &viewportSize);
+	uint32_t getSlice(float depth) const;
+
+	glm::mat4 m_projection = glm::mat4(0.0f);
+	glm::vec2 m_viewportSize = glm::vec2(0.0f);
+	float m_near = 0.1f;
+	float m_far = 100.0f;
+	float m_sliceScale = 0.0f;
+	float m_sliceBias = 0.0f;
+
+	// cluster 별 view space AABB (index = x + y * GRID_X + z * GRID_X * GRID_Y)
+	std::vector<glm::vec3> m_clusterMin;
+	std::vector<glm::vec3> m_clusterMax;
+
+	std::vector<glm::vec4> m_viewLights;			   // view space 중심 + range
+	std::vector<std::vector<uint32_t>> m_sliceLights;  // depth slice 에 걸치는 light
+	std::vector<std::vector<uint32_t>> m_sliceIndices; // depth slice 별 결과 (slice 안에서의 offset 기준)
+	std::vector<LightClusterRange> m_clusters;
+	std::vector<uint32_t> m_lightIndices;
+};
+
+} // namespace ale
+
+#endif
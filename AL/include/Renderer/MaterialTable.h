@@ -0,0 +1,71 @@
+#ifndef MATERIALTABLE_H
+#define MATERIALTABLE_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+#include "Renderer/Material.h"
+#include "Renderer/ShaderResourceManager.h"
+
+namespace ale
+{
+/*
+	geometry pass 가 쓰는 material 을 하나의 table 과 전역 texture 배열로 관리한다.
+	- texture 는 처음 쓰일 때 배열의 빈 slot 을 받고, 그 뒤로는 같은 slot 을 계속 쓴다. (0 번은 기본 texture)
+	- slot 이 바뀌면 프레임별 디스크립터 셋에 바로 쓰지 않고, 그 프레임의 GPU 작업이 끝난 뒤 update 에서 쓴다.
+	- material table 은 매 프레임 그릴 material 만 모아서 만들고, draw 는 table 의 index 만 push constant 로 넘긴다.
+*/
+class MaterialTable
+{
+  public:
+	static std::unique_ptr<MaterialTable> createMaterialTable(VkDescriptorSetLayout descriptorSetLayout);
+	// MAX_MATERIAL_TEXTURES 와 device 의 stage / set 당 sampler 한도 중 작은 값
+	static uint32_t getTextureCapacity();
+
+	~MaterialTable() = default;
+
+	void cleanup();
+
+	// frame 의 fence 를 기다린 뒤 호출한다. materials[i] 는 table 의 i 번 항목이 된다.
+	void update(uint32_t frame, const std::vector<Material *> &materials);
+	// Renderer 의 frames in flight 가 바뀌면 호출한다. (device idle 상태에서)
+	void setFrameCount(uint32_t frameCount);
+
+	const std::vector<MaterialData> &getMaterialData() const
+	{
+		return m_materialData;
+	}
+	VkDescriptorSet getDescriptorSet(uint32_t frame)
+	{
+		return m_shaderResourceManager->getDescriptorSets()[frame];
+	}
+	uint32_t getTextureCount() const
+	{
+		return static_cast<uint32_t>(m_textureSlots.size());
+	}
+
+  private:
+	MaterialTable() = default;
+
+	void initMaterialTable(VkDescriptorSetLayout descriptorSetLayout);
+	uint32_t acquireTextureSlot(const std::shared_ptr<Texture> &texture);
+	void assignTextureSlot(uint32_t slot, const std::shared_ptr<Texture> &texture);
+	void releaseExpiredSlots();
+
+	std::shared_ptr<Texture> m_defaultTexture;
+	std::unique_ptr<ShaderResourceManager> m_shaderResourceManager;
+	uint32_t m_capacity = 0;
+
+	std::unordered_map<Texture *, uint32_t> m_textureSlots;
+	std::vector<std::weak_ptr<Texture>> m_slotTextures; // slot 을 차지한 texture, 만료되면 slot 을 다시 쓴다.
+	std::vector<uint32_t> m_freeSlots;
+	std::vector<uint32_t> m_pendingSlots[MAX_FRAMES_IN_FLIGHT]; // 아직 그 프레임 셋에 쓰지 않은 slot
+	// 쓰는 프레임 셋 수 (Renderer 의 frames in flight), 그 뒤의 목록은 비워 둔다.
+	uint32_t m_frameCount = DEFAULT_FRAMES_IN_FLIGHT;
+	bool m_capacityWarned = false;
+
+	std::vector<MaterialData> m_materialData;
+};
+
+} // namespace ale
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef MEMORYALLOCATOR_H
+#define MEMORYALLOCATOR_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace ale
+{
+class MemoryBlock;
+
+enum class AllocationStrategy
+{
+	// TLSF (two-level segregated fit): 크기 class 별 빈 구간 목록에서 O(1) 로 찾고, 해제 시 이웃한 빈 구간과 합친다.
+	GENERAL,
+	// 앞에서부터 잘라 쓰기만 하고, block 의 할당이 모두 해제되면 처음으로 되돌린다. (staging buffer 처럼 바로 해제되는
+	// 임시 버퍼용)
+	LINEAR
+};
+
+// vkAllocateMemory 로 받은 큰 block 안의 한 구간
+struct MemoryAllocation
+{
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	VkDeviceSize size = 0;
+	void *mappedData = nullptr; // host visible 메모리면 block 을 map 해둔 주소 + offset
+	uint32_t memoryTypeIndex = 0;
+	MemoryBlock *block = nullptr; // nullptr 이면 단독(dedicated) 할당
+};
+
+struct MemoryHeapStats
+{
+	VkDeviceSize blockBytes = 0;  // 이 heap 에서 vkAllocateMemory 로 받은 크기
+	VkDeviceSize usedBytes = 0;	  // 그 중 실제로 잘라 준 크기
+	VkDeviceSize budgetBytes = 0; // 이 이상은 새 block 을 만들지 않는다.
+	VkDeviceSize heapSize = 0;
+	bool deviceLocal = false;
+};
+
+struct MemoryStats
+{
+	uint32_t blockCount = 0;
+	uint32_t dedicatedCount = 0;
+	uint32_t allocationCount = 0;
+	uint32_t deviceAllocationCount = 0; // 살아있는 vkAllocateMemory 수
+	VkDeviceSize blockBytes = 0;
+	VkDeviceSize usedBytes = 0;
+	VkDeviceSize largestFreeRange = 0;
+	std::vector<MemoryHeapStats> heaps;
+};
+
+class MemoryBlock
+{
+  public:
+	MemoryBlock(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, uint32_t heapIndex,
+				AllocationStrategy strategy, void *mappedData);
+
+	bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset);
+	void free(VkDeviceSize offset, VkDeviceSize size);
+
+	bool isEmpty() const
+	{
+		return m_allocationCount == 0;
+	}
+	VkDeviceSize getLargestFreeRange() const;
+
+	VkDeviceMemory getMemory() const
+	{
+		return m_memory;
+	}
+	VkDeviceSize getSize() const
+	{
+		return m_size;
+	}
+	VkDeviceSize getUsedSize() const
+	{
+		return m_usedSize;
+	}
+	uint32_t getAllocationCount() const
+	{
+		return m_allocationCount;
+	}
+	uint32_t getMemoryTypeIndex() const
+	{
+		return m_memoryTypeIndex;
+	}
+	uint32_t getHeapIndex() const
+	{
+		return m_heapIndex;
+	}
+	void *getMappedData() const
+	{
+		return m_mappedData;
+	}
+
+  private:
+	static constexpr uint32_t NULL_RANGE = UINT32_MAX;
+	// 첫 단계는 크기의 최상위 bit, 두 번째 단계는 그 구간을 SL_COUNT 개로 나눈 것
+	static constexpr uint32_t SL_BITS = 4;
+	static constexpr uint32_t SL_COUNT = 1 << SL_BITS;
+	static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+
+	// block 을 나눈 구간 하나 (사용 중이거나 비어 있음)
+	struct Range
+	{
+		VkDeviceSize offset;
+		VkDeviceSize size;
+		uint32_t prevPhysical; // 주소상 앞 / 뒤 구간 (합치기용)
+		uint32_t nextPhysical;
+		uint32_t prevFree; // 같은 크기 class 의 빈 구간 목록
+		uint32_t nextFree;
+		bool free;
+	};
+
+	static void mapSize(VkDeviceSize size, uint32_t &fl, uint32_t &sl);
+	uint32_t createRange(VkDeviceSize offset, VkDeviceSize size, uint32_t prevPhysical, uint32_t nextPhysical);
+	void destroyRange(uint32_t index);
+	void insertFreeRange(uint32_t index);
+	void removeFreeRange(uint32_t index);
+	uint32_t findFreeRange(VkDeviceSize size, VkDeviceSize alignment);
+
+  private:
+	VkDeviceMemory m_memory;
+	VkDeviceSize m_size;
+	uint32_t m_memoryTypeIndex;
+	uint32_t m_heapIndex;
+	AllocationStrategy m_strategy;
+	void *m_mappedData;
+
+	VkDeviceSize m_usedSize = 0;
+	uint32_t m_allocationCount = 0;
+
+	// GENERAL: TLSF 구간, 크기 class 별 빈 구간 목록의 head 와 비어있지 않은 목록의 bitmap
+	std::vector<Range> m_ranges;
+	std::vector<uint32_t> m_unusedRanges;
+	std::unordered_map<VkDeviceSize, uint32_t> m_allocatedRanges; // offset -> 사용 중인 구간
+	uint32_t m_freeHeads[FL_COUNT][SL_COUNT];
+	uint64_t m_flBitmap = 0;
+	uint32_t m_slBitmaps[FL_COUNT] = {};
+	// LINEAR: 다음에 잘라 줄 위치
+	VkDeviceSize m_linearOffset = 0;
+};
+
+/*
+	buffer / image 메모리를 memory type 별 큰 block 에서 잘라 주는 allocator
+	- device local 은 64MB, host visible 은 16MB block 을 만들고 block 크기의 절반을 넘는 요청은 단독으로 할당한다.
+	- buffer 와 image(optimal tiling) 는 다른 block 을 써서 bufferImageGranularity 를 신경 쓰지 않는다.
+	- host visible block 은 만들 때 한 번만 map 해두고 MemoryAllocation::mappedData 로 넘긴다.
+	- heap 마다 budget(기본 heap 크기의 90%)을 넘으면 빈 block 을 먼저 반환하고, 그래도 부족하면 실패한다.
+*/
+class MemoryAllocator
+{
+  public:
+	static MemoryAllocator &getAllocator();
+
+	void init(VkDevice device, VkPhysicalDevice physicalDevice);
+	void cleanup();
+
+	// 메모리를 할당하고 buffer / image 에 bind 까지 한다.
+	MemoryAllocation allocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags properties,
+										  AllocationStrategy strategy = AllocationStrategy::GENERAL);
+	MemoryAllocation allocateImageMemory(VkImage image, VkMemoryPropertyFlags properties);
+	// bind 하지 않고 image 용 메모리만 잘라 준다. (여러 image 를 같은 구간에 bind 하는 render graph aliasing)
+	MemoryAllocation allocateImageMemory(const VkMemoryRequirements &requirements, VkMemoryPropertyFlags properties);
+	void free(MemoryAllocation &allocation);
+	bool hasMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties);
+
+	// 조각 모음 hook: 할당이 하나도 없는 block 을 driver 에 반환한다. (장면 unload 후 등)
+	uint32_t releaseEmptyBlocks();
+	void setHeapBudget(uint32_t heapIndex, VkDeviceSize budget);
+
+	MemoryStats getStats();
+
+  private:
+	MemoryAllocator() = default;
+
+	MemoryAllocation allocate(const VkMemoryRequirements &requirements, VkMemoryPropertyFlags properties, bool image,
+							  AllocationStrategy strategy);
+	MemoryAllocation allocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex);
+	MemoryBlock *createBlock(uint32_t memoryTypeIndex, VkDeviceSize size, AllocationStrategy strategy);
+	bool reserveHeap(uint32_t heapIndex, VkDeviceSize size);
+	uint32_t releaseEmptyBlocksLocked();
+	VkDeviceSize getBlockSize(uint32_t memoryTypeIndex);
+	uint32_t getPoolIndex(uint32_t memoryTypeIndex, bool image, AllocationStrategy strategy);
+
+  private:
+	VkDevice m_device = VK_NULL_HANDLE;
+	VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+	std::mutex m_mutex;
+
+	// [memoryTypeIndex][buffer / image][GENERAL / LINEAR] 별 block 목록
+	std::vector<std::vector<std::unique_ptr<MemoryBlock>>> m_pools;
+	std::vector<MemoryHeapStats> m_heaps;
+	uint32_t m_dedicatedCount = 0;
+	uint32_t m_allocationCount = 0;
+};
+
+} // namespace ale
+
+#endif
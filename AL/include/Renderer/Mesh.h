@@ -4,6 +4,7 @@
 #include "Core/Base.h"
 #include "Renderer/Buffer.h"
 #include "Renderer/Common.h"
+#include "Renderer/MeshPool.h"
 
 namespace ale
 {
@@ -22,7 +23,18 @@ class Mesh
 
 	void cleanup();
 
-	void draw(VkCommandBuffer commandBuffer);
+	void draw(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+	// vertex / index buffer bind 와 draw 를 나눠서, 같은 mesh 가 이어지면 bind 를 생략할 수 있게 한다.
+	void bind(VkCommandBuffer commandBuffer);
+	void drawIndexed(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+	// indirect draw 에 쓸 command (instanceCount 는 호출한 쪽이 채운다)
+	VkDrawIndexedIndirectCommand getDrawCommand(uint32_t instanceCount, uint32_t firstInstance);
+
+	// mesh 가 담긴 MeshPool page (같은 page 의 mesh 끼리는 bind 를 공유한다)
+	uint32_t getPage()
+	{
+		return m_range.page;
+	}
 
 	void calculateAABB(std::vector<Vertex> &vertices);
 	glm::vec3 getMaxPos();
@@ -33,8 +45,7 @@ class Mesh
 
 	glm::vec3 m_minPos;
 	glm::vec3 m_maxPos;
-	std::unique_ptr<VertexBuffer> m_vertexBuffer;
-	std::unique_ptr<IndexBuffer> m_indexBuffer;
+	MeshRange m_range;
 
 	void initMesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
 	void calculateTangents(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
@@ -0,0 +1,74 @@
+#ifndef MESHPOOL_H
+#define MESHPOOL_H
+
+#include "Core/Base.h"
+#include "Renderer/Buffer.h"
+#include "Renderer/Common.h"
+
+#include <map>
+#include <mutex>
+
+namespace ale
+{
+// MeshPool 안에서 mesh 하나가 차지하는 구간
+struct MeshRange
+{
+	uint32_t page = UINT32_MAX;
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+	int32_t vertexOffset = 0;
+	uint32_t vertexCount = 0;
+};
+
+/*
+	모든 mesh 의 vertex / index 를 몇 개의 큰 공용 buffer(page)에 이어 담는 pool
+	- 같은 page 의 mesh 는 buffer bind 없이 firstIndex / vertexOffset 만 바꿔 그릴 수 있어서,
+	  GPU culling 모드에서 page 단위로 여러 draw 를 indirect 호출 하나로 묶을 수 있다.
+	- page 마다 vertex / index 의 빈 구간 목록을 두고 first fit 으로 잘라 쓰며, 해제된 구간은 이웃한 빈 구간과 합친다.
+	- page 크기보다 큰 mesh 는 그 mesh 만 담는 page 를 따로 만든다.
+*/
+class MeshPool
+{
+  public:
+	static constexpr uint32_t PAGE_VERTEX_COUNT = 256 * 1024;
+	static constexpr uint32_t PAGE_INDEX_COUNT = 1024 * 1024;
+
+	static MeshPool &getMeshPool();
+
+	void init();
+	void cleanup();
+
+	MeshRange allocate(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
+	void free(const MeshRange &range);
+
+	void bind(VkCommandBuffer commandBuffer, uint32_t page);
+
+	uint32_t getPageCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return static_cast<uint32_t>(m_pages.size());
+	}
+
+  private:
+	struct Page
+	{
+		std::unique_ptr<VertexBuffer> vertexBuffer;
+		std::unique_ptr<IndexBuffer> indexBuffer;
+		// offset -> 개수, 주소 순으로 정렬된 빈 구간
+		std::map<uint32_t, uint32_t> freeVertices;
+		std::map<uint32_t, uint32_t> freeIndices;
+	};
+
+	MeshPool() = default;
+	MeshPool(MeshPool const &) = delete;
+	void operator=(MeshPool const &) = delete;
+
+	uint32_t findPage(uint32_t vertexCount, uint32_t indexCount);
+
+	std::vector<Page> m_pages;
+	std::mutex m_mutex;
+};
+
+} // namespace ale
+
+#endif
@@ -15,41 +15,39 @@
 
 namespace ale
 {
-class ShaderResourceManager;
+class Mesh;
 
-struct DrawInfo
+// command buffer 하나에 마지막으로 bind 한 상태, 같은 상태는 다시 bind 하지 않는다.
+struct DrawState
 {
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 projection;
-	glm::mat4 finalBonesMatrices[MAX_BONES];
-	ShaderResourceManager *shaderResourceManager;
-	VkCommandBuffer commandBuffer;
-	VkPipelineLayout pipelineLayout;
-	std::vector<std::shared_ptr<Material>> materials;
-	uint32_t currentFrame;
+	uint32_t materialIndex = UINT32_MAX;
+	uint32_t meshPage = UINT32_MAX; // 같은 MeshPool page 의 mesh 끼리는 vertex / index buffer 를 공유한다.
+	uint32_t bindCount = 0;
+	uint32_t drawCount = 0;
 };
 
-struct ShadowMapDrawInfo
+// 모델의 mesh 하나를 instance buffer 의 [firstInstance, firstInstance + instanceCount) 구간으로 그린다.
+// model 행렬 / bone palette 위치는 instance buffer 에서, material 은 pass 시작 시 bind 한 material table 의
+// materialIndex 번 항목에서 읽는다.
+struct DrawInfo
 {
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 projection;
-	ShaderResourceManager *shaderResourceManager;
 	VkCommandBuffer commandBuffer;
 	VkPipelineLayout pipelineLayout;
-	uint32_t currentFrame;
+	uint32_t meshIndex = 0;
+	uint32_t materialIndex = 0;
+	uint32_t firstInstance = 0;
+	uint32_t instanceCount = 1;
+	DrawState *state;
 };
 
-struct ShadowCubeMapDrawInfo
+// shadow pass 의 light 행렬은 pass 시작 시 한 번 bind 되므로 mesh 만 그린다.
+struct ShadowMapDrawInfo
 {
-	glm::mat4 model;
-	glm::mat4 view[6];
-	glm::mat4 projection;
-	ShaderResourceManager *shaderResourceManager;
 	VkCommandBuffer commandBuffer;
-	VkPipelineLayout pipelineLayout;
-	uint32_t currentFrame;
+	uint32_t meshIndex = 0;
+	uint32_t firstInstance = 0;
+	uint32_t instanceCount = 1;
+	DrawState *state;
 };
 
 struct CullSphere;
@@ -70,7 +68,6 @@ class Model
 
 	void draw(DrawInfo &drawInfo);
 	void drawShadow(ShadowMapDrawInfo &drawInfo);
-	void drawShadowCubeMap(ShadowCubeMapDrawInfo &drawInfo);
 	CullSphere initCullSphere();
 
 	size_t getMeshCount()
@@ -117,6 +114,9 @@ class Model
 	void initCapsuleModel(std::shared_ptr<Material> &defaultMaterial);
 	void initCylinderModel(std::shared_ptr<Material> &defaultMaterial);
 
+	static void drawMesh(Mesh *mesh, VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance,
+						 DrawState &state);
+
 	void loadModel(std::string path, std::shared_ptr<Material> &defaultMaterial);
 	void loadGLTFModel(std::string path, std::shared_ptr<Material> &defaultMaterial);
 	void loadOBJModel(std::string path, std::shared_ptr<Material> &defaultMaterial);
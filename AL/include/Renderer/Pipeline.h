@@ -3,37 +3,58 @@
 
 #include "Core/Base.h"
 #include "Renderer/Common.h"
+#include "Renderer/ShaderLibrary.h"
 #include "Renderer/VulkanContext.h"
 #include "Renderer/VulkanUtil.h"
 
+#include <functional>
+#include <set>
+
 namespace ale
 {
 class Pipeline
 {
   public:
+	// skinned == false 이면 bone 입력이 없는 static mesh 용, heightMap == false 면 height map 을 쓰지 않는 material 용
+	// vertex shader permutation
 	static std::unique_ptr<Pipeline> createGeometryPassPipeline(VkRenderPass renderPass,
-																VkDescriptorSetLayout descriptorSetLayout);
+																VkDescriptorSetLayout frameDescriptorSetLayout,
+																VkDescriptorSetLayout descriptorSetLayout,
+																bool skinned = true, bool heightMap = true);
 	static std::unique_ptr<Pipeline> createLightingPassPipeline(VkRenderPass renderPass,
 																VkDescriptorSetLayout descriptorSetLayout);
 	static std::unique_ptr<Pipeline> createShadowMapPipeline(VkRenderPass renderPass,
 															 VkDescriptorSetLayout descriptorSetLayout);
 	static std::unique_ptr<Pipeline> createShadowCubeMapPipeline(VkRenderPass renderPass,
 																 VkDescriptorSetLayout descriptorSetLayout);
-	static std::unique_ptr<Pipeline> createSphericalMapPipeline(VkRenderPass renderPass,
-																VkDescriptorSetLayout descriptorSetLayout);
 	static std::unique_ptr<Pipeline> createBackgroundPipeline(VkRenderPass renderPass,
 															  VkDescriptorSetLayout descriptorSetLayout);
+	// 내부 해상도의 scene color 를 viewport 크기로 늘리는 pass (push constant = UpscalePushConstants)
+	static std::unique_ptr<Pipeline> createUpscalePipeline(VkRenderPass renderPass,
+														   VkDescriptorSetLayout descriptorSetLayout);
+	// GPU culling compute pipeline (push constant = GpuCullingPushConstants)
+	static std::unique_ptr<Pipeline> createGpuCullingPipeline(VkDescriptorSetLayout descriptorSetLayout);
+	// skybox 전처리 compute pipeline (push constant = EnvironmentMapPushConstants)
+	static std::unique_ptr<Pipeline> createEnvironmentMapPipeline(VkDescriptorSetLayout descriptorSetLayout,
+																  const std::string &shaderFile);
 
-	void initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
+	void initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSetLayout frameDescriptorSetLayout,
+								  VkDescriptorSetLayout descriptorSetLayout, bool skinned = true,
+								  bool heightMap = true);
 	void initLightingPassPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
 	void initShadowMapPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
 	void initShadowCubeMapPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
-	void initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
 	void initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
+	void initUpscalePipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout);
+	void initGpuCullingPipeline(VkDescriptorSetLayout descriptorSetLayout);
+	void initEnvironmentMapPipeline(VkDescriptorSetLayout descriptorSetLayout, const std::string &shaderFile);
 
 	~Pipeline() = default;
 
 	void cleanup();
+	// 이 pipeline 이 쓰는 shader 가 changedShaders 에 있으면 처음과 같은 인자로 다시 만든다. (hot reload)
+	// GPU 가 이 pipeline 을 쓰고 있지 않을 때 호출해야 하며, pipeline / layout handle 이 바뀐다.
+	bool reload(const std::set<std::string> &changedShaders);
 
 	VkPipeline getPipeline()
 	{
@@ -47,8 +68,15 @@ class Pipeline
   private:
 	VkPipelineLayout pipelineLayout;
 	VkPipeline pipeline;
+	std::function<void(Pipeline &)> reinit; // create 에서 받은 인자로 init 을 다시 호출한다.
+	std::vector<std::string> shaderFiles;	// reload 판단용
+
+	VkShaderModule getShaderModule(const std::string &fileName, const ShaderDefines &defines = {});
 
-	VkShaderModule createShaderModule(const std::vector<char> &code);
+	// Vertex 속성(location 0 ~ 5) + InstanceData 속성(location 6 ~ 10)
+	std::vector<VkVertexInputAttributeDescription> getInstancedAttributeDescriptions();
+	// bone 입력(boneIds, weights, boneOffset)을 뺀 속성
+	std::vector<VkVertexInputAttributeDescription> getStaticInstancedAttributeDescriptions();
 };
 } // namespace ale
 
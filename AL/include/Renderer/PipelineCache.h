@@ -0,0 +1,57 @@
+#ifndef PIPELINECACHE_H
+#define PIPELINECACHE_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+namespace ale
+{
+/*
+	VkPipelineCache 를 디스크에 저장해 두고 다음 실행에서 다시 쓰는 cache
+	- 파일 header 에 vendorID / deviceID / driverVersion / pipelineCacheUUID 를 적어두고, 하나라도 다르면 (GPU 나
+	  driver 가 바뀌면) 파일을 버리고 빈 cache 로 시작한다. 데이터 hash 가 맞지 않는 (쓰다 만) 파일도 버린다.
+	- VkPipelineCache 는 driver 가 내부에서 동기화하므로 여러 worker 가 동시에 pipeline 을 만들어도 된다.
+*/
+class PipelineCache
+{
+  public:
+	static PipelineCache &getPipelineCache();
+
+	void init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string &path = "./cache/pipeline.bin");
+	// cache 를 파일에 저장하고 정리한다.
+	void cleanup();
+	void save();
+
+	VkPipelineCache getCache()
+	{
+		return m_cache;
+	}
+
+  private:
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t vendorID;
+		uint32_t deviceID;
+		uint32_t driverVersion;
+		uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+		uint64_t dataSize;
+		uint64_t dataHash;
+	};
+
+	PipelineCache() = default;
+
+	std::vector<char> loadFile();
+	FileHeader makeHeader();
+
+  private:
+	VkDevice m_device = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties m_properties{};
+	std::string m_path;
+	VkPipelineCache m_cache = VK_NULL_HANDLE;
+};
+
+} // namespace ale
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+#include "Renderer/GpuProfiler.h"
+#include "Renderer/MemoryAllocator.h"
+#include "Renderer/VulkanContext.h"
+
+#include <functional>
+
+namespace ale
+{
+// RenderGraph::createImage / addPass 가 돌려주는 index
+using RenderGraphHandle = uint32_t;
+
+struct RenderGraphImageInfo
+{
+	VkFormat format = VK_FORMAT_UNDEFINED;
+	// 0 이면 graph 의 extent (viewport 크기) 를 따르고 resize 때 다시 만든다.
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t layers = 1; // cube 면 6
+	bool cube = false;
+	// 프레임이 지나도 내용과 layout 을 유지한다. (shadow map 캐시, 화면 출력) alias group 에 들어가지 않으며,
+	// shareMemory 로 묶은 persistent image 끼리만 메모리를 나눈다.
+	bool persistent = false;
+	VkImageUsageFlags usage = 0; // pass 선언으로 알 수 없는 추가 usage (TRANSFER_SRC 등)
+};
+
+enum class RenderGraphAccess
+{
+	COLOR_ATTACHMENT,
+	DEPTH_ATTACHMENT,
+	INPUT_ATTACHMENT, // 같은 pass 의 앞 subpass 가 쓴 attachment 를 읽는다.
+	SAMPLED			  // fragment shader 에서 sampler 로 읽는다. (pass 시작 전에 SHADER_READ_ONLY 로 바꾼다)
+};
+
+struct RenderGraphStats
+{
+	uint32_t passCount = 0;
+	uint32_t culledPassCount = 0;
+	uint32_t imageCount = 0;
+	uint32_t aliasGroupCount = 0;
+	VkDeviceSize requestedBytes = 0; // image 마다 따로 할당했을 때의 크기
+	VkDeviceSize allocatedBytes = 0; // aliasing 후 실제로 할당한 크기 (lazily allocated 제외)
+	VkDeviceSize lazyBytes = 0;		 // lazily allocated 메모리에 둔 transient attachment 크기
+};
+
+// subpass 의 내용을 기록한다. SECONDARY_COMMAND_BUFFERS subpass 는 vkCmdExecuteCommands 만 호출해야 한다.
+using RenderGraphRecordFunction = std::function<void(VkCommandBuffer commandBuffer)>;
+
+/*
+	pass 가 읽고 쓰는 image 를 선언하면 render pass / framebuffer / barrier 를 graph 가 만든다.
+	- compile: output 으로 이어지지 않는 pass 는 빼고, 남은 pass 마다 render pass 를 만든다.
+	  다른 pass 가 읽지 않는 attachment 는 store 하지 않고, 한 pass 안에서만 쓰이면 lazily allocated 메모리에 둔다.
+	  persistent 가 아닌 image 는 살아있는 pass 구간이 겹치지 않으면 같은 메모리를 나눠 쓴다.
+	  shareMemory 로 묶은 persistent image 는 구간과 상관없이 같은 메모리를 쓴다. (한 프레임에 하나만 쓴다)
+	- execute: pass 마다 필요한 layout 전환 / barrier 를 넣고 선언 순서대로 기록한다.
+	- resize: image 와 framebuffer 만 다시 만든다. render pass 는 그대로라서 pipeline 을 다시 만들 필요가 없다.
+	  pass 의 render area 를 image 보다 작게 잡으면 image 를 다시 만들지 않고 그리는 크기만 바꿀 수 있다.
+	graphics pass 만 다루며, buffer 만 쓰는 compute pass (GPU culling) 는 graph 앞에서 따로 기록한다.
+*/
+class RenderGraph
+{
+  public:
+	static std::unique_ptr<RenderGraph> createRenderGraph(VkExtent2D extent);
+
+	~RenderGraph() = default;
+
+	void cleanup();
+
+	// [선언] compile 전에만 호출한다. name 은 GPU profiler scope 이름으로도 쓰므로 문자열 상수여야 한다.
+	RenderGraphHandle createImage(const char *name, const RenderGraphImageInfo &info);
+	// 프레임 끝에 image 를 layout 으로 바꿔둔다. (graph 밖에서 읽는 image)
+	void setOutput(RenderGraphHandle image, VkImageLayout layout);
+	// 한 프레임에 둘 중 하나만 쓰는 persistent image 들이 같은 메모리를 쓴다. (light slot 의 2D / cube shadow map)
+	// 한 쪽 pass 가 그리면 다른 쪽 내용은 사라지므로, 호출하는 쪽이 캐시를 무효로 해야 한다.
+	void shareMemory(RenderGraphHandle image, RenderGraphHandle other);
+
+	// pass 는 subpass 0 을 가지고 시작하고, addSubpass 로 뒤에 subpass 를 붙인다.
+	RenderGraphHandle addPass(const char *name, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+	uint32_t addSubpass(RenderGraphHandle pass, const char *name,
+						VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+	void setRecord(RenderGraphHandle pass, uint32_t subpass, RenderGraphRecordFunction record);
+
+	void writeColor(RenderGraphHandle pass, uint32_t subpass, RenderGraphHandle image, VkAttachmentLoadOp loadOp,
+					VkClearValue clearValue = {});
+	void writeDepth(RenderGraphHandle pass, uint32_t subpass, RenderGraphHandle image, VkAttachmentLoadOp loadOp,
+					VkClearValue clearValue = {});
+	void readInput(RenderGraphHandle pass, uint32_t subpass, RenderGraphHandle image);
+	void readSampled(RenderGraphHandle pass, RenderGraphHandle image);
+
+	void compile();
+	void resize(VkExtent2D extent);
+
+	// 이번 프레임에 기록하지 않을 pass (캐시한 shadow map 등), 그 pass 가 쓰는 image 는 이전 내용을 그대로 둔다.
+	void setPassEnabled(RenderGraphHandle pass, bool enabled);
+	// pass 를 framebuffer 의 왼쪽 위 area 만큼만 그린다. (dynamic resolution) {0, 0} 이면 framebuffer 전체
+	// image 를 다시 만들지 않으므로 매 프레임 바꿔도 된다. 영역 밖의 내용은 정의되지 않는다.
+	void setRenderArea(RenderGraphHandle pass, VkExtent2D area);
+	void execute(VkCommandBuffer commandBuffer, GpuProfiler *profiler);
+
+	VkRenderPass getRenderPass(RenderGraphHandle pass)
+	{
+		return m_passes[pass].renderPass;
+	}
+	VkFramebuffer getFramebuffer(RenderGraphHandle pass)
+	{
+		return m_passes[pass].framebuffer;
+	}
+	VkExtent2D getPassExtent(RenderGraphHandle pass)
+	{
+		return m_passes[pass].extent;
+	}
+	VkImage getImage(RenderGraphHandle image)
+	{
+		return m_images[image].image;
+	}
+	VkImageView getImageView(RenderGraphHandle image)
+	{
+		return m_images[image].imageView;
+	}
+	VkExtent2D getExtent()
+	{
+		return m_extent;
+	}
+	const RenderGraphStats &getStats()
+	{
+		return m_stats;
+	}
+
+  private:
+	struct ImageState
+	{
+		VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags stage = 0; // 마지막으로 접근한 stage
+		VkAccessFlags access = 0;		// 마지막 접근 중 쓰기
+	};
+
+	struct ImageResource
+	{
+		const char *name;
+		RenderGraphImageInfo info;
+		VkImageUsageFlags usage = 0;	  // info.usage + pass 선언에서 모은 usage
+		VkImageAspectFlags aspect = 0;	  // barrier 용 (depth stencil format 이면 stencil 포함)
+		VkImageAspectFlags viewAspect = 0; // image view 용
+		bool output = false;
+		VkImageLayout outputLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		// compile 결과: 살아있는 pass 중 이 image 를 처음 / 마지막으로 쓰는 pass 의 순서
+		uint32_t firstPass = UINT32_MAX;
+		uint32_t lastPass = 0;
+		bool transientAttachment = false; // 한 pass 안에서만 attachment 로 쓰인다.
+		uint32_t aliasGroup = UINT32_MAX;
+		RenderGraphHandle memoryOwner = UINT32_MAX; // shareMemory 로 묶은 image 들의 대표 (묶이지 않았으면 UINT32_MAX)
+
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView imageView = VK_NULL_HANDLE;
+		VkMemoryRequirements requirements{};
+		MemoryAllocation allocation; // alias group 에 속하지 않는 image 만 (shareMemory 묶음은 처음 image 만)
+		ImageState state;
+		uint32_t frame = UINT32_MAX; // 마지막으로 쓴 execute 번호 (프레임의 첫 사용 판단)
+	};
+
+	struct Attachment
+	{
+		RenderGraphHandle image;
+		RenderGraphAccess access;
+		VkAttachmentLoadOp loadOp;
+		VkClearValue clearValue;
+	};
+
+	struct Subpass
+	{
+		const char *name;
+		VkSubpassContents contents;
+		std::vector<Attachment> attachments;
+		RenderGraphRecordFunction record;
+	};
+
+	// pass 하나가 image 하나를 쓰는 방식 (compile 에서 subpass 선언을 모아 만든다)
+	struct ImageUsage
+	{
+		RenderGraphHandle image;
+		VkImageLayout firstLayout;
+		VkPipelineStageFlags firstStage;
+		VkAccessFlags firstAccess;
+		bool discard = false; // 이전 내용을 읽지 않는다. (CLEAR / DONT_CARE)
+		VkImageLayout lastLayout;
+		VkPipelineStageFlags stage = 0;
+		VkAccessFlags writeAccess = 0;
+		uint32_t attachmentIndex = UINT32_MAX; // sampled image 면 UINT32_MAX
+	};
+
+	struct Pass
+	{
+		const char *name;
+		std::vector<Subpass> subpasses;
+		std::vector<RenderGraphHandle> sampledImages;
+		bool culled = false;
+		bool enabled = true;
+
+		// render pass attachment 순서의 image 와 clear 값
+		std::vector<RenderGraphHandle> attachmentImages;
+		std::vector<VkClearValue> clearValues;
+		std::vector<ImageUsage> usages;
+		VkRenderPass renderPass = VK_NULL_HANDLE;
+		VkFramebuffer framebuffer = VK_NULL_HANDLE;
+		VkExtent2D extent{};
+		VkExtent2D renderArea{}; // {0, 0} 이면 extent 전체
+	};
+
+	// 구간이 겹치지 않는 image 들이 나눠 쓰는 메모리
+	struct AliasGroup
+	{
+		std::vector<RenderGraphHandle> images;
+		VkMemoryRequirements requirements{};
+		MemoryAllocation allocation;
+		ImageState state; // 이 메모리를 마지막으로 쓴 image 의 접근 (다음 image 의 첫 barrier 가 기다린다)
+	};
+
+	RenderGraph() = default;
+
+	void initRenderGraph(VkExtent2D extent);
+	void cullPasses();
+	void computeLifetimes();
+	void createRenderPass(Pass &pass, uint32_t passOrder);
+	void createResources();
+	void destroyResources(bool keepFixedSize);
+	void createImage(ImageResource &resource);
+	void allocateAliasGroups();
+	void allocateSharedMemory(const std::vector<RenderGraphHandle> &images);
+	void recordSharedLayouts(VkCommandBuffer commandBuffer);
+	void createFramebuffer(Pass &pass);
+	void recordBarriers(VkCommandBuffer commandBuffer, Pass &pass);
+	void recordOutputBarriers(VkCommandBuffer commandBuffer);
+	void finishPass(Pass &pass);
+
+	static void getAccessState(RenderGraphAccess access, VkImageLayout &layout, VkPipelineStageFlags &stage,
+							   VkAccessFlags &accessMask);
+	static bool isWrite(RenderGraphAccess access);
+
+	VkExtent2D m_extent{};
+	std::vector<ImageResource> m_images;
+	std::vector<Pass> m_passes;
+	std::vector<RenderGraphHandle> m_passOrder; // 살아있는 pass 의 실행 순서
+	std::vector<AliasGroup> m_aliasGroups;
+	std::vector<RenderGraphHandle> m_sharedLayoutImages; // 다음 execute 에서 처음 layout 을 잡을 shareMemory image
+	RenderGraphStats m_stats;
+	uint32_t m_frame = 0;
+	bool m_compiled = false;
+};
+
+} // namespace ale
+
+#endif
@@ -12,18 +12,10 @@ class RenderPass
 {
   public:
 	static std::unique_ptr<RenderPass> createRenderPass(VkFormat swapChainImageFormat);
-	static std::unique_ptr<RenderPass> createDeferredRenderPass();
 	static std::unique_ptr<RenderPass> createImGuiRenderPass(VkFormat swapChainImageFormat);
-	static std::unique_ptr<RenderPass> createShadowMapRenderPass();
-	static std::unique_ptr<RenderPass> createSphericalMapRenderPass();
-	static std::unique_ptr<RenderPass> createBackgroundRenderPass();
 
 	void initRenderPass(VkFormat swapChainImageFormat);
-	void initDeferredRenderPass();
 	void initImGuiRenderPass(VkFormat swapChainImageFormat);
-	void initShadowMapRenderPass();
-	void initSphericalMapRenderPass();
-	void initBackgroundRenderPass();
 
 	~RenderPass() = default;
 
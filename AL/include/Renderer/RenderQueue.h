@@ -0,0 +1,75 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+namespace ale
+{
+// 그릴 대상 하나 (정렬 key + 원본 record index)
+struct RenderPacket
+{
+	uint64_t key;
+	uint32_t index;
+};
+
+/*
+	visible draw 를 64bit key 로 정렬하는 render queue
+	- key 는 상위 bit 부터 pipeline | material | mesh | depth 순서이므로, 정렬 후 인접한 packet 끼리 상태를 공유한다.
+	- depth 를 제외한 상위 bit 가 같은 packet 은 하나의 instanced draw 로 묶이고, 그 안에서는 앞쪽부터 그린다.
+	- 정렬은 8bit 단위 LSD radix sort 이며, 모든 packet 의 값이 같은 byte 는 건너뛴다.
+*/
+class RenderQueue
+{
+  public:
+	static constexpr uint32_t DEPTH_BITS = 16;
+	static constexpr uint32_t MESH_BITS = 24;
+	static constexpr uint32_t MATERIAL_BITS = 22;
+	static constexpr uint32_t PIPELINE_BITS = 2;
+
+	// pipelineId: geometry pass pipeline variant (skinning / height map permutation)
+	// material / mesh id 가 bit 수를 넘으면 마지막 값으로 묶고 경고한다. 그런 key 는 서로 같아질 수 있으므로 batch 를
+	// 나눌 때는 key 만 보지 말고 material / mesh 도 비교해야 한다.
+	static uint64_t makeKey(uint32_t pipelineId, uint32_t materialId, uint32_t meshId, float depth, float maxDepth);
+
+	// depth 를 뺀 부분이 같으면 같은 batch
+	static uint64_t getBatchKey(uint64_t key)
+	{
+		return key >> DEPTH_BITS;
+	}
+
+	static uint32_t getPipelineId(uint64_t key)
+	{
+		return static_cast<uint32_t>(key >> (MATERIAL_BITS + MESH_BITS + DEPTH_BITS));
+	}
+
+	void clear()
+	{
+		m_packets.clear();
+	}
+
+	void push(uint64_t key, uint32_t index)
+	{
+		m_packets.push_back({key, index});
+	}
+
+	void sort();
+
+	const std::vector<RenderPacket> &getPackets() const
+	{
+		return m_packets;
+	}
+
+	uint32_t size() const
+	{
+		return static_cast<uint32_t>(m_packets.size());
+	}
+
+  private:
+	std::vector<RenderPacket> m_packets;
+	std::vector<RenderPacket> m_sortBuffer;
+};
+
+} // namespace ale
+
+#endif
@@ -5,25 +5,77 @@
 #include "Renderer/CommandBuffers.h"
 #include "Renderer/Common.h"
 #include "Renderer/DescriptorSetLayout.h"
+#include "Renderer/DynamicResolution.h"
 #include "Renderer/EditorCamera.h"
+#include "Renderer/EnvironmentMap.h"
 #include "Renderer/FrameBuffers.h"
+#include "Renderer/FramePacer.h"
+#include "Renderer/GpuProfiler.h"
+#include "Renderer/LightCluster.h"
+#include "Renderer/MaterialTable.h"
 #include "Renderer/Pipeline.h"
 #include "Renderer/RenderPass.h"
+#include "Renderer/RenderGraph.h"
+#include "Renderer/RenderQueue.h"
+#include "Renderer/SecondaryCommandBuffers.h"
 #include "Renderer/ShaderResourceManager.h"
 #include "Renderer/SwapChain.h"
 #include "Renderer/SyncObjects.h"
 #include "Renderer/VulkanContext.h"
 #include "Renderer/SAComponent.h"
 
+#include "Scene/OcclusionCuller.h"
 #include "Scene/Scene.h"
 #include "Scene/SceneCamera.h"
 
 namespace ale
 {
+class RenderingComponent;
+
+// camera frustum culling 을 어디서 할지
+// CPU: CullTree 로 보이는 entity 만 골라서 batch 를 만든다.
+// GPU: 모든 entity 로 batch 를 만들고, compute shader 가 instance 의 sphere 를 검사해서 indirect command 를 채운다.
+enum class ECullingMode
+{
+	CPU,
+	GPU
+};
+
+// geometry pass pipeline permutation (GeometryPass.vert 의 SKINNED / HEIGHT_MAP define)
+const uint32_t GEOMETRY_PASS_SKINNED = 1 << 0;
+const uint32_t GEOMETRY_PASS_HEIGHT_MAP = 1 << 1;
+const uint32_t GEOMETRY_PASS_VARIANT_COUNT = 4;
+
+// 같은 (Model, mesh, material) 로 그려지는 entity 묶음, instanced draw 1번으로 그린다.
+struct InstanceBatch
+{
+	RenderingComponent *renderingComponent; // mesh 를 빌려 쓸 대표 component
+	uint32_t meshIndex;
+	uint32_t firstInstance;
+	uint32_t instanceCount;
+	uint32_t variant;			// 그릴 geometry pass pipeline (GEOMETRY_PASS_* 조합, shadow pass 는 쓰지 않음)
+	uint32_t materialIndex = 0; // 이번 프레임 material table 의 index (shadow pass 는 쓰지 않음)
+};
+
+// light 하나의 이번 프레임 shadow pass
+struct ShadowPass
+{
+	bool cube = false;	 // point light 는 cube map, spot / directional light 는 2D shadow map 만 그린다.
+	bool render = false; // false 면 이전 프레임에 그린 shadow map 을 그대로 쓴다.
+	glm::mat4 proj;
+	glm::mat4 view[6];					   // 2D shadow map 은 view[0] 만 사용
+	std::vector<InstanceBatch> batches[6]; // view 마다 그 frustum 안에 있는 caster 만 mesh 별로 묶는다.
+	uint64_t signature = 0;				   // light 행렬 + caster 목록 / transform 의 hash
+	const Light *light = nullptr;
+	uint32_t commandOffset[6] = {}; // GPU culling 모드에서 view 별 batch 의 첫 indirect command index
+};
+
 class Renderer
 {
   public:
 	static std::unique_ptr<Renderer> createRenderer(GLFWwindow *window);
+	// window / swap chain / ImGui 없이 width x height 의 offscreen viewport 에만 그린다. (benchmark, CI)
+	static std::unique_ptr<Renderer> createHeadlessRenderer(uint32_t width, uint32_t height);
 	~Renderer() = default;
 	void cleanup();
 
@@ -36,7 +88,19 @@ class Renderer
 	void recreateSwapChain();
 	void recreateViewPort();
 
+	// 처음 한 번은 cubemap / IBL map 을 만들어 cache 하고, 이후에는 cache 를 읽어서 바꾼다.
 	void updateSkybox(std::string path);
+	EnvironmentMap *getEnvironmentMap()
+	{
+		return m_environmentMap.get();
+	}
+	// 마지막으로 그린 viewport image 를 PNG 로 저장한다. (GPU 작업이 모두 끝날 때까지 기다린다)
+	void captureViewPort(const std::string &path);
+
+	bool isHeadless()
+	{
+		return m_headless;
+	}
 
 	VkDevice getDevice()
 	{
@@ -62,6 +126,144 @@ class Renderer
 		return m_modelsMap;
 	}
 
+	// 마지막 프레임의 geometry pass draw 수와 instance 수
+	uint32_t getDrawCallCount()
+	{
+		return static_cast<uint32_t>(m_instanceBatches.size());
+	}
+	uint32_t getInstanceCount()
+	{
+		return m_visibleInstanceCount;
+	}
+	// 마지막 프레임에 업로드한 skinning 행렬 수
+	uint32_t getBoneMatrixCount()
+	{
+		return static_cast<uint32_t>(m_bonePalette.size());
+	}
+
+	// GPU culling 은 device 가 multiDrawIndirect / drawIndirectFirstInstance 를 지원할 때만 쓸 수 있다.
+	void setCullingMode(ECullingMode mode)
+	{
+		m_cullingMode = mode;
+	}
+	ECullingMode getCullingMode()
+	{
+		return m_cullingMode;
+	}
+	bool isGpuCullingSupported()
+	{
+		return VulkanContext::getContext().isMultiDrawIndirectSupported();
+	}
+	// GPU culling 모드에서 compute shader 가 통과시킨 instance 수 (frames in flight 만큼 전 프레임의 결과)
+	uint32_t getGpuVisibleInstanceCount()
+	{
+		return m_gpuVisibleInstanceCount;
+	}
+	// CPU culling 모드에서 frustum culling 뒤에 큰 occluder 에 가려진 entity 를 뺀다. (shadow caster 는 그대로)
+	OcclusionCuller &getOcclusionCuller()
+	{
+		return m_occlusionCuller;
+	}
+
+	float getRecordTimeMs()
+	{
+		return m_recordTimeMs;
+	}
+	// pass 별 GPU 시간 (timestamp 를 지원하지 않는 device 면 비어 있다)
+	GpuProfiler &getGpuProfiler()
+	{
+		return *m_gpuProfiler;
+	}
+	// render graph 의 pass 수와 attachment 메모리 (aliasing / lazily allocated 포함)
+	const RenderGraphStats &getRenderGraphStats()
+	{
+		return m_renderGraph->getStats();
+	}
+
+	// GPU 프레임 시간에 맞춰 G-buffer / lighting 을 그리는 내부 해상도를 조절한다. (결과는 viewport 크기로 upscale)
+	DynamicResolution &getDynamicResolution()
+	{
+		return m_dynamicResolution;
+	}
+	// 이번 프레임의 내부 해상도
+	VkExtent2D getRenderExtent()
+	{
+		return m_renderExtent;
+	}
+
+	// 동시에 GPU 에 넘길 프레임 수 (1 ~ MAX_FRAMES_IN_FLIGHT). 1 이면 매 프레임 GPU 를 기다려서 지연이 가장 짧고,
+	// 늘릴수록 CPU 와 GPU 가 겹쳐서 처리량이 늘어난다. 바꿀 때 device idle 을 기다린다.
+	void setFramesInFlight(uint32_t count);
+	uint32_t getFramesInFlight()
+	{
+		return m_framesInFlight;
+	}
+	// swap chain 을 다시 만든다. (headless 는 무시)
+	void setPresentMode(VkPresentModeKHR presentMode);
+	VkPresentModeKHR getPresentMode();
+	// 목표 프레임 시간과 입력 -> present 지연 시간
+	FramePacer &getFramePacer()
+	{
+		return m_framePacer;
+	}
+
+	// shaders 폴더의 source 가 바뀌면 그 shader 를 쓰는 pipeline 만 다시 만든다. (켜져 있으면 drawFrame 에서 확인)
+	void setShaderHotReload(bool enabled)
+	{
+		m_shaderHotReload = enabled;
+	}
+	bool isShaderHotReload()
+	{
+		return m_shaderHotReload;
+	}
+	// 바뀐 shader 를 다시 컴파일하고 다시 만든 pipeline 수를 돌려준다.
+	uint32_t reloadShaders();
+
+	// 이번 프레임의 shadow / geometry pass 에서 기록된 bind, draw 명령 수
+	uint32_t getBindCount()
+	{
+		return m_bindCount;
+	}
+
+	uint32_t getDrawCount()
+	{
+		return m_drawCount;
+	}
+
+	// 마지막 프레임에 새로 그린 / 캐시를 재사용한 shadow map 수와 shadow pass 의 caster instance 수
+	uint32_t getShadowRenderCount()
+	{
+		return m_shadowRenderCount;
+	}
+	uint32_t getShadowCachedCount()
+	{
+		return m_shadowCachedCount;
+	}
+	uint32_t getShadowCasterCount()
+	{
+		return m_shadowCasterCount;
+	}
+
+	// 마지막 프레임의 light 수와 cluster 에 배정된 light index 수
+	uint32_t getLightCount()
+	{
+		return static_cast<uint32_t>(m_lights.size());
+	}
+	uint32_t getLightIndexCount()
+	{
+		return static_cast<uint32_t>(m_lightCluster.getLightIndices().size());
+	}
+
+	// 마지막 프레임의 material table 크기와 전역 texture 배열에 올라간 texture 수
+	uint32_t getMaterialCount()
+	{
+		return static_cast<uint32_t>(m_visibleMaterials.size());
+	}
+	uint32_t getMaterialTextureCount()
+	{
+		return m_materialTable->getTextureCount();
+	}
+
   private:
 	Renderer() = default;
 
@@ -69,6 +271,7 @@ class Renderer
 
 	// Vulkan
 	GLFWwindow *window;
+	bool m_headless = false;
 	VkSurfaceKHR surface;
 	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
 	VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
@@ -84,8 +287,6 @@ class Renderer
 	VkFormat swapChainImageFormat;
 	VkExtent2D swapChainExtent;
 	std::vector<VkImageView> swapChainImageViews;
-	std::unique_ptr<FrameBuffers> m_viewPortFrameBuffers;
-	std::vector<VkFramebuffer> viewPortFramebuffers;
 
 	std::unique_ptr<FrameBuffers> m_ImGuiSwapChainFrameBuffers;
 	std::vector<VkFramebuffer> imGuiSwapChainFrameBuffers;
@@ -97,10 +298,29 @@ class Renderer
 	std::unique_ptr<RenderPass> m_ImGuiRenderPass;
 	VkRenderPass imGuiRenderPass;
 
-	std::unique_ptr<RenderPass> m_deferredRenderPass;
+	// viewport 에 그리는 pass 와 attachment (G-buffer, depth, background, shadow map, viewport image)
+	std::unique_ptr<RenderGraph> m_renderGraph;
+	RenderGraphHandle m_shadowMapPasses[4];
+	RenderGraphHandle m_shadowCubeMapPasses[4];
+	RenderGraphHandle m_backgroundPass;
+	RenderGraphHandle m_deferredPass;
+	RenderGraphHandle m_upscalePass;
+	RenderGraphHandle m_shadowMapImages[4];
+	RenderGraphHandle m_shadowCubeMapImages[4];
+	RenderGraphHandle m_backgroundImage;
+	RenderGraphHandle m_positionImage;
+	RenderGraphHandle m_normalImage;
+	RenderGraphHandle m_albedoImage;
+	RenderGraphHandle m_pbrImage;
+	RenderGraphHandle m_depthImage;
+	RenderGraphHandle m_sceneColorImage;
+	RenderGraphHandle m_viewPortImage;
 	VkRenderPass deferredRenderPass;
 
 	// DescriptorSetLayout
+	std::unique_ptr<DescriptorSetLayout> m_geometryPassFrameDescriptorSetLayout;
+	VkDescriptorSetLayout geometryPassFrameDescriptorSetLayout;
+
 	std::unique_ptr<DescriptorSetLayout> m_geometryPassDescriptorSetLayout;
 	VkDescriptorSetLayout geometryPassDescriptorSetLayout;
 
@@ -108,14 +328,19 @@ class Renderer
 	VkDescriptorSetLayout lightingPassDescriptorSetLayout;
 
 	// Pipeline
-	std::unique_ptr<Pipeline> m_geometryPassPipeline;
+	// GEOMETRY_PASS_* 조합을 index 로 쓰는 permutation, pipeline layout 은 모두 같은 정의라 호환된다.
+	std::array<std::unique_ptr<Pipeline>, GEOMETRY_PASS_VARIANT_COUNT> m_geometryPassPipelines;
 	VkPipelineLayout geometryPassPipelineLayout;
-	VkPipeline geometryPassGraphicsPipeline;
+	std::array<VkPipeline, GEOMETRY_PASS_VARIANT_COUNT> geometryPassGraphicsPipelines;
 
 	std::unique_ptr<Pipeline> m_lightingPassPipeline;
 	VkPipelineLayout lightingPassPipelineLayout;
 	VkPipeline lightingPassGraphicsPipeline;
 
+	std::unique_ptr<Pipeline> m_upscalePipeline;
+	VkPipelineLayout upscalePipelineLayout;
+	VkPipeline upscaleGraphicsPipeline;
+
 	// Descriptor Pool
 	VkDescriptorPool descriptorPool;
 
@@ -132,32 +357,28 @@ class Renderer
 	std::vector<VkSemaphore> renderFinishedSemaphores;
 	std::vector<VkFence> inFlightFences;
 	uint32_t currentFrame = 0;
+	uint32_t m_framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+	FramePacer m_framePacer;
 
 	// ShadowMap Info
-	std::vector<std::unique_ptr<RenderPass>> m_shadowMapRenderPass;
 	std::vector<VkRenderPass> shadowMapRenderPass;
 
 	std::vector<std::unique_ptr<Pipeline>> m_shadowMapPipeline;
 	std::vector<VkPipelineLayout> shadowMapPipelineLayout;
 	std::vector<VkPipeline> shadowMapGraphicsPipeline;
 
-	std::vector<std::unique_ptr<FrameBuffers>> m_shadowMapFrameBuffers;
-	std::vector<std::vector<VkFramebuffer>> shadowMapFramebuffers;
 	std::vector<VkImageView> shadowMapImageViews;
 
 	std::unique_ptr<DescriptorSetLayout> m_shadowMapDescriptorSetLayout;
 	VkDescriptorSetLayout shadowMapDescriptorSetLayout;
 	VkSampler shadowMapSampler;
 
-	std::vector<std::unique_ptr<RenderPass>> m_shadowCubeMapRenderPass;
 	std::vector<VkRenderPass> shadowCubeMapRenderPass;
 
 	std::vector<std::unique_ptr<Pipeline>> m_shadowCubeMapPipeline;
 	std::vector<VkPipelineLayout> shadowCubeMapPipelineLayout;
 	std::vector<VkPipeline> shadowCubeMapGraphicsPipeline;
 
-	std::vector<std::unique_ptr<FrameBuffers>> m_shadowCubeMapFrameBuffers;
-	std::vector<std::vector<VkFramebuffer>> shadowCubeMapFramebuffers;
 	std::vector<VkImageView> shadowCubeMapImageViews;
 
 	std::unique_ptr<DescriptorSetLayout> m_shadowCubeMapDescriptorSetLayout;
@@ -174,37 +395,26 @@ class Renderer
 	std::unique_ptr<ShaderResourceManager> m_viewPortShaderResourceManager;
 	std::vector<VkDescriptorSet> viewPortDescriptorSets;
 
+	// upscale pass 가 읽는 scene color (viewport descriptor set layout 을 같이 쓴다)
+	std::unique_ptr<ShaderResourceManager> m_upscaleShaderResourceManager;
+	std::vector<VkDescriptorSet> upscaleDescriptorSets;
+
+	// viewPortSize 는 ImGui 에 보이는 크기, m_renderExtent 는 그 안에 scale 을 곱한 내부 해상도
+	// render graph 의 image 는 둘보다 크게 잡아두고 왼쪽 위 영역만 그리므로 크기가 바뀌어도 다시 만들지 않는다.
 	glm::vec2 viewPortSize;
+	VkExtent2D m_renderExtent{};
+	DynamicResolution m_dynamicResolution;
 
 	glm::mat4 projMatrix;
 	glm::mat4 viewMatirx;
 
 	std::unordered_map<std::string, std::shared_ptr<Model>> m_modelsMap;
 
-	// skybox
-	std::shared_ptr<Texture> m_sphericalMapTexture;
-
-	std::unique_ptr<RenderPass> m_sphericalMapRenderPass;
-	VkRenderPass sphericalMapRenderPass;
-
-	std::unique_ptr<FrameBuffers> m_sphericalMapFrameBuffers;
-	std::vector<VkFramebuffer> sphericalMapFramebuffers;
-	VkImageView sphericalMapImageView;
-	VkSampler sphericalMapSampler;
-
-	std::unique_ptr<Pipeline> m_sphericalMapPipeline;
-	VkPipelineLayout sphericalMapPipelineLayout;
-	VkPipeline sphericalMapGraphicsPipeline;
-
-	std::unique_ptr<DescriptorSetLayout> m_sphericalMapDescriptorSetLayout;
-	VkDescriptorSetLayout sphericalMapDescriptorSetLayout;
-
-	std::unique_ptr<ShaderResourceManager> m_sphericalMapShaderResourceManager;
-	std::vector<VkDescriptorSet> sphericalMapDescriptorSets;
-	std::vector<std::shared_ptr<UniformBuffer>> sphericalMapUniformBuffers;
+	// skybox (background 가 specular cube 의 mip 0 을 그린다)
+	std::unique_ptr<EnvironmentMap> m_environmentMap;
+	std::string m_skyboxPath;
 
 	// background
-	std::unique_ptr<RenderPass> m_backgroundRenderPass;
 	VkRenderPass backgroundRenderPass;
 
 	std::unique_ptr<Pipeline> m_backgroundPipeline;
@@ -218,8 +428,6 @@ class Renderer
 	std::vector<VkDescriptorSet> backgroundDescriptorSets;
 	std::vector<std::shared_ptr<UniformBuffer>> backgroundUniformBuffers;
 
-	std::unique_ptr<FrameBuffers> m_backgroundFrameBuffers;
-	std::vector<VkFramebuffer> backgroundFramebuffers;
 	VkImageView backgroundImageView;
 	VkSampler backgroundSampler;
 
@@ -229,17 +437,134 @@ class Renderer
 
 	bool firstFrame = true;
 
-	void init(GLFWwindow *window);
+	// instancing
+	struct InstanceRecord
+	{
+		Model *model;
+		uint32_t meshIndex;
+		Material *material;
+		uint32_t variant; // geometry pass pipeline (GEOMETRY_PASS_* 조합)
+		uint32_t boneOffset;
+		float depth; // 카메라까지의 거리
+		RenderingComponent *renderingComponent;
+		entt::entity entity;
+		uint32_t cullIndex; // GPU culling 모드에서 m_cullSpheres 의 index
+	};
+	std::vector<std::unique_ptr<InstanceBuffer>> m_instanceBuffers;
+	std::vector<InstanceRecord> m_instanceRecords;
+	std::vector<InstanceData> m_instanceData;
+	std::vector<InstanceBatch> m_instanceBatches;
+	uint32_t m_visibleInstanceCount = 0; // m_instanceData 중 camera 에 보이는 instance 수 (뒤쪽은 shadow caster)
+
+	// render queue 의 sort key 에 넣을 이번 프레임의 material / mesh id
+	RenderQueue m_renderQueue;
+	std::unordered_map<Material *, uint32_t> m_materialIds;
+	std::unordered_map<Model *, uint32_t> m_modelMeshIds;
+
+	// material id 순서의 material 목록 -> 프레임별 material table (storage buffer) + 전역 texture 배열
+	std::vector<Material *> m_visibleMaterials;
+	std::unique_ptr<MaterialTable> m_materialTable;
+	std::vector<std::unique_ptr<StorageBuffer>> m_materialBuffers;
+
+	// GPU culling: camera 후보 instance 의 sphere 를 compute shader 가 검사해서 보이는 instance 만 culled instance buffer
+	// 에 batch 별로 모으고, indirect command 의 instanceCount 를 채운다. draw 는 MeshPool page 마다 indirect 호출 하나.
+	ECullingMode m_cullingMode = ECullingMode::CPU;
+	OcclusionCuller m_occlusionCuller;
+	bool m_gpuCulling = false; // 이번 프레임에 GPU culling 을 쓰는지 (mode + device 지원)
+	Frustum m_cullFrustum;
+	std::vector<CullSphere> m_cullSpheres;			 // scene->getVisibleEntities() 와 같은 순서
+	std::vector<GpuCullInstance> m_gpuCullInstances; // m_instanceData 의 camera instance 와 같은 순서
+	std::unique_ptr<DescriptorSetLayout> m_gpuCullingDescriptorSetLayout;
+	std::unique_ptr<Pipeline> m_gpuCullingPipeline;
+	std::unique_ptr<ShaderResourceManager> m_gpuCullingShaderResourceManager;
+	std::vector<std::unique_ptr<StorageBuffer>> m_gpuCullInstanceBuffers;
+	std::vector<std::unique_ptr<InstanceBuffer>> m_culledInstanceBuffers;
+	std::vector<std::unique_ptr<IndirectBuffer>> m_indirectBuffers;
+	bool m_gpuCullingSetDirty[MAX_FRAMES_IN_FLIGHT] = {};	 // buffer 를 다시 만들어서 디스크립터 셋을 다시 써야 함
+	uint32_t m_gpuCullBatchCount[MAX_FRAMES_IN_FLIGHT] = {}; // 그 프레임에 GPU culling 한 camera batch 수
+	uint32_t m_gpuVisibleInstanceCount = 0;
+
+	// skinning palette (skeleton 마다 실제 bone 개수만큼, 프레임마다 한 번)
+	std::vector<std::unique_ptr<StorageBuffer>> m_boneBuffers;
+	std::vector<glm::mat4> m_bonePalette;
+
+	// per-frame uniform (dynamic offset)
+	std::vector<std::unique_ptr<UniformRingBuffer>> m_uniformRingBuffers;
+	std::unique_ptr<ShaderResourceManager> m_geometryPassFrameShaderResourceManager;
+	std::unique_ptr<ShaderResourceManager> m_shadowMapFrameShaderResourceManager;
+	std::unique_ptr<ShaderResourceManager> m_shadowCubeMapFrameShaderResourceManager;
+	uint32_t m_layerIndexOffsets[6] = {};
+
+	// light 별 shadow caster culling, 움직인 caster 가 없는 light 는 shadow map 을 다시 그리지 않는다.
+	ShadowPass m_shadowPasses[4];
+	uint64_t m_shadowSignatures[4] = {}; // shadow map image 에 지금 들어있는 내용의 signature
+	bool m_shadowCacheValid[4] = {};
+	std::vector<entt::entity> m_shadowCasters[6];
+	std::vector<InstanceRecord> m_shadowRecords;
+	uint32_t m_shadowRenderCount = 0;
+	uint32_t m_shadowCachedCount = 0;
+	uint32_t m_shadowCasterCount = 0;
+
+	// clustered lighting: light 목록 / cluster / light index 는 프레임별 storage buffer
+	LightCluster m_lightCluster;
+	std::vector<Light> m_lights;
+	std::vector<Light> m_clusteredLights;
+	std::vector<std::unique_ptr<StorageBuffer>> m_lightBuffers;
+	std::vector<std::unique_ptr<StorageBuffer>> m_clusterBuffers;
+	std::vector<std::unique_ptr<StorageBuffer>> m_lightIndexBuffers;
+
+	// worker thread 별 secondary command buffer (shadow / geometry pass)
+	std::unique_ptr<SecondaryCommandBuffers> m_secondaryCommandBuffers;
+	std::vector<VkCommandBuffer> m_geometrySecondaryCommandBuffers;
+	VkCommandBuffer m_shadowMapSecondaryCommandBuffers[4] = {};
+	VkCommandBuffer m_shadowCubeMapSecondaryCommandBuffers[4] = {};
+	float m_recordTimeMs = 0.0f;
+	std::unique_ptr<GpuProfiler> m_gpuProfiler;
+
+	// shader hot reload (source 수정 시간은 SHADER_RELOAD_INTERVAL 마다 확인한다)
+	bool m_shaderHotReload = false;
+	std::chrono::steady_clock::time_point m_lastShaderCheck;
+
+	// secondary command buffer 별 bind / draw 횟수 (기록이 끝난 뒤 합산)
+	std::vector<DrawState> m_geometryDrawStates;
+	DrawState m_shadowMapDrawStates[4];
+	DrawState m_shadowCubeMapDrawStates[4];
+	uint32_t m_bindCount = 0;
+	uint32_t m_drawCount = 0;
 
-	void recordDeferredRenderPassCommandBuffer(Scene *scene, VkCommandBuffer commandBuffer, uint32_t imageIndex,
-											   uint32_t shadowMapIndex);
+	void init(GLFWwindow *window);
+	bool initGpuCulling();
+
+	void cullScene(Scene *scene, Camera &camera);
+
+	void buildInstanceBatches(Scene *scene);
+	void buildShadowPasses(Scene *scene, const std::vector<Light *> &shadowLights);
+	void buildShadowBatches(Scene *scene, const std::vector<entt::entity> &casters, std::vector<InstanceBatch> &batches);
+	void uploadInstanceData();
+	void uploadMaterialTable();
+	void uploadIndirectCommands();
+	void prepareLights(Scene *scene, uint32_t shadowMapCount);
+	void uploadLightingStorageBuffer(std::unique_ptr<StorageBuffer> &storageBuffer, uint32_t binding, const void *data,
+									 VkDeviceSize size);
+	void updateLightingPassStorageBufferDescriptorSets();
+	void prepareFrameUniforms();
+
+	void buildRenderGraph();
+	void updateRenderExtent();
+	glm::vec2 getViewPortUV(); // viewport image 중 viewport 크기만큼의 uv 범위
+	void createPipelines();
+	void updatePipelineHandles();
+	void recordLightingCommandBuffer(VkCommandBuffer commandBuffer);
 	void recordImGuiCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
-	void recordShadowMapCommandBuffer(Scene *scene, VkCommandBuffer commandBuffer, Light &lightInfo,
-									  uint32_t shadowMapIndex);
-	void recordShadowCubeMapCommandBuffer(Scene *scene, VkCommandBuffer commandBuffer, Light &lightInfo,
-										  uint32_t shadowMapIndex);
-	void recordSphericalMapCommandBuffer();
+	void recordGpuCulling(VkCommandBuffer commandBuffer);
+	void recordSecondaryCommandBuffers(const std::vector<Light *> &shadowLights);
+	void drawIndirectBatches(VkCommandBuffer commandBuffer, const std::vector<InstanceBatch> &batches, uint32_t begin,
+							 uint32_t end, uint32_t firstCommand, DrawState &state);
+	VkCommandBuffer recordGeometryPassDraws(uint32_t begin, uint32_t end, uint32_t cameraOffset, DrawState &state);
+	void recordShadowMapDraws(uint32_t shadowMapIndex);
+	void recordShadowCubeMapDraws(uint32_t shadowMapIndex);
 	void recordBackgroundCommandBuffer(VkCommandBuffer commandBuffer);
+	void recordUpscaleCommandBuffer(VkCommandBuffer commandBuffer);
 };
 } // namespace ale
 
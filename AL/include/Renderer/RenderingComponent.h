@@ -17,8 +17,7 @@ class RenderingComponent
 	~RenderingComponent() = default;
 
 	void draw(DrawInfo &drawInfo);
-	void drawShadow(ShadowMapDrawInfo &drawInfo, uint32_t index);
-	void drawShadowCubeMap(ShadowCubeMapDrawInfo &drawInfo, uint32_t index);
+	void drawShadow(ShadowMapDrawInfo &drawInfo);
 	void updateMaterial(std::vector<std::shared_ptr<Material>> materials);
 	void updateMaterial(std::shared_ptr<Model> model);
 	std::shared_ptr<Model> getModel() { return m_model; };
@@ -45,9 +44,6 @@ class RenderingComponent
   private:
 	RenderingComponent() = default;
 	std::shared_ptr<Model> m_model;
-	std::unique_ptr<ShaderResourceManager> m_shaderResourceManager;
-	std::vector<std::unique_ptr<ShaderResourceManager>> m_shadowMapResourceManager;
-	std::vector<std::unique_ptr<ShaderResourceManager>> m_shadowCubeMapResourceManager;
 	std::vector<std::shared_ptr<Material>> m_materials;
 	void initRenderingComponent(std::shared_ptr<Model> model);
 };
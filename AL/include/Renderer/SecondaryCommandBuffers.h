@@ -0,0 +1,52 @@
+#ifndef SECONDARYCOMMANDBUFFERS_H
+#define SECONDARYCOMMANDBUFFERS_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+#include "Renderer/VulkanContext.h"
+
+namespace ale
+{
+/*
+	JobSystem thread 마다, 프레임마다 command pool 을 하나씩 두고 secondary command buffer 를 빌려준다.
+	- command pool 은 외부 동기화가 필요하므로 thread 끼리 pool 을 공유하지 않는다.
+	- 프레임 시작 시(해당 프레임의 fence 대기 후) reset() 으로 pool 을 통째로 초기화하고 buffer 는 재사용한다.
+*/
+class SecondaryCommandBuffers
+{
+  public:
+	static std::unique_ptr<SecondaryCommandBuffers> createSecondaryCommandBuffers(uint32_t threadCount);
+
+	~SecondaryCommandBuffers() = default;
+
+	void cleanup();
+
+	void reset(uint32_t frame);
+	// 호출한 thread 의 pool 에서 buffer 를 꺼내 renderPass 의 subpass 를 이어서 기록하도록 begin 한다.
+	VkCommandBuffer begin(uint32_t frame, VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer);
+	void end(VkCommandBuffer commandBuffer);
+
+	uint32_t getThreadCount()
+	{
+		return m_threadCount;
+	}
+
+  private:
+	struct ThreadCommandPool
+	{
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		std::vector<VkCommandBuffer> commandBuffers;
+		uint32_t usedCount = 0;
+	};
+
+	uint32_t m_threadCount = 0;
+	// [frame * m_threadCount + threadIndex]
+	std::vector<ThreadCommandPool> m_threadCommandPools;
+
+	void initSecondaryCommandBuffers(uint32_t threadCount);
+	ThreadCommandPool &getThreadCommandPool(uint32_t frame);
+};
+
+} // namespace ale
+
+#endif
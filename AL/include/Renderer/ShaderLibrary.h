@@ -0,0 +1,88 @@
+#ifndef SHADERLIBRARY_H
+#define SHADERLIBRARY_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include <shaderc/shaderc.hpp>
+
+namespace ale
+{
+// permutation 을 만드는 define 목록 ("NAME" 또는 "NAME=VALUE")
+using ShaderDefines = std::vector<std::string>;
+
+struct ShaderLibraryStats
+{
+	uint32_t shaderCount = 0;	// 만들어진 shader module (source + define 조합) 수
+	uint32_t compileCount = 0;	// 실제로 GLSL 을 컴파일한 횟수
+	uint32_t cacheHitCount = 0; // 디스크 cache 의 SPIR-V 를 그대로 쓴 횟수
+	uint32_t reloadCount = 0;	// hot reload 로 다시 만든 shader module 수
+};
+
+/*
+	GLSL source 를 실행 중에 SPIR-V 로 컴파일하고 shader module 을 (source, define) 조합마다 하나씩 들고 있는 library
+	- source 를 include / define 까지 풀어서 (preprocess) hash 하고, 같은 hash 의 SPIR-V 가 cache 폴더에 있으면
+	  컴파일하지 않고 읽어온다. 주석만 바뀐 경우도 다시 컴파일하지 않는다.
+	- define 으로 permutation (skinning 유무, height map 유무 등) 을 만들어 안 쓰는 코드를 shader 에서 뺀다.
+	- hot reload: source 와 include 파일의 수정 시간을 비교해 바뀐 shader 만 다시 컴파일한다.
+	  어떤 pipeline 을 다시 만들지는 돌려받은 source 이름으로 호출한 쪽이 정한다.
+*/
+class ShaderLibrary
+{
+  public:
+	static ShaderLibrary &getShaderLibrary();
+
+	void init(VkDevice device, const std::filesystem::path &sourceDirectory = "./shaders",
+			  const std::filesystem::path &cacheDirectory = "./cache/shaders");
+	void cleanup();
+
+	// thread safe. fileName 은 source 폴더 기준 경로 (예: "GeometryPass.vert") 이고 확장자로 stage 를 정한다.
+	VkShaderModule getShaderModule(const std::string &fileName, const ShaderDefines &defines = {});
+
+	// source 나 include 파일이 바뀐 shader 를 다시 컴파일하고, module 이 바뀐 shader 의 fileName 을 돌려준다.
+	// 컴파일에 실패하면 error 만 남기고 이전 module 을 계속 쓴다. 돌려준 shader 를 쓰는 pipeline 은 다시 만들어야 한다.
+	std::set<std::string> reloadChangedShaders();
+
+	ShaderLibraryStats getStats();
+
+  private:
+	struct Shader
+	{
+		std::string fileName;
+		ShaderDefines defines;
+		VkShaderModule module = VK_NULL_HANDLE;
+		std::vector<std::filesystem::path> dependencies; // source + include 한 파일
+		std::filesystem::file_time_type lastWriteTime;	 // dependencies 중 가장 최근 수정 시간
+		std::once_flag compiled;
+	};
+
+	ShaderLibrary() = default;
+
+	bool compile(const std::string &fileName, const ShaderDefines &defines, std::vector<uint32_t> &code,
+				 std::vector<std::filesystem::path> &dependencies, std::string &error);
+	VkShaderModule createShaderModule(const std::vector<uint32_t> &code);
+	static std::string makeKey(const std::string &fileName, const ShaderDefines &defines);
+	static std::filesystem::file_time_type getLastWriteTime(const std::vector<std::filesystem::path> &dependencies);
+
+  private:
+	VkDevice m_device = VK_NULL_HANDLE;
+	std::filesystem::path m_sourceDirectory;
+	std::filesystem::path m_cacheDirectory;
+	shaderc::Compiler m_compiler; // 여러 thread 에서 동시에 써도 된다. (CompileOptions 는 호출마다 만든다)
+
+	std::mutex m_mutex;
+	std::unordered_map<std::string, std::unique_ptr<Shader>> m_shaders; // key: fileName + defines
+	std::atomic<uint32_t> m_compileCount{0};
+	std::atomic<uint32_t> m_cacheHitCount{0};
+	uint32_t m_reloadCount = 0;
+};
+
+} // namespace ale
+
+#endif
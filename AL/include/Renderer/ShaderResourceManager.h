@@ -12,18 +12,27 @@ namespace ale
 class ShaderResourceManager
 {
   public:
-	static std::unique_ptr<ShaderResourceManager> createGeometryPassShaderResourceManager(Model *model);
+	// 프레임별 texture 배열 디스크립터 셋 (빈 원소는 기본 texture 로 채운다)
+	static std::unique_ptr<ShaderResourceManager> createTextureArrayShaderResourceManager(
+		VkDescriptorSetLayout descriptorSetLayout, uint32_t textureCount, VkImageView defaultImageView,
+		VkSampler defaultSampler);
 	static std::unique_ptr<ShaderResourceManager> createLightingPassShaderResourceManager(
 		VkDescriptorSetLayout descriptorSetLayout, VkImageView positionImageView, VkImageView normalImageView,
 		VkImageView albedoImageView, VkImageView pbrImageView, std::vector<VkImageView> &shadowMapImageViews,
 		VkSampler shadowMapSamplers, std::vector<VkImageView> &shadowCubeMapImageViews, VkSampler shadowCubeMapSampler,
 		VkImageView backgroundImageView, VkSampler backgroundSampler);
-	static std::unique_ptr<ShaderResourceManager> createShadowMapShaderResourceManager();
-	static std::unique_ptr<ShaderResourceManager> createShadowCubeMapShaderResourceManager();
+	// 프레임별 buffer 를 가리키는 dynamic uniform buffer 디스크립터 셋 (binding i 의 크기 = ranges[i])
+	static std::unique_ptr<ShaderResourceManager> createDynamicUniformShaderResourceManager(
+		VkDescriptorSetLayout descriptorSetLayout, std::vector<VkBuffer> &buffers, std::vector<VkDeviceSize> &ranges);
+	// storage buffer 만 담는 프레임별 디스크립터 셋 (buffer 는 updateStorageBufferDescriptorSet 으로 설정)
+	static std::unique_ptr<ShaderResourceManager> createStorageBufferShaderResourceManager(
+		VkDescriptorSetLayout descriptorSetLayout);
 	static std::unique_ptr<ShaderResourceManager> createViewPortShaderResourceManager(
 		VkDescriptorSetLayout descriptorSetLayout, VkImageView viewPortImageView, VkSampler viewPortSampler);
-	static std::unique_ptr<ShaderResourceManager> createSphericalMapShaderResourceManager(
-		VkDescriptorSetLayout descriptorSetLayout, VkImageView sphericalMapImageView, VkSampler sphericalMapSampler);
+	// skybox 전처리 compute pass 마다 (입력 image, 출력 mip) 하나씩 디스크립터 셋을 만든다.
+	static std::unique_ptr<ShaderResourceManager> createEnvironmentMapShaderResourceManager(
+		VkDescriptorSetLayout descriptorSetLayout, std::vector<VkImageView> &sourceImageViews, VkSampler sourceSampler,
+		std::vector<VkImageView> &outputImageViews);
 	static std::unique_ptr<ShaderResourceManager> createBackgroundShaderResourceManager(
 		VkDescriptorSetLayout descriptorSetLayout, VkImageView skyboxImageView, VkSampler skyboxSampler);
 
@@ -41,8 +50,9 @@ class ShaderResourceManager
 	void initViewPortShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout, VkImageView viewPortImageView,
 										   VkSampler viewPortSampler);
 
-	void initSphericalMapShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
-											   VkImageView sphericalMapImageView, VkSampler sphericalMapSampler);
+	void initEnvironmentMapShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
+												 std::vector<VkImageView> &sourceImageViews, VkSampler sourceSampler,
+												 std::vector<VkImageView> &outputImageViews);
 	~ShaderResourceManager() = default;
 
 	void cleanup();
@@ -51,14 +61,6 @@ class ShaderResourceManager
 	{
 		return m_uniformBuffers;
 	}
-	std::vector<std::shared_ptr<UniformBuffer>> &getLayerIndexUniformBuffers()
-	{
-		return m_layerIndexUniformBuffers;
-	}
-	std::vector<std::shared_ptr<UniformBuffer>> &getVertexUniformBuffers()
-	{
-		return m_vertexUniformBuffers;
-	}
 	std::vector<std::shared_ptr<UniformBuffer>> &getFragmentUniformBuffers()
 	{
 		return m_fragmentUniformBuffers;
@@ -67,19 +69,19 @@ class ShaderResourceManager
 	{
 		return descriptorSets;
 	}
-	void updateDescriptorSets(Model *model, std::vector<std::shared_ptr<Material>> materials);
+	void updateDynamicUniformDescriptorSet(uint32_t frame, VkBuffer buffer);
+	void updateStorageBufferDescriptorSet(uint32_t frame, uint32_t binding, VkBuffer buffer);
+	void updateTextureArrayDescriptorSet(uint32_t frame, uint32_t element, VkImageView imageView, VkSampler sampler);
 
   private:
 	std::vector<std::shared_ptr<UniformBuffer>> m_uniformBuffers = {};
-	std::vector<std::shared_ptr<UniformBuffer>> m_layerIndexUniformBuffers = {};
-	std::vector<std::shared_ptr<UniformBuffer>> m_vertexUniformBuffers = {};
 	std::vector<std::shared_ptr<UniformBuffer>> m_fragmentUniformBuffers = {};
 
 	std::vector<VkDescriptorSet> descriptorSets = {};
+	std::vector<VkDeviceSize> m_dynamicUniformRanges = {};
 
-	void initGeometryPassShaderResourceManager(Model *model);
-	void createGeometryPassUniformBuffers(Model *model);
-	void createGeometryPassDescriptorSets(Model *model);
+	void initTextureArrayShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout, uint32_t textureCount,
+											   VkImageView defaultImageView, VkSampler defaultSampler);
 
 	void createLightingPassUniformBuffers();
 	void createLightingPassDescriptorSets(VkDescriptorSetLayout descriptorSetLayout, VkImageView positionImageView,
@@ -91,20 +93,17 @@ class ShaderResourceManager
 										  VkSampler shadowCubeMapSampler, VkImageView backgroundImageView,
 										  VkSampler backgroundSampler);
 
-	void initShadowMapShaderResourceManager();
-	void createShadowMapUniformBuffers();
-	void createShadowMapDescriptorSets();
+	void initDynamicUniformShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
+												 std::vector<VkBuffer> &buffers, std::vector<VkDeviceSize> &ranges);
 
-	void initShadowCubeMapShaderResourceManager();
-	void createShadowCubeMapUniformBuffers();
-	void createShadowCubeMapDescriptorSets();
+	void initStorageBufferShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout);
 
 	void createViewPortDescriptorSets(VkDescriptorSetLayout descriptorSetLayout, VkImageView viewPortImageView,
 									  VkSampler viewPortSampler);
 
-	void createSphericalMapUniformBuffers();
-	void createSphericalMapDescriptorSets(VkDescriptorSetLayout descriptorSetLayout, VkImageView sphericalMapImageView,
-										  VkSampler sphericalMapSampler);
+	void createEnvironmentMapDescriptorSets(VkDescriptorSetLayout descriptorSetLayout,
+											std::vector<VkImageView> &sourceImageViews, VkSampler sourceSampler,
+											std::vector<VkImageView> &outputImageViews);
 
 	void createBackgroundUniformBuffers();
 	void createBackgroundDescriptorSets(VkDescriptorSetLayout descriptorSetLayout, VkImageView skyboxImageView,
@@ -39,12 +39,30 @@ class SwapChain
 		return swapChainImageViews;
 	}
 
+	// 다음 recreateSwapChain 부터 쓸 present mode. surface 가 지원하지 않으면 FIFO 를 쓴다.
+	// FIFO: vsync, 처리량 위주 / MAILBOX: vsync + 최신 image 만 표시 / IMMEDIATE: tearing 을 허용하고 지연이 가장 짧다.
+	void setPreferredPresentMode(VkPresentModeKHR presentMode)
+	{
+		preferredPresentMode = presentMode;
+	}
+	VkPresentModeKHR getPreferredPresentMode()
+	{
+		return preferredPresentMode;
+	}
+	// 실제로 만든 swap chain 의 present mode
+	VkPresentModeKHR getPresentMode()
+	{
+		return presentMode;
+	}
+
   private:
 	VkSwapchainKHR swapChain;
 	std::vector<VkImage> swapChainImages;
 	VkFormat swapChainImageFormat;
 	VkExtent2D swapChainExtent;
 	std::vector<VkImageView> swapChainImageViews;
+	VkPresentModeKHR preferredPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+	VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
 
 	GLFWwindow *window;
 	VkDevice device;
@@ -18,7 +18,7 @@ class Texture : public Buffer
 	static std::shared_ptr<Texture> createTextureFromMemory(const aiTexture *aiTexture);
 	static VkSampler createShadowMapSampler();
 	static VkSampler createShadowCubeMapSampler();
-	static VkSampler createSphericalMapSampler();
+	static VkSampler createEnvironmentMapSampler();
 	static VkSampler createBackgroundSampler();
 	void initTexture(std::string path, bool flipVertically = false);
 
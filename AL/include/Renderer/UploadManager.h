@@ -0,0 +1,119 @@
+#ifndef UPLOADMANAGER_H
+#define UPLOADMANAGER_H
+
+#include "Core/Base.h"
+#include "Renderer/Common.h"
+#include "Renderer/MemoryAllocator.h"
+
+#include <deque>
+#include <mutex>
+
+namespace ale
+{
+/*
+	buffer / image 업로드를 batch 로 모아서 제출하는 manager
+	- 업로드 데이터는 계속 map 되어 있는 staging ring buffer 에 복사하고, 복사 명령만 현재 batch 에 기록한다.
+	- transfer 전용 queue family 가 있으면 복사는 그 queue 에서 하고, 소유권(queue family ownership)을 graphics queue
+	  로 넘긴다. mipmap 생성(blit)은 graphics queue 에서만 가능하므로 graphics 쪽 command buffer 에 기록한다.
+	- batch 는 flush() 에서 한 번에 제출되고 (매 프레임 렌더링 제출 직전), 완료는 fence 로 확인해 ring 공간을 돌려받는다.
+	- ring 이 가득 차면 가장 오래된 batch 만 기다린다. ring 절반보다 큰 업로드는 임시 staging buffer 를 쓴다.
+*/
+class UploadManager
+{
+  public:
+	static UploadManager &getUploadManager();
+
+	void init();
+	void cleanup();
+
+	// dstAccess / dstStage: 업로드가 끝난 뒤 이 buffer 를 읽는 곳
+	void uploadBuffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkAccessFlags dstAccess,
+					  VkPipelineStageFlags dstStage, VkDeviceSize dstOffset = 0);
+	// mip 0 을 채우고 나머지 mip 은 graphics queue 에서 blit 으로 만든다. 끝나면 SHADER_READ_ONLY_OPTIMAL 상태
+	void uploadImage(VkImage image, VkFormat format, const void *data, VkDeviceSize size, uint32_t width,
+					 uint32_t height, uint32_t mipLevels);
+	// 모든 mip 이 미리 만들어진 cube image (mip 마다 6 face 가 이어진 데이터). 끝나면 SHADER_READ_ONLY_OPTIMAL 상태
+	void uploadCubeImage(VkImage image, const void *data, VkDeviceSize size, uint32_t faceSize, uint32_t mipLevels,
+						 uint32_t texelSize);
+
+	// 지금까지 기록된 업로드를 제출한다. 이후 graphics queue 에 제출되는 작업은 업로드 결과를 볼 수 있다.
+	void flush();
+	// 제출된 업로드가 모두 끝날 때까지 대기
+	void waitIdle();
+
+	bool hasTransferQueue() const
+	{
+		return m_transferQueueFamily != m_graphicsQueueFamily;
+	}
+
+  private:
+	struct PendingMipmap
+	{
+		VkImage image;
+		int32_t width;
+		int32_t height;
+		uint32_t mipLevels;
+	};
+
+	struct UploadBatch
+	{
+		VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
+		VkCommandBuffer graphicsCommandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+		VkSemaphore transferSemaphore = VK_NULL_HANDLE; // transfer queue -> graphics queue
+
+		std::vector<VkBufferMemoryBarrier> releaseBufferBarriers;
+		std::vector<VkImageMemoryBarrier> releaseImageBarriers;
+		std::vector<VkBufferMemoryBarrier> acquireBufferBarriers;
+		std::vector<VkImageMemoryBarrier> acquireImageBarriers;
+		VkPipelineStageFlags acquireDstStage = 0;
+		std::vector<PendingMipmap> mipmaps;
+
+		// ring 을 넘는 업로드용 임시 staging buffer (batch 가 끝나면 해제)
+		std::vector<std::pair<VkBuffer, MemoryAllocation>> dedicatedStagingBuffers;
+		VkDeviceSize ringEnd = 0;
+	};
+
+	struct StagingRegion
+	{
+		VkBuffer buffer;
+		VkDeviceSize offset;
+		void *mappedData;
+	};
+
+	UploadManager() = default;
+
+	UploadBatch &getCurrentBatch();
+	StagingRegion allocateStaging(VkDeviceSize size);
+	void flushLocked();
+	void waitOldestBatch();
+	void collectCompletedBatches();
+	void recordMipmaps(VkCommandBuffer commandBuffer, const PendingMipmap &mipmap);
+	void createCommandPool(uint32_t queueFamily, VkCommandPool &commandPool);
+
+  private:
+	VkDevice m_device = VK_NULL_HANDLE;
+	VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+	VkQueue m_graphicsQueue = VK_NULL_HANDLE;
+	VkQueue m_transferQueue = VK_NULL_HANDLE;
+	uint32_t m_graphicsQueueFamily = 0;
+	uint32_t m_transferQueueFamily = 0;
+	VkCommandPool m_graphicsCommandPool = VK_NULL_HANDLE;
+	VkCommandPool m_transferCommandPool = VK_NULL_HANDLE;
+
+	// staging ring: head / tail 은 계속 증가하는 위치이고, 실제 offset 은 ringSize 로 나눈 나머지
+	VkBuffer m_ringBuffer = VK_NULL_HANDLE;
+	MemoryAllocation m_ringAllocation;
+	VkDeviceSize m_ringSize = 0;
+	VkDeviceSize m_ringHead = 0;
+	VkDeviceSize m_ringTail = 0;
+
+	std::unique_ptr<UploadBatch> m_currentBatch;
+	std::deque<std::unique_ptr<UploadBatch>> m_submittedBatches; // 제출 순서대로 끝난다.
+	std::vector<std::unique_ptr<UploadBatch>> m_freeBatches;
+	std::mutex m_mutex;
+};
+
+} // namespace ale
+
+#endif
@@ -41,6 +41,15 @@ class VulkanContext
 	{
 		return presentQueue;
 	}
+	// transfer 전용 queue 가 없으면 graphics queue 와 같다.
+	VkQueue getTransferQueue()
+	{
+		return transferQueue;
+	}
+	uint32_t getTransferQueueFamily()
+	{
+		return transferQueueFamily;
+	}
 	VkCommandPool getCommandPool()
 	{
 		return commandPool;
@@ -58,6 +67,14 @@ class VulkanContext
 		return descriptorPool;
 	}
 	uint32_t getQueueFamily();
+	bool isMultiDrawIndirectSupported()
+	{
+		return multiDrawIndirectSupported;
+	}
+	bool isHeadless()
+	{
+		return headless;
+	}
 
 	VkDescriptorSetLayout getGeometryPassDescriptorSetLayout()
 	{
@@ -94,13 +111,17 @@ class VulkanContext
 
 	VkInstance instance;
 	VkDebugUtilsMessengerEXT debugMessenger;
-	VkSurfaceKHR surface;
+	VkSurfaceKHR surface = VK_NULL_HANDLE;
 	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
 	VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
+	bool multiDrawIndirectSupported = false;
+	bool headless = false;
 	VkDevice device;
 	VkCommandPool commandPool;
 	VkQueue graphicsQueue;
 	VkQueue presentQueue;
+	VkQueue transferQueue;
+	uint32_t transferQueueFamily;
 	VkDescriptorPool descriptorPool;
 	VkDescriptorSetLayout geometryPassDescriptorSetLayout;
 	VkDescriptorSetLayout shadowMapDescriptorSetLayout;
@@ -118,6 +139,7 @@ class VulkanContext
 	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
 	VkSampleCountFlagBits getMaxUsableSampleCount();
 	bool checkDeviceExtensionSupport(VkPhysicalDevice device);
+	std::vector<const char *> getDeviceExtensions();
 	QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
 	void createDescriptorPool();
 
@@ -3,6 +3,7 @@
 
 #include "Core/Base.h"
 #include "Renderer/Common.h"
+#include "Renderer/MemoryAllocator.h"
 #include "Renderer/VulkanContext.h"
 #include <imgui/imgui.h>
 
@@ -14,6 +15,10 @@ class VulkanUtil
 	static void createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
 							VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
 							VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory);
+	// texture 처럼 수명이 긴 이미지는 MemoryAllocator 의 block 에서 메모리를 잘라 받는다.
+	static void createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
+							VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
+							VkMemoryPropertyFlags properties, VkImage &image, MemoryAllocation &imageAllocation);
 	static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 	static VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
 									   uint32_t mipLevels);
@@ -21,6 +26,8 @@ class VulkanUtil
 	static VkFormat findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling,
 										VkFormatFeatureFlags features);
 	static std::vector<char> readFile(const std::string &filename);
+	// FNV-1a 64bit (디스크 cache 의 key / 무결성 확인용), hash 를 이어서 계산하려면 이전 값을 seed 로 넘긴다.
+	static uint64_t hashData(const void *data, size_t size, uint64_t seed = 14695981039346656037ull);
 	static void insertImageMemoryBarrier(VkCommandBuffer cmdbuffer, VkImage image, VkAccessFlags srcAccessMask,
 										 VkAccessFlags dstAccessMask, VkImageLayout oldImageLayout,
 										 VkImageLayout newImageLayout, VkPipelineStageFlags srcStageMask,
@@ -38,6 +45,10 @@ class VulkanUtil
 								   VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling,
 								   VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
 								   VkDeviceMemory &imageMemory);
+	static void createCubeMapImage(uint32_t width, uint32_t height, uint32_t mipLevels,
+								   VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling,
+								   VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
+								   MemoryAllocation &imageAllocation);
 	static VkImageView createCubeMapImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
 											  uint32_t mipLevels);
 
@@ -47,6 +47,8 @@ struct TransformComponent
 	glm::vec3 m_LastPosition = {0.0f, 0.0f, 0.0f};
 
 	bool m_isMoved = false;
+	// local 값이 바뀌었음을 TransformSystem 에 알림 (자손까지 world transform 재계산)
+	bool m_isDirty = true;
 
 	glm::mat4 m_WorldTransform = glm::mat4(1.0f);
 
@@ -91,11 +93,15 @@ struct MeshRendererComponent
 	std::string path = "";
 	std::string matPath = "";
 	bool isMatChanged = false;
+	// occlusion culling 에서 bounding box 를 속이 찬 가림막으로 쓴다. (box primitive 는 항상 사용)
+	bool occluder = false;
 
 	// Culling
 	int32_t nodeId = NULL_NODE;
 	CullSphere cullSphere;
 	ECullState cullState;
+	// 마지막으로 frustum 안에 있었던 cull frame (이전 frame 과의 visible set 비교용)
+	uint32_t lastVisibleFrame = 0;
 
 	MeshRendererComponent() = default;
 	MeshRendererComponent(const MeshRendererComponent &) = default;
@@ -2,6 +2,7 @@
 
 #include "Core/Log.h"
 #include "Renderer/Common.h"
+#include "Scene/entt.hpp"
 
 namespace ale
 {
@@ -130,6 +131,65 @@ struct Frustum
 			return EFrustum::INSIDE;
 		}
 	}
+
+	// projection * view 행렬에서 plane 을 뽑는다. (Gribb-Hartmann, depth 0 ~ 1 기준)
+	// light 처럼 corner 점이 없는 frustum 용. normal 은 바깥쪽을 향한다.
+	void setFromViewProjection(const glm::mat4 &viewProjection)
+	{
+		glm::vec4 row[4];
+		for (int32_t i = 0; i < 4; ++i)
+		{
+			row[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+		}
+
+		// 안쪽이 양수인 plane 이므로 부호를 뒤집어 저장한다. (y 가 뒤집힌 projection 이면 up / down 만 바뀐다)
+		glm::vec4 planes[6] = {row[2], row[3] - row[2], row[3] + row[0], row[3] - row[0], row[3] - row[1], row[3] + row[1]};
+		for (int32_t i = 0; i < 6; ++i)
+		{
+			float length = glm::length(glm::vec3(planes[i]));
+			plane[i].normal = -glm::vec3(planes[i]) / length;
+			plane[i].distance = planes[i].w / length;
+		}
+	}
+};
+
+// SIMD 로 한 번에 plane 4개씩 검사하기 위해 SoA 로 펼친 frustum
+// 6 ~ 7 번 lane 은 항상 통과하도록 채워둔다.
+struct FrustumPlanesSoA
+{
+	alignas(16) float normalX[8];
+	alignas(16) float normalY[8];
+	alignas(16) float normalZ[8];
+	alignas(16) float distance[8];
+
+	FrustumPlanesSoA(const Frustum &frustum);
+};
+
+// frustum culling 전용으로 평탄화한 tree (DFS 전위 순회 순서, SoA)
+// subtree 는 [index, skipIndex[index]) 구간에 연속으로 놓이고, 그 subtree 의 leaf 들은
+// leafEntities 의 [leafBegin[index], leafBegin[skipIndex[index]]) 구간에 연속으로 놓인다.
+struct FlatCullTree
+{
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> radius;
+	std::vector<uint32_t> skipIndex;
+	std::vector<uint32_t> leafBegin;
+	std::vector<uint32_t> leafEntities;
+
+	void clear();
+	void reserve(size_t nodeCount);
+
+	uint32_t size() const
+	{
+		return static_cast<uint32_t>(centerX.size());
+	}
+
+	bool isLeaf(uint32_t index) const
+	{
+		return skipIndex[index] == index + 1;
+	}
 };
 
 struct CullTreeNode
@@ -160,12 +220,13 @@ class CullTree
 	CullTree();
 	~CullTree() = default;
 
-	void updateTree();
+	// movedEntities 에 있는 entity 의 node 만 다시 맞추고 목록을 비운다.
+	void updateTree(std::vector<entt::entity> &movedEntities);
 	void destroyNode(int32_t nodeId);
 	void setScene(Scene *scene);
-	void setRenderEnable(int32_t nodeId);
-	void setRenderDisable(int32_t nodeId);
-	void frustumCulling(const Frustum &frustum, int32_t nodeId);
+	void frustumCulling(const Frustum &frustum, std::vector<entt::entity> &visibleEntities);
+	// 검사 없이 모든 leaf 의 entity 와 sphere 를 flat tree 순서로 모은다. (GPU culling 의 입력)
+	void collectLeaves(std::vector<entt::entity> &entities, std::vector<CullSphere> &spheres);
 	void changeEntityHandle(int32_t nodeId, uint32_t entityHandle);
 	int32_t createNode(const CullSphere &sphere, uint32_t entityHandle);
 
@@ -181,11 +242,16 @@ class CullTree
 	void freeNode(int32_t nodeId);
 	void insertLeaf(int32_t leaf);
 	void detachNode(int32_t nodeId);
+	// tree 구조를 바꿨으면 (다시 삽입) true
 	bool moveNode(int32_t nodeId, const CullSphere &newSphere);
 	float getInsertionCost(const CullSphere &leafSphere, int32_t child, float inheritedCost);
 	float getInsertionCostForLeaf(const CullSphere &leafSphere, int32_t child, float inheritedCost);
 	int32_t balance(int32_t index);
 	int32_t allocateNode();
+	void buildFlatTree();
+	uint32_t flattenNode(int32_t nodeId);
+	void cullRange(const FrustumPlanesSoA &planes, uint32_t begin, uint32_t end,
+				   std::vector<uint32_t> &visibleEntities) const;
 
 	Scene *m_scene;
 	int32_t m_root;
@@ -193,6 +259,10 @@ class CullTree
 	int32_t m_nodeCount;
 	int32_t m_nodeCapacity;
 	std::vector<CullTreeNode> m_nodes;
+
+	FlatCullTree m_flatTree;
+	std::vector<uint32_t> m_flatIndex; // node id -> m_flatTree 의 index (buildFlatTree 에서 채운다)
+	bool m_flatTreeDirty = true;
 };
 
 } // namespace ale
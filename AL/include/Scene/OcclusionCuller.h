@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Scene/CullTree.h"
+
+namespace ale
+{
+class Scene;
+
+/*
+	CPU software occlusion culling
+	- frustum culling 을 통과한 entity 중 화면에 크게 보이는 occluder 의 bounding box 를 저해상도 depth buffer 에
+	  SIMD 로 rasterize 하고, depth pyramid 를 만들어서 나머지 entity 의 bounding box 가 완전히 가려지면 뺀다.
+	- occluder 는 box primitive 와 MeshRendererComponent::occluder 를 켠 entity 이다. box 를 속이 찬 가림막으로
+	  쓰므로 bounding box 를 거의 채우는 mesh (벽, 건물 등) 에만 켜야 한다.
+	- depth 는 1 / w 로 저장한다. (화면에서 선형으로 보간되고 멀리서도 정밀도가 남는다, 클수록 가깝다)
+	- triangle 준비, rasterize (가로 띠 단위), 가림 검사 모두 JobSystem worker 에 나눠서 처리한다.
+*/
+class OcclusionCuller
+{
+  public:
+	static constexpr uint32_t DEPTH_WIDTH = 320;
+	static constexpr uint32_t DEPTH_HEIGHT = 192;
+	static constexpr uint32_t MAX_OCCLUDERS = 128;
+
+	struct Stats
+	{
+		uint32_t occluderCount = 0;
+		uint32_t triangleCount = 0;
+		uint32_t testedCount = 0;
+		uint32_t culledCount = 0;
+		float rasterMs = 0.0f;
+		float testMs = 0.0f;
+	};
+
+	void setEnabled(bool enabled)
+	{
+		m_enabled = enabled;
+	}
+	bool isEnabled()
+	{
+		return m_enabled;
+	}
+
+	// 이번 프레임의 camera (frustum 을 만든 것과 같은 projection * view)
+	void setCamera(const glm::mat4 &viewProjection, const glm::vec3 &cameraPos)
+	{
+		m_viewProjection = viewProjection;
+		m_cameraPos = cameraPos;
+	}
+
+	// visibleEntities 에서 가려진 entity 를 순서를 유지한 채로 뺀다.
+	void cull(Scene &scene, std::vector<entt::entity> &visibleEntities);
+
+	const Stats &getStats()
+	{
+		return m_stats;
+	}
+
+  private:
+	struct Occluder
+	{
+		uint32_t visibleIndex; // cull 에 넘긴 visibleEntities 의 index
+		glm::mat4 transform;
+		glm::vec3 minPos;
+		glm::vec3 maxPos;
+		float priority;
+	};
+
+	// screen 좌표 (pixel) 와 1 / w
+	struct ScreenTriangle
+	{
+		float x[3];
+		float y[3];
+		float z[3];
+		int32_t minY;
+		int32_t maxY;
+	};
+
+	void selectOccluders(Scene &scene, const std::vector<entt::entity> &visibleEntities);
+	void setupTriangles();
+	void rasterize();
+	void buildDepthPyramid();
+	bool isOccluded(const glm::mat4 &transform, const CullSphere &sphere) const;
+
+	void clipAndEmitTriangle(const glm::vec4 *clip, std::vector<ScreenTriangle> &triangles) const;
+	void emitTriangle(const glm::vec4 &v0, const glm::vec4 &v1, const glm::vec4 &v2,
+					  std::vector<ScreenTriangle> &triangles) const;
+	void rasterizeTriangle(const ScreenTriangle &triangle, int32_t bandBegin, int32_t bandEnd);
+
+  private:
+	bool m_enabled = true;
+	glm::mat4 m_viewProjection = glm::mat4(1.0f);
+	glm::vec3 m_cameraPos = glm::vec3(0.0f);
+
+	std::vector<Occluder> m_occluders;
+	std::vector<std::vector<ScreenTriangle>> m_occluderTriangles;
+	std::vector<ScreenTriangle> m_triangles;
+
+	// m_depthLevels[0] 이 rasterize 한 depth buffer, 그 위는 2x2 중 가장 먼 값 (가장 작은 1 / w)
+	std::vector<std::vector<float>> m_depthLevels;
+	std::vector<glm::uvec2> m_levelSizes;
+
+	std::vector<uint8_t> m_occludedFlags;
+	Stats m_stats;
+};
+
+} // namespace ale
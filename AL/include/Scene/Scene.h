@@ -9,6 +9,9 @@
 #include "Renderer/EditorCamera.h"
 #include "Renderer/Material.h"
 
+#include "Scene/SystemGraph.h"
+#include "Scene/TransformSystem.h"
+
 #include <queue>
 
 namespace ale
@@ -17,6 +20,8 @@ class Entity;
 class Model;
 class CullTree;
 class World;
+class Camera;
+class OcclusionCuller;
 
 struct Frustum;
 
@@ -61,6 +66,16 @@ class Scene
 		return m_IsRunning;
 	}
 
+	const SystemGraph &getRuntimeSystems() const
+	{
+		return m_RuntimeSystems;
+	}
+
+	TransformSystem &getTransformSystem()
+	{
+		return m_TransformSystem;
+	}
+
 	glm::vec3 &getLightPos()
 	{
 		return m_lightPos;
@@ -123,15 +138,34 @@ class Scene
 		return m_Registry.try_get<Component>(entity);
 	}
 
-	// frustumCulling
-	void frustumCulling(const Frustum &frustum);
-	void initFrustumDrawFlag();
+	// frustumCulling, occlusionCuller 가 있으면 frustum 을 통과한 entity 중 가려진 것을 뺀다.
+	void frustumCulling(const Frustum &frustum, OcclusionCuller *occlusionCuller = nullptr);
+	// GPU culling 모드: tree 만 갱신하고 모든 entity 를 visible 로 둔다. spheres[i] 는 getVisibleEntities()[i] 의 sphere
+	void collectCullCandidates(std::vector<CullSphere> &spheres);
+	// light frustum 안의 entity 목록 (visible set 은 건드리지 않음). frustumCulling 이후에 호출해야 한다.
+	void shadowCasterCulling(const Frustum &frustum, std::vector<entt::entity> &casters);
 	void removeEntityInCullTree(Entity &entity);
 	void insertEntityInCullTree(Entity &entity);
 	void setNoneInCullTree(Entity &entity);
 	void unsetNoneInCullTree(Entity &entity);
 	void printCullTree();
 
+	// 마지막 frustumCulling 결과 (화면에 보이는 MeshRenderer entity 목록)
+	const std::vector<entt::entity> &getVisibleEntities() const
+	{
+		return m_VisibleEntities;
+	}
+
+	// 이전 frustumCulling 결과와 비교해서 새로 보이게 된 / 보이지 않게 된 entity 목록
+	const std::vector<entt::entity> &getEnteredEntities() const
+	{
+		return m_EnteredEntities;
+	}
+	const std::vector<entt::entity> &getExitedEntities() const
+	{
+		return m_ExitedEntities;
+	}
+
   private:
 	template <typename T> void onComponentAdded(Entity entity, T &component);
 
@@ -140,6 +174,12 @@ class Scene
 	void onPhysicsStart();
 	void onPhysicsStop();
 	void findMoveObject();
+	void updateVisibleSet();
+	void initRuntimeSystems();
+	void updateScripts(Timestep ts);
+	void updatePhysics(Timestep ts);
+	void updateAnimations(Timestep ts, bool isRuntime);
+	Camera *findMainCamera();
 
 	void setCamPos(glm::vec3 &pos)
 	{
@@ -173,10 +213,23 @@ class Scene
 	float m_ambientStrength{0.1f};
 
 	CullTree m_cullTree;
+	std::vector<entt::entity> m_VisibleEntities;
+	std::vector<entt::entity> m_PrevVisibleEntities;
+	std::vector<entt::entity> m_EnteredEntities;
+	std::vector<entt::entity> m_ExitedEntities;
+	// cull tree 를 다시 맞춰야 하는 entity (TransformComponent::m_isMoved 로 중복 방지)
+	std::vector<entt::entity> m_MovedEntities;
+	uint32_t m_CullFrame = 0;
+
+	TransformSystem m_TransformSystem;
+	SystemGraph m_RuntimeSystems;
+	Timestep m_RuntimeTimestep;
+	Camera *m_MainCamera = nullptr;
 
 	friend class Entity;
 	friend class SceneSerializer;
 	friend class SceneHierarchyPanel;
 	friend class CullTree;
+	friend class TransformSystem;
 };
 } // namespace ale
@@ -0,0 +1,106 @@
+#ifndef SYSTEMGRAPH_H
+#define SYSTEMGRAPH_H
+
+#include "Core/Base.h"
+#include "Scene/entt.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ale
+{
+class JobCounter;
+
+using SystemFunction = std::function<void()>;
+
+// graph 에 등록되는 system 하나
+// read / write 로 접근하는 component 타입을 선언하면 compile() 에서 의존 관계가 만들어진다.
+struct SystemNode
+{
+	std::string m_Name;
+	SystemFunction m_Function;
+	std::vector<entt::id_type> m_Reads;
+	std::vector<entt::id_type> m_Writes;
+	// Mono 호출 / Vulkan 명령처럼 main thread 에서만 실행해야 하는 system
+	bool m_MainThread = false;
+
+	template <typename... Components> SystemNode &read()
+	{
+		(m_Reads.push_back(entt::type_hash<Components>::value()), ...);
+		return *this;
+	}
+
+	template <typename... Components> SystemNode &write()
+	{
+		(m_Writes.push_back(entt::type_hash<Components>::value()), ...);
+		return *this;
+	}
+
+	SystemNode &mainThread()
+	{
+		m_MainThread = true;
+		return *this;
+	}
+};
+
+struct SystemTiming
+{
+	std::string m_Name;
+	float m_StartMs = 0.0f;
+	float m_DurationMs = 0.0f;
+	uint32_t m_ThreadIndex = 0;
+};
+
+/*
+	프레임 단위 system 실행 graph
+	- 등록 순서가 곧 논리적인 실행 순서이며, component 접근이 충돌(write-write, read-write)하는 system 끼리만
+	  앞선 system 이 끝난 뒤 실행된다.
+	- 충돌하지 않는 system 은 JobSystem worker 에서 동시에 실행된다.
+*/
+class SystemGraph
+{
+  public:
+	SystemNode &addSystem(const std::string &name, SystemFunction function);
+	void compile();
+	void execute();
+	void clear();
+
+	bool empty() const
+	{
+		return m_Nodes.empty();
+	}
+
+	const std::vector<SystemTiming> &getTimings() const
+	{
+		return m_Timings;
+	}
+
+	float getTotalMs() const
+	{
+		return m_TotalMs;
+	}
+
+  private:
+	void runNode(uint32_t index);
+	void scheduleNode(uint32_t index);
+	bool hasConflict(const SystemNode &before, const SystemNode &after) const;
+
+  private:
+	std::vector<SystemNode> m_Nodes;
+	std::vector<std::vector<uint32_t>> m_Dependents;
+	std::vector<uint32_t> m_DependencyCounts;
+	std::vector<std::atomic<uint32_t>> m_PendingCounts;
+	std::vector<SystemTiming> m_Timings;
+	std::chrono::steady_clock::time_point m_FrameStart;
+	float m_TotalMs = 0.0f;
+	bool m_Compiled = false;
+
+	JobCounter *m_Counter = nullptr;
+};
+
+} // namespace ale
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef TRANSFORMSYSTEM_H
+#define TRANSFORMSYSTEM_H
+
+#include "Core/Base.h"
+#include "Scene/entt.hpp"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace ale
+{
+class Scene;
+struct TransformComponent;
+
+/*
+	RelationshipComponent 계층을 따라 TransformComponent::m_WorldTransform 을 계산한다.
+	- 계층 구조가 바뀔 때만 root subtree 별로 깊이 순서(BFS)의 평탄화된 순서를 다시 만든다.
+	- m_isDirty 인 entity 와 그 자손만 다시 계산하며, 서로 독립인 root subtree 는 병렬로 처리한다.
+	- 다시 계산된 entity 목록은 cull tree 갱신 같은 후속 처리에서 전체 순회 대신 사용한다.
+*/
+class TransformSystem
+{
+  public:
+	void setScene(Scene *scene);
+	void update();
+
+	void invalidateHierarchy()
+	{
+		m_HierarchyChanged = true;
+	}
+
+	uint32_t getUpdatedCount() const
+	{
+		return static_cast<uint32_t>(m_ChangedEntities.size());
+	}
+
+	// 마지막 update() 에서 world transform 이 다시 계산된 entity 목록
+	const std::vector<entt::entity> &getChangedEntities() const
+	{
+		return m_ChangedEntities;
+	}
+
+	// world 기준 transform 을 부모 기준 local 값(position, rotation, scale)으로 바꿔서 적용
+	static void setWorldTransform(TransformComponent &transform, const glm::mat4 &parentWorld,
+								  const glm::mat4 &world);
+
+  private:
+	void rebuildOrder();
+	void onRelationshipChanged(entt::registry &registry, entt::entity entity);
+
+  private:
+	Scene *m_Scene = nullptr;
+
+	// root subtree 별로 BFS 순서로 나열된 entity (부모가 항상 자식보다 앞에 온다)
+	std::vector<entt::entity> m_Order;
+	// m_Order 기준 부모의 index, root 이면 -1
+	std::vector<int32_t> m_ParentIndex;
+	// root subtree 의 시작 index, 마지막 원소는 m_Order.size()
+	std::vector<uint32_t> m_SubtreeOffsets;
+	std::vector<uint8_t> m_Changed;
+
+	bool m_HierarchyChanged = true;
+	bool m_ForceUpdate = true;
+	std::vector<entt::entity> m_ChangedEntities;
+};
+
+} // namespace ale
+
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace ale
@@ -10,4 +11,13 @@ class FileDialogs
 	static std::string openFile(const char *filter);
 	static std::string saveFile(const char *filter);
 };
+
+// OS timer 해상도 (Windows 기본값은 약 15.6ms 라서 1ms sleep 도 그만큼 길어진다)
+class TimerResolution
+{
+  public:
+	// request 와 release 는 같은 값으로 짝을 맞춰 호출한다.
+	static void request(uint32_t milliseconds);
+	static void release(uint32_t milliseconds);
+};
 } // namespace ale
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "Core/App.h"
-#include "ALpch.h"
+#include "alpch.h"
 #include <GLFW/glfw3.h>
 
+#include "Core/JobSystem.h"
 #include "Scripting/ScriptingEngine.h"
 
 namespace ale
@@ -15,22 +16,42 @@ App::App(const ApplicationSpecification &spec) : m_Spec(spec)
 	AL_CORE_INFO("App::App");
 	s_Instance = this;
 
-	m_Window = std::unique_ptr<Window>(Window::create());
-	m_Window->setEventCallback(AL_BIND_EVENT_FN(App::onEvent));
+	if (!m_Spec.m_Headless)
+	{
+		m_Window = std::unique_ptr<Window>(Window::create());
+		m_Window->setEventCallback(AL_BIND_EVENT_FN(App::onEvent));
+	}
 
 	if (!m_Spec.m_WorkingDirectory.empty())
 	{
 		std::filesystem::current_path(m_Spec.m_WorkingDirectory);
 	}
 
+	// init job system
+	JobSystem::init();
+
 	// init renderer
-	m_Renderer = Renderer::createRenderer(m_Window->getNativeWindow());
-	// m_Scene = Scene::createScene();
-	// m_Renderer->loadScene(m_Scene.get());
+	if (m_Spec.m_Headless)
+	{
+		m_Renderer = Renderer::createHeadlessRenderer(m_Spec.m_HeadlessWidth, m_Spec.m_HeadlessHeight);
+	}
+	else
+	{
+		m_Renderer = Renderer::createRenderer(m_Window->getNativeWindow());
+		// m_Scene = Scene::createScene();
+		// m_Renderer->loadScene(m_Scene.get());
+
+		// ImGuiLayer created
+		m_ImGuiLayer = new ImGuiLayer();
+		pushOverlay(m_ImGuiLayer);
+	}
 
-	// ImGuiLayer created
-	m_ImGuiLayer = new ImGuiLayer();
-	pushOverlay(m_ImGuiLayer);
+	m_Renderer->setFramesInFlight(m_Spec.m_FramesInFlight);
+	m_Renderer->setPresentMode(m_Spec.m_PresentMode);
+	if (!m_Spec.m_Headless)
+	{
+		m_Renderer->getFramePacer().setTargetFrameMs(m_Spec.m_TargetFrameMs);
+	}
 }
 
 App::~App()
@@ -38,6 +59,7 @@ App::~App()
 	ScriptingEngine::shutDown();
 	m_LayerStack.onDetach();
 	m_Renderer->cleanup();
+	JobSystem::shutDown();
 }
 
 void App::pushLayer(Layer *layer)
@@ -63,6 +85,21 @@ void App::run()
 		m_LastFrameTime = time;
 		// AL_CORE_TRACE("Delta time: {0}s ({1}ms))", ts.getSeconds(), ts.getMiliSeconds());
 
+		// main thread 전용 job (Mono 호출 등) 처리
+		JobSystem::processMainThreadJobs();
+
+		// headless 는 ImGui context / window 가 없으므로 onUpdate 만 호출한다.
+		if (m_Spec.m_Headless)
+		{
+			// 입력은 없지만 프레임 시작을 기준으로 submit 까지의 시간을 잰다.
+			m_Renderer->getFramePacer().markInputSampled();
+			for (Layer *layer : m_LayerStack)
+			{
+				layer->onUpdate(ts);
+			}
+			continue;
+		}
+
 		// layer stack update
 		m_ImGuiLayer->beginFrame();
 
@@ -76,7 +113,11 @@ void App::run()
 		{
 			layer->onUpdate(ts);
 		}
+
+		// 목표 프레임 시간까지 기다린 뒤에 입력을 읽는다. (기다린 시간이 입력 지연에 더해지지 않는다)
+		m_Renderer->getFramePacer().waitForNextFrame();
 		m_Window->onUpdate();
+		m_Renderer->getFramePacer().markInputSampled();
 	}
 	vkDeviceWaitIdle(m_Renderer->getDevice());
 }
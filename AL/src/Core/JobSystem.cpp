@@ -0,0 +1,410 @@
+#include "Core/JobSystem.h"
+#include "alpch.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace ale
+{
+static constexpr uint32_t INVALID_THREAD_INDEX = std::numeric_limits<uint32_t>::max();
+
+// worker 하나가 소유하는 작업 큐
+// 소유자는 뒤에서 꺼내고(LIFO, 캐시 친화적), 다른 worker 는 앞에서 훔쳐간다(FIFO, 큰 작업 우선).
+struct WorkQueue
+{
+	std::mutex m_Mutex;
+	std::deque<Job> m_Jobs;
+
+	void push(Job &&job)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Jobs.push_back(std::move(job));
+	}
+
+	bool pop(Job &job)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_Jobs.empty())
+			return false;
+		job = std::move(m_Jobs.back());
+		m_Jobs.pop_back();
+		return true;
+	}
+
+	bool steal(Job &job)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_Jobs.empty())
+			return false;
+		job = std::move(m_Jobs.front());
+		m_Jobs.pop_front();
+		return true;
+	}
+};
+
+struct JobSystemData
+{
+	// 0번 큐는 main thread, 1 ~ N 번 큐는 worker thread 가 소유
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+
+	// main thread 에서만 실행되어야 하는 job (Mono, Vulkan submit 등)
+	std::mutex mainThreadMutex;
+	std::vector<Job> mainThreadJobs;
+
+	std::mutex sleepMutex;
+	std::condition_variable wakeCondition;
+	std::atomic<uint32_t> pendingJobs{0};
+	std::atomic<bool> running{false};
+
+	std::thread::id mainThreadId;
+};
+
+static JobSystemData *s_Data = nullptr;
+static thread_local uint32_t s_ThreadIndex = INVALID_THREAD_INDEX;
+
+void JobSystem::init(uint32_t workerCount)
+{
+	if (s_Data)
+		return;
+
+	if (workerCount == 0)
+	{
+		uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	s_Data = new JobSystemData();
+	s_Data->mainThreadId = std::this_thread::get_id();
+	s_Data->running = true;
+	s_ThreadIndex = 0;
+
+	for (uint32_t i = 0; i < workerCount + 1; i++)
+	{
+		s_Data->queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	for (uint32_t i = 1; i <= workerCount; i++)
+	{
+		s_Data->workers.emplace_back(&JobSystem::workerLoop, i);
+	}
+
+	AL_CORE_INFO("JobSystem::init: {0} worker threads", workerCount);
+}
+
+void JobSystem::shutDown()
+{
+	if (!s_Data)
+		return;
+
+	{
+		std::lock_guard lock(s_Data->sleepMutex);
+		s_Data->running = false;
+	}
+	s_Data->wakeCondition.notify_all();
+
+	for (auto &worker : s_Data->workers)
+	{
+		worker.join();
+	}
+
+	// 남아있는 job 은 main thread 에서 마저 처리
+	while (tryRunJob(0))
+		;
+	processMainThreadJobs();
+
+	delete s_Data;
+	s_Data = nullptr;
+	s_ThreadIndex = INVALID_THREAD_INDEX;
+}
+
+void JobSystem::execute(JobFunction job, JobCounter *counter)
+{
+	if (!s_Data)
+	{
+		// job system 초기화 전에는 호출한 thread 에서 바로 실행
+		job();
+		return;
+	}
+
+	if (counter)
+		counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+	schedule(Job{std::move(job), counter, false});
+}
+
+void JobSystem::executeAfter(JobCounter &dependency, JobFunction job, JobCounter *counter)
+{
+	if (!s_Data)
+	{
+		job();
+		return;
+	}
+
+	if (counter)
+		counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+	Job continuation{std::move(job), counter, false};
+	{
+		std::lock_guard lock(dependency.m_Mutex);
+		if (dependency.m_Count.load(std::memory_order_acquire) != 0)
+		{
+			dependency.m_Continuations.push_back(std::move(continuation));
+			return;
+		}
+	}
+	schedule(std::move(continuation));
+}
+
+void JobSystem::executeOnMainThread(JobFunction job, JobCounter *counter)
+{
+	if (!s_Data)
+	{
+		job();
+		return;
+	}
+
+	if (counter)
+		counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+	schedule(Job{std::move(job), counter, true});
+}
+
+void JobSystem::parallelFor(uint32_t count, uint32_t grainSize, const ParallelForFunction &job)
+{
+	if (count == 0)
+		return;
+
+	if (grainSize == 0)
+		grainSize = 1;
+
+	uint32_t jobCount = (count + grainSize - 1) / grainSize;
+	if (!s_Data || jobCount == 1)
+	{
+		job(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	// 마지막 구간은 호출한 thread 가 직접 처리
+	for (uint32_t i = 0; i < jobCount - 1; i++)
+	{
+		uint32_t begin = i * grainSize;
+		uint32_t end = std::min(begin + grainSize, count);
+		execute([&job, begin, end]() { job(begin, end); }, &counter);
+	}
+	job((jobCount - 1) * grainSize, count);
+
+	wait(counter);
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+	if (s_Data)
+	{
+		bool mainThread = isMainThread();
+		while (!counter.isDone())
+		{
+			if (mainThread)
+				processMainThreadJobs();
+
+			if (!tryRunJob(s_ThreadIndex))
+				std::this_thread::yield();
+		}
+	}
+
+	// 마지막 job 이 counter 의 mutex 를 놓을 때까지 기다린 후 반환해야 counter 를 안전하게 해제할 수 있다.
+	std::lock_guard lock(counter.m_Mutex);
+}
+
+void JobSystem::processMainThreadJobs()
+{
+	if (!s_Data || !isMainThread())
+		return;
+
+	std::vector<Job> jobs;
+	{
+		std::lock_guard lock(s_Data->mainThreadMutex);
+		jobs.swap(s_Data->mainThreadJobs);
+	}
+
+	for (auto &job : jobs)
+	{
+		job.m_Function();
+		finishJob(job);
+	}
+}
+
+bool JobSystem::isInitialized()
+{
+	return s_Data != nullptr;
+}
+
+bool JobSystem::isMainThread()
+{
+	return s_Data && std::this_thread::get_id() == s_Data->mainThreadId;
+}
+
+uint32_t JobSystem::getWorkerCount()
+{
+	return s_Data ? static_cast<uint32_t>(s_Data->workers.size()) : 0;
+}
+
+uint32_t JobSystem::getThreadIndex()
+{
+	return s_ThreadIndex;
+}
+
+void JobSystem::schedule(Job &&job)
+{
+	if (job.m_MainThread)
+	{
+		std::lock_guard lock(s_Data->mainThreadMutex);
+		s_Data->mainThreadJobs.push_back(std::move(job));
+		return;
+	}
+
+	// pool 밖의 thread 에서 들어온 job 은 main thread 큐에 넣고 worker 들이 훔쳐가게 한다.
+	uint32_t queueIndex = s_ThreadIndex == INVALID_THREAD_INDEX ? 0 : s_ThreadIndex;
+	s_Data->pendingJobs.fetch_add(1, std::memory_order_release);
+	s_Data->queues[queueIndex]->push(std::move(job));
+
+	// 잠들기 직전의 worker 가 신호를 놓치지 않도록 mutex 를 한 번 거친 뒤 깨운다.
+	{
+		std::lock_guard lock(s_Data->sleepMutex);
+	}
+	s_Data->wakeCondition.notify_one();
+}
+
+void JobSystem::finishJob(Job &job)
+{
+	JobCounter *counter = job.m_Counter;
+	if (!counter)
+		return;
+
+	std::vector<Job> continuations;
+	{
+		std::lock_guard lock(counter->m_Mutex);
+		if (counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			continuations.swap(counter->m_Continuations);
+	}
+
+	for (auto &continuation : continuations)
+	{
+		schedule(std::move(continuation));
+	}
+}
+
+bool JobSystem::tryRunJob(uint32_t threadIndex)
+{
+	Job job;
+	bool found = false;
+	uint32_t queueCount = static_cast<uint32_t>(s_Data->queues.size());
+
+	if (threadIndex != INVALID_THREAD_INDEX)
+		found = s_Data->queues[threadIndex]->pop(job);
+
+	if (!found)
+	{
+		uint32_t start = threadIndex == INVALID_THREAD_INDEX ? 0 : threadIndex + 1;
+		for (uint32_t i = 0; i < queueCount && !found; i++)
+		{
+			uint32_t victim = (start + i) % queueCount;
+			if (victim == threadIndex)
+				continue;
+			found = s_Data->queues[victim]->steal(job);
+		}
+	}
+
+	if (!found)
+		return false;
+
+	s_Data->pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+	job.m_Function();
+	finishJob(job);
+	return true;
+}
+
+void JobSystem::workerLoop(uint32_t threadIndex)
+{
+	s_ThreadIndex = threadIndex;
+
+	while (s_Data->running.load(std::memory_order_acquire))
+	{
+		if (tryRunJob(threadIndex))
+			continue;
+
+		std::unique_lock lock(s_Data->sleepMutex);
+		s_Data->wakeCondition.wait(lock, []() {
+			return !s_Data->running.load(std::memory_order_acquire) ||
+				   s_Data->pendingJobs.load(std::memory_order_acquire) > 0;
+		});
+	}
+}
+
+void JobSystem::runSchedulingBenchmark(uint32_t jobCount)
+{
+	if (!s_Data)
+	{
+		AL_CORE_WARN("JobSystem::runSchedulingBenchmark: job system is not initialized");
+		return;
+	}
+
+	using Clock = std::chrono::high_resolution_clock;
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+
+	AL_CORE_INFO("JobSystem benchmark: {0} workers + main thread, {1} jobs", getWorkerCount(), jobCount);
+
+	// 1. 빈 job 을 하나씩 execute -> wait (스케줄링 비용만 측정)
+	{
+		auto start = Clock::now();
+		JobCounter counter;
+		for (uint32_t i = 0; i < jobCount; i++)
+		{
+			execute([]() {}, &counter);
+		}
+		wait(counter);
+		double elapsed = Milliseconds(Clock::now() - start).count();
+		AL_CORE_INFO("  execute/wait   : {0:.3f} ms ({1:.1f} ns/job)", elapsed, elapsed * 1.0e6 / jobCount);
+	}
+
+	// 2. parallelFor (grain 크기에 따른 분할 비용)
+	std::vector<float> values(jobCount, 1.0f);
+	for (uint32_t grainSize : {64u, 1024u})
+	{
+		auto start = Clock::now();
+		parallelFor(jobCount, grainSize, [&values](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+				values[i] = values[i] * 0.5f + 1.0f;
+		});
+		double elapsed = Milliseconds(Clock::now() - start).count();
+		AL_CORE_INFO("  parallelFor({0:4}): {1:.3f} ms", grainSize, elapsed);
+	}
+
+	// 3. dependency chain (counter 를 통한 후속 job 연결 비용)
+	{
+		uint32_t chainLength = std::min(jobCount, 1000u);
+		std::vector<std::unique_ptr<JobCounter>> counters;
+		for (uint32_t i = 0; i < chainLength; i++)
+		{
+			counters.push_back(std::make_unique<JobCounter>());
+		}
+
+		auto start = Clock::now();
+		execute([]() {}, counters[0].get());
+		for (uint32_t i = 1; i < chainLength; i++)
+		{
+			executeAfter(*counters[i - 1], []() {}, counters[i].get());
+		}
+		for (auto &counter : counters)
+		{
+			wait(*counter);
+		}
+		double elapsed = Milliseconds(Clock::now() - start).count();
+		AL_CORE_INFO("  dependency chain: {0} jobs in {1:.3f} ms ({2:.1f} ns/link)", chainLength, elapsed,
+					 elapsed * 1.0e6 / chainLength);
+	}
+}
+
+} // namespace ale
@@ -1,5 +1,5 @@
 #include "Core/Layer.h"
-#include "ALpch.h"
+#include "alpch.h"
 
 namespace ale
 {
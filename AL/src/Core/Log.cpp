@@ -1,5 +1,5 @@
 #include "Core/Log.h"
-#include "ALpch.h"
+#include "alpch.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace ale
@@ -1,5 +1,5 @@
 #include "ImGui/ImGuiLayer.h"
-#include "ALpch.h"
+#include "alpch.h"
 #include "Core/App.h"
 #include "Events/AppEvent.h"
 
@@ -110,7 +110,7 @@
 
 #include "imgui/imgui.h"
 #ifndef IMGUI_DISABLE
-#include "imgui/ImGuiVulkanGlfw.h"
+#include "ImGui/ImGuiVulkanGlfw.h"
 
 // Clang warnings with -Weverything
 #if defined(__clang__)
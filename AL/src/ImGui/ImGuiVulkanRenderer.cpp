@@ -99,7 +99,7 @@
 
 #include "imgui/imgui.h"
 #ifndef IMGUI_DISABLE
-#include "imgui/ImGuiVulkanRenderer.h"
+#include "ImGui/ImGuiVulkanRenderer.h"
 #include <stdio.h>
 #ifndef IM_MAX
 #define IM_MAX(A, B) (((A) >= (B)) ? (A) : (B))
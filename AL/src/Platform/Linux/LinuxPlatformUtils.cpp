@@ -0,0 +1,29 @@
+#include "alpch.h"
+
+#include "Utils/PlatformUtils.h"
+
+namespace ale
+{
+// Linux 는 native file dialog 가 없으므로 빈 경로를 돌려준다. (headless benchmark 는 dialog 를 쓰지 않는다)
+std::string FileDialogs::openFile(const char *filter)
+{
+	AL_CORE_WARN("FileDialogs::openFile is not supported on this platform");
+	return std::string();
+}
+
+std::string FileDialogs::saveFile(const char *filter)
+{
+	AL_CORE_WARN("FileDialogs::saveFile is not supported on this platform");
+	return std::string();
+}
+
+// Linux 의 sleep 은 이미 1ms 보다 정밀하므로 따로 요청할 것이 없다.
+void TimerResolution::request(uint32_t milliseconds)
+{
+}
+
+void TimerResolution::release(uint32_t milliseconds)
+{
+}
+
+} // namespace ale
@@ -1,4 +1,4 @@
-#include "Alpch.h"
+#include "alpch.h"
 #include "Core/App.h"
 #include "Core/Input.h"
 
@@ -7,6 +7,7 @@
 #include <glfw/glfw3.h>
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
+#include <timeapi.h>
 
 namespace ale
 {
@@ -59,4 +60,14 @@ std::string FileDialogs::saveFile(const char *filter)
 	return std::string();
 }
 
+void TimerResolution::request(uint32_t milliseconds)
+{
+	timeBeginPeriod(milliseconds);
+}
+
+void TimerResolution::release(uint32_t milliseconds)
+{
+	timeEndPeriod(milliseconds);
+}
+
 } // namespace ale
\ No newline at end of file
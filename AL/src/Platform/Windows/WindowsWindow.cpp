@@ -1,5 +1,5 @@
 #include "Platform/Windows/WindowsWindow.h"
-#include "ALpch.h"
+#include "alpch.h"
 #include "Core/Log.h"
 #include "Events/AppEvent.h"
 #include "Events/KeyEvent.h"
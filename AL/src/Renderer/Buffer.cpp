@@ -5,7 +5,7 @@
 namespace ale
 {
 void Buffer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
-						  VkBuffer &buffer, VkDeviceMemory &bufferMemory)
+						  VkBuffer &buffer, MemoryAllocation &allocation, AllocationStrategy strategy)
 {
 	// 버퍼 객체를 생성하기 위한 구조체 (GPU 메모리에 데이터 저장 공간을 할당하는 데 필요한 설정을 정의)
 	VkBufferCreateInfo bufferInfo{};
@@ -23,89 +23,14 @@ void Buffer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryP
 	}
 
 	// [버퍼에 메모리 할당]
-	// 메모리 할당 요구사항 조회
-	VkMemoryRequirements memRequirements;
-	vkGetBufferMemoryRequirements(m_device, buffer, &memRequirements);
-
-	// 메모리 할당을 위한 구조체
-	VkMemoryAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size; // 할당할 메모리 크기
-	// 메모리 요구사항 설정 (GPU 메모리 유형 중 buffer와 호환되고 properties 속성들과 일치하는 것 찾아 저장)
-	// 메모리 유형 - GPU 메모리는 구역마다 유형이 다르다. (memoryTypeBits는 buffer가 호환되는 GPU의 메모리 유형이 전부
-	// 담겨있음) 메모리 유형의 속성 - 메모리 유형마다 특성을 가지고 있음
-	allocInfo.memoryTypeIndex = VulkanUtil::findMemoryType(memRequirements.memoryTypeBits, properties);
-
-	// 버퍼 메모리 할당
-	if (vkAllocateMemory(m_device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS)
-	{
-		throw std::runtime_error("failed to allocate buffer memory!");
-	}
-
-	// 버퍼 객체에 할당된 메모리를 바인딩 (4번째 매개변수는 할당할 메모리의 offset)
-	vkBindBufferMemory(m_device, buffer, bufferMemory, 0);
-}
-
-// srcBuffer 에서 dstBuffer 로 데이터 복사
-void Buffer::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
-{
-	VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-	VkBufferCopy copyRegion{}; // 복사할 버퍼 영역을 지정 (크기, src 와 dst의 시작 offset 등)
-	copyRegion.size = size;	   // 복사할 버퍼 크기 설정
-	vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion); // 커맨드 버퍼에 복사 명령 기록
-
-	endSingleTimeCommands(commandBuffer);
-}
-
-// 한 번만 실행할 커맨드 버퍼 생성 및 기록 시작
-VkCommandBuffer Buffer::beginSingleTimeCommands()
-{
-	// 커맨드 버퍼 할당을 위한 구조체
-	VkCommandBufferAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocInfo.level =
-		VK_COMMAND_BUFFER_LEVEL_PRIMARY;   // PRIMARY LEVEL 등록 (해당 커맨드 버퍼가 큐에 단독으로 제출될 수 있음)
-	allocInfo.commandPool = m_commandPool; // 커맨드 풀 지정
-	allocInfo.commandBufferCount = 1;	   // 커맨드 버퍼 개수 지정
-
-	// 커맨드 버퍼 생성
-	VkCommandBuffer commandBuffer;
-	vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer);
-
-	// 커맨드 버퍼 기록을 위한 정보 객체
-	VkCommandBufferBeginInfo beginInfo{};
-	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // 커맨드 버퍼를 1번만 제출
-
-	// GPU에 필요한 작업을 모두 커맨드 버퍼에 기록하기 시작
-	vkBeginCommandBuffer(commandBuffer, &beginInfo);
-
-	return commandBuffer;
-}
-
-// 한 번만 실행할 커맨드 버퍼 기록 중지 및 큐에 커맨드 버퍼 제출
-void Buffer::endSingleTimeCommands(VkCommandBuffer commandBuffer)
-{
-	// 커맨드 버퍼 기록 중지
-	vkEndCommandBuffer(commandBuffer);
-
-	// 복사 커맨드 버퍼 제출 정보 객체 생성
-	VkSubmitInfo submitInfo{};
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-	submitInfo.commandBufferCount = 1;			 // 커맨드 버퍼 개수
-	submitInfo.pCommandBuffers = &commandBuffer; // 커맨드 버퍼 등록
-
-	vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE); // 커맨드 버퍼 큐에 제출
-	vkQueueWaitIdle(m_graphicsQueue);								// 그래픽스 큐 작업 종료 대기
-
-	vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer); // 커맨드 버퍼 제거
+	// buffer 마다 vkAllocateMemory 를 호출하지 않고 allocator 의 큰 block 에서 잘라 받은 뒤 bind
+	allocation = MemoryAllocator::getAllocator().allocateBufferMemory(buffer, properties, strategy);
 }
 
-std::unique_ptr<VertexBuffer> VertexBuffer::createVertexBuffer(std::vector<Vertex> &vertices)
+std::unique_ptr<VertexBuffer> VertexBuffer::createVertexBuffer(uint32_t vertexCapacity)
 {
 	std::unique_ptr<VertexBuffer> vertexBuffer = std::unique_ptr<VertexBuffer>(new VertexBuffer());
-	vertexBuffer->initVertexBuffer(vertices);
+	vertexBuffer->initVertexBuffer(vertexCapacity);
 	return vertexBuffer;
 }
 
@@ -116,11 +41,20 @@ void VertexBuffer::cleanup()
 		vkDestroyBuffer(m_device, m_buffer, nullptr);
 		m_buffer = VK_NULL_HANDLE;
 	}
-	if (m_bufferMemory != VK_NULL_HANDLE)
+	MemoryAllocator::getAllocator().free(m_allocation);
+}
+
+void VertexBuffer::updateVertexBuffer(const std::vector<Vertex> &vertices, uint32_t firstVertex)
+{
+	if (firstVertex + vertices.size() > m_capacity)
 	{
-		vkFreeMemory(m_device, m_bufferMemory, nullptr);
-		m_bufferMemory = VK_NULL_HANDLE;
+		throw std::runtime_error("vertex buffer overflow!");
 	}
+
+	// staging 복사는 UploadManager 가 batch 로 모아서 제출한다.
+	UploadManager::getUploadManager().uploadBuffer(m_buffer, vertices.data(), sizeof(Vertex) * vertices.size(),
+												   VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+												   VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, sizeof(Vertex) * firstVertex);
 }
 
 void VertexBuffer::bind(VkCommandBuffer commandBuffer)
@@ -130,40 +64,22 @@ void VertexBuffer::bind(VkCommandBuffer commandBuffer)
 	vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
 }
 
-void VertexBuffer::initVertexBuffer(std::vector<Vertex> &vertices)
+void VertexBuffer::initVertexBuffer(uint32_t vertexCapacity)
 {
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
-
-	VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
-
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-				 stagingBufferMemory);
-
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, bufferSize, 0, &data);
-	memcpy(data, vertices.data(), (size_t)bufferSize);
-
-	vkUnmapMemory(m_device, stagingBufferMemory);
+	m_capacity = vertexCapacity;
 
+	VkDeviceSize bufferSize = sizeof(Vertex) * vertexCapacity;
 	createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-				 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_buffer, m_bufferMemory);
-	copyBuffer(stagingBuffer, m_buffer, bufferSize);
-
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+				 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_buffer, m_allocation);
 }
 
-std::unique_ptr<IndexBuffer> IndexBuffer::createIndexBuffer(std::vector<uint32_t> &indices)
+std::unique_ptr<IndexBuffer> IndexBuffer::createIndexBuffer(uint32_t indexCapacity)
 {
 	std::unique_ptr<IndexBuffer> indexBuffer = std::unique_ptr<IndexBuffer>(new IndexBuffer());
-	indexBuffer->initIndexBuffer(indices);
+	indexBuffer->initIndexBuffer(indexCapacity);
 	return indexBuffer;
 }
 
@@ -174,11 +90,19 @@ void IndexBuffer::cleanup()
 		vkDestroyBuffer(m_device, m_buffer, nullptr);
 		m_buffer = VK_NULL_HANDLE;
 	}
-	if (m_bufferMemory != VK_NULL_HANDLE)
+	MemoryAllocator::getAllocator().free(m_allocation);
+}
+
+void IndexBuffer::updateIndexBuffer(const std::vector<uint32_t> &indices, uint32_t firstIndex)
+{
+	if (firstIndex + indices.size() > m_capacity)
 	{
-		vkFreeMemory(m_device, m_bufferMemory, nullptr);
-		m_bufferMemory = VK_NULL_HANDLE;
+		throw std::runtime_error("index buffer overflow!");
 	}
+
+	UploadManager::getUploadManager().uploadBuffer(m_buffer, indices.data(), sizeof(uint32_t) * indices.size(),
+												   VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+												   sizeof(uint32_t) * firstIndex);
 }
 
 void IndexBuffer::bind(VkCommandBuffer commandBuffer)
@@ -186,34 +110,16 @@ void IndexBuffer::bind(VkCommandBuffer commandBuffer)
 	vkCmdBindIndexBuffer(commandBuffer, m_buffer, 0, VK_INDEX_TYPE_UINT32);
 }
 
-void IndexBuffer::initIndexBuffer(std::vector<uint32_t> &indices)
+void IndexBuffer::initIndexBuffer(uint32_t indexCapacity)
 {
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
-
-	VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
-	m_indexCount = static_cast<uint32_t>(indices.size());
-
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-				 stagingBufferMemory);
-
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, bufferSize, 0, &data);
-	memcpy(data, indices.data(), (size_t)bufferSize);
-	vkUnmapMemory(m_device, stagingBufferMemory);
+	m_capacity = indexCapacity;
 
+	VkDeviceSize bufferSize = sizeof(uint32_t) * indexCapacity;
 	createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-				 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_buffer, m_bufferMemory);
-	copyBuffer(stagingBuffer, m_buffer, bufferSize);
-
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+				 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_buffer, m_allocation);
 }
 
 std::unique_ptr<ImageBuffer> ImageBuffer::createImageBuffer(std::string path, bool flipVertically)
@@ -250,11 +156,7 @@ void ImageBuffer::cleanup()
 		vkDestroyImage(m_device, textureImage, nullptr);
 		textureImage = VK_NULL_HANDLE;
 	}
-	if (textureImageMemory != VK_NULL_HANDLE)
-	{
-		vkFreeMemory(m_device, textureImageMemory, nullptr);
-		textureImageMemory = VK_NULL_HANDLE;
-	}
+	MemoryAllocator::getAllocator().free(textureImageAllocation);
 }
 
 bool ImageBuffer::initImageBuffer(std::string path, bool flipVertically)
@@ -262,8 +164,6 @@ bool ImageBuffer::initImageBuffer(std::string path, bool flipVertically)
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
 
 	int texWidth, texHeight, texChannels;
 	stbi_set_flip_vertically_on_load(flipVertically);
@@ -275,31 +175,16 @@ bool ImageBuffer::initImageBuffer(std::string path, bool flipVertically)
 
 	mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
 
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-				 stagingBufferMemory);
-
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, imageSize, 0, &data);
-	memcpy(data, pixels, static_cast<size_t>(imageSize));
-	vkUnmapMemory(m_device, stagingBufferMemory);
-
-	stbi_image_free(pixels);
 	VulkanUtil::createImage(
 		texWidth, texHeight, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_TILING_OPTIMAL,
 		VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
-
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED,
-						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-	copyBufferToImage(stagingBuffer, textureImage, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageAllocation);
 
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
-
-	generateMipmaps(textureImage, VK_FORMAT_R8G8B8A8_SRGB, texWidth, texHeight, mipLevels);
+	// 복사와 mipmap 생성은 UploadManager 의 다음 batch 에서 실행된다. (pixels 는 staging ring 에 복사됨)
+	UploadManager::getUploadManager().uploadImage(textureImage, VK_FORMAT_R8G8B8A8_SRGB, pixels, imageSize,
+												  static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight),
+												  mipLevels);
+	stbi_image_free(pixels);
 	return true;
 }
 
@@ -308,8 +193,6 @@ bool ImageBuffer::initMaterialImageBuffer(std::string path, bool flipVertically)
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
 
 	int texWidth, texHeight, texChannels;
 	stbi_set_flip_vertically_on_load(flipVertically);
@@ -321,32 +204,15 @@ bool ImageBuffer::initMaterialImageBuffer(std::string path, bool flipVertically)
 
 	mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
 
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-				 stagingBufferMemory);
-
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, imageSize, 0, &data);
-	memcpy(data, pixels, static_cast<size_t>(imageSize));
-	vkUnmapMemory(m_device, stagingBufferMemory);
-
-	stbi_image_free(pixels);
-
 	VulkanUtil::createImage(
 		texWidth, texHeight, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL,
 		VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
-
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
-						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-	copyBufferToImage(stagingBuffer, textureImage, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
-
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageAllocation);
 
-	generateMipmaps(textureImage, VK_FORMAT_R8G8B8A8_UNORM, texWidth, texHeight, mipLevels);
+	UploadManager::getUploadManager().uploadImage(textureImage, VK_FORMAT_R8G8B8A8_UNORM, pixels, imageSize,
+												  static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight),
+												  mipLevels);
+	stbi_image_free(pixels);
 	return true;
 }
 
@@ -355,8 +221,6 @@ void ImageBuffer::initImageBufferFromMemory(const aiTexture *texture)
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
 
 	int texWidth, texHeight, texChannels;
 	unsigned char *pixels = nullptr;
@@ -385,32 +249,15 @@ void ImageBuffer::initImageBufferFromMemory(const aiTexture *texture)
 	mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
 
 	VkDeviceSize imageSize = texWidth * texHeight * 4; // RGBA: 4 bytes per pixel
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-				 stagingBufferMemory);
-
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, imageSize, 0, &data);
-	memcpy(data, pixels, static_cast<size_t>(imageSize));
-	vkUnmapMemory(m_device, stagingBufferMemory);
-
-	stbi_image_free(pixels);
-
 	VulkanUtil::createImage(
 		texWidth, texHeight, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL,
 		VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageAllocation);
 
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
-						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-	copyBufferToImage(stagingBuffer, textureImage, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
-
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
-
-	generateMipmaps(textureImage, VK_FORMAT_R8G8B8A8_UNORM, texWidth, texHeight, mipLevels);
+	UploadManager::getUploadManager().uploadImage(textureImage, VK_FORMAT_R8G8B8A8_UNORM, pixels, imageSize,
+												  static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight),
+												  mipLevels);
+	stbi_image_free(pixels);
 }
 
 std::unique_ptr<ImageBuffer> ImageBuffer::createDefaultImageBuffer(glm::vec4 color)
@@ -425,42 +272,21 @@ void ImageBuffer::initDefaultImageBuffer(glm::vec4 color)
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
 
-	// 1. 스테이징 버퍼 생성 및 데이터 복사
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
+	// 1. 픽셀 데이터 준비
 	VkDeviceSize bufferSize = 4; // RGBA 1픽셀
-
-	Buffer::createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-						 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-						 stagingBufferMemory);
-
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, bufferSize, 0, &data);
 	uint8_t pixel[4] = {static_cast<uint8_t>(color.r * 255), static_cast<uint8_t>(color.g * 255),
 						static_cast<uint8_t>(color.b * 255), static_cast<uint8_t>(color.a * 255)};
-	memcpy(data, pixel, static_cast<size_t>(bufferSize));
-	vkUnmapMemory(m_device, stagingBufferMemory);
 
 	// 2. VulkanUtil을 사용하여 Default Image 생성
 	mipLevels = 1; // Default Texture는 mipmap이 필요 없음
 
 	VulkanUtil::createImage(1, 1, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL,
 							VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
+							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageAllocation);
 
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
-						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
-
-	copyBufferToImage(stagingBuffer, textureImage, 1, 1);
-
-	transitionImageLayout(textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-						  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels);
-
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+	UploadManager::getUploadManager().uploadImage(textureImage, VK_FORMAT_R8G8B8A8_UNORM, pixel, bufferSize, 1, 1,
+												  mipLevels);
 }
 
 std::unique_ptr<ImageBuffer> ImageBuffer::createDefaultSingleChannelImageBuffer(float value)
@@ -475,221 +301,245 @@ void ImageBuffer::initDefaultSingleChannelImageBuffer(float value)
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
-
-	// 1. 스테이징 버퍼 생성 및 데이터 복사
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferMemory;
-	VkDeviceSize bufferSize = 1; // 단일 R 채널 1픽셀
-
-	Buffer::createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-						 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-						 stagingBufferMemory);
 
-	void *data;
-	vkMapMemory(m_device, stagingBufferMemory, 0, bufferSize, 0, &data);
+	// 1. 픽셀 데이터 준비
+	VkDeviceSize bufferSize = 1;					   // 단일 R 채널 1픽셀
 	uint8_t pixel = static_cast<uint8_t>(value * 255); // 0.0 ~ 1.0 값을 0 ~ 255로 변환
-	memcpy(data, &pixel, sizeof(pixel));
-	vkUnmapMemory(m_device, stagingBufferMemory);
 
 	// 2. VulkanUtil을 사용하여 단일 채널 이미지 생성
 	mipLevels = 1; // Default Texture는 mipmap이 필요 없음
 
 	VulkanUtil::createImage(1, 1, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8_UNORM, VK_IMAGE_TILING_OPTIMAL,
 							VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
+							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageAllocation);
 
-	transitionImageLayout(textureImage, VK_FORMAT_R8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
-						  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
+	UploadManager::getUploadManager().uploadImage(textureImage, VK_FORMAT_R8_UNORM, &pixel, bufferSize, 1, 1,
+												  mipLevels);
+}
 
-	copyBufferToImage(stagingBuffer, textureImage, 1, 1);
+std::unique_ptr<InstanceBuffer> InstanceBuffer::createInstanceBuffer(uint32_t instanceCapacity)
+{
+	std::unique_ptr<InstanceBuffer> instanceBuffer = std::unique_ptr<InstanceBuffer>(new InstanceBuffer());
+	instanceBuffer->initInstanceBuffer(instanceCapacity, true);
+	return instanceBuffer;
+}
 
-	transitionImageLayout(textureImage, VK_FORMAT_R8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-						  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels);
+std::unique_ptr<InstanceBuffer> InstanceBuffer::createCulledInstanceBuffer(uint32_t instanceCapacity)
+{
+	std::unique_ptr<InstanceBuffer> instanceBuffer = std::unique_ptr<InstanceBuffer>(new InstanceBuffer());
+	instanceBuffer->initInstanceBuffer(instanceCapacity, false);
+	return instanceBuffer;
+}
 
-	vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-	vkFreeMemory(m_device, stagingBufferMemory, nullptr);
+void InstanceBuffer::cleanup()
+{
+	if (m_buffer != VK_NULL_HANDLE)
+	{
+		vkDestroyBuffer(m_device, m_buffer, nullptr);
+		m_buffer = VK_NULL_HANDLE;
+	}
+	MemoryAllocator::getAllocator().free(m_allocation);
+	m_mappedMemory = nullptr;
 }
 
-// 이미지 레이아웃, 접근 권한을 변경할 수 있는 베리어를 커맨드 버퍼에 기록
-void ImageBuffer::transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout,
-										VkImageLayout newLayout, uint32_t mipLevels)
+void InstanceBuffer::updateInstanceBuffer(const InstanceData *data, uint32_t instanceCount)
 {
-	VkCommandBuffer commandBuffer = beginSingleTimeCommands(); // 커맨드 버퍼 생성 및 기록 시작
+	if (instanceCount > m_capacity)
+	{
+		throw std::runtime_error("instance buffer overflow!");
+	}
+	if (m_mappedMemory == nullptr)
+	{
+		throw std::runtime_error("instance buffer is not host visible!");
+	}
+	memcpy(m_mappedMemory, data, sizeof(InstanceData) * instanceCount);
+}
 
-	// 베리어 생성을 위한 구조체
-	VkImageMemoryBarrier barrier{};
-	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrier.oldLayout = oldLayout;						   // src 단계까지의 이미지 레이아웃
-	barrier.newLayout = newLayout;						   // src 단계 이후 적용시킬 새로운 이미지 레이아웃
-	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // 베리어 전환 적용 후 리소스 소유권을 넘겨줄 src 큐 패밀리
-														   // (현재는 동일 큐 패밀리에서 실행)
-	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // 리소스 소유권을 받을 dst 큐 패밀리로 dst 큐패밀리에는 큐
-														   // 전체에 동기화가 적용 (현재는 동일 큐 패밀리에서 실행)
-	barrier.image = image;								   // 배리어 적용할 이미지 객체
-	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT; // 전환 작업의 적용 대상을 color bit 으로 설정
-	barrier.subresourceRange.baseMipLevel = 0;						 // 전환 작업을 시작할 miplevel
-	barrier.subresourceRange.levelCount = mipLevels;				 // 전환 작업을 적용할 miplevel의 개수
-	barrier.subresourceRange.baseArrayLayer = 0;					 // 전환 작업을 시작할 레이어 인덱스
-	barrier.subresourceRange.layerCount = 1;						 // 전환 작업을 적용할 레이어 개수
+void InstanceBuffer::bind(VkCommandBuffer commandBuffer)
+{
+	// 정점 데이터는 binding 0, instance 데이터는 binding 1
+	VkBuffer buffers[] = {m_buffer};
+	VkDeviceSize offsets[] = {0};
+	vkCmdBindVertexBuffers(commandBuffer, 1, 1, buffers, offsets);
+}
 
-	VkPipelineStageFlags sourceStage;	   // 파이프라인의 sourceStage 단계가 끝나면 배리어 전환 실행
-	VkPipelineStageFlags destinationStage; // destinationStage 단계는 배리어 전환이 끝날때까지 대기
+void InstanceBuffer::initInstanceBuffer(uint32_t instanceCapacity, bool hostVisible)
+{
+	auto &context = VulkanContext::getContext();
+	m_device = context.getDevice();
+	m_physicalDevice = context.getPhysicalDevice();
+	m_capacity = instanceCapacity;
 
-	if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+	// GPU culling compute shader 가 storage buffer 로 읽고 / 쓴다.
+	VkDeviceSize bufferSize = sizeof(InstanceData) * instanceCapacity;
+	VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+	if (hostVisible)
 	{
-		// 이미지 복사 전에 이미지 레이아웃, 접근 권한 변경
-		barrier.srcAccessMask = 0;							  // 접근 제한 x
-		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT; // 쓰기 권한 필요
-
-		sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;   // Vulkan의 파이프라인에서 가장 상단에 위치한 첫 번째 단계로,
-														   // 어떠한 작업도 진행되지 않은 상태
-		destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT; // 데이터 복사 단계
+		createBuffer(bufferSize, usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+					 m_buffer, m_allocation);
+		m_mappedMemory = m_allocation.mappedData;
 	}
-	else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+	else
 	{
-		// 이미지 복사가 완료되고 읽기를 수행하기 위해 Fragment shader 작업 대기
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT; // 쓰기 권한 필요
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;	  // 읽기 권한 필요
+		createBuffer(bufferSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_buffer, m_allocation);
+	}
+}
+
+std::unique_ptr<IndirectBuffer> IndirectBuffer::createIndirectBuffer(uint32_t commandCapacity)
+{
+	std::unique_ptr<IndirectBuffer> indirectBuffer = std::unique_ptr<IndirectBuffer>(new IndirectBuffer());
+	indirectBuffer->initIndirectBuffer(commandCapacity);
+	return indirectBuffer;
+}
 
-		sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;			  // 데이터 복사 단계
-		destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT; // Fragment shader 단계
+void IndirectBuffer::cleanup()
+{
+	if (m_buffer != VK_NULL_HANDLE)
+	{
+		vkDestroyBuffer(m_device, m_buffer, nullptr);
+		m_buffer = VK_NULL_HANDLE;
 	}
-	else
+	MemoryAllocator::getAllocator().free(m_allocation);
+	m_commands = nullptr;
+}
+
+void IndirectBuffer::initIndirectBuffer(uint32_t commandCapacity)
+{
+	auto &context = VulkanContext::getContext();
+	m_device = context.getDevice();
+	m_physicalDevice = context.getPhysicalDevice();
+	m_capacity = commandCapacity;
+
+	VkDeviceSize bufferSize = sizeof(VkDrawIndexedIndirectCommand) * commandCapacity;
+	createBuffer(bufferSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_buffer, m_allocation);
+	m_commands = static_cast<VkDrawIndexedIndirectCommand *>(m_allocation.mappedData);
+}
+
+std::unique_ptr<StorageBuffer> StorageBuffer::createStorageBuffer(VkDeviceSize bufferSize)
+{
+	std::unique_ptr<StorageBuffer> storageBuffer = std::unique_ptr<StorageBuffer>(new StorageBuffer());
+	storageBuffer->initStorageBuffer(bufferSize);
+	return storageBuffer;
+}
+
+void StorageBuffer::cleanup()
+{
+	if (m_buffer != VK_NULL_HANDLE)
+	{
+		vkDestroyBuffer(m_device, m_buffer, nullptr);
+		m_buffer = VK_NULL_HANDLE;
+	}
+	MemoryAllocator::getAllocator().free(m_allocation);
+	m_mappedMemory = nullptr;
+}
+
+void StorageBuffer::updateStorageBuffer(const void *data, VkDeviceSize size)
+{
+	if (size > m_size)
 	{
-		throw std::invalid_argument("unsupported layout transition!");
+		throw std::runtime_error("storage buffer overflow!");
 	}
+	memcpy(m_mappedMemory, data, size);
+}
 
-	// 베리어를 커맨드 버퍼에 기록
-	vkCmdPipelineBarrier(commandBuffer,					// 베리어를 기록할 커맨드 버퍼
-						 sourceStage, destinationStage, // sourceStage 단계가 끝나면 베리어 작업 시작, 베리어 작업이
-														// 끝나기 전에 destinationStage에 돌입한 다른 작업들 모두 대기
-						 0,								// 의존성 플래그
-						 0, nullptr,					// 메모리 베리어 (개수 + 베리어 포인터)
-						 0, nullptr,					// 버퍼 베리어   (개수 + 베리어 포인터)
-						 1, &barrier					// 이미지 베리어 (개수 + 베리어 포인터)
-	);
+void StorageBuffer::initStorageBuffer(VkDeviceSize bufferSize)
+{
+	auto &context = VulkanContext::getContext();
+	m_device = context.getDevice();
+	m_physicalDevice = context.getPhysicalDevice();
+	m_size = bufferSize;
 
-	endSingleTimeCommands(commandBuffer); // 커맨드 버퍼 기록 종료
+	createBuffer(m_size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_buffer, m_allocation);
+	m_mappedMemory = m_allocation.mappedData;
 }
 
-// 커맨드 버퍼 제출을 통해 버퍼 -> 이미지 데이터 복사
-void ImageBuffer::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
+std::unique_ptr<ReadbackBuffer> ReadbackBuffer::createReadbackBuffer(VkDeviceSize bufferSize)
 {
-	// 커맨드 버퍼 생성 및 기록 시작
-	VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+	std::unique_ptr<ReadbackBuffer> readbackBuffer = std::unique_ptr<ReadbackBuffer>(new ReadbackBuffer());
+	readbackBuffer->initReadbackBuffer(bufferSize);
+	return readbackBuffer;
+}
 
-	// 버퍼 -> 이미지 복사를 위한 정보
-	VkBufferImageCopy region{};
-	region.bufferOffset = 0;	  // 복사할 버퍼의 시작 위치 offset
-	region.bufferRowLength = 0;	  // 저장될 공간의 row 당 픽셀 수 (0으로 하면 이미지 너비에 자동으로 맞춰진다.)
-	region.bufferImageHeight = 0; // 저장될 공간의 col 당 픽셀 수 (0으로 하면 이미지 높이에 자동으로 맞춰진다.)
-	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT; // 이미지의 데이터 타입 (현재는 컬러값을 복사)
-	region.imageSubresource.mipLevel = 0;							// 이미지의 miplevel 설정
-	region.imageSubresource.baseArrayLayer = 0; // 이미지의 시작 layer 설정 (cubemap과 같은 경우 여러 레이어 존재)
-	region.imageSubresource.layerCount = 1;		// 이미지 layer 개수
-	region.imageOffset = {0, 0, 0};				// 이미지의 저장할 시작 위치
-	region.imageExtent = {						// 이미지의 저장할 너비, 높이, 깊이
-						  width, height, 1};
+void ReadbackBuffer::cleanup()
+{
+	if (m_buffer != VK_NULL_HANDLE)
+	{
+		vkDestroyBuffer(m_device, m_buffer, nullptr);
+		m_buffer = VK_NULL_HANDLE;
+	}
+	MemoryAllocator::getAllocator().free(m_allocation);
+	m_mappedMemory = nullptr;
+}
 
-	// 커맨드 버퍼에 버퍼 -> 이미지로 데이터 복사하는 명령 기록
-	vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+void ReadbackBuffer::initReadbackBuffer(VkDeviceSize bufferSize)
+{
+	auto &context = VulkanContext::getContext();
+	m_device = context.getDevice();
+	m_physicalDevice = context.getPhysicalDevice();
 
-	// 커맨드 버퍼 기록 종료 및 제출
-	endSingleTimeCommands(commandBuffer);
+	createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_buffer, m_allocation);
+	m_mappedMemory = m_allocation.mappedData;
 }
 
-void ImageBuffer::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight,
-								  uint32_t mipLevels)
+std::unique_ptr<UniformRingBuffer> UniformRingBuffer::createUniformRingBuffer(VkDeviceSize bufferSize)
 {
-	// 이미지 포맷이 선형 필터링을 사용한 Blit 작업을 지원하는지 확인
-	VkFormatProperties formatProperties;
-	vkGetPhysicalDeviceFormatProperties(m_physicalDevice, imageFormat, &formatProperties);
+	std::unique_ptr<UniformRingBuffer> uniformRingBuffer = std::unique_ptr<UniformRingBuffer>(new UniformRingBuffer());
+	uniformRingBuffer->initUniformRingBuffer(bufferSize);
+	return uniformRingBuffer;
+}
 
-	if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+void UniformRingBuffer::cleanup()
+{
+	if (m_buffer != VK_NULL_HANDLE)
 	{
-		throw std::runtime_error("texture image format does not support linear blitting!");
+		vkDestroyBuffer(m_device, m_buffer, nullptr);
+		m_buffer = VK_NULL_HANDLE;
 	}
+	MemoryAllocator::getAllocator().free(m_allocation);
+	m_mappedMemory = nullptr;
+}
 
-	// 커맨드 버퍼 생성 및 기록 시작
-	VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-	// 베리어 생성
-	VkImageMemoryBarrier barrier{};
-	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrier.image = image;
-	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	barrier.subresourceRange.baseArrayLayer = 0;
-	barrier.subresourceRange.layerCount = 1;
-	barrier.subresourceRange.levelCount = 1;
-
-	int32_t mipWidth = texWidth;
-	int32_t mipHeight = texHeight;
-
-	// miplevel 0 ~ mipLevels
-	for (uint32_t i = 1; i < mipLevels; i++)
+void UniformRingBuffer::reset()
+{
+	m_offset.store(0, std::memory_order_relaxed);
+}
+
+uint32_t UniformRingBuffer::push(const void *data, VkDeviceSize size)
+{
+	VkDeviceSize alignedSize = getAlignedSize(size);
+	VkDeviceSize offset = m_offset.fetch_add(alignedSize, std::memory_order_relaxed);
+	if (offset + alignedSize > m_size)
 	{
-		barrier.subresourceRange.baseMipLevel = i - 1;			  // 해당 mipmap에 대한 barrier 설정
-		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL; // 데이터 쓰기에 적합한 레이아웃
-		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; // 데이터 읽기에 적합한 레이아웃
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;	  // 쓰기 권한 on
-		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;	  // 읽기 권한 on
-
-		// 파이프라인 베리어 설정 (GPU 특정 작업간의 동기화 설정)
-		// 이전 단계의 mipmap 복사가 끝나야, 다음 단계 mipmap 복사가 시작되게 베리어 설정
-		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
-							 nullptr, 0, nullptr, 1, &barrier);
-
-		// blit 작업시 소스와 대상의 복사 범위를 지정하는 구조체
-		VkImageBlit blit{};
-		blit.srcOffsets[0] = {0, 0, 0};
-		blit.srcOffsets[1] = {mipWidth, mipHeight, 1}; // 소스의 범위 설정
-		blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		blit.srcSubresource.mipLevel = i - 1; // 소스의 mipLevel 설정
-		blit.srcSubresource.baseArrayLayer = 0;
-		blit.srcSubresource.layerCount = 1;
-		blit.dstOffsets[0] = {0, 0, 0};
-		blit.dstOffsets[1] = {mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1,
-							  1}; // 대상의 범위 설정
-		blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		blit.dstSubresource.mipLevel = i; // 대상의 mipLevel 설정
-		blit.dstSubresource.baseArrayLayer = 0;
-		blit.dstSubresource.layerCount = 1;
-
-		// 소스 miplevel 을 대상 miplevel로 설정에 맞게 복사
-		vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
-					   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
-					   VK_FILTER_LINEAR); // 선형적으로 복사
-
-		// shader 단계에서 사용하기 전에 Bllit 단계가 끝나기를 기다림
-		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
-							 nullptr, 0, nullptr, 1, &barrier);
-
-		if (mipWidth > 1)
-			mipWidth /= 2;
-		if (mipHeight > 1)
-			mipHeight /= 2;
+		throw std::runtime_error("uniform ring buffer overflow!");
 	}
 
-	// 마지막 단계 miplevel 처리
-	barrier.subresourceRange.baseMipLevel = mipLevels - 1;
-	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	memcpy(static_cast<char *>(m_mappedMemory) + offset, data, size);
+	return static_cast<uint32_t>(offset);
+}
+
+VkDeviceSize UniformRingBuffer::getAlignedSize(VkDeviceSize size)
+{
+	// dynamic offset 은 minUniformBufferOffsetAlignment 의 배수여야 한다.
+	return (size + m_alignment - 1) & ~(m_alignment - 1);
+}
+
+void UniformRingBuffer::initUniformRingBuffer(VkDeviceSize bufferSize)
+{
+	auto &context = VulkanContext::getContext();
+	m_device = context.getDevice();
+	m_physicalDevice = context.getPhysicalDevice();
 
-	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
-						 nullptr, 0, nullptr, 1, &barrier);
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(m_physicalDevice, &properties);
+	m_alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 16);
+	m_size = getAlignedSize(bufferSize);
 
-	endSingleTimeCommands(commandBuffer);
+	createBuffer(m_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_buffer, m_allocation);
+	m_mappedMemory = m_allocation.mappedData;
 }
 
 std::shared_ptr<UniformBuffer> UniformBuffer::createUniformBuffer(VkDeviceSize buffersize)
@@ -706,11 +556,7 @@ void UniformBuffer::cleanup()
 		vkDestroyBuffer(m_device, m_buffer, nullptr);
 		m_buffer = VK_NULL_HANDLE;
 	}
-	if (m_bufferMemory != VK_NULL_HANDLE)
-	{
-		vkFreeMemory(m_device, m_bufferMemory, nullptr);
-		m_bufferMemory = VK_NULL_HANDLE;
-	}
+	MemoryAllocator::getAllocator().free(m_allocation);
 }
 
 void UniformBuffer::updateUniformBuffer(void *data, VkDeviceSize size)
@@ -723,11 +569,9 @@ void UniformBuffer::initUniformBuffer(VkDeviceSize buffersize)
 	auto &context = VulkanContext::getContext();
 	m_device = context.getDevice();
 	m_physicalDevice = context.getPhysicalDevice();
-	m_commandPool = context.getCommandPool();
-	m_graphicsQueue = context.getGraphicsQueue();
 
 	createBuffer(buffersize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_buffer, m_bufferMemory);
-	vkMapMemory(m_device, m_bufferMemory, 0, buffersize, 0, &m_mappedMemory);
+				 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_buffer, m_allocation);
+	m_mappedMemory = m_allocation.mappedData;
 }
 } // namespace ale
\ No newline at end of file
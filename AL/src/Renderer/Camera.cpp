@@ -1,5 +1,5 @@
 #include "Renderer/Camera.h"
-#include "ALpch.h"
+#include "alpch.h"
 
 namespace ale
 {
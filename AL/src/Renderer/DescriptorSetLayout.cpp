@@ -1,7 +1,16 @@
 #include "Renderer/DescriptorSetLayout.h"
+#include "Renderer/MaterialTable.h"
 
 namespace ale
 {
+std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::createGeometryPassFrameDescriptorSetLayout()
+{
+	std::unique_ptr<DescriptorSetLayout> descriptorSetLayout =
+		std::unique_ptr<DescriptorSetLayout>(new DescriptorSetLayout());
+	descriptorSetLayout->initGeometryPassFrameDescriptorSetLayout();
+	return descriptorSetLayout;
+}
+
 std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::createGeometryPassDescriptorSetLayout()
 {
 	std::unique_ptr<DescriptorSetLayout> descriptorSetLayout =
@@ -18,76 +27,66 @@ void DescriptorSetLayout::cleanup()
 	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
 }
 
-void DescriptorSetLayout::initGeometryPassDescriptorSetLayout()
+// set 0: 프레임별 UniformRingBuffer 를 가리키는 camera dynamic uniform buffer + material table / bone storage buffer
+void DescriptorSetLayout::initGeometryPassFrameDescriptorSetLayout()
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 
-	VkDescriptorSetLayoutBinding vertexUBOLayoutBinding{};
-	vertexUBOLayoutBinding.binding = 0;
-	vertexUBOLayoutBinding.descriptorCount = 1;
-	vertexUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	vertexUBOLayoutBinding.pImmutableSamplers = nullptr;
-	vertexUBOLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-	VkDescriptorSetLayoutBinding vertexHeightMapBinding{};
-	vertexHeightMapBinding.binding = 1;
-	vertexHeightMapBinding.descriptorCount = 1;
-	vertexHeightMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	vertexHeightMapBinding.pImmutableSamplers = nullptr;
-	vertexHeightMapBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-	VkDescriptorSetLayoutBinding fragmentUBOLayoutBinding{};
-	fragmentUBOLayoutBinding.binding = 2;
-	fragmentUBOLayoutBinding.descriptorCount = 1;
-	fragmentUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	fragmentUBOLayoutBinding.pImmutableSamplers = nullptr;
-	fragmentUBOLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-	VkDescriptorSetLayoutBinding normalMapBinding{};
-	normalMapBinding.binding = 3;
-	normalMapBinding.descriptorCount = 1;
-	normalMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	normalMapBinding.pImmutableSamplers = nullptr;
-	normalMapBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-	VkDescriptorSetLayoutBinding roughnessMapBinding{};
-	roughnessMapBinding.binding = 4;
-	roughnessMapBinding.descriptorCount = 1;
-	roughnessMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	roughnessMapBinding.pImmutableSamplers = nullptr;
-	roughnessMapBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-	VkDescriptorSetLayoutBinding metallicMapBinding{};
-	metallicMapBinding.binding = 5;
-	metallicMapBinding.descriptorCount = 1;
-	metallicMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	metallicMapBinding.pImmutableSamplers = nullptr;
-	metallicMapBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-	VkDescriptorSetLayoutBinding aoMapBinding{};
-	aoMapBinding.binding = 6;
-	aoMapBinding.descriptorCount = 1;
-	aoMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	aoMapBinding.pImmutableSamplers = nullptr;
-	aoMapBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-	VkDescriptorSetLayoutBinding albedoMapBinding{};
-	albedoMapBinding.binding = 7;
-	albedoMapBinding.descriptorCount = 1;
-	albedoMapBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	albedoMapBinding.pImmutableSamplers = nullptr;
-	albedoMapBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-	std::array<VkDescriptorSetLayoutBinding, 8> bindings = {
-		vertexUBOLayoutBinding, vertexHeightMapBinding, fragmentUBOLayoutBinding, normalMapBinding, roughnessMapBinding,
-		metallicMapBinding,		aoMapBinding,			albedoMapBinding};
+	VkDescriptorSetLayoutBinding cameraUBOLayoutBinding{};
+	cameraUBOLayoutBinding.binding = 0;
+	cameraUBOLayoutBinding.descriptorCount = 1;
+	cameraUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	cameraUBOLayoutBinding.pImmutableSamplers = nullptr;
+	cameraUBOLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+	VkDescriptorSetLayoutBinding materialSSBOLayoutBinding{};
+	materialSSBOLayoutBinding.binding = 1;
+	materialSSBOLayoutBinding.descriptorCount = 1;
+	materialSSBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	materialSSBOLayoutBinding.pImmutableSamplers = nullptr;
+	materialSSBOLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	VkDescriptorSetLayoutBinding bonesSSBOLayoutBinding{};
+	bonesSSBOLayoutBinding.binding = 2;
+	bonesSSBOLayoutBinding.descriptorCount = 1;
+	bonesSSBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bonesSSBOLayoutBinding.pImmutableSamplers = nullptr;
+	bonesSSBOLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+	std::array<VkDescriptorSetLayoutBinding, 3> bindings = {cameraUBOLayoutBinding, materialSSBOLayoutBinding,
+															bonesSSBOLayoutBinding};
 
 	VkDescriptorSetLayoutCreateInfo layoutInfo{};
 	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
 	layoutInfo.pBindings = bindings.data();
 
+	if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create geometry pass frame descriptor set layout!");
+	}
+}
+
+// set 1: 모든 material 이 공유하는 texture 배열 (material table 의 texture index 로 접근)
+void DescriptorSetLayout::initGeometryPassDescriptorSetLayout()
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	// height map 은 vertex shader 에서도 읽는다.
+	VkDescriptorSetLayoutBinding texturesBinding{};
+	texturesBinding.binding = 0;
+	texturesBinding.descriptorCount = MaterialTable::getTextureCapacity();
+	texturesBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	texturesBinding.pImmutableSamplers = nullptr;
+	texturesBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 1;
+	layoutInfo.pBindings = &texturesBinding;
+
 	if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to create descriptor set layout!");
@@ -166,9 +165,21 @@ void DescriptorSetLayout::initLightingPassDescriptorSetLayout()
 	backgroundBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 	backgroundBinding.pImmutableSamplers = nullptr;
 
-	std::array<VkDescriptorSetLayoutBinding, 8> bindings = {
+	// light 목록, cluster 별 (offset, count), cluster 가 참조하는 light index
+	std::array<VkDescriptorSetLayoutBinding, 3> lightStorageBindings{};
+	for (uint32_t i = 0; i < lightStorageBindings.size(); i++)
+	{
+		lightStorageBindings[i].binding = 8 + i;
+		lightStorageBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		lightStorageBindings[i].descriptorCount = 1;
+		lightStorageBindings[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		lightStorageBindings[i].pImmutableSamplers = nullptr;
+	}
+
+	std::array<VkDescriptorSetLayoutBinding, 11> bindings = {
 		positionAttachmentBinding, normalAttachmentBinding, albedoAttachmentBinding, pbrAttachmentBinding,
-		lightingUBOBinding,		   shadowMapBinding,		shadowCubeMapBinding,	 backgroundBinding};
+		lightingUBOBinding,		   shadowMapBinding,		shadowCubeMapBinding,	 backgroundBinding,
+		lightStorageBindings[0],   lightStorageBindings[1], lightStorageBindings[2]};
 
 	VkDescriptorSetLayoutCreateInfo layoutInfo{};
 	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -197,7 +208,7 @@ void DescriptorSetLayout::initShadowMapDescriptorSetLayout()
 	// Uniform buffer binding for ShadowUniformBufferObject
 	VkDescriptorSetLayoutBinding shadowUBOLayoutBinding{};
 	shadowUBOLayoutBinding.binding = 0; // Matches shader binding
-	shadowUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	shadowUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	shadowUBOLayoutBinding.descriptorCount = 1;
 	shadowUBOLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; // Used in vertex shader
 	shadowUBOLayoutBinding.pImmutableSamplers = nullptr;
@@ -231,14 +242,14 @@ void DescriptorSetLayout::initShadowCubeMapDescriptorSetLayout()
 	// Uniform buffer binding for ShadowUniformBufferObject
 	VkDescriptorSetLayoutBinding shadowUBOLayoutBinding{};
 	shadowUBOLayoutBinding.binding = 0; // Matches shader binding
-	shadowUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	shadowUBOLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	shadowUBOLayoutBinding.descriptorCount = 1;
 	shadowUBOLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; // Used in vertex shader
 	shadowUBOLayoutBinding.pImmutableSamplers = nullptr;
 
 	VkDescriptorSetLayoutBinding layerIndexBinding{};
 	layerIndexBinding.binding = 1;
-	layerIndexBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	layerIndexBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	layerIndexBinding.descriptorCount = 1;
 	layerIndexBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 	layerIndexBinding.pImmutableSamplers = nullptr;
@@ -287,35 +298,36 @@ void DescriptorSetLayout::initViewPortDescriptorSetLayout()
 	}
 }
 
-std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::createSphericalMapDescriptorSetLayout()
+std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::createEnvironmentMapDescriptorSetLayout()
 {
 	std::unique_ptr<DescriptorSetLayout> descriptorSetLayout =
 		std::unique_ptr<DescriptorSetLayout>(new DescriptorSetLayout());
-	descriptorSetLayout->initSphericalMapDescriptorSetLayout();
+	descriptorSetLayout->initEnvironmentMapDescriptorSetLayout();
 	return descriptorSetLayout;
 }
 
-void DescriptorSetLayout::initSphericalMapDescriptorSetLayout()
+void DescriptorSetLayout::initEnvironmentMapDescriptorSetLayout()
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 
-	VkDescriptorSetLayoutBinding sphericalMapUniformBufferBinding{};
-	sphericalMapUniformBufferBinding.binding = 0;
-	sphericalMapUniformBufferBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	sphericalMapUniformBufferBinding.descriptorCount = 1;
-	sphericalMapUniformBufferBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-	sphericalMapUniformBufferBinding.pImmutableSamplers = nullptr;
+	// equirectangular texture 또는 mip 이 있는 environment cube map
+	VkDescriptorSetLayoutBinding sourceBinding{};
+	sourceBinding.binding = 0;
+	sourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	sourceBinding.descriptorCount = 1;
+	sourceBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	sourceBinding.pImmutableSamplers = nullptr;
 
-	VkDescriptorSetLayoutBinding sphericalMapTextureBinding{};
-	sphericalMapTextureBinding.binding = 1;
-	sphericalMapTextureBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	sphericalMapTextureBinding.descriptorCount = 1;
-	sphericalMapTextureBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-	sphericalMapTextureBinding.pImmutableSamplers = nullptr;
+	// 결과를 쓸 cube map 의 mip 하나 (6 layer)
+	VkDescriptorSetLayoutBinding outputBinding{};
+	outputBinding.binding = 1;
+	outputBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	outputBinding.descriptorCount = 1;
+	outputBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	outputBinding.pImmutableSamplers = nullptr;
 
-	std::array<VkDescriptorSetLayoutBinding, 2> bindings = {sphericalMapUniformBufferBinding,
-															sphericalMapTextureBinding};
+	std::array<VkDescriptorSetLayoutBinding, 2> bindings = {sourceBinding, outputBinding};
 
 	VkDescriptorSetLayoutCreateInfo layoutInfo{};
 	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
@@ -324,7 +336,7 @@ void DescriptorSetLayout::initSphericalMapDescriptorSetLayout()
 
 	if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
 	{
-		throw std::runtime_error("failed to create spherical map descriptor set layout!");
+		throw std::runtime_error("failed to create environment map descriptor set layout!");
 	}
 }
 
@@ -368,4 +380,39 @@ void DescriptorSetLayout::initBackgroundDescriptorSetLayout()
 		throw std::runtime_error("failed to create skybox descriptor set layout!");
 	}
 }
+
+std::unique_ptr<DescriptorSetLayout> DescriptorSetLayout::createGpuCullingDescriptorSetLayout()
+{
+	std::unique_ptr<DescriptorSetLayout> descriptorSetLayout =
+		std::unique_ptr<DescriptorSetLayout>(new DescriptorSetLayout());
+	descriptorSetLayout->initGpuCullingDescriptorSetLayout();
+	return descriptorSetLayout;
+}
+
+void DescriptorSetLayout::initGpuCullingDescriptorSetLayout()
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	// 0: cull instance (bounding sphere + batch), 1: 원본 instance, 2: 보이는 instance 출력, 3: indirect command
+	std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
+	for (uint32_t i = 0; i < bindings.size(); i++)
+	{
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		bindings[i].pImmutableSamplers = nullptr;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	layoutInfo.pBindings = bindings.data();
+
+	if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create gpu culling descriptor set layout!");
+	}
+}
 } // namespace ale
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "Renderer/DynamicResolution.h"
+#include "alpch.h"
+
+namespace ale
+{
+// 목표 시간의 이 비율을 겨냥해서 측정 오차로 목표를 넘나드는 것을 줄인다.
+static constexpr float TARGET_HEADROOM = 0.9f;
+// 측정 시간이 목표의 이 비율보다 작을 때만 scale 을 올린다.
+static constexpr float INCREASE_THRESHOLD = 0.75f;
+static constexpr float MAX_INCREASE_STEP = 0.05f;
+static constexpr float MAX_DECREASE_STEP = 0.15f;
+// 이보다 작은 변화는 무시한다. (내부 해상도가 거의 그대로라 이득이 없다)
+static constexpr float MIN_SCALE_CHANGE = 0.02f;
+static constexpr float FILTER_WEIGHT = 0.25f;
+
+void DynamicResolution::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+	m_filteredMs = 0.0f;
+	m_cooldown = 0;
+	if (!enabled)
+	{
+		m_scale = m_maxScale;
+	}
+}
+
+void DynamicResolution::setScaleRange(float minScale, float maxScale)
+{
+	m_minScale = std::clamp(minScale, MIN_SCALE, MAX_SCALE);
+	m_maxScale = std::clamp(maxScale, m_minScale, MAX_SCALE);
+	m_scale = std::clamp(m_scale, m_minScale, m_maxScale);
+}
+
+void DynamicResolution::update(float gpuFrameMs)
+{
+	if (!m_enabled || gpuFrameMs <= 0.0f)
+	{
+		return;
+	}
+
+	// scale 을 바꾸기 전에 기록한 프레임의 결과는 버린다.
+	if (m_cooldown > 0)
+	{
+		m_cooldown--;
+		return;
+	}
+	m_filteredMs = m_filteredMs == 0.0f ? gpuFrameMs : glm::mix(m_filteredMs, gpuFrameMs, FILTER_WEIGHT);
+
+	// pixel 수가 scale^2 에 비례하므로 목표 시간에 맞는 scale 은 sqrt(목표 / 현재) 배
+	float desired = m_scale * std::sqrt(m_targetMs * TARGET_HEADROOM / m_filteredMs);
+	float scale = m_scale;
+	if (m_filteredMs > m_targetMs)
+	{
+		scale = std::max(desired, m_scale - MAX_DECREASE_STEP);
+	}
+	else if (m_filteredMs < m_targetMs * INCREASE_THRESHOLD)
+	{
+		scale = std::min(desired, m_scale + MAX_INCREASE_STEP);
+	}
+	scale = std::clamp(scale, m_minScale, m_maxScale);
+
+	// 범위 끝에 닿는 변화는 작아도 반영한다.
+	bool reachesLimit = scale != m_scale && (scale == m_minScale || scale == m_maxScale);
+	if (std::abs(scale - m_scale) < MIN_SCALE_CHANGE && !reachesLimit)
+	{
+		return;
+	}
+
+	m_scale = scale;
+	m_filteredMs = 0.0f;
+	m_cooldown = m_latencyFrames;
+}
+
+VkExtent2D DynamicResolution::getRenderExtent(VkExtent2D displayExtent)
+{
+	if (m_scale >= 1.0f)
+	{
+		return displayExtent;
+	}
+
+	auto scaleAxis = [this](uint32_t size) {
+		uint32_t scaled = static_cast<uint32_t>(static_cast<float>(size) * m_scale + 0.5f);
+		scaled = (scaled + RENDER_EXTENT_ALIGNMENT - 1) / RENDER_EXTENT_ALIGNMENT * RENDER_EXTENT_ALIGNMENT;
+		return std::clamp(scaled, std::min(size, RENDER_EXTENT_ALIGNMENT), size);
+	};
+	return {scaleAxis(displayExtent.width), scaleAxis(displayExtent.height)};
+}
+
+} // namespace ale
@@ -0,0 +1,534 @@
+#include "Renderer/EnvironmentMap.h"
+#include "alpch.h"
+#include "Renderer/DescriptorSetLayout.h"
+#include "Renderer/Pipeline.h"
+#include "Renderer/ShaderResourceManager.h"
+#include "Renderer/Texture.h"
+#include "Renderer/UploadManager.h"
+#include "Renderer/VulkanUtil.h"
+
+#include "stb/stb_image.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace ale
+{
+static constexpr uint32_t ENVIRONMENT_MAP_MAGIC = 0x564e454c; // "LENV"
+static constexpr uint32_t ENVIRONMENT_MAP_VERSION = 1;
+static constexpr uint32_t TEXEL_SIZE = 8; // R16G16B16A16_SFLOAT
+static constexpr uint32_t MIN_FACE_SIZE = 256;
+static constexpr uint32_t MAX_FACE_SIZE = 1024;
+static constexpr uint32_t PREFILTER_SAMPLE_COUNT = 256;
+static constexpr uint32_t IRRADIANCE_SAMPLE_COUNT = 1024;
+static constexpr uint32_t WORKGROUP_SIZE = 8; // EnvironmentMap.glsl 의 local_size
+// 파일 이름의 ".<key 16자리>.env" 부분
+static constexpr size_t KEY_SUFFIX_LENGTH = 1 + 16 + 4;
+
+static const char *SHADER_DIRECTORY = "./shaders/";
+static const std::array<const char *, 4> BAKE_SHADERS = {"EnvironmentMap.glsl", "EquirectToCube.comp",
+														 "PrefilterEnvironment.comp", "IrradianceMap.comp"};
+
+// mip 하나의 6 face 를 compute shader 가 쓰는 view
+static VkImageView createStorageImageView(VkImage image, uint32_t mipLevel)
+{
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = image;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+	viewInfo.format = EnvironmentMap::FORMAT;
+	viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, mipLevel, 1, 0, 6};
+
+	VkImageView imageView;
+	if (vkCreateImageView(VulkanContext::getContext().getDevice(), &viewInfo, nullptr, &imageView) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create environment map storage image view!");
+	}
+	return imageView;
+}
+
+// 원본 가로 길이는 둘레 4 face 이므로 width / 4 에 가까운 2 의 거듭제곱
+static uint32_t chooseFaceSize(uint32_t sourceWidth)
+{
+	uint32_t faceSize = MIN_FACE_SIZE;
+	while (faceSize < MAX_FACE_SIZE && faceSize * 4 < sourceWidth)
+	{
+		faceSize *= 2;
+	}
+	return faceSize;
+}
+
+std::unique_ptr<EnvironmentMap> EnvironmentMap::createEnvironmentMap(const std::string &path,
+																	 const std::string &cacheDirectory)
+{
+	std::unique_ptr<EnvironmentMap> environmentMap = std::unique_ptr<EnvironmentMap>(new EnvironmentMap());
+	environmentMap->initEnvironmentMap(path, cacheDirectory);
+	return environmentMap;
+}
+
+void EnvironmentMap::cleanup()
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+
+	vkDestroySampler(device, m_sampler, nullptr);
+	vkDestroyImageView(device, m_irradianceImageView, nullptr);
+	vkDestroyImage(device, m_irradianceImage, nullptr);
+	MemoryAllocator::getAllocator().free(m_irradianceImageAllocation);
+	vkDestroyImageView(device, m_specularImageView, nullptr);
+	vkDestroyImage(device, m_specularImage, nullptr);
+	MemoryAllocator::getAllocator().free(m_specularImageAllocation);
+
+	m_sampler = VK_NULL_HANDLE;
+	m_irradianceImageView = VK_NULL_HANDLE;
+	m_irradianceImage = VK_NULL_HANDLE;
+	m_specularImageView = VK_NULL_HANDLE;
+	m_specularImage = VK_NULL_HANDLE;
+}
+
+bool EnvironmentMap::usesShader(const std::string &fileName)
+{
+	return std::find(BAKE_SHADERS.begin(), BAKE_SHADERS.end(), fileName) != BAKE_SHADERS.end();
+}
+
+void EnvironmentMap::initEnvironmentMap(const std::string &path, const std::string &cacheDirectory)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	m_sampler = Texture::createEnvironmentMapSampler();
+
+	// 원본 파일은 key 와 face 크기를 정하는 데만 쓴다. (cache 가 있으면 decode 하지 않는다)
+	std::vector<char> source;
+	std::ifstream file(path, std::ios::binary);
+	if (file.is_open())
+	{
+		source.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	if (source.empty() || !stbi_info_from_memory(reinterpret_cast<const stbi_uc *>(source.data()),
+												 static_cast<int>(source.size()), &width, &height, &channels))
+	{
+		// Texture 가 대신 만드는 기본 texture 로 만들고, cache 는 남기지 않는다.
+		AL_CORE_WARN("EnvironmentMap: could not read {0}", path);
+		source.clear();
+		width = 0;
+	}
+	m_faceSize = chooseFaceSize(static_cast<uint32_t>(width));
+
+	uint64_t key = makeKey(source);
+	char keyString[17];
+	std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(key));
+	std::filesystem::path cachePath = std::filesystem::path(cacheDirectory) /
+									  (std::filesystem::path(path).stem().string() + "." + keyString + ".env");
+
+	m_loadedFromCache = !source.empty() && loadCache(cachePath, key);
+	if (!m_loadedFromCache)
+	{
+		bake(path, source.empty() ? std::filesystem::path() : cachePath, key);
+	}
+
+	m_loadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	AL_CORE_INFO("EnvironmentMap: {0} {1} ({2}x{2}) in {3:.1f} ms", path,
+				 m_loadedFromCache ? "loaded from cache" : "baked", m_faceSize, m_loadMs);
+}
+
+void EnvironmentMap::createImages(VkImageUsageFlags usage)
+{
+	VulkanUtil::createCubeMapImage(m_faceSize, m_faceSize, SPECULAR_MIP_LEVELS, VK_SAMPLE_COUNT_1_BIT, FORMAT,
+								   VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_specularImage,
+								   m_specularImageAllocation);
+	m_specularImageView =
+		VulkanUtil::createCubeMapImageView(m_specularImage, FORMAT, VK_IMAGE_ASPECT_COLOR_BIT, SPECULAR_MIP_LEVELS);
+
+	VulkanUtil::createCubeMapImage(IRRADIANCE_SIZE, IRRADIANCE_SIZE, 1, VK_SAMPLE_COUNT_1_BIT, FORMAT,
+								   VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+								   m_irradianceImage, m_irradianceImageAllocation);
+	m_irradianceImageView = VulkanUtil::createCubeMapImageView(m_irradianceImage, FORMAT, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+}
+
+/*
+	header 가 맞는 cache 파일을 그대로 업로드한다.
+	데이터 전체 hash 를 다시 계산하면 읽는 시간만큼 더 걸리므로 크기만 확인한다.
+	(key 가 파일 이름에도 들어 있어서 다른 원본의 결과와 섞이지 않는다)
+*/
+bool EnvironmentMap::loadCache(const std::filesystem::path &cachePath, uint64_t key)
+{
+	std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	size_t fileSize = static_cast<size_t>(file.tellg());
+	if (fileSize < sizeof(FileHeader))
+	{
+		return false;
+	}
+	file.seekg(0);
+
+	FileHeader header;
+	file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+	VkDeviceSize specularSize = getCubeDataSize(m_faceSize, SPECULAR_MIP_LEVELS);
+	VkDeviceSize irradianceSize = getCubeDataSize(IRRADIANCE_SIZE, 1);
+	if (header.magic != ENVIRONMENT_MAP_MAGIC || header.version != ENVIRONMENT_MAP_VERSION || header.key != key ||
+		header.format != static_cast<uint32_t>(FORMAT) || header.faceSize != m_faceSize ||
+		header.specularMipLevels != SPECULAR_MIP_LEVELS || header.irradianceSize != IRRADIANCE_SIZE)
+	{
+		AL_CORE_INFO("EnvironmentMap: {0} was made with other settings, baking again", cachePath.string());
+		return false;
+	}
+	if (header.dataSize != specularSize + irradianceSize || header.dataSize != fileSize - sizeof(FileHeader))
+	{
+		AL_CORE_WARN("EnvironmentMap: {0} is truncated, baking again", cachePath.string());
+		return false;
+	}
+
+	std::vector<char> data(header.dataSize);
+	file.read(data.data(), header.dataSize);
+	if (!file)
+	{
+		AL_CORE_WARN("EnvironmentMap: could not read {0}, baking again", cachePath.string());
+		return false;
+	}
+
+	createImages(VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+
+	auto &uploadManager = UploadManager::getUploadManager();
+	uploadManager.uploadCubeImage(m_specularImage, data.data(), specularSize, m_faceSize, SPECULAR_MIP_LEVELS,
+								  TEXEL_SIZE);
+	uploadManager.uploadCubeImage(m_irradianceImage, data.data() + specularSize, irradianceSize, IRRADIANCE_SIZE, 1,
+								  TEXEL_SIZE);
+	uploadManager.flush();
+	return true;
+}
+
+/*
+	compute shader 로 specular / irradiance cube 를 만든다. (command buffer 하나, 끝날 때까지 대기)
+	1. equirect texture -> radiance cube mip 0 -> blit 으로 전체 mip chain
+	2. radiance mip 0 을 specular mip 0 으로 복사, specular mip 1 ~ 은 roughness 별 prefilter
+	3. radiance 로 irradiance
+	4. cachePath 가 있으면 결과를 readback 해서 파일로 저장
+*/
+void EnvironmentMap::bake(const std::string &path, const std::filesystem::path &cachePath, uint64_t key)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+	VkCommandPool commandPool = context.getCommandPool();
+	VkQueue graphicsQueue = context.getGraphicsQueue();
+
+	std::shared_ptr<Texture> source = Texture::createTexture(path);
+
+	createImages(VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+				 VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+
+	// prefilter / irradiance 의 입력. sample 이 넓은 영역을 대표할수록 작은 mip 을 읽으므로 전체 mip chain 이 필요하다.
+	uint32_t radianceMipLevels = static_cast<uint32_t>(std::log2(m_faceSize)) + 1;
+	VkImage radianceImage;
+	MemoryAllocation radianceImageAllocation;
+	VulkanUtil::createCubeMapImage(m_faceSize, m_faceSize, radianceMipLevels, VK_SAMPLE_COUNT_1_BIT, FORMAT,
+								   VK_IMAGE_TILING_OPTIMAL,
+								   VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+									   VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+								   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, radianceImage, radianceImageAllocation);
+	VkImageView radianceImageView =
+		VulkanUtil::createCubeMapImageView(radianceImage, FORMAT, VK_IMAGE_ASPECT_COLOR_BIT, radianceMipLevels);
+
+	// dispatch 마다 (입력, 출력 mip) 디스크립터 셋 하나: equirect, prefilter mip 1 ~, irradiance 순서
+	std::vector<VkImageView> sourceImageViews = {source->getImageView()};
+	std::vector<VkImageView> outputImageViews = {createStorageImageView(radianceImage, 0)};
+	for (uint32_t mip = 1; mip < SPECULAR_MIP_LEVELS; mip++)
+	{
+		sourceImageViews.push_back(radianceImageView);
+		outputImageViews.push_back(createStorageImageView(m_specularImage, mip));
+	}
+	sourceImageViews.push_back(radianceImageView);
+	outputImageViews.push_back(createStorageImageView(m_irradianceImage, 0));
+
+	std::unique_ptr<DescriptorSetLayout> descriptorSetLayout =
+		DescriptorSetLayout::createEnvironmentMapDescriptorSetLayout();
+	VkDescriptorSetLayout layout = descriptorSetLayout->getDescriptorSetLayout();
+	std::unique_ptr<ShaderResourceManager> shaderResourceManager =
+		ShaderResourceManager::createEnvironmentMapShaderResourceManager(layout, sourceImageViews, m_sampler,
+																		 outputImageViews);
+	std::vector<VkDescriptorSet> &descriptorSets = shaderResourceManager->getDescriptorSets();
+
+	std::unique_ptr<Pipeline> equirectPipeline = Pipeline::createEnvironmentMapPipeline(layout, "EquirectToCube.comp");
+	std::unique_ptr<Pipeline> prefilterPipeline =
+		Pipeline::createEnvironmentMapPipeline(layout, "PrefilterEnvironment.comp");
+	std::unique_ptr<Pipeline> irradiancePipeline = Pipeline::createEnvironmentMapPipeline(layout, "IrradianceMap.comp");
+
+	VkDeviceSize specularSize = getCubeDataSize(m_faceSize, SPECULAR_MIP_LEVELS);
+	VkDeviceSize irradianceSize = getCubeDataSize(IRRADIANCE_SIZE, 1);
+	std::unique_ptr<ReadbackBuffer> readbackBuffer;
+	if (!cachePath.empty())
+	{
+		readbackBuffer = ReadbackBuffer::createReadbackBuffer(specularSize + irradianceSize);
+	}
+
+	VkCommandBuffer commandBuffer = VulkanUtil::beginSingleTimeCommands(device, commandPool);
+
+	auto dispatch = [&](Pipeline &pipeline, uint32_t setIndex, const EnvironmentMapPushConstants &pushConstants) {
+		VkPipelineLayout pipelineLayout = pipeline.getPipelineLayout();
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.getPipeline());
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1,
+								&descriptorSets[setIndex], 0, nullptr);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+						   &pushConstants);
+		uint32_t groupCount = (pushConstants.faceSize + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+		vkCmdDispatch(commandBuffer, groupCount, groupCount, 6);
+	};
+	auto cubeRange = [](uint32_t baseMipLevel, uint32_t levelCount) {
+		return VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, baseMipLevel, levelCount, 0, 6};
+	};
+
+	// 원본 texture 업로드 (mipmap blit) 는 이 command buffer 보다 먼저 제출되므로 그 쓰기를 compute 에서 보이게 한다.
+	VkMemoryBarrier memoryBarrier{};
+	memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1,
+						 &memoryBarrier, 0, nullptr, 0, nullptr);
+
+	// 1. equirect -> radiance mip 0 -> mip chain
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, radianceImage, 0, VK_ACCESS_SHADER_WRITE_BIT,
+										 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+										 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+										 cubeRange(0, 1));
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, radianceImage, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+										 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+										 cubeRange(1, radianceMipLevels - 1));
+
+	EnvironmentMapPushConstants pushConstants{};
+	pushConstants.faceSize = m_faceSize;
+	pushConstants.sourceFaceSize = static_cast<float>(m_faceSize);
+	dispatch(*equirectPipeline, 0, pushConstants);
+
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, radianceImage, VK_ACCESS_SHADER_WRITE_BIT,
+										 VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+										 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+										 VK_PIPELINE_STAGE_TRANSFER_BIT, cubeRange(0, 1));
+	for (uint32_t mip = 1; mip < radianceMipLevels; mip++)
+	{
+		int32_t srcSize = static_cast<int32_t>(m_faceSize >> (mip - 1));
+		int32_t dstSize = static_cast<int32_t>(m_faceSize >> mip);
+
+		VkImageBlit blit{};
+		blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip - 1, 0, 6};
+		blit.srcOffsets[1] = {srcSize, srcSize, 1};
+		blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 6};
+		blit.dstOffsets[1] = {dstSize, dstSize, 1};
+		vkCmdBlitImage(commandBuffer, radianceImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, radianceImage,
+					   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+		VulkanUtil::insertImageMemoryBarrier(commandBuffer, radianceImage, VK_ACCESS_TRANSFER_WRITE_BIT,
+											 VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+											 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+											 VK_PIPELINE_STAGE_TRANSFER_BIT, cubeRange(mip, 1));
+	}
+
+	// 2. roughness 0 은 거울 반사라 원본을 그대로 복사한다.
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_specularImage, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+										 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+										 cubeRange(0, 1));
+	VkImageCopy copy{};
+	copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 6};
+	copy.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 6};
+	copy.extent = {m_faceSize, m_faceSize, 1};
+	vkCmdCopyImage(commandBuffer, radianceImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_specularImage,
+				   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, radianceImage, VK_ACCESS_TRANSFER_WRITE_BIT,
+										 VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+										 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+										 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, cubeRange(0, radianceMipLevels));
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_specularImage, 0, VK_ACCESS_SHADER_WRITE_BIT,
+										 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+										 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+										 cubeRange(1, SPECULAR_MIP_LEVELS - 1));
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_irradianceImage, 0, VK_ACCESS_SHADER_WRITE_BIT,
+										 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+										 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+										 cubeRange(0, 1));
+
+	for (uint32_t mip = 1; mip < SPECULAR_MIP_LEVELS; mip++)
+	{
+		pushConstants.faceSize = m_faceSize >> mip;
+		pushConstants.roughness = static_cast<float>(mip) / static_cast<float>(SPECULAR_MIP_LEVELS - 1);
+		pushConstants.sampleCount = PREFILTER_SAMPLE_COUNT;
+		dispatch(*prefilterPipeline, mip, pushConstants);
+	}
+
+	// 3. irradiance
+	pushConstants.faceSize = IRRADIANCE_SIZE;
+	pushConstants.roughness = 0.0f;
+	pushConstants.sampleCount = IRRADIANCE_SAMPLE_COUNT;
+	dispatch(*irradiancePipeline, SPECULAR_MIP_LEVELS, pushConstants);
+
+	// 4. readback (cache 파일의 데이터 배치 = uploadCubeImage 의 입력 배치)
+	VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	VkAccessFlags finalAccess = VK_ACCESS_SHADER_READ_BIT;
+	VkPipelineStageFlags finalStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	if (readbackBuffer)
+	{
+		finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		finalAccess = VK_ACCESS_TRANSFER_READ_BIT;
+		finalStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	}
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_specularImage, VK_ACCESS_TRANSFER_WRITE_BIT, finalAccess,
+										 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout,
+										 VK_PIPELINE_STAGE_TRANSFER_BIT, finalStage, cubeRange(0, 1));
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_specularImage, VK_ACCESS_SHADER_WRITE_BIT, finalAccess,
+										 VK_IMAGE_LAYOUT_GENERAL, finalLayout, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+										 finalStage, cubeRange(1, SPECULAR_MIP_LEVELS - 1));
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_irradianceImage, VK_ACCESS_SHADER_WRITE_BIT, finalAccess,
+										 VK_IMAGE_LAYOUT_GENERAL, finalLayout, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+										 finalStage, cubeRange(0, 1));
+
+	if (readbackBuffer)
+	{
+		std::vector<VkBufferImageCopy> regions(SPECULAR_MIP_LEVELS);
+		VkDeviceSize offset = 0;
+		for (uint32_t mip = 0; mip < SPECULAR_MIP_LEVELS; mip++)
+		{
+			uint32_t mipSize = m_faceSize >> mip;
+			regions[mip].bufferOffset = offset;
+			regions[mip].imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 6};
+			regions[mip].imageExtent = {mipSize, mipSize, 1};
+			offset += getCubeDataSize(mipSize, 1);
+		}
+		vkCmdCopyImageToBuffer(commandBuffer, m_specularImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+							   readbackBuffer->getBuffer(), static_cast<uint32_t>(regions.size()), regions.data());
+
+		VkBufferImageCopy irradianceRegion{};
+		irradianceRegion.bufferOffset = specularSize;
+		irradianceRegion.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 6};
+		irradianceRegion.imageExtent = {IRRADIANCE_SIZE, IRRADIANCE_SIZE, 1};
+		vkCmdCopyImageToBuffer(commandBuffer, m_irradianceImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+							   readbackBuffer->getBuffer(), 1, &irradianceRegion);
+
+		VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_specularImage, VK_ACCESS_TRANSFER_READ_BIT,
+											 VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+											 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+											 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, cubeRange(0, SPECULAR_MIP_LEVELS));
+		VulkanUtil::insertImageMemoryBarrier(commandBuffer, m_irradianceImage, VK_ACCESS_TRANSFER_READ_BIT,
+											 VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+											 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+											 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, cubeRange(0, 1));
+
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1,
+							 &memoryBarrier, 0, nullptr, 0, nullptr);
+	}
+
+	// 원본 texture 업로드가 아직 제출되지 않았을 수 있으므로 먼저 제출
+	UploadManager::getUploadManager().flush();
+	VulkanUtil::endSingleTimeCommands(device, graphicsQueue, commandPool, commandBuffer);
+
+	if (readbackBuffer)
+	{
+		saveCache(cachePath, key, readbackBuffer->getData(), specularSize + irradianceSize);
+		readbackBuffer->cleanup();
+	}
+
+	// 전처리에만 쓴 resource 정리
+	equirectPipeline->cleanup();
+	prefilterPipeline->cleanup();
+	irradiancePipeline->cleanup();
+	shaderResourceManager->cleanup();
+	descriptorSetLayout->cleanup();
+	for (VkImageView imageView : outputImageViews)
+	{
+		vkDestroyImageView(device, imageView, nullptr);
+	}
+	vkDestroyImageView(device, radianceImageView, nullptr);
+	vkDestroyImage(device, radianceImage, nullptr);
+	MemoryAllocator::getAllocator().free(radianceImageAllocation);
+	source->cleanup();
+}
+
+void EnvironmentMap::saveCache(const std::filesystem::path &cachePath, uint64_t key, const void *data,
+							   VkDeviceSize dataSize)
+{
+	FileHeader header{};
+	header.magic = ENVIRONMENT_MAP_MAGIC;
+	header.version = ENVIRONMENT_MAP_VERSION;
+	header.key = key;
+	header.format = static_cast<uint32_t>(FORMAT);
+	header.faceSize = m_faceSize;
+	header.specularMipLevels = SPECULAR_MIP_LEVELS;
+	header.irradianceSize = IRRADIANCE_SIZE;
+	header.dataSize = dataSize;
+
+	std::error_code error;
+	std::filesystem::create_directories(cachePath.parent_path(), error);
+
+	// 쓰는 도중 종료되어도 깨진 파일이 남지 않도록 임시 파일에 쓰고 바꿔친다.
+	std::filesystem::path tempPath = cachePath;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			AL_CORE_WARN("EnvironmentMap: could not write {0}", tempPath.string());
+			return;
+		}
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(static_cast<const char *>(data), static_cast<std::streamsize>(dataSize));
+	}
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error)
+	{
+		AL_CORE_WARN("EnvironmentMap: could not replace {0} ({1})", cachePath.string(), error.message());
+		return;
+	}
+
+	// 같은 원본의 이전 결과 (원본이나 shader 가 바뀌기 전 key) 는 다시 쓰이지 않으므로 지운다.
+	std::string fileName = cachePath.filename().string();
+	std::string prefix = fileName.substr(0, fileName.size() - KEY_SUFFIX_LENGTH + 1);
+	for (const auto &entry : std::filesystem::directory_iterator(cachePath.parent_path(), error))
+	{
+		std::string name = entry.path().filename().string();
+		if (name != fileName && name.size() == fileName.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+			entry.path().extension() == ".env")
+		{
+			std::filesystem::remove(entry.path(), error);
+		}
+	}
+}
+
+// 원본 파일 + 전처리 shader source + 결과 형식을 정하는 설정 값
+uint64_t EnvironmentMap::makeKey(const std::vector<char> &source)
+{
+	const uint32_t settings[] = {ENVIRONMENT_MAP_VERSION, static_cast<uint32_t>(FORMAT), SPECULAR_MIP_LEVELS,
+								 IRRADIANCE_SIZE,		  PREFILTER_SAMPLE_COUNT,		 IRRADIANCE_SAMPLE_COUNT,
+								 MIN_FACE_SIZE,			  MAX_FACE_SIZE};
+	uint64_t key = VulkanUtil::hashData(settings, sizeof(settings));
+	key = VulkanUtil::hashData(source.data(), source.size(), key);
+	for (const char *shader : BAKE_SHADERS)
+	{
+		std::vector<char> shaderSource = VulkanUtil::readFile(std::string(SHADER_DIRECTORY) + shader);
+		key = VulkanUtil::hashData(shaderSource.data(), shaderSource.size(), key);
+	}
+	return key;
+}
+
+// mip 마다 6 face 가 이어진 데이터의 크기
+VkDeviceSize EnvironmentMap::getCubeDataSize(uint32_t faceSize, uint32_t mipLevels)
+{
+	VkDeviceSize size = 0;
+	for (uint32_t mip = 0; mip < mipLevels; mip++)
+	{
+		VkDeviceSize mipSize = std::max(faceSize >> mip, 1u);
+		size += mipSize * mipSize * TEXEL_SIZE * 6;
+	}
+	return size;
+}
+
+} // namespace ale
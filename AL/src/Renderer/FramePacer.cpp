@@ -0,0 +1,148 @@
+#include "Renderer/FramePacer.h"
+#include "alpch.h"
+
+#include "Utils/PlatformUtils.h"
+
+#include <thread>
+
+namespace ale
+{
+static constexpr float STATS_WEIGHT = 0.1f;
+static constexpr float SLEEP_WEIGHT = 0.05f;
+static constexpr uint32_t TIMER_RESOLUTION_MS = 1;
+
+void FramePacer::cleanup()
+{
+	setTargetFrameMs(0.0f);
+}
+
+void FramePacer::setTargetFrameMs(float targetMs)
+{
+	m_targetMs = std::max(targetMs, 0.0f);
+
+	// 제한할 때만 OS timer 해상도를 올린다. (전체 시스템의 전력 소모가 늘어난다)
+	bool needed = m_targetMs > 0.0f;
+	if (needed != m_timerResolutionRequested)
+	{
+		if (needed)
+		{
+			TimerResolution::request(TIMER_RESOLUTION_MS);
+		}
+		else
+		{
+			TimerResolution::release(TIMER_RESOLUTION_MS);
+		}
+		m_timerResolutionRequested = needed;
+	}
+}
+
+void FramePacer::waitForNextFrame()
+{
+	Clock::time_point now = Clock::now();
+	if (m_targetMs <= 0.0f)
+	{
+		m_frameStart = now;
+		accumulate(m_stats.pacingSleepMs, 0.0f);
+		return;
+	}
+
+	auto targetDuration = std::chrono::duration<float, std::milli>(m_targetMs);
+	Clock::time_point deadline = m_frameStart + std::chrono::duration_cast<Clock::duration>(targetDuration);
+	if (now >= deadline)
+	{
+		// 이미 늦었으면 밀린 만큼 따라잡지 않고 지금부터 다시 센다.
+		m_frameStart = now;
+		accumulate(m_stats.pacingSleepMs, 0.0f);
+		return;
+	}
+
+	sleepUntil(deadline);
+	// deadline 기준으로 이어가야 sleep 오차가 쌓이지 않는다.
+	m_frameStart = deadline;
+	accumulate(m_stats.pacingSleepMs, toMs(Clock::now() - now));
+}
+
+void FramePacer::markInputSampled()
+{
+	Clock::time_point now = Clock::now();
+	if (m_inputTime != Clock::time_point{})
+	{
+		accumulate(m_stats.frameMs, toMs(now - m_inputTime));
+	}
+	m_inputTime = now;
+}
+
+void FramePacer::onFenceWaited(uint32_t frame, Clock::time_point waitStart)
+{
+	Clock::time_point now = Clock::now();
+	accumulate(m_stats.fenceWaitMs, toMs(now - waitStart));
+
+	FrameRecord &record = m_frames[frame];
+	if (record.pending)
+	{
+		accumulate(m_stats.inputToGpuDoneMs, toMs(now - record.inputTime));
+		record.pending = false;
+	}
+}
+
+void FramePacer::onSubmit(uint32_t frame)
+{
+	FrameRecord &record = m_frames[frame];
+	record.inputTime = m_inputTime;
+	record.pending = true;
+	accumulate(m_stats.inputToSubmitMs, toMs(Clock::now() - record.inputTime));
+}
+
+void FramePacer::onPresent(uint32_t frame)
+{
+	accumulate(m_stats.inputToPresentMs, toMs(Clock::now() - m_frames[frame].inputTime));
+}
+
+void FramePacer::resetFrames()
+{
+	for (FrameRecord &record : m_frames)
+	{
+		record.pending = false;
+	}
+}
+
+/*
+	남은 시간이 sleep 한 번의 예상 시간 (평균 + 표준편차) 보다 길면 sleep(1ms) 를 반복하고,
+	실제로 걸린 시간으로 추정을 갱신한다. 나머지는 yield 하면서 deadline 까지 기다린다.
+*/
+void FramePacer::sleepUntil(Clock::time_point deadline)
+{
+	while (true)
+	{
+		Clock::time_point start = Clock::now();
+		float estimateMs = m_sleepMeanMs + std::sqrt(m_sleepVariance);
+		if (toMs(deadline - start) <= estimateMs)
+		{
+			break;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(TIMER_RESOLUTION_MS));
+
+		float observedMs = toMs(Clock::now() - start);
+		float delta = observedMs - m_sleepMeanMs;
+		m_sleepMeanMs += SLEEP_WEIGHT * delta;
+		m_sleepVariance = (1.0f - SLEEP_WEIGHT) * (m_sleepVariance + SLEEP_WEIGHT * delta * delta);
+	}
+
+	while (Clock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void FramePacer::accumulate(float &average, float sampleMs)
+{
+	average = average == 0.0f ? sampleMs : glm::mix(average, sampleMs, STATS_WEIGHT);
+}
+
+float FramePacer::toMs(Clock::duration duration)
+{
+	return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+} // namespace ale
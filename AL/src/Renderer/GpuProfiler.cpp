@@ -0,0 +1,199 @@
+#include "Renderer/GpuProfiler.h"
+#include "alpch.h"
+
+namespace ale
+{
+std::unique_ptr<GpuProfiler> GpuProfiler::createGpuProfiler()
+{
+	std::unique_ptr<GpuProfiler> gpuProfiler = std::unique_ptr<GpuProfiler>(new GpuProfiler());
+	gpuProfiler->initGpuProfiler();
+	return gpuProfiler;
+}
+
+void GpuProfiler::initGpuProfiler()
+{
+	auto &context = VulkanContext::getContext();
+	VkPhysicalDevice physicalDevice = context.getPhysicalDevice();
+	VkDevice device = context.getDevice();
+
+	// graphics queue 가 timestamp 를 지원하지 않으면 profiler 는 아무것도 기록하지 않는다.
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	uint32_t validBits = queueFamilies[context.getQueueFamily()].timestampValidBits;
+	if (validBits == 0)
+	{
+		AL_CORE_WARN("GpuProfiler: graphics queue does not support timestamps");
+		return;
+	}
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	m_timestampPeriod = properties.limits.timestampPeriod;
+	m_timestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t(1) << validBits) - 1;
+
+	VkQueryPoolCreateInfo queryPoolInfo{};
+	queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolInfo.queryCount = MAX_SCOPES * 2;
+	for (auto &frameQueries : m_frames)
+	{
+		if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &frameQueries.queryPool) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create timestamp query pool!");
+		}
+	}
+	m_queryResults.resize(MAX_SCOPES * 2);
+	m_supported = true;
+}
+
+void GpuProfiler::cleanup()
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+	for (auto &frameQueries : m_frames)
+	{
+		if (frameQueries.queryPool != VK_NULL_HANDLE)
+		{
+			vkDestroyQueryPool(device, frameQueries.queryPool, nullptr);
+			frameQueries.queryPool = VK_NULL_HANDLE;
+		}
+	}
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+	if (!m_supported)
+	{
+		return;
+	}
+
+	m_currentFrame = frame;
+	FrameQueries &frameQueries = m_frames[frame];
+	readResults(frameQueries);
+
+	vkCmdResetQueryPool(commandBuffer, frameQueries.queryPool, 0, MAX_SCOPES * 2);
+}
+
+void GpuProfiler::endFrame(uint32_t frame)
+{
+	m_frames[frame].submitTime = std::chrono::steady_clock::now();
+}
+
+void GpuProfiler::resetFrames()
+{
+	for (FrameQueries &frameQueries : m_frames)
+	{
+		frameQueries.scopes.clear();
+	}
+}
+
+uint32_t GpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char *name)
+{
+	FrameQueries &frameQueries = m_frames[m_currentFrame];
+	if (!m_supported || frameQueries.scopes.size() == MAX_SCOPES)
+	{
+		return UINT32_MAX;
+	}
+
+	uint32_t scope = static_cast<uint32_t>(frameQueries.scopes.size());
+	frameQueries.scopes.push_back({name, getTimingIndex(name)});
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frameQueries.queryPool, scope * 2);
+	return scope;
+}
+
+void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scope)
+{
+	if (scope == UINT32_MAX)
+	{
+		return;
+	}
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_frames[m_currentFrame].queryPool,
+						scope * 2 + 1);
+}
+
+/*
+	fence 를 기다린 뒤이므로 query 는 모두 끝나 있다. (WAIT 없이 읽어도 stall 이 없다)
+	GPU timestamp 와 CPU 시계는 기준이 다르므로, trace 에는 프레임의 첫 timestamp 를 submit 시각에 맞춰서 기록한다.
+*/
+void GpuProfiler::readResults(FrameQueries &frameQueries)
+{
+	uint32_t scopeCount = static_cast<uint32_t>(frameQueries.scopes.size());
+	if (scopeCount == 0)
+	{
+		return;
+	}
+
+	VkDevice device = VulkanContext::getContext().getDevice();
+	VkResult result = vkGetQueryPoolResults(device, frameQueries.queryPool, 0, scopeCount * 2,
+											sizeof(uint64_t) * scopeCount * 2, m_queryResults.data(), sizeof(uint64_t),
+											VK_QUERY_RESULT_64_BIT);
+	std::vector<Scope> scopes = std::move(frameQueries.scopes);
+	frameQueries.scopes.clear();
+	if (result != VK_SUCCESS)
+	{
+		return;
+	}
+
+	std::vector<float> samples(m_timings.size(), 0.0f);
+	uint64_t frameStart = m_queryResults[0] & m_timestampMask;
+	uint64_t frameEnd = 0;
+	bool tracing = Instrumentor::get().isSessionActive();
+	FloatingPointMicroseconds submitTime{frameQueries.submitTime.time_since_epoch()};
+	for (uint32_t i = 0; i < scopeCount; i++)
+	{
+		uint64_t begin = m_queryResults[i * 2] & m_timestampMask;
+		uint64_t end = m_queryResults[i * 2 + 1] & m_timestampMask;
+		double durationNs = static_cast<double>((end - begin) & m_timestampMask) * m_timestampPeriod;
+		samples[scopes[i].timingIndex] += static_cast<float>(durationNs / 1000000.0);
+		frameEnd = std::max(frameEnd, (end - frameStart) & m_timestampMask);
+
+		if (tracing)
+		{
+			double offsetNs = static_cast<double>((begin - frameStart) & m_timestampMask) * m_timestampPeriod;
+			Instrumentor::get().writeGpuProfile(scopes[i].name,
+												submitTime + FloatingPointMicroseconds(offsetNs / 1000.0),
+												FloatingPointMicroseconds(durationNs / 1000.0));
+		}
+	}
+
+	m_frameMs = static_cast<float>(static_cast<double>(frameEnd) * m_timestampPeriod / 1000000.0);
+
+	// 이번 프레임에 없던 pass 는 0 ms 로 평균에 들어간다.
+	m_totalMs = 0.0f;
+	m_historyCount = std::min(m_historyCount + 1, HISTORY_SIZE);
+	for (size_t i = 0; i < m_timings.size(); i++)
+	{
+		m_history[i][m_historyIndex] = samples[i];
+
+		float sum = 0.0f;
+		for (uint32_t j = 0; j < m_historyCount; j++)
+		{
+			sum += m_history[i][j];
+		}
+		m_timings[i].lastMs = samples[i];
+		m_timings[i].averageMs = sum / m_historyCount;
+		m_totalMs += m_timings[i].averageMs;
+	}
+	m_historyIndex = (m_historyIndex + 1) % HISTORY_SIZE;
+}
+
+uint32_t GpuProfiler::getTimingIndex(const char *name)
+{
+	for (uint32_t i = 0; i < m_timings.size(); i++)
+	{
+		if (m_timings[i].name == name)
+		{
+			return i;
+		}
+	}
+
+	GpuTiming timing;
+	timing.name = name;
+	m_timings.push_back(timing);
+	m_history.emplace_back();
+	m_history.back().fill(0.0f);
+	return static_cast<uint32_t>(m_timings.size() - 1);
+}
+
+} // namespace ale
@@ -0,0 +1,186 @@
+#include "Renderer/LightCluster.h"
+#include "alpch.h"
+#include "Core/JobSystem.h"
+
+namespace ale
+{
+// LightingPass.frag 의 point / spot light 감쇠 계수
+static constexpr float ATTENUATION_LINEAR = 0.09f;
+static constexpr float ATTENUATION_QUADRATIC = 0.032f;
+
+float LightCluster::computeLightRange(const Light &light)
+{
+	// intensity * color * 1 / (1 + linear * d + quadratic * d^2) == LIGHT_CUTOFF 인 거리
+	float brightness = light.intensity * std::max(light.color.r, std::max(light.color.g, light.color.b));
+	if (brightness <= LIGHT_CUTOFF)
+	{
+		return 0.0f;
+	}
+
+	float c = 1.0f - brightness / LIGHT_CUTOFF;
+	float discriminant = ATTENUATION_LINEAR * ATTENUATION_LINEAR - 4.0f * ATTENUATION_QUADRATIC * c;
+	return (-ATTENUATION_LINEAR + std::sqrt(discriminant)) / (2.0f * ATTENUATION_QUADRATIC);
+}
+
+void LightCluster::build(const std::vector<Light> &lights, uint32_t globalLightCount, const glm::mat4 &view,
+						 const glm::mat4 &projection, const glm::vec2 &viewportSize)
+{
+	if (projection != m_projection || viewportSize != m_viewportSize)
+	{
+		buildClusterBounds(projection, viewportSize);
+	}
+
+	// light 를 view space 로 옮기고 걸치는 depth slice 에만 후보로 넣는다.
+	m_viewLights.resize(lights.size());
+	m_sliceLights.resize(GRID_Z);
+	for (auto &sliceLights : m_sliceLights)
+	{
+		sliceLights.clear();
+	}
+
+	for (uint32_t i = globalLightCount; i < lights.size(); i++)
+	{
+		const Light &light = lights[i];
+		if (light.range <= 0.0f)
+		{
+			continue;
+		}
+
+		glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+		m_viewLights[i] = glm::vec4(center, light.range);
+
+		float depthMin = -center.z - light.range;
+		float depthMax = -center.z + light.range;
+		if (depthMax < m_near || depthMin > m_far)
+		{
+			continue;
+		}
+
+		uint32_t lastSlice = getSlice(depthMax);
+		for (uint32_t z = getSlice(depthMin); z <= lastSlice; z++)
+		{
+			m_sliceLights[z].push_back(i);
+		}
+	}
+
+	// slice 마다 tile 의 AABB 와 구 겹침 검사 (slice 끼리는 쓰는 곳이 겹치지 않는다)
+	constexpr uint32_t tileCount = GRID_X * GRID_Y;
+	m_sliceIndices.resize(GRID_Z);
+	m_clusters.resize(CLUSTER_COUNT);
+	JobSystem::parallelFor(GRID_Z, 1, [this](uint32_t begin, uint32_t end) {
+		for (uint32_t z = begin; z < end; z++)
+		{
+			std::vector<uint32_t> &indices = m_sliceIndices[z];
+			indices.clear();
+			for (uint32_t tile = 0; tile < tileCount; tile++)
+			{
+				uint32_t cluster = tile + z * tileCount;
+				LightClusterRange &range = m_clusters[cluster];
+				range.offset = static_cast<uint32_t>(indices.size());
+				for (uint32_t lightIndex : m_sliceLights[z])
+				{
+					const glm::vec4 &light = m_viewLights[lightIndex];
+					glm::vec3 closest = glm::clamp(glm::vec3(light), m_clusterMin[cluster], m_clusterMax[cluster]);
+					glm::vec3 diff = closest - glm::vec3(light);
+					if (glm::dot(diff, diff) <= light.w * light.w)
+					{
+						indices.push_back(lightIndex);
+					}
+				}
+				range.count = static_cast<uint32_t>(indices.size()) - range.offset;
+			}
+		}
+	});
+
+	// slice 별 결과를 이어 붙이고 offset 을 전체 index 목록 기준으로 바꾼다.
+	m_lightIndices.clear();
+	for (uint32_t z = 0; z < GRID_Z; z++)
+	{
+		uint32_t base = static_cast<uint32_t>(m_lightIndices.size());
+		for (uint32_t tile = 0; tile < tileCount; tile++)
+		{
+			m_clusters[tile + z * tileCount].offset += base;
+		}
+		m_lightIndices.insert(m_lightIndices.end(), m_sliceIndices[z].begin(), m_sliceIndices[z].end());
+	}
+}
+
+/*
+	tile 의 네 모서리를 지나는 시선(near ~ far)을 slice 의 앞 / 뒤 depth 평면과 교차시킨 8개 점으로 AABB 를 만든다.
+	perspective / orthographic 모두 같은 방식으로 계산된다.
+*/
+void LightCluster::buildClusterBounds(const glm::mat4 &projection, const glm::vec2 &viewportSize)
+{
+	m_projection = projection;
+	m_viewportSize = viewportSize;
+
+	glm::mat4 inverseProjection = glm::inverse(projection);
+	auto unproject = [&inverseProjection](float x, float y, float z) {
+		glm::vec4 position = inverseProjection * glm::vec4(x, y, z, 1.0f);
+		return glm::vec3(position) / position.w;
+	};
+
+	m_near = std::max(-unproject(0.0f, 0.0f, 0.0f).z, 0.01f);
+	m_far = std::max(-unproject(0.0f, 0.0f, 1.0f).z, m_near * 2.0f);
+	float logRatio = std::log(m_far / m_near);
+	m_sliceScale = GRID_Z / logRatio;
+	m_sliceBias = -(GRID_Z * std::log(m_near)) / logRatio;
+
+	float sliceDepths[GRID_Z + 1];
+	for (uint32_t z = 0; z <= GRID_Z; z++)
+	{
+		sliceDepths[z] = m_near * std::pow(m_far / m_near, static_cast<float>(z) / GRID_Z);
+	}
+
+	m_clusterMin.resize(CLUSTER_COUNT);
+	m_clusterMax.resize(CLUSTER_COUNT);
+	for (uint32_t y = 0; y < GRID_Y; y++)
+	{
+		for (uint32_t x = 0; x < GRID_X; x++)
+		{
+			glm::vec3 nearCorners[4];
+			glm::vec3 farCorners[4];
+			for (uint32_t corner = 0; corner < 4; corner++)
+			{
+				float ndcX = -1.0f + 2.0f * static_cast<float>(x + (corner & 1)) / GRID_X;
+				float ndcY = -1.0f + 2.0f * static_cast<float>(y + (corner >> 1)) / GRID_Y;
+				nearCorners[corner] = unproject(ndcX, ndcY, 0.0f);
+				farCorners[corner] = unproject(ndcX, ndcY, 1.0f);
+			}
+
+			for (uint32_t z = 0; z < GRID_Z; z++)
+			{
+				glm::vec3 minPoint(std::numeric_limits<float>::max());
+				glm::vec3 maxPoint(std::numeric_limits<float>::lowest());
+				for (uint32_t corner = 0; corner < 4; corner++)
+				{
+					glm::vec3 ray = farCorners[corner] - nearCorners[corner];
+					for (float depth : {sliceDepths[z], sliceDepths[z + 1]})
+					{
+						float t = (-depth - nearCorners[corner].z) / ray.z;
+						glm::vec3 point = nearCorners[corner] + ray * t;
+						minPoint = glm::min(minPoint, point);
+						maxPoint = glm::max(maxPoint, point);
+					}
+				}
+
+				uint32_t cluster = x + y * GRID_X + z * GRID_X * GRID_Y;
+				m_clusterMin[cluster] = minPoint;
+				m_clusterMax[cluster] = maxPoint;
+			}
+		}
+	}
+}
+
+uint32_t LightCluster::getSlice(float depth) const
+{
+	if (depth <= m_near)
+	{
+		return 0;
+	}
+
+	int32_t slice = static_cast<int32_t>(std::floor(std::log(depth) * m_sliceScale + m_sliceBias));
+	return static_cast<uint32_t>(std::clamp(slice, 0, static_cast<int32_t>(GRID_Z) - 1));
+}
+
+} // namespace ale
@@ -0,0 +1,186 @@
+#include "Renderer/MaterialTable.h"
+#include "alpch.h"
+
+namespace ale
+{
+std::unique_ptr<MaterialTable> MaterialTable::createMaterialTable(VkDescriptorSetLayout descriptorSetLayout)
+{
+	std::unique_ptr<MaterialTable> materialTable = std::unique_ptr<MaterialTable>(new MaterialTable());
+	materialTable->initMaterialTable(descriptorSetLayout);
+	return materialTable;
+}
+
+uint32_t MaterialTable::getTextureCapacity()
+{
+	auto &context = VulkanContext::getContext();
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(context.getPhysicalDevice(), &properties);
+
+	const VkPhysicalDeviceLimits &limits = properties.limits;
+	return std::min({MAX_MATERIAL_TEXTURES, limits.maxPerStageDescriptorSamplers,
+					 limits.maxPerStageDescriptorSampledImages, limits.maxDescriptorSetSamplers,
+					 limits.maxDescriptorSetSampledImages});
+}
+
+void MaterialTable::initMaterialTable(VkDescriptorSetLayout descriptorSetLayout)
+{
+	m_capacity = getTextureCapacity();
+	m_defaultTexture = Texture::createDefaultTexture(glm::vec4(1.0f));
+	m_shaderResourceManager = ShaderResourceManager::createTextureArrayShaderResourceManager(
+		descriptorSetLayout, m_capacity, m_defaultTexture->getImageView(), m_defaultTexture->getSampler());
+
+	// 0 번 slot 은 기본 texture 로 고정
+	m_slotTextures.resize(m_capacity);
+	m_slotTextures[0] = m_defaultTexture;
+	m_textureSlots[m_defaultTexture.get()] = 0;
+	for (uint32_t slot = m_capacity - 1; slot > 0; slot--)
+	{
+		m_freeSlots.push_back(slot);
+	}
+}
+
+void MaterialTable::cleanup()
+{
+	m_shaderResourceManager->cleanup();
+	m_defaultTexture->cleanup();
+	m_textureSlots.clear();
+	m_slotTextures.clear();
+	m_freeSlots.clear();
+	m_materialData.clear();
+}
+
+void MaterialTable::update(uint32_t frame, const std::vector<Material *> &materials)
+{
+	// 사라진 texture 의 slot 은 셋을 bind 하기 전에 기본 texture 로 되돌린다. (PARTIALLY_BOUND 가 없는 Vulkan 1.0 에서는
+	// 파괴된 image view 를 가리키는 셋을 bind 하면 안 된다)
+	releaseExpiredSlots();
+
+	m_materialData.resize(materials.size());
+	for (size_t i = 0; i < materials.size(); i++)
+	{
+		Material *material = materials[i];
+		MaterialData &data = m_materialData[i];
+
+		data.albedoValue = glm::vec4(material->getAlbedo().albedo, 1.0f);
+		data.roughnessValue = material->getRoughness().roughness;
+		data.metallicValue = material->getMetallic().metallic;
+		data.aoValue = material->getAOMap().ao;
+		data.heightScale = 0.1f;
+
+		data.albedoTexture = acquireTextureSlot(material->getAlbedo().albedoTexture);
+		data.normalTexture = acquireTextureSlot(material->getNormalMap().normalTexture);
+		data.roughnessTexture = acquireTextureSlot(material->getRoughness().roughnessTexture);
+		data.metallicTexture = acquireTextureSlot(material->getMetallic().metallicTexture);
+		data.aoTexture = acquireTextureSlot(material->getAOMap().aoTexture);
+		data.heightTexture = acquireTextureSlot(material->getHeightMap().heightTexture);
+
+		data.flags = 0;
+		data.flags |= material->getAlbedo().flag ? MATERIAL_ALBEDO_FLAG : 0;
+		data.flags |= material->getNormalMap().flag ? MATERIAL_NORMAL_FLAG : 0;
+		data.flags |= material->getRoughness().flag ? MATERIAL_ROUGHNESS_FLAG : 0;
+		data.flags |= material->getMetallic().flag ? MATERIAL_METALLIC_FLAG : 0;
+		data.flags |= material->getAOMap().flag ? MATERIAL_AO_FLAG : 0;
+		data.flags |= material->getHeightMap().flag ? MATERIAL_HEIGHT_FLAG : 0;
+		data.padding = 0;
+	}
+
+	// 이 프레임 셋에 밀린 slot 을 쓴다. (다른 프레임 셋은 GPU 가 아직 읽고 있을 수 있다)
+	std::vector<uint32_t> &pendingSlots = m_pendingSlots[frame];
+	for (uint32_t slot : pendingSlots)
+	{
+		std::shared_ptr<Texture> texture = m_slotTextures[slot].lock();
+		if (!texture)
+		{
+			texture = m_defaultTexture;
+		}
+		m_shaderResourceManager->updateTextureArrayDescriptorSet(frame, slot, texture->getImageView(),
+																 texture->getSampler());
+	}
+	pendingSlots.clear();
+}
+
+void MaterialTable::setFrameCount(uint32_t frameCount)
+{
+	uint32_t previousCount = m_frameCount;
+	m_frameCount = std::clamp(frameCount, 1u, static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT));
+
+	// 쉬는 동안 바뀐 slot 을 모르므로 새로 쓰게 된 프레임 셋은 모든 slot 을 다시 쓰고, 쓰지 않게 된 셋의 목록은 비운다.
+	for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; frame++)
+	{
+		std::vector<uint32_t> &pendingSlots = m_pendingSlots[frame];
+		pendingSlots.clear();
+		if (frame >= previousCount && frame < m_frameCount)
+		{
+			for (uint32_t slot = 0; slot < m_capacity; slot++)
+			{
+				pendingSlots.push_back(slot);
+			}
+		}
+	}
+}
+
+uint32_t MaterialTable::acquireTextureSlot(const std::shared_ptr<Texture> &texture)
+{
+	if (!texture)
+	{
+		return 0;
+	}
+
+	auto it = m_textureSlots.find(texture.get());
+	if (it != m_textureSlots.end())
+	{
+		// 만료된 texture 의 주소를 새 texture 가 받은 경우 slot 은 그대로 두고 내용만 바꾼다.
+		if (m_slotTextures[it->second].lock() != texture)
+		{
+			assignTextureSlot(it->second, texture);
+		}
+		return it->second;
+	}
+
+	if (m_freeSlots.empty())
+	{
+		if (!m_capacityWarned)
+		{
+			AL_CORE_WARN("MaterialTable: texture array is full ({0} slots), falling back to the default texture",
+						 m_capacity);
+			m_capacityWarned = true;
+		}
+		return 0;
+	}
+
+	uint32_t slot = m_freeSlots.back();
+	m_freeSlots.pop_back();
+	m_textureSlots[texture.get()] = slot;
+	assignTextureSlot(slot, texture);
+	return slot;
+}
+
+void MaterialTable::assignTextureSlot(uint32_t slot, const std::shared_ptr<Texture> &texture)
+{
+	m_slotTextures[slot] = texture;
+	for (uint32_t frame = 0; frame < m_frameCount; frame++)
+	{
+		m_pendingSlots[frame].push_back(slot);
+	}
+}
+
+// 더 이상 아무 material 도 들고 있지 않은 texture 의 slot 을 기본 texture 로 되돌리고 free list 에 넣는다.
+void MaterialTable::releaseExpiredSlots()
+{
+	for (auto it = m_textureSlots.begin(); it != m_textureSlots.end();)
+	{
+		uint32_t slot = it->second;
+		if (slot != 0 && m_slotTextures[slot].expired())
+		{
+			assignTextureSlot(slot, nullptr);
+			m_freeSlots.push_back(slot);
+			it = m_textureSlots.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+} // namespace ale
@@ -0,0 +1,666 @@
+#include "Renderer/MemoryAllocator.h"
+#include "alpch.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ale
+{
+static constexpr VkDeviceSize DEVICE_LOCAL_BLOCK_SIZE = 64ull * 1024 * 1024;
+static constexpr VkDeviceSize HOST_VISIBLE_BLOCK_SIZE = 16ull * 1024 * 1024;
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+static uint32_t findLowestBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return static_cast<uint32_t>(index);
+#else
+	return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+static uint32_t findHighestBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return static_cast<uint32_t>(index);
+#else
+	return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+MemoryBlock::MemoryBlock(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, uint32_t heapIndex,
+						 AllocationStrategy strategy, void *mappedData)
+	: m_memory(memory), m_size(size), m_memoryTypeIndex(memoryTypeIndex), m_heapIndex(heapIndex),
+	  m_strategy(strategy), m_mappedData(mappedData)
+{
+	if (m_strategy == AllocationStrategy::GENERAL)
+	{
+		for (auto &heads : m_freeHeads)
+		{
+			std::fill(std::begin(heads), std::end(heads), NULL_RANGE);
+		}
+		insertFreeRange(createRange(0, m_size, NULL_RANGE, NULL_RANGE));
+	}
+}
+
+bool MemoryBlock::allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset)
+{
+	if (m_strategy == AllocationStrategy::LINEAR)
+	{
+		VkDeviceSize alignedOffset = alignUp(m_linearOffset, alignment);
+		if (alignedOffset + size > m_size)
+		{
+			return false;
+		}
+		offset = alignedOffset;
+		m_linearOffset = alignedOffset + size;
+		m_usedSize += size;
+		m_allocationCount++;
+		return true;
+	}
+
+	uint32_t index = findFreeRange(size, alignment);
+	if (index == NULL_RANGE)
+	{
+		return false;
+	}
+	removeFreeRange(index);
+
+	// 정렬로 생긴 앞쪽 틈은 따로 빈 구간으로 둔다. (앞 구간은 빈 구간끼리 항상 합쳐져 있으므로 사용 중이다)
+	VkDeviceSize alignedOffset = alignUp(m_ranges[index].offset, alignment);
+	if (alignedOffset > m_ranges[index].offset)
+	{
+		VkDeviceSize gapSize = alignedOffset - m_ranges[index].offset;
+		uint32_t prev = m_ranges[index].prevPhysical;
+		uint32_t gap = createRange(m_ranges[index].offset, gapSize, prev, index);
+		if (prev != NULL_RANGE)
+		{
+			m_ranges[prev].nextPhysical = gap;
+		}
+		m_ranges[index].prevPhysical = gap;
+		m_ranges[index].offset = alignedOffset;
+		m_ranges[index].size -= gapSize;
+		insertFreeRange(gap);
+	}
+
+	// 남은 뒤쪽도 빈 구간으로 돌려준다.
+	if (m_ranges[index].size > size)
+	{
+		uint32_t next = m_ranges[index].nextPhysical;
+		uint32_t rest = createRange(alignedOffset + size, m_ranges[index].size - size, index, next);
+		if (next != NULL_RANGE)
+		{
+			m_ranges[next].prevPhysical = rest;
+		}
+		m_ranges[index].nextPhysical = rest;
+		m_ranges[index].size = size;
+		insertFreeRange(rest);
+	}
+
+	m_allocatedRanges[alignedOffset] = index;
+	offset = alignedOffset;
+	m_usedSize += size;
+	m_allocationCount++;
+	return true;
+}
+
+void MemoryBlock::free(VkDeviceSize offset, VkDeviceSize size)
+{
+	m_usedSize -= size;
+	m_allocationCount--;
+
+	if (m_strategy == AllocationStrategy::LINEAR)
+	{
+		// 모든 할당이 해제되면 처음부터 다시 쓴다.
+		if (m_allocationCount == 0)
+		{
+			m_linearOffset = 0;
+		}
+		return;
+	}
+
+	auto allocated = m_allocatedRanges.find(offset);
+	uint32_t index = allocated->second;
+	m_allocatedRanges.erase(allocated);
+
+	// 앞쪽 빈 구간과 합치기
+	uint32_t prev = m_ranges[index].prevPhysical;
+	if (prev != NULL_RANGE && m_ranges[prev].free)
+	{
+		removeFreeRange(prev);
+		uint32_t next = m_ranges[index].nextPhysical;
+		m_ranges[prev].size += m_ranges[index].size;
+		m_ranges[prev].nextPhysical = next;
+		if (next != NULL_RANGE)
+		{
+			m_ranges[next].prevPhysical = prev;
+		}
+		destroyRange(index);
+		index = prev;
+	}
+
+	// 뒤쪽 빈 구간과 합치기
+	uint32_t next = m_ranges[index].nextPhysical;
+	if (next != NULL_RANGE && m_ranges[next].free)
+	{
+		removeFreeRange(next);
+		uint32_t afterNext = m_ranges[next].nextPhysical;
+		m_ranges[index].size += m_ranges[next].size;
+		m_ranges[index].nextPhysical = afterNext;
+		if (afterNext != NULL_RANGE)
+		{
+			m_ranges[afterNext].prevPhysical = index;
+		}
+		destroyRange(next);
+	}
+
+	insertFreeRange(index);
+}
+
+VkDeviceSize MemoryBlock::getLargestFreeRange() const
+{
+	if (m_strategy == AllocationStrategy::LINEAR)
+	{
+		return m_size - m_linearOffset;
+	}
+	if (m_flBitmap == 0)
+	{
+		return 0;
+	}
+
+	// 가장 큰 크기 class 의 목록만 보면 된다.
+	uint32_t fl = findHighestBit(m_flBitmap);
+	uint32_t sl = findHighestBit(m_slBitmaps[fl]);
+	VkDeviceSize largest = 0;
+	for (uint32_t index = m_freeHeads[fl][sl]; index != NULL_RANGE; index = m_ranges[index].nextFree)
+	{
+		largest = std::max(largest, m_ranges[index].size);
+	}
+	return largest;
+}
+
+// 작은 크기는 fl 0 에 1 byte 단위로, 나머지는 [2^n, 2^(n+1)) 을 SL_COUNT 등분한 class 에 넣는다.
+void MemoryBlock::mapSize(VkDeviceSize size, uint32_t &fl, uint32_t &sl)
+{
+	if (size < SL_COUNT)
+	{
+		fl = 0;
+		sl = static_cast<uint32_t>(size);
+		return;
+	}
+
+	uint32_t highestBit = findHighestBit(size);
+	fl = highestBit - SL_BITS + 1;
+	sl = static_cast<uint32_t>(size >> (highestBit - SL_BITS)) - SL_COUNT;
+}
+
+uint32_t MemoryBlock::createRange(VkDeviceSize offset, VkDeviceSize size, uint32_t prevPhysical, uint32_t nextPhysical)
+{
+	uint32_t index;
+	if (!m_unusedRanges.empty())
+	{
+		index = m_unusedRanges.back();
+		m_unusedRanges.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(m_ranges.size());
+		m_ranges.emplace_back();
+	}
+
+	Range &range = m_ranges[index];
+	range.offset = offset;
+	range.size = size;
+	range.prevPhysical = prevPhysical;
+	range.nextPhysical = nextPhysical;
+	range.prevFree = NULL_RANGE;
+	range.nextFree = NULL_RANGE;
+	range.free = false;
+	return index;
+}
+
+void MemoryBlock::destroyRange(uint32_t index)
+{
+	m_unusedRanges.push_back(index);
+}
+
+void MemoryBlock::insertFreeRange(uint32_t index)
+{
+	uint32_t fl, sl;
+	mapSize(m_ranges[index].size, fl, sl);
+
+	uint32_t head = m_freeHeads[fl][sl];
+	m_ranges[index].free = true;
+	m_ranges[index].prevFree = NULL_RANGE;
+	m_ranges[index].nextFree = head;
+	if (head != NULL_RANGE)
+	{
+		m_ranges[head].prevFree = index;
+	}
+	m_freeHeads[fl][sl] = index;
+	m_slBitmaps[fl] |= 1u << sl;
+	m_flBitmap |= 1ull << fl;
+}
+
+void MemoryBlock::removeFreeRange(uint32_t index)
+{
+	uint32_t fl, sl;
+	mapSize(m_ranges[index].size, fl, sl);
+
+	Range &range = m_ranges[index];
+	if (range.prevFree != NULL_RANGE)
+	{
+		m_ranges[range.prevFree].nextFree = range.nextFree;
+	}
+	else
+	{
+		m_freeHeads[fl][sl] = range.nextFree;
+	}
+	if (range.nextFree != NULL_RANGE)
+	{
+		m_ranges[range.nextFree].prevFree = range.prevFree;
+	}
+	range.free = false;
+
+	if (m_freeHeads[fl][sl] == NULL_RANGE)
+	{
+		m_slBitmaps[fl] &= ~(1u << sl);
+		if (m_slBitmaps[fl] == 0)
+		{
+			m_flBitmap &= ~(1ull << fl);
+		}
+	}
+}
+
+/*
+	정렬 여유 (alignment - 1) 를 더하고 다음 class 경계로 올린 크기로 찾으면, 찾은 목록의 어느 구간이든 들어가므로
+	bitmap 두 번으로 끝난다. 그런 class 가 없을 때만 요청 크기 class 의 목록을 직접 확인한다.
+*/
+uint32_t MemoryBlock::findFreeRange(VkDeviceSize size, VkDeviceSize alignment)
+{
+	VkDeviceSize searchSize = size + alignment - 1;
+	if (searchSize >= SL_COUNT)
+	{
+		searchSize += (VkDeviceSize(1) << (findHighestBit(searchSize) - SL_BITS)) - 1;
+	}
+
+	uint32_t fl, sl;
+	mapSize(searchSize, fl, sl);
+	uint32_t slBitmap = fl < FL_COUNT ? m_slBitmaps[fl] & (~0u << sl) : 0;
+	if (slBitmap == 0)
+	{
+		uint64_t flBitmap = fl + 1 < 64 ? m_flBitmap & (~0ull << (fl + 1)) : 0;
+		if (flBitmap != 0)
+		{
+			fl = findLowestBit(flBitmap);
+			slBitmap = m_slBitmaps[fl];
+		}
+	}
+	if (slBitmap != 0)
+	{
+		return m_freeHeads[fl][findLowestBit(slBitmap)];
+	}
+
+	mapSize(size, fl, sl);
+	for (uint32_t index = m_freeHeads[fl][sl]; index != NULL_RANGE; index = m_ranges[index].nextFree)
+	{
+		const Range &range = m_ranges[index];
+		if (alignUp(range.offset, alignment) + size <= range.offset + range.size)
+		{
+			return index;
+		}
+	}
+	return NULL_RANGE;
+}
+
+MemoryAllocator &MemoryAllocator::getAllocator()
+{
+	static MemoryAllocator allocator;
+	return allocator;
+}
+
+void MemoryAllocator::init(VkDevice device, VkPhysicalDevice physicalDevice)
+{
+	m_device = device;
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+	m_pools.clear();
+	m_pools.resize(m_memoryProperties.memoryTypeCount * 4);
+
+	m_heaps.clear();
+	m_heaps.resize(m_memoryProperties.memoryHeapCount);
+	for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; i++)
+	{
+		const VkMemoryHeap &heap = m_memoryProperties.memoryHeaps[i];
+		m_heaps[i].heapSize = heap.size;
+		m_heaps[i].budgetBytes = heap.size / 10 * 9;
+		m_heaps[i].deviceLocal = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+	}
+	m_dedicatedCount = 0;
+	m_allocationCount = 0;
+}
+
+void MemoryAllocator::cleanup()
+{
+	std::lock_guard lock(m_mutex);
+
+	if (m_allocationCount > 0)
+	{
+		AL_CORE_WARN("MemoryAllocator::cleanup: {0} allocations were not freed", m_allocationCount);
+	}
+
+	for (auto &pool : m_pools)
+	{
+		for (auto &block : pool)
+		{
+			if (block->getMappedData())
+			{
+				vkUnmapMemory(m_device, block->getMemory());
+			}
+			vkFreeMemory(m_device, block->getMemory(), nullptr);
+		}
+	}
+	m_pools.clear();
+	m_heaps.clear();
+}
+
+MemoryAllocation MemoryAllocator::allocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags properties,
+													   AllocationStrategy strategy)
+{
+	VkMemoryRequirements memRequirements;
+	vkGetBufferMemoryRequirements(m_device, buffer, &memRequirements);
+
+	MemoryAllocation allocation = allocate(memRequirements, properties, false, strategy);
+	vkBindBufferMemory(m_device, buffer, allocation.memory, allocation.offset);
+	return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocateImageMemory(VkImage image, VkMemoryPropertyFlags properties)
+{
+	VkMemoryRequirements memRequirements;
+	vkGetImageMemoryRequirements(m_device, image, &memRequirements);
+
+	MemoryAllocation allocation = allocate(memRequirements, properties, true, AllocationStrategy::GENERAL);
+	vkBindImageMemory(m_device, image, allocation.memory, allocation.offset);
+	return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocateImageMemory(const VkMemoryRequirements &requirements,
+													  VkMemoryPropertyFlags properties)
+{
+	return allocate(requirements, properties, true, AllocationStrategy::GENERAL);
+}
+
+void MemoryAllocator::free(MemoryAllocation &allocation)
+{
+	if (allocation.memory == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	std::lock_guard lock(m_mutex);
+
+	uint32_t heapIndex = m_memoryProperties.memoryTypes[allocation.memoryTypeIndex].heapIndex;
+	if (allocation.block)
+	{
+		allocation.block->free(allocation.offset, allocation.size);
+		m_heaps[heapIndex].usedBytes -= allocation.size;
+	}
+	else
+	{
+		if (allocation.mappedData)
+		{
+			vkUnmapMemory(m_device, allocation.memory);
+		}
+		vkFreeMemory(m_device, allocation.memory, nullptr);
+		m_heaps[heapIndex].blockBytes -= allocation.size;
+		m_heaps[heapIndex].usedBytes -= allocation.size;
+		m_dedicatedCount--;
+	}
+	m_allocationCount--;
+
+	allocation = MemoryAllocation{};
+}
+
+bool MemoryAllocator::hasMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties)
+{
+	for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++)
+	{
+		if ((memoryTypeBits & (1 << i)) && (m_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+uint32_t MemoryAllocator::releaseEmptyBlocks()
+{
+	std::lock_guard lock(m_mutex);
+	return releaseEmptyBlocksLocked();
+}
+
+void MemoryAllocator::setHeapBudget(uint32_t heapIndex, VkDeviceSize budget)
+{
+	std::lock_guard lock(m_mutex);
+	if (heapIndex < m_heaps.size())
+	{
+		m_heaps[heapIndex].budgetBytes = std::min(budget, m_heaps[heapIndex].heapSize);
+	}
+}
+
+MemoryStats MemoryAllocator::getStats()
+{
+	std::lock_guard lock(m_mutex);
+
+	MemoryStats stats;
+	stats.dedicatedCount = m_dedicatedCount;
+	stats.allocationCount = m_allocationCount;
+	stats.heaps = m_heaps;
+	for (auto &pool : m_pools)
+	{
+		for (auto &block : pool)
+		{
+			stats.blockCount++;
+			stats.largestFreeRange = std::max(stats.largestFreeRange, block->getLargestFreeRange());
+		}
+	}
+	for (auto &heap : m_heaps)
+	{
+		stats.blockBytes += heap.blockBytes;
+		stats.usedBytes += heap.usedBytes;
+	}
+	stats.deviceAllocationCount = stats.blockCount + stats.dedicatedCount;
+	return stats;
+}
+
+MemoryAllocation MemoryAllocator::allocate(const VkMemoryRequirements &requirements, VkMemoryPropertyFlags properties,
+										   bool image, AllocationStrategy strategy)
+{
+	uint32_t memoryTypeIndex = UINT32_MAX;
+	for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++)
+	{
+		if ((requirements.memoryTypeBits & (1 << i)) &&
+			(m_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+		{
+			memoryTypeIndex = i;
+			break;
+		}
+	}
+	if (memoryTypeIndex == UINT32_MAX)
+	{
+		throw std::runtime_error("failed to find suitable memory type!");
+	}
+
+	std::lock_guard lock(m_mutex);
+
+	// block 의 절반을 넘는 요청은 block 을 낭비하므로 따로 할당
+	VkDeviceSize blockSize = getBlockSize(memoryTypeIndex);
+	if (requirements.size > blockSize / 2)
+	{
+		return allocateDedicated(requirements.size, memoryTypeIndex);
+	}
+
+	auto &pool = m_pools[getPoolIndex(memoryTypeIndex, image, strategy)];
+	MemoryAllocation allocation;
+	allocation.memoryTypeIndex = memoryTypeIndex;
+	allocation.size = requirements.size;
+
+	MemoryBlock *target = nullptr;
+	for (auto &block : pool)
+	{
+		if (block->allocate(requirements.size, requirements.alignment, allocation.offset))
+		{
+			target = block.get();
+			break;
+		}
+	}
+	if (!target)
+	{
+		target = createBlock(memoryTypeIndex, blockSize, strategy);
+		pool.push_back(std::unique_ptr<MemoryBlock>(target));
+		target->allocate(requirements.size, requirements.alignment, allocation.offset);
+	}
+
+	allocation.memory = target->getMemory();
+	allocation.block = target;
+	if (target->getMappedData())
+	{
+		allocation.mappedData = static_cast<char *>(target->getMappedData()) + allocation.offset;
+	}
+
+	m_heaps[target->getHeapIndex()].usedBytes += allocation.size;
+	m_allocationCount++;
+	return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex)
+{
+	const VkMemoryType &memoryType = m_memoryProperties.memoryTypes[memoryTypeIndex];
+	if (!reserveHeap(memoryType.heapIndex, size))
+	{
+		throw std::runtime_error("memory heap budget exceeded!");
+	}
+
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+	MemoryAllocation allocation;
+	if (vkAllocateMemory(m_device, &allocInfo, nullptr, &allocation.memory) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to allocate dedicated memory!");
+	}
+	if (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+	{
+		vkMapMemory(m_device, allocation.memory, 0, size, 0, &allocation.mappedData);
+	}
+	allocation.size = size;
+	allocation.memoryTypeIndex = memoryTypeIndex;
+
+	m_heaps[memoryType.heapIndex].blockBytes += size;
+	m_heaps[memoryType.heapIndex].usedBytes += size;
+	m_dedicatedCount++;
+	m_allocationCount++;
+	return allocation;
+}
+
+MemoryBlock *MemoryAllocator::createBlock(uint32_t memoryTypeIndex, VkDeviceSize size, AllocationStrategy strategy)
+{
+	const VkMemoryType &memoryType = m_memoryProperties.memoryTypes[memoryTypeIndex];
+	if (!reserveHeap(memoryType.heapIndex, size))
+	{
+		throw std::runtime_error("memory heap budget exceeded!");
+	}
+
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+	VkDeviceMemory memory;
+	if (vkAllocateMemory(m_device, &allocInfo, nullptr, &memory) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to allocate memory block!");
+	}
+
+	// host visible block 은 한 번만 map 하고 계속 유지 (같은 메모리를 여러 번 map 할 수 없다.)
+	void *mappedData = nullptr;
+	if (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+	{
+		vkMapMemory(m_device, memory, 0, size, 0, &mappedData);
+	}
+
+	m_heaps[memoryType.heapIndex].blockBytes += size;
+	return new MemoryBlock(memory, size, memoryTypeIndex, memoryType.heapIndex, strategy, mappedData);
+}
+
+bool MemoryAllocator::reserveHeap(uint32_t heapIndex, VkDeviceSize size)
+{
+	MemoryHeapStats &heap = m_heaps[heapIndex];
+	if (heap.blockBytes + size <= heap.budgetBytes)
+	{
+		return true;
+	}
+
+	// budget 을 넘으면 비어있는 block 을 먼저 돌려주고 다시 확인
+	uint32_t releasedCount = releaseEmptyBlocksLocked();
+	AL_CORE_WARN("MemoryAllocator: heap {0} over budget ({1} MB), released {2} empty blocks", heapIndex,
+				 heap.budgetBytes >> 20, releasedCount);
+	return heap.blockBytes + size <= heap.budgetBytes;
+}
+
+uint32_t MemoryAllocator::releaseEmptyBlocksLocked()
+{
+	uint32_t releasedCount = 0;
+	for (auto &pool : m_pools)
+	{
+		for (auto it = pool.begin(); it != pool.end();)
+		{
+			MemoryBlock *block = it->get();
+			if (!block->isEmpty())
+			{
+				it++;
+				continue;
+			}
+
+			if (block->getMappedData())
+			{
+				vkUnmapMemory(m_device, block->getMemory());
+			}
+			vkFreeMemory(m_device, block->getMemory(), nullptr);
+			m_heaps[block->getHeapIndex()].blockBytes -= block->getSize();
+			it = pool.erase(it);
+			releasedCount++;
+		}
+	}
+	return releasedCount;
+}
+
+VkDeviceSize MemoryAllocator::getBlockSize(uint32_t memoryTypeIndex)
+{
+	const VkMemoryType &memoryType = m_memoryProperties.memoryTypes[memoryTypeIndex];
+	VkDeviceSize blockSize = (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+								 ? HOST_VISIBLE_BLOCK_SIZE
+								 : DEVICE_LOCAL_BLOCK_SIZE;
+
+	// 작은 heap (BAR 영역 등) 에서는 block 이 heap 의 1/8 을 넘지 않게 한다.
+	return std::min(blockSize, m_heaps[memoryType.heapIndex].heapSize / 8);
+}
+
+uint32_t MemoryAllocator::getPoolIndex(uint32_t memoryTypeIndex, bool image, AllocationStrategy strategy)
+{
+	return memoryTypeIndex * 4 + (image ? 2 : 0) + (strategy == AllocationStrategy::LINEAR ? 1 : 0);
+}
+
+} // namespace ale
@@ -278,15 +278,37 @@ std::shared_ptr<Mesh> Mesh::createCylinder()
 
 void Mesh::cleanup()
 {
-	m_vertexBuffer->cleanup();
-	m_indexBuffer->cleanup();
+	MeshPool::getMeshPool().free(m_range);
+	m_range = MeshRange();
 }
 
-void Mesh::draw(VkCommandBuffer commandBuffer)
+void Mesh::draw(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance)
 {
-	m_vertexBuffer->bind(commandBuffer);
-	m_indexBuffer->bind(commandBuffer);
-	vkCmdDrawIndexed(commandBuffer, m_indexBuffer->getIndexCount(), 1, 0, 0, 0);
+	bind(commandBuffer);
+	drawIndexed(commandBuffer, instanceCount, firstInstance);
+}
+
+void Mesh::bind(VkCommandBuffer commandBuffer)
+{
+	MeshPool::getMeshPool().bind(commandBuffer, m_range.page);
+}
+
+void Mesh::drawIndexed(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance)
+{
+	// instance 데이터는 firstInstance 부터 instanceCount 개를 읽는다.
+	vkCmdDrawIndexed(commandBuffer, m_range.indexCount, instanceCount, m_range.firstIndex, m_range.vertexOffset,
+					 firstInstance);
+}
+
+VkDrawIndexedIndirectCommand Mesh::getDrawCommand(uint32_t instanceCount, uint32_t firstInstance)
+{
+	VkDrawIndexedIndirectCommand command{};
+	command.indexCount = m_range.indexCount;
+	command.instanceCount = instanceCount;
+	command.firstIndex = m_range.firstIndex;
+	command.vertexOffset = m_range.vertexOffset;
+	command.firstInstance = firstInstance;
+	return command;
 }
 
 void Mesh::initMesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
@@ -294,8 +316,7 @@ void Mesh::initMesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &indice
 	calculateTangents(vertices, indices);
 	calculateAABB(vertices);
 
-	m_vertexBuffer = VertexBuffer::createVertexBuffer(vertices);
-	m_indexBuffer = IndexBuffer::createIndexBuffer(indices);
+	m_range = MeshPool::getMeshPool().allocate(vertices, indices);
 }
 
 void Mesh::calculateTangents(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
@@ -0,0 +1,147 @@
+#include "Renderer/MeshPool.h"
+#include "alpch.h"
+
+namespace ale
+{
+// count 개가 들어가는 첫 빈 구간
+static std::map<uint32_t, uint32_t>::iterator findFreeRange(std::map<uint32_t, uint32_t> &freeRanges, uint32_t count)
+{
+	return std::find_if(freeRanges.begin(), freeRanges.end(), [count](auto &range) { return range.second >= count; });
+}
+
+static uint32_t takeFreeRange(std::map<uint32_t, uint32_t> &freeRanges, uint32_t count)
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	auto it = findFreeRange(freeRanges, count);
+	uint32_t offset = it->first;
+	uint32_t remaining = it->second - count;
+	freeRanges.erase(it);
+	if (remaining > 0)
+	{
+		freeRanges[offset + count] = remaining;
+	}
+	return offset;
+}
+
+static void returnFreeRange(std::map<uint32_t, uint32_t> &freeRanges, uint32_t offset, uint32_t count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	auto it = freeRanges.emplace(offset, count).first;
+
+	// 뒤쪽 빈 구간과 합치기
+	auto next = std::next(it);
+	if (next != freeRanges.end() && it->first + it->second == next->first)
+	{
+		it->second += next->second;
+		freeRanges.erase(next);
+	}
+
+	// 앞쪽 빈 구간과 합치기
+	if (it != freeRanges.begin())
+	{
+		auto prev = std::prev(it);
+		if (prev->first + prev->second == it->first)
+		{
+			prev->second += it->second;
+			freeRanges.erase(it);
+		}
+	}
+}
+
+MeshPool &MeshPool::getMeshPool()
+{
+	static MeshPool meshPool;
+	return meshPool;
+}
+
+void MeshPool::init()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pages.clear();
+}
+
+void MeshPool::cleanup()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto &page : m_pages)
+	{
+		page.vertexBuffer->cleanup();
+		page.indexBuffer->cleanup();
+	}
+	m_pages.clear();
+}
+
+MeshRange MeshPool::allocate(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+	uint32_t indexCount = static_cast<uint32_t>(indices.size());
+	uint32_t pageIndex = findPage(vertexCount, indexCount);
+	Page &page = m_pages[pageIndex];
+
+	MeshRange range;
+	range.page = pageIndex;
+	range.firstIndex = takeFreeRange(page.freeIndices, indexCount);
+	range.indexCount = indexCount;
+	range.vertexOffset = static_cast<int32_t>(takeFreeRange(page.freeVertices, vertexCount));
+	range.vertexCount = vertexCount;
+
+	page.vertexBuffer->updateVertexBuffer(vertices, static_cast<uint32_t>(range.vertexOffset));
+	page.indexBuffer->updateIndexBuffer(indices, range.firstIndex);
+	return range;
+}
+
+void MeshPool::free(const MeshRange &range)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (range.page >= m_pages.size())
+	{
+		return;
+	}
+
+	// 일부만 쓰이는 page 의 빈 곳도 다음 mesh 가 다시 쓸 수 있도록 빈 구간 목록에 돌려준다.
+	Page &page = m_pages[range.page];
+	returnFreeRange(page.freeVertices, static_cast<uint32_t>(range.vertexOffset), range.vertexCount);
+	returnFreeRange(page.freeIndices, range.firstIndex, range.indexCount);
+}
+
+void MeshPool::bind(VkCommandBuffer commandBuffer, uint32_t page)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pages[page].vertexBuffer->bind(commandBuffer);
+	m_pages[page].indexBuffer->bind(commandBuffer);
+}
+
+uint32_t MeshPool::findPage(uint32_t vertexCount, uint32_t indexCount)
+{
+	for (uint32_t i = 0; i < m_pages.size(); i++)
+	{
+		Page &page = m_pages[i];
+		bool vertexFits = vertexCount == 0 || findFreeRange(page.freeVertices, vertexCount) != page.freeVertices.end();
+		bool indexFits = indexCount == 0 || findFreeRange(page.freeIndices, indexCount) != page.freeIndices.end();
+		if (vertexFits && indexFits)
+		{
+			return i;
+		}
+	}
+
+	// 남는 page 가 없으면 새로 만든다. (page 보다 큰 mesh 는 크기에 맞춘 전용 page)
+	Page page;
+	page.vertexBuffer = VertexBuffer::createVertexBuffer(std::max(vertexCount, PAGE_VERTEX_COUNT));
+	page.indexBuffer = IndexBuffer::createIndexBuffer(std::max(indexCount, PAGE_INDEX_COUNT));
+	page.freeVertices[0] = page.vertexBuffer->getCapacity();
+	page.freeIndices[0] = page.indexBuffer->getCapacity();
+	m_pages.push_back(std::move(page));
+	return static_cast<uint32_t>(m_pages.size() - 1);
+}
+
+} // namespace ale
@@ -1,6 +1,5 @@
 #include "Renderer/Model.h"
 #include "Core/App.h"
-#include "Renderer/ShaderResourceManager.h"
 #include "Scene/CullTree.h"
 
 #include <glm/gtx/string_cast.hpp>
@@ -118,88 +117,39 @@ void Model::cleanup()
 
 void Model::draw(DrawInfo &drawInfo)
 {
-	auto &descriptorSets = drawInfo.shaderResourceManager->getDescriptorSets();
-	auto &vertexUniformBuffers = drawInfo.shaderResourceManager->getVertexUniformBuffers();
-	auto &fragmentUniformBuffers = drawInfo.shaderResourceManager->getFragmentUniformBuffers();
-	for (uint32_t i = 0; i < m_meshes.size(); i++)
-	{
-		uint32_t index = MAX_FRAMES_IN_FLIGHT * i + drawInfo.currentFrame;
-		vkCmdBindDescriptorSets(drawInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawInfo.pipelineLayout, 0, 1,
-								&descriptorSets[index], 0, nullptr);
-		GeometryPassVertexUniformBufferObject vertexUbo{};
-		vertexUbo.model = drawInfo.model;
-		vertexUbo.view = drawInfo.view;
-		vertexUbo.proj = drawInfo.projection;
-		for (size_t i = 0; i < MAX_BONES; ++i)
-			vertexUbo.finalBonesMatrices[i] = drawInfo.finalBonesMatrices[i];
-		vertexUbo.heightFlag = drawInfo.materials[i]->getHeightMap().flag;
-		vertexUbo.heightScale = 0.1;
-		vertexUbo.padding = glm::vec2(0.0f);
-		vertexUniformBuffers[index]->updateUniformBuffer(&vertexUbo, sizeof(vertexUbo));
-
-		GeometryPassFragmentUniformBufferObject fragmentUbo{};
-		fragmentUbo.albedoValue = glm::vec4(drawInfo.materials[i]->getAlbedo().albedo, 1.0f);
-		fragmentUbo.roughnessValue = drawInfo.materials[i]->getRoughness().roughness;
-		fragmentUbo.metallicValue = drawInfo.materials[i]->getMetallic().metallic;
-		fragmentUbo.aoValue = drawInfo.materials[i]->getAOMap().ao;
-		fragmentUbo.albedoFlag = drawInfo.materials[i]->getAlbedo().flag;
-		fragmentUbo.normalFlag = drawInfo.materials[i]->getNormalMap().flag;
-		fragmentUbo.roughnessFlag = drawInfo.materials[i]->getRoughness().flag;
-		fragmentUbo.metallicFlag = drawInfo.materials[i]->getMetallic().flag;
-		fragmentUbo.aoFlag = drawInfo.materials[i]->getAOMap().flag;
-		fragmentUbo.padding = glm::vec2(0.0f);
-		fragmentUniformBuffers[index]->updateUniformBuffer(&fragmentUbo, sizeof(fragmentUbo));
-
-		m_meshes[i]->draw(drawInfo.commandBuffer);
+	DrawState &state = *drawInfo.state;
+
+	// render queue 가 material 순으로 정렬하므로 material 이 바뀔 때만 table index 를 다시 넘긴다.
+	if (state.materialIndex != drawInfo.materialIndex)
+	{
+		state.materialIndex = drawInfo.materialIndex;
+		vkCmdPushConstants(drawInfo.commandBuffer, drawInfo.pipelineLayout,
+						   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(uint32_t),
+						   &state.materialIndex);
+		state.bindCount++;
 	}
+
+	drawMesh(m_meshes[drawInfo.meshIndex].get(), drawInfo.commandBuffer, drawInfo.instanceCount,
+			 drawInfo.firstInstance, state);
 }
 
 void Model::drawShadow(ShadowMapDrawInfo &drawInfo)
 {
-	auto &descriptorSets = drawInfo.shaderResourceManager->getDescriptorSets();
-	auto &uniformBuffers = drawInfo.shaderResourceManager->getUniformBuffers();
-	for (uint32_t i = 0; i < m_meshes.size(); i++)
-	{
-		uint32_t index = drawInfo.currentFrame;
-		vkCmdBindDescriptorSets(drawInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawInfo.pipelineLayout, 0, 1,
-								&descriptorSets[index], 0, nullptr);
-		ShadowMapUniformBufferObject shadowMapUbo{};
-		shadowMapUbo.model = drawInfo.model;
-		shadowMapUbo.view = drawInfo.view;
-		shadowMapUbo.proj = drawInfo.projection;
-		uniformBuffers[index]->updateUniformBuffer(&shadowMapUbo, sizeof(shadowMapUbo));
-		m_meshes[i]->draw(drawInfo.commandBuffer);
-	}
+	drawMesh(m_meshes[drawInfo.meshIndex].get(), drawInfo.commandBuffer, drawInfo.instanceCount,
+			 drawInfo.firstInstance, *drawInfo.state);
 }
 
-void Model::drawShadowCubeMap(ShadowCubeMapDrawInfo &drawInfo)
+void Model::drawMesh(Mesh *mesh, VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance,
+					 DrawState &state)
 {
-	auto &descriptorSets = drawInfo.shaderResourceManager->getDescriptorSets();
-	auto &uniformBuffers = drawInfo.shaderResourceManager->getUniformBuffers();
-	auto &layerIndexUniformBuffers = drawInfo.shaderResourceManager->getLayerIndexUniformBuffers();
-	uint32_t currentFrame = drawInfo.currentFrame;
-	ShadowCubeMapUniformBufferObject shadowCubeMapUbo{};
-	shadowCubeMapUbo.model = drawInfo.model;
-	shadowCubeMapUbo.proj = drawInfo.projection;
-	for (uint32_t i = 0; i < 6; i++)
+	if (state.meshPage != mesh->getPage())
 	{
-		shadowCubeMapUbo.view[i] = drawInfo.view[i];
-	}
-
-	for (uint32_t i = 0; i < 6; i++)
-	{
-		uint32_t index = currentFrame * 6 + i;
-		for (uint32_t j = 0; j < m_meshes.size(); j++)
-		{
-			vkCmdBindDescriptorSets(drawInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawInfo.pipelineLayout, 0,
-									1, &descriptorSets[index], 0, nullptr);
-			uniformBuffers[currentFrame]->updateUniformBuffer(&shadowCubeMapUbo, sizeof(shadowCubeMapUbo));
-			ShadowCubeMapLayerIndex layerIndexUbo{};
-			layerIndexUbo.layerIndex = i;
-			layerIndexUniformBuffers[index]->updateUniformBuffer(&layerIndexUbo, sizeof(layerIndexUbo));
-			m_meshes[j]->draw(drawInfo.commandBuffer);
-		}
+		state.meshPage = mesh->getPage();
+		mesh->bind(commandBuffer);
+		state.bindCount++;
 	}
+	mesh->drawIndexed(commandBuffer, instanceCount, firstInstance);
+	state.drawCount++;
 }
 
 void Model::initModel(std::string path, std::shared_ptr<Material> &defaultMaterial)
@@ -1,12 +1,20 @@
 #include "Renderer/Pipeline.h"
+#include "Renderer/MaterialTable.h"
+#include "Renderer/PipelineCache.h"
+#include "Renderer/ShaderLibrary.h"
 
 namespace ale
 {
 std::unique_ptr<Pipeline> Pipeline::createGeometryPassPipeline(VkRenderPass renderPass,
-															   VkDescriptorSetLayout descriptorSetLayout)
+															   VkDescriptorSetLayout frameDescriptorSetLayout,
+															   VkDescriptorSetLayout descriptorSetLayout, bool skinned,
+															   bool heightMap)
 {
 	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
-	pipeline->initGeometryPassPipeline(renderPass, descriptorSetLayout);
+	pipeline->reinit = [=](Pipeline &target) {
+		target.initGeometryPassPipeline(renderPass, frameDescriptorSetLayout, descriptorSetLayout, skinned, heightMap);
+	};
+	pipeline->reinit(*pipeline);
 	return pipeline;
 }
 
@@ -19,17 +27,46 @@ void Pipeline::cleanup()
 	vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
 }
 
-void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout)
+bool Pipeline::reload(const std::set<std::string> &changedShaders)
+{
+	bool changed = std::any_of(shaderFiles.begin(), shaderFiles.end(), [&changedShaders](const std::string &file) {
+		return changedShaders.count(file) > 0;
+	});
+	if (!changed)
+	{
+		return false;
+	}
+
+	cleanup();
+	shaderFiles.clear();
+	reinit(*this);
+	return true;
+}
+
+VkShaderModule Pipeline::getShaderModule(const std::string &fileName, const ShaderDefines &defines)
+{
+	shaderFiles.push_back(fileName);
+	return ShaderLibrary::getShaderLibrary().getShaderModule(fileName, defines);
+}
+
+void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSetLayout frameDescriptorSetLayout,
+										VkDescriptorSetLayout descriptorSetLayout, bool skinned, bool heightMap)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
-	// SPIR-V 파일 읽기
-	std::vector<char> vertShaderCode = VulkanUtil::readFile("./spvs/GeometryPassWithSA.vert.spv");
-	std::vector<char> fragShaderCode = VulkanUtil::readFile("./spvs/GeometryPass.frag.spv");
-
-	// shader module 생성
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-	VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
+	// static mesh 는 skinning 을, height map 이 없는 material 은 displacement 를 뺀 vertex shader permutation 을 쓴다.
+	ShaderDefines defines;
+	if (skinned)
+	{
+		defines.push_back("SKINNED");
+	}
+	if (heightMap)
+	{
+		defines.push_back("HEIGHT_MAP");
+	}
+	VkShaderModule vertShaderModule = getShaderModule("GeometryPass.vert", defines);
+	VkShaderModule fragShaderModule = getShaderModule("GeometryPass.frag");
 
 	/*
 	shader stage 란?
@@ -37,12 +74,22 @@ void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 	특정 셰이더 단계에서 사용할 셰이더 코드를 가지고 있음
 	*/
 
+	// texture 배열 크기는 set 1 layout 과 같은 값을 specialization constant (constant_id = 0) 로 넘긴다.
+	uint32_t textureCapacity = MaterialTable::getTextureCapacity();
+	VkSpecializationMapEntry specializationEntry{0, 0, sizeof(uint32_t)};
+	VkSpecializationInfo specializationInfo{};
+	specializationInfo.mapEntryCount = 1;
+	specializationInfo.pMapEntries = &specializationEntry;
+	specializationInfo.dataSize = sizeof(uint32_t);
+	specializationInfo.pData = &textureCapacity;
+
 	// vertex shader stage 설정
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 	vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT; // 쉐이더 종류
 	vertShaderStageInfo.module = vertShaderModule;			// 쉐이더 모듈
 	vertShaderStageInfo.pName = "main"; // 쉐이더 파일 내부에서 가장 먼저 시작 될 함수 이름 (엔트리 포인트)
+	vertShaderStageInfo.pSpecializationInfo = &specializationInfo;
 
 	// fragment shader stage 설정
 	VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
@@ -50,6 +97,7 @@ void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 	fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT; // 쉐이더 종류
 	fragShaderStageInfo.module = fragShaderModule;			  // 쉐이더 모듈
 	fragShaderStageInfo.pName = "main"; // 쉐이더 파일 내부에서 가장 먼저 시작 될 함수 이름 (엔트리 포인트)
+	fragShaderStageInfo.pSpecializationInfo = &specializationInfo;
 
 	// shader stage 모음
 	VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
@@ -58,13 +106,18 @@ void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
-	auto bindingDescription = Vertex::getBindingDescription();		 // 정점 바인딩 정보를 가진 구조체
-	auto attributeDescriptions = Vertex::getAttributeDescriptions(); // 정점 속성 정보를 가진 구조체 배열
+	// binding 0: 정점 데이터, binding 1: instance 별 model 행렬
+	std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {Vertex::getBindingDescription(),
+																		   InstanceData::getBindingDescription()};
+	// 정점 속성 정보를 가진 구조체 배열
+	auto attributeDescriptions =
+		skinned ? getInstancedAttributeDescriptions() : getStaticInstancedAttributeDescriptions();
 
-	vertexInputInfo.vertexBindingDescriptionCount = 1; // 정점 바인딩 정보 개수
+	vertexInputInfo.vertexBindingDescriptionCount =
+		static_cast<uint32_t>(bindingDescriptions.size()); // 정점 바인딩 정보 개수
 	vertexInputInfo.vertexAttributeDescriptionCount =
 		static_cast<uint32_t>(attributeDescriptions.size());					 // 정점 속성 정보 개수
-	vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;			 // 정점 바인딩 정보
+	vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();	 // 정점 바인딩 정보
 	vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data(); // 정점 속성 정보
 
 	// [input assembly 설정] (그려질 primitive 설정)
@@ -159,8 +212,18 @@ void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 	// [파이프라인 레이아웃 생성]
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-	pipelineLayoutInfo.setLayoutCount = 1;				   // 디스크립터 셋 레이아웃 개수
-	pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout; // 디스크립투 셋 레이아웃
+	// set 0: 프레임별 uniform (dynamic offset) / material table, set 1: 전역 texture 배열
+	std::array<VkDescriptorSetLayout, 2> setLayouts = {frameDescriptorSetLayout, descriptorSetLayout};
+	pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size()); // 디스크립터 셋 레이아웃 개수
+	pipelineLayoutInfo.pSetLayouts = setLayouts.data();							  // 디스크립투 셋 레이아웃
+
+	// draw 마다 material table index 하나만 push constant 로 넘긴다.
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(uint32_t);
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
 	if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
 	{
@@ -188,45 +251,41 @@ void Pipeline::initGeometryPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 
 	// [파이프라인 객체 생성]
 	// 두 번째 매개변수는 상속할 파이프라인
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to create GeometryPass graphics pipeline!");
 	}
-
-	// 쉐이더 모듈 더 안 쓰므로 제거
-	vkDestroyShaderModule(device, fragShaderModule, nullptr);
-	vkDestroyShaderModule(device, vertShaderModule, nullptr);
 }
 
-/*
-매개변수로 받은 쉐이더 파일을 shader module로 만들어 줌
-shader module은 쉐이더 파일을 객체화 한 것임
-*/
-VkShaderModule Pipeline::createShaderModule(const std::vector<char> &code)
+std::vector<VkVertexInputAttributeDescription> Pipeline::getInstancedAttributeDescriptions()
 {
-	auto &context = VulkanContext::getContext();
-	VkDevice device = context.getDevice();
-
-	VkShaderModuleCreateInfo createInfo{};
-	createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	createInfo.codeSize = code.size();									// 코드 길이 입력
-	createInfo.pCode = reinterpret_cast<const uint32_t *>(code.data()); // 코드 내용 입력
+	auto vertexAttributes = Vertex::getAttributeDescriptions();
+	auto instanceAttributes = InstanceData::getAttributeDescriptions();
 
-	// 쉐이더 모듈 생성
-	VkShaderModule shaderModule;
-	if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
-	{
-		throw std::runtime_error("failed to create shader module!");
-	}
+	std::vector<VkVertexInputAttributeDescription> attributeDescriptions(vertexAttributes.begin(),
+																		   vertexAttributes.end());
+	attributeDescriptions.insert(attributeDescriptions.end(), instanceAttributes.begin(), instanceAttributes.end());
+	return attributeDescriptions;
+}
 
-	return shaderModule;
+std::vector<VkVertexInputAttributeDescription> Pipeline::getStaticInstancedAttributeDescriptions()
+{
+	std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getInstancedAttributeDescriptions();
+	attributeDescriptions.erase(std::remove_if(attributeDescriptions.begin(), attributeDescriptions.end(),
+											   [](const VkVertexInputAttributeDescription &attribute) {
+												   return attribute.location == 4 || attribute.location == 5 ||
+														  attribute.location == 10;
+											   }),
+								attributeDescriptions.end());
+	return attributeDescriptions;
 }
 
 std::unique_ptr<Pipeline> Pipeline::createLightingPassPipeline(VkRenderPass renderPass,
 															   VkDescriptorSetLayout descriptorSetLayout)
 {
 	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
-	pipeline->initLightingPassPipeline(renderPass, descriptorSetLayout);
+	pipeline->reinit = [=](Pipeline &target) { target.initLightingPassPipeline(renderPass, descriptorSetLayout); };
+	pipeline->reinit(*pipeline);
 	return pipeline;
 }
 
@@ -234,14 +293,11 @@ void Pipeline::initLightingPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
 
-	// SPIR-V 셰이더 파일 읽기
-	std::vector<char> vertShaderCode = VulkanUtil::readFile("./spvs/LightingPass.vert.spv");
-	std::vector<char> fragShaderCode = VulkanUtil::readFile("./spvs/LightingPass.frag.spv");
-
-	// 셰이더 모듈 생성
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-	VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+	// 셰이더 모듈 (ShaderLibrary 가 source 마다 한 번만 만든다)
+	VkShaderModule vertShaderModule = getShaderModule("LightingPass.vert");
+	VkShaderModule fragShaderModule = getShaderModule("LightingPass.frag");
 
 	// Shader Stage 설정
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
@@ -349,20 +405,18 @@ void Pipeline::initLightingPassPipeline(VkRenderPass renderPass, VkDescriptorSet
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 1;
 
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
 	{
 		throw std::runtime_error("Failed to create LightingPass pipeline!");
 	}
-
-	vkDestroyShaderModule(device, fragShaderModule, nullptr);
-	vkDestroyShaderModule(device, vertShaderModule, nullptr);
 }
 
 std::unique_ptr<Pipeline> Pipeline::createShadowMapPipeline(VkRenderPass renderPass,
 															VkDescriptorSetLayout descriptorSetLayout)
 {
 	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
-	pipeline->initShadowMapPipeline(renderPass, descriptorSetLayout);
+	pipeline->reinit = [=](Pipeline &target) { target.initShadowMapPipeline(renderPass, descriptorSetLayout); };
+	pipeline->reinit(*pipeline);
 	return pipeline;
 }
 
@@ -370,10 +424,10 @@ void Pipeline::initShadowMapPipeline(VkRenderPass renderPass, VkDescriptorSetLay
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
 
 	// Vertex Shader Module 생성
-	std::vector<char> vertShaderCode = VulkanUtil::readFile("./spvs/ShadowMap.vert.spv");
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
+	VkShaderModule vertShaderModule = getShaderModule("ShadowMap.vert");
 
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -384,13 +438,14 @@ void Pipeline::initShadowMapPipeline(VkRenderPass renderPass, VkDescriptorSetLay
 	VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo};
 
 	// Vertex Input 설정
-	auto bindingDescription = Vertex::getBindingDescription();
-	auto attributeDescriptions = Vertex::getAttributeDescriptions();
+	std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {Vertex::getBindingDescription(),
+																		   InstanceData::getBindingDescription()};
+	auto attributeDescriptions = getInstancedAttributeDescriptions();
 
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputInfo.vertexBindingDescriptionCount = 1;
-	vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+	vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+	vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
 	vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
@@ -467,20 +522,18 @@ void Pipeline::initShadowMapPipeline(VkRenderPass renderPass, VkDescriptorSetLay
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 0;
 
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
 	{
 		throw std::runtime_error("Failed to create shadow map graphics pipeline!");
 	}
-
-	// Shader Module Cleanup
-	vkDestroyShaderModule(device, vertShaderModule, nullptr);
 }
 
 std::unique_ptr<Pipeline> Pipeline::createShadowCubeMapPipeline(VkRenderPass renderPass,
 																VkDescriptorSetLayout descriptorSetLayout)
 {
 	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
-	pipeline->initShadowCubeMapPipeline(renderPass, descriptorSetLayout);
+	pipeline->reinit = [=](Pipeline &target) { target.initShadowCubeMapPipeline(renderPass, descriptorSetLayout); };
+	pipeline->reinit(*pipeline);
 	return pipeline;
 }
 
@@ -488,10 +541,10 @@ void Pipeline::initShadowCubeMapPipeline(VkRenderPass renderPass, VkDescriptorSe
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
 
 	// Vertex Shader Module 생성
-	std::vector<char> vertShaderCode = VulkanUtil::readFile("./spvs/ShadowCubeMap.vert.spv");
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
+	VkShaderModule vertShaderModule = getShaderModule("ShadowCubeMap.vert");
 
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -502,13 +555,14 @@ void Pipeline::initShadowCubeMapPipeline(VkRenderPass renderPass, VkDescriptorSe
 	VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo};
 
 	// Vertex Input 설정
-	auto bindingDescription = Vertex::getBindingDescription();
-	auto attributeDescriptions = Vertex::getAttributeDescriptions();
+	std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {Vertex::getBindingDescription(),
+																		   InstanceData::getBindingDescription()};
+	auto attributeDescriptions = getInstancedAttributeDescriptions();
 
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	vertexInputInfo.vertexBindingDescriptionCount = 1;
-	vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+	vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+	vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
 	vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
@@ -585,33 +639,29 @@ void Pipeline::initShadowCubeMapPipeline(VkRenderPass renderPass, VkDescriptorSe
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 0;
 
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
 	{
 		throw std::runtime_error("Failed to create shadow map graphics pipeline!");
 	}
-
-	// Shader Module Cleanup
-	vkDestroyShaderModule(device, vertShaderModule, nullptr);
 }
 
-std::unique_ptr<Pipeline> Pipeline::createSphericalMapPipeline(VkRenderPass renderPass,
-															   VkDescriptorSetLayout descriptorSetLayout)
+std::unique_ptr<Pipeline> Pipeline::createBackgroundPipeline(VkRenderPass renderPass,
+															 VkDescriptorSetLayout descriptorSetLayout)
 {
 	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
-	pipeline->initSphericalMapPipeline(renderPass, descriptorSetLayout);
+	pipeline->reinit = [=](Pipeline &target) { target.initBackgroundPipeline(renderPass, descriptorSetLayout); };
+	pipeline->reinit(*pipeline);
 	return pipeline;
 }
 
-void Pipeline::initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout)
+void Pipeline::initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
 
-	std::vector<char> vertShaderCode = VulkanUtil::readFile("./spvs/SphericalMap.vert.spv");
-	std::vector<char> fragShaderCode = VulkanUtil::readFile("./spvs/SphericalMap.frag.spv");
-
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-	VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+	VkShaderModule vertShaderModule = getShaderModule("Background.vert");
+	VkShaderModule fragShaderModule = getShaderModule("Background.frag");
 
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -639,31 +689,19 @@ void Pipeline::initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSet
 	inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 	inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-	VkViewport viewport{};
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = 2048;
-	viewport.height = 2048;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-
-	VkRect2D scissor{};
-	scissor.offset = {0, 0};
-	scissor.extent = {2048, 2048};
-
 	VkPipelineViewportStateCreateInfo viewportState{};
 	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 	viewportState.viewportCount = 1;
-	viewportState.pViewports = &viewport;
+	viewportState.pViewports = nullptr;
 	viewportState.scissorCount = 1;
-	viewportState.pScissors = &scissor;
+	viewportState.pScissors = nullptr;
 
 	VkPipelineRasterizationStateCreateInfo rasterizer{};
 	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 	rasterizer.depthClampEnable = VK_FALSE;
 	rasterizer.rasterizerDiscardEnable = VK_FALSE;
 	rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-	rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+	rasterizer.cullMode = VK_CULL_MODE_NONE;
 	rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 	rasterizer.depthBiasEnable = VK_FALSE;
 	rasterizer.lineWidth = 1.0f;
@@ -677,7 +715,7 @@ void Pipeline::initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSet
 	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 	depthStencil.depthTestEnable = VK_FALSE;
 	depthStencil.depthWriteEnable = VK_FALSE;
-	depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+	depthStencil.depthCompareOp = VK_COMPARE_OP_ALWAYS;
 	depthStencil.depthBoundsTestEnable = VK_FALSE;
 	depthStencil.stencilTestEnable = VK_FALSE;
 
@@ -693,6 +731,12 @@ void Pipeline::initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSet
 	colorBlending.attachmentCount = 1;
 	colorBlending.pAttachments = &colorBlendAttachment;
 
+	std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+	VkPipelineDynamicStateCreateInfo dynamicState{};
+	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+	dynamicState.pDynamicStates = dynamicStates.data();
+
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = 1;
@@ -700,7 +744,7 @@ void Pipeline::initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSet
 
 	if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to create pipeline layout for Spherical Map!");
+		throw std::runtime_error("Failed to create pipeline layout for Background!");
 	}
 
 	VkGraphicsPipelineCreateInfo pipelineInfo{};
@@ -717,35 +761,34 @@ void Pipeline::initSphericalMapPipeline(VkRenderPass renderPass, VkDescriptorSet
 	pipelineInfo.layout = pipelineLayout;
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 0;
+	pipelineInfo.pDynamicState = &dynamicState;
 
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to create spherical map graphics pipeline!");
+		throw std::runtime_error("Failed to create Background graphics pipeline!");
 	}
-
-	vkDestroyShaderModule(device, fragShaderModule, nullptr);
-	vkDestroyShaderModule(device, vertShaderModule, nullptr);
 }
 
-std::unique_ptr<Pipeline> Pipeline::createBackgroundPipeline(VkRenderPass renderPass,
-															 VkDescriptorSetLayout descriptorSetLayout)
+std::unique_ptr<Pipeline> Pipeline::createUpscalePipeline(VkRenderPass renderPass,
+														  VkDescriptorSetLayout descriptorSetLayout)
 {
 	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
-	pipeline->initBackgroundPipeline(renderPass, descriptorSetLayout);
+	pipeline->reinit = [=](Pipeline &target) { target.initUpscalePipeline(renderPass, descriptorSetLayout); };
+	pipeline->reinit(*pipeline);
 	return pipeline;
 }
 
-void Pipeline::initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout)
+void Pipeline::initUpscalePipeline(VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
 
-	std::vector<char> vertShaderCode = VulkanUtil::readFile("./spvs/Background.vert.spv");
-	std::vector<char> fragShaderCode = VulkanUtil::readFile("./spvs/Background.frag.spv");
-
-	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-	VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+	// 셰이더 모듈 (ShaderLibrary 가 source 마다 한 번만 만든다)
+	VkShaderModule vertShaderModule = getShaderModule("Upscale.vert");
+	VkShaderModule fragShaderModule = getShaderModule("Upscale.frag");
 
+	// Shader Stage 설정
 	VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 	vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 	vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
@@ -760,6 +803,7 @@ void Pipeline::initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLa
 
 	VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
+	// Vertex Input State (풀스크린 삼각형은 입력 없음)
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 	vertexInputInfo.vertexBindingDescriptionCount = 0;
@@ -767,41 +811,42 @@ void Pipeline::initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLa
 	vertexInputInfo.vertexAttributeDescriptionCount = 0;
 	vertexInputInfo.pVertexAttributeDescriptions = nullptr;
 
+	// Input Assembly
 	VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
 	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 	inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 	inputAssembly.primitiveRestartEnable = VK_FALSE;
 
+	// Viewport & Scissor
 	VkPipelineViewportStateCreateInfo viewportState{};
 	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 	viewportState.viewportCount = 1;
-	viewportState.pViewports = nullptr;
 	viewportState.scissorCount = 1;
-	viewportState.pScissors = nullptr;
 
+	// Rasterizer
 	VkPipelineRasterizationStateCreateInfo rasterizer{};
 	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 	rasterizer.depthClampEnable = VK_FALSE;
 	rasterizer.rasterizerDiscardEnable = VK_FALSE;
 	rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterizer.lineWidth = 1.0f;
 	rasterizer.cullMode = VK_CULL_MODE_NONE;
 	rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-	rasterizer.depthBiasEnable = VK_FALSE;
-	rasterizer.lineWidth = 1.0f;
 
+	// Multisampling
 	VkPipelineMultisampleStateCreateInfo multisampling{};
 	multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-	multisampling.sampleShadingEnable = VK_FALSE;
 	multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+	multisampling.sampleShadingEnable = VK_FALSE;
 
+	// Depth-Stencil (불필요)
 	VkPipelineDepthStencilStateCreateInfo depthStencil{};
 	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 	depthStencil.depthTestEnable = VK_FALSE;
 	depthStencil.depthWriteEnable = VK_FALSE;
-	depthStencil.depthCompareOp = VK_COMPARE_OP_ALWAYS;
-	depthStencil.depthBoundsTestEnable = VK_FALSE;
 	depthStencil.stencilTestEnable = VK_FALSE;
 
+	// Color Blending
 	VkPipelineColorBlendAttachmentState colorBlendAttachment{};
 	colorBlendAttachment.colorWriteMask =
 		VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
@@ -810,26 +855,37 @@ void Pipeline::initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLa
 	VkPipelineColorBlendStateCreateInfo colorBlending{};
 	colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 	colorBlending.logicOpEnable = VK_FALSE;
-	colorBlending.logicOp = VK_LOGIC_OP_COPY;
 	colorBlending.attachmentCount = 1;
 	colorBlending.pAttachments = &colorBlendAttachment;
 
-	std::array<VkDynamicState, 2> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+	// Dynamic State
+	std::vector<VkDynamicState> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
 	VkPipelineDynamicStateCreateInfo dynamicState{};
 	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 	dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
 	dynamicState.pDynamicStates = dynamicStates.data();
 
+	// 내부 해상도 / image 크기 비율과 texel 크기
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(UpscalePushConstants);
+
+	// Pipeline Layout
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = 1;
 	pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
 	if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to create pipeline layout for Background!");
+		throw std::runtime_error("Failed to create Upscale pipeline layout!");
 	}
 
+	// Graphics Pipeline
 	VkGraphicsPipelineCreateInfo pipelineInfo{};
 	pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 	pipelineInfo.stageCount = 2;
@@ -841,18 +897,117 @@ void Pipeline::initBackgroundPipeline(VkRenderPass renderPass, VkDescriptorSetLa
 	pipelineInfo.pMultisampleState = &multisampling;
 	pipelineInfo.pDepthStencilState = &depthStencil;
 	pipelineInfo.pColorBlendState = &colorBlending;
+	pipelineInfo.pDynamicState = &dynamicState;
 	pipelineInfo.layout = pipelineLayout;
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 0;
-	pipelineInfo.pDynamicState = &dynamicState;
 
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to create Background graphics pipeline!");
+		throw std::runtime_error("Failed to create Upscale pipeline!");
 	}
+}
+
+std::unique_ptr<Pipeline> Pipeline::createGpuCullingPipeline(VkDescriptorSetLayout descriptorSetLayout)
+{
+	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
+	pipeline->reinit = [=](Pipeline &target) { target.initGpuCullingPipeline(descriptorSetLayout); };
+	pipeline->reinit(*pipeline);
+	return pipeline;
+}
+
+void Pipeline::initGpuCullingPipeline(VkDescriptorSetLayout descriptorSetLayout)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
+
+	VkShaderModule compShaderModule = getShaderModule("GpuCulling.comp");
+
+	VkPipelineShaderStageCreateInfo compShaderStageInfo{};
+	compShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	compShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	compShaderStageInfo.module = compShaderModule;
+	compShaderStageInfo.pName = "main";
 
-	vkDestroyShaderModule(device, fragShaderModule, nullptr);
-	vkDestroyShaderModule(device, vertShaderModule, nullptr);
+	// frustum plane 6개 + instance 수
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(GpuCullingPushConstants);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = 1;
+	pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+	if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+	{
+		throw std::runtime_error("Failed to create pipeline layout for GPU culling!");
+	}
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage = compShaderStageInfo;
+	pipelineInfo.layout = pipelineLayout;
+
+	if (vkCreateComputePipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	{
+		throw std::runtime_error("Failed to create GPU culling compute pipeline!");
+	}
+}
+
+std::unique_ptr<Pipeline> Pipeline::createEnvironmentMapPipeline(VkDescriptorSetLayout descriptorSetLayout,
+																 const std::string &shaderFile)
+{
+	std::unique_ptr<Pipeline> pipeline = std::unique_ptr<Pipeline>(new Pipeline());
+	pipeline->reinit = [=](Pipeline &target) { target.initEnvironmentMapPipeline(descriptorSetLayout, shaderFile); };
+	pipeline->reinit(*pipeline);
+	return pipeline;
+}
+
+void Pipeline::initEnvironmentMapPipeline(VkDescriptorSetLayout descriptorSetLayout, const std::string &shaderFile)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+	VkPipelineCache pipelineCache = PipelineCache::getPipelineCache().getCache();
+
+	VkShaderModule compShaderModule = getShaderModule(shaderFile);
+
+	VkPipelineShaderStageCreateInfo compShaderStageInfo{};
+	compShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	compShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	compShaderStageInfo.module = compShaderModule;
+	compShaderStageInfo.pName = "main";
+
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(EnvironmentMapPushConstants);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = 1;
+	pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+	if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+	{
+		throw std::runtime_error("Failed to create pipeline layout for environment map!");
+	}
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage = compShaderStageInfo;
+	pipelineInfo.layout = pipelineLayout;
+
+	if (vkCreateComputePipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	{
+		throw std::runtime_error("Failed to create environment map compute pipeline!");
+	}
 }
 
 } // namespace ale
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "Renderer/PipelineCache.h"
+#include "alpch.h"
+#include "Renderer/VulkanUtil.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace ale
+{
+static constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x43504c41; // "ALPC"
+static constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+PipelineCache &PipelineCache::getPipelineCache()
+{
+	static PipelineCache pipelineCache;
+	return pipelineCache;
+}
+
+void PipelineCache::init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string &path)
+{
+	m_device = device;
+	m_path = path;
+	vkGetPhysicalDeviceProperties(physicalDevice, &m_properties);
+
+	std::vector<char> data = loadFile();
+
+	VkPipelineCacheCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	createInfo.initialDataSize = data.size();
+	createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+	if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS)
+	{
+		// driver 가 데이터를 받아주지 않으면 빈 cache 로 다시 만든다.
+		createInfo.initialDataSize = 0;
+		createInfo.pInitialData = nullptr;
+		if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create pipeline cache!");
+		}
+	}
+}
+
+void PipelineCache::cleanup()
+{
+	save();
+
+	vkDestroyPipelineCache(m_device, m_cache, nullptr);
+	m_cache = VK_NULL_HANDLE;
+}
+
+void PipelineCache::save()
+{
+	if (m_cache == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	size_t dataSize = 0;
+	if (vkGetPipelineCacheData(m_device, m_cache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+	{
+		return;
+	}
+	std::vector<char> data(dataSize);
+	if (vkGetPipelineCacheData(m_device, m_cache, &dataSize, data.data()) != VK_SUCCESS)
+	{
+		return;
+	}
+
+	FileHeader header = makeHeader();
+	header.dataSize = dataSize;
+	header.dataHash = VulkanUtil::hashData(data.data(), dataSize);
+
+	// 쓰는 도중 종료되어도 기존 파일이 깨지지 않도록 임시 파일에 쓰고 바꿔친다.
+	std::filesystem::path path(m_path);
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	std::error_code error;
+	if (path.has_parent_path())
+	{
+		std::filesystem::create_directories(path.parent_path(), error);
+	}
+
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			AL_CORE_WARN("PipelineCache: could not write {0}", tempPath.string());
+			return;
+		}
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(data.data(), dataSize);
+	}
+
+	std::filesystem::rename(tempPath, path, error);
+	if (error)
+	{
+		AL_CORE_WARN("PipelineCache: could not replace {0} ({1})", path.string(), error.message());
+	}
+}
+
+// header 가 현재 device / driver 와 맞는 파일이면 cache 데이터를, 아니면 빈 vector 를 돌려준다.
+std::vector<char> PipelineCache::loadFile()
+{
+	std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		return {};
+	}
+
+	size_t fileSize = static_cast<size_t>(file.tellg());
+	if (fileSize < sizeof(FileHeader))
+	{
+		return {};
+	}
+	file.seekg(0);
+
+	FileHeader header;
+	file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+	FileHeader expected = makeHeader();
+	if (header.magic != expected.magic || header.version != expected.version ||
+		header.vendorID != expected.vendorID || header.deviceID != expected.deviceID ||
+		header.driverVersion != expected.driverVersion ||
+		std::memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+	{
+		AL_CORE_INFO("PipelineCache: {0} was made for another device or driver, starting empty", m_path);
+		return {};
+	}
+	if (header.dataSize != fileSize - sizeof(FileHeader))
+	{
+		AL_CORE_WARN("PipelineCache: {0} is truncated, starting empty", m_path);
+		return {};
+	}
+
+	std::vector<char> data(header.dataSize);
+	file.read(data.data(), header.dataSize);
+	if (!file || VulkanUtil::hashData(data.data(), data.size()) != header.dataHash)
+	{
+		AL_CORE_WARN("PipelineCache: {0} is corrupted, starting empty", m_path);
+		return {};
+	}
+	return data;
+}
+
+PipelineCache::FileHeader PipelineCache::makeHeader()
+{
+	FileHeader header{};
+	header.magic = PIPELINE_CACHE_MAGIC;
+	header.version = PIPELINE_CACHE_VERSION;
+	header.vendorID = m_properties.vendorID;
+	header.deviceID = m_properties.deviceID;
+	header.driverVersion = m_properties.driverVersion;
+	std::memcpy(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+	return header;
+}
+
+} // namespace ale
@@ -0,0 +1,1009 @@
+#include "Renderer/RenderGraph.h"
+#include "alpch.h"
+#include "Renderer/VulkanUtil.h"
+
+namespace ale
+{
+static bool isDepthFormat(VkFormat format)
+{
+	return format == VK_FORMAT_D16_UNORM || format == VK_FORMAT_X8_D24_UNORM_PACK32 || format == VK_FORMAT_D32_SFLOAT ||
+		   format == VK_FORMAT_D16_UNORM_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT ||
+		   format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+}
+
+static bool hasStencilComponent(VkFormat format)
+{
+	return format == VK_FORMAT_D16_UNORM_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT ||
+		   format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+}
+
+std::unique_ptr<RenderGraph> RenderGraph::createRenderGraph(VkExtent2D extent)
+{
+	std::unique_ptr<RenderGraph> renderGraph = std::unique_ptr<RenderGraph>(new RenderGraph());
+	renderGraph->initRenderGraph(extent);
+	return renderGraph;
+}
+
+void RenderGraph::initRenderGraph(VkExtent2D extent)
+{
+	m_extent = extent;
+}
+
+void RenderGraph::cleanup()
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+	destroyResources(false);
+	for (Pass &pass : m_passes)
+	{
+		if (pass.renderPass != VK_NULL_HANDLE)
+		{
+			vkDestroyRenderPass(device, pass.renderPass, nullptr);
+			pass.renderPass = VK_NULL_HANDLE;
+		}
+	}
+	m_passes.clear();
+	m_images.clear();
+	m_passOrder.clear();
+	m_compiled = false;
+}
+
+RenderGraphHandle RenderGraph::createImage(const char *name, const RenderGraphImageInfo &info)
+{
+	ImageResource resource;
+	resource.name = name;
+	resource.info = info;
+	resource.usage = info.usage;
+	if (isDepthFormat(info.format))
+	{
+		resource.viewAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+		resource.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+		if (hasStencilComponent(info.format))
+		{
+			resource.aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
+	}
+	else
+	{
+		resource.viewAspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		resource.aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+	}
+	m_images.push_back(resource);
+	return static_cast<RenderGraphHandle>(m_images.size() - 1);
+}
+
+void RenderGraph::setOutput(RenderGraphHandle image, VkImageLayout layout)
+{
+	m_images[image].output = true;
+	m_images[image].outputLayout = layout;
+}
+
+void RenderGraph::shareMemory(RenderGraphHandle image, RenderGraphHandle other)
+{
+	// persistent 가 아닌 image 는 alias group 이 구간을 보고 나눈다.
+	if (!m_images[image].info.persistent || !m_images[other].info.persistent)
+	{
+		throw std::runtime_error("render graph can only share memory between persistent images!");
+	}
+	RenderGraphHandle owner = m_images[image].memoryOwner != UINT32_MAX ? m_images[image].memoryOwner : image;
+	m_images[image].memoryOwner = owner;
+	m_images[other].memoryOwner = owner;
+}
+
+RenderGraphHandle RenderGraph::addPass(const char *name, VkSubpassContents contents)
+{
+	Pass pass;
+	pass.name = name;
+	pass.subpasses.push_back({name, contents, {}, nullptr});
+	m_passes.push_back(pass);
+	return static_cast<RenderGraphHandle>(m_passes.size() - 1);
+}
+
+uint32_t RenderGraph::addSubpass(RenderGraphHandle pass, const char *name, VkSubpassContents contents)
+{
+	m_passes[pass].subpasses.push_back({name, contents, {}, nullptr});
+	return static_cast<uint32_t>(m_passes[pass].subpasses.size() - 1);
+}
+
+void RenderGraph::setRecord(RenderGraphHandle pass, uint32_t subpass, RenderGraphRecordFunction record)
+{
+	m_passes[pass].subpasses[subpass].record = std::move(record);
+}
+
+void RenderGraph::writeColor(RenderGraphHandle pass, uint32_t subpass, RenderGraphHandle image,
+							 VkAttachmentLoadOp loadOp, VkClearValue clearValue)
+{
+	m_passes[pass].subpasses[subpass].attachments.push_back(
+		{image, RenderGraphAccess::COLOR_ATTACHMENT, loadOp, clearValue});
+}
+
+void RenderGraph::writeDepth(RenderGraphHandle pass, uint32_t subpass, RenderGraphHandle image,
+							 VkAttachmentLoadOp loadOp, VkClearValue clearValue)
+{
+	m_passes[pass].subpasses[subpass].attachments.push_back(
+		{image, RenderGraphAccess::DEPTH_ATTACHMENT, loadOp, clearValue});
+}
+
+void RenderGraph::readInput(RenderGraphHandle pass, uint32_t subpass, RenderGraphHandle image)
+{
+	m_passes[pass].subpasses[subpass].attachments.push_back(
+		{image, RenderGraphAccess::INPUT_ATTACHMENT, VK_ATTACHMENT_LOAD_OP_LOAD, {}});
+}
+
+void RenderGraph::readSampled(RenderGraphHandle pass, RenderGraphHandle image)
+{
+	m_passes[pass].sampledImages.push_back(image);
+}
+
+void RenderGraph::setPassEnabled(RenderGraphHandle pass, bool enabled)
+{
+	m_passes[pass].enabled = enabled;
+}
+
+void RenderGraph::setRenderArea(RenderGraphHandle pass, VkExtent2D area)
+{
+	m_passes[pass].renderArea = area;
+}
+
+void RenderGraph::compile()
+{
+	if (m_compiled)
+	{
+		throw std::runtime_error("render graph is already compiled!");
+	}
+
+	cullPasses();
+	computeLifetimes();
+	for (uint32_t order = 0; order < m_passOrder.size(); order++)
+	{
+		createRenderPass(m_passes[m_passOrder[order]], order);
+	}
+	createResources();
+	m_compiled = true;
+
+	AL_CORE_INFO("RenderGraph: {0} passes ({1} culled), {2} images in {3} alias groups, {4:.1f} MB ({5:.1f} MB "
+				 "unaliased, {6:.1f} MB lazily allocated)",
+				 m_stats.passCount, m_stats.culledPassCount, m_stats.imageCount, m_stats.aliasGroupCount,
+				 m_stats.allocatedBytes / (1024.0 * 1024.0), m_stats.requestedBytes / (1024.0 * 1024.0),
+				 m_stats.lazyBytes / (1024.0 * 1024.0));
+}
+
+void RenderGraph::resize(VkExtent2D extent)
+{
+	if (extent.width == m_extent.width && extent.height == m_extent.height)
+	{
+		return;
+	}
+
+	// 호출하는 쪽에서 device 를 기다린 뒤여야 한다.
+	m_extent = extent;
+	destroyResources(true);
+	createResources();
+}
+
+/*
+	pass 는 앞에서 선언한 pass 의 결과만 읽으므로 뒤에서부터 훑는다.
+	output / 살아있는 pass 가 필요로 하는 image 를 쓰지 않는 pass 는 빠진다.
+*/
+void RenderGraph::cullPasses()
+{
+	std::vector<bool> needed(m_images.size(), false);
+	for (size_t i = 0; i < m_images.size(); i++)
+	{
+		needed[i] = m_images[i].output;
+	}
+
+	for (size_t i = m_passes.size(); i-- > 0;)
+	{
+		Pass &pass = m_passes[i];
+		pass.culled = true;
+		for (const Subpass &subpass : pass.subpasses)
+		{
+			for (const Attachment &attachment : subpass.attachments)
+			{
+				if (isWrite(attachment.access) && needed[attachment.image])
+				{
+					pass.culled = false;
+				}
+			}
+		}
+		if (pass.culled)
+		{
+			AL_CORE_INFO("RenderGraph: culled pass {0}", pass.name);
+			continue;
+		}
+
+		// 이 pass 가 읽는 image (이전 내용을 load 하는 attachment 포함) 를 쓰는 pass 도 살린다.
+		for (const Subpass &subpass : pass.subpasses)
+		{
+			for (const Attachment &attachment : subpass.attachments)
+			{
+				if (!isWrite(attachment.access) || attachment.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+				{
+					needed[attachment.image] = true;
+				}
+			}
+		}
+		for (RenderGraphHandle image : pass.sampledImages)
+		{
+			needed[image] = true;
+		}
+	}
+
+	m_passOrder.clear();
+	for (uint32_t i = 0; i < m_passes.size(); i++)
+	{
+		if (!m_passes[i].culled)
+		{
+			m_passOrder.push_back(i);
+		}
+	}
+}
+
+void RenderGraph::computeLifetimes()
+{
+	auto touch = [this](RenderGraphHandle image, uint32_t order, VkImageUsageFlags usage) {
+		ImageResource &resource = m_images[image];
+		resource.firstPass = std::min(resource.firstPass, order);
+		resource.lastPass = std::max(resource.lastPass, order);
+		resource.usage |= usage;
+	};
+
+	for (uint32_t order = 0; order < m_passOrder.size(); order++)
+	{
+		Pass &pass = m_passes[m_passOrder[order]];
+		for (const Subpass &subpass : pass.subpasses)
+		{
+			for (const Attachment &attachment : subpass.attachments)
+			{
+				VkImageUsageFlags usage = 0;
+				switch (attachment.access)
+				{
+				case RenderGraphAccess::COLOR_ATTACHMENT:
+					usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+					break;
+				case RenderGraphAccess::DEPTH_ATTACHMENT:
+					usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+					break;
+				default:
+					usage = VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+					break;
+				}
+				touch(attachment.image, order, usage);
+			}
+		}
+		for (RenderGraphHandle image : pass.sampledImages)
+		{
+			touch(image, order, VK_IMAGE_USAGE_SAMPLED_BIT);
+		}
+	}
+
+	// 한 render pass 안에서 쓰고 버리는 attachment 는 tile 메모리에만 있으면 된다.
+	for (ImageResource &resource : m_images)
+	{
+		resource.transientAttachment = resource.firstPass != UINT32_MAX && resource.firstPass == resource.lastPass &&
+									   !resource.info.persistent && !resource.output && resource.info.usage == 0 &&
+									   !(resource.usage & VK_IMAGE_USAGE_SAMPLED_BIT);
+		if (resource.transientAttachment)
+		{
+			resource.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+		}
+	}
+}
+
+void RenderGraph::createRenderPass(Pass &pass, uint32_t passOrder)
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+
+	pass.attachmentImages.clear();
+	pass.clearValues.clear();
+	pass.usages.clear();
+
+	auto findUsage = [&pass](RenderGraphHandle image) -> ImageUsage * {
+		for (ImageUsage &usage : pass.usages)
+		{
+			if (usage.image == image)
+			{
+				return &usage;
+			}
+		}
+		return nullptr;
+	};
+
+	// sampled image 는 pass 시작 전에 SHADER_READ_ONLY 로 둔다.
+	for (RenderGraphHandle image : pass.sampledImages)
+	{
+		ImageUsage usage{};
+		usage.image = image;
+		getAccessState(RenderGraphAccess::SAMPLED, usage.firstLayout, usage.firstStage, usage.firstAccess);
+		usage.lastLayout = usage.firstLayout;
+		usage.stage = usage.firstStage;
+		pass.usages.push_back(usage);
+	}
+
+	std::vector<VkAttachmentDescription> descriptions;
+	std::vector<std::vector<VkAttachmentReference>> colorReferences(pass.subpasses.size());
+	std::vector<std::vector<VkAttachmentReference>> inputReferences(pass.subpasses.size());
+	std::vector<VkAttachmentReference> depthReferences(pass.subpasses.size(), {VK_ATTACHMENT_UNUSED});
+
+	for (size_t s = 0; s < pass.subpasses.size(); s++)
+	{
+		for (const Attachment &attachment : pass.subpasses[s].attachments)
+		{
+			VkImageLayout layout;
+			VkPipelineStageFlags stage;
+			VkAccessFlags access;
+			getAccessState(attachment.access, layout, stage, access);
+
+			ImageResource &resource = m_images[attachment.image];
+			ImageUsage *usage = findUsage(attachment.image);
+			if (usage && usage->attachmentIndex == UINT32_MAX)
+			{
+				throw std::runtime_error("render graph image is sampled and attached in the same pass!");
+			}
+			if (!usage)
+			{
+				ImageUsage newUsage{};
+				newUsage.image = attachment.image;
+				newUsage.firstLayout = layout;
+				newUsage.firstStage = stage;
+				newUsage.firstAccess = access;
+				newUsage.discard = isWrite(attachment.access) && attachment.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD;
+				newUsage.attachmentIndex = static_cast<uint32_t>(descriptions.size());
+				pass.usages.push_back(newUsage);
+				usage = &pass.usages.back();
+
+				// 뒤에서 읽지 않는 transient image 는 store 하지 않는다. (G-buffer, depth)
+				bool store = resource.info.persistent || resource.output || resource.lastPass > passOrder;
+				VkAttachmentDescription description{};
+				description.format = resource.info.format;
+				description.samples = VK_SAMPLE_COUNT_1_BIT;
+				description.loadOp = attachment.loadOp;
+				description.storeOp = store ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+				description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+				description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+				description.initialLayout = layout;
+				descriptions.push_back(description);
+
+				pass.attachmentImages.push_back(attachment.image);
+				pass.clearValues.push_back(attachment.clearValue);
+			}
+			usage->lastLayout = layout;
+			usage->stage |= stage;
+			if (isWrite(attachment.access))
+			{
+				usage->writeAccess |=
+					access & (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+			}
+			descriptions[usage->attachmentIndex].finalLayout = layout;
+
+			VkAttachmentReference reference{usage->attachmentIndex, layout};
+			switch (attachment.access)
+			{
+			case RenderGraphAccess::COLOR_ATTACHMENT:
+				colorReferences[s].push_back(reference);
+				break;
+			case RenderGraphAccess::DEPTH_ATTACHMENT:
+				depthReferences[s] = reference;
+				break;
+			default:
+				inputReferences[s].push_back(reference);
+				break;
+			}
+		}
+	}
+
+	if (pass.attachmentImages.empty())
+	{
+		throw std::runtime_error("render graph pass has no attachments!");
+	}
+
+	std::vector<VkSubpassDescription> subpasses(pass.subpasses.size());
+	for (size_t s = 0; s < pass.subpasses.size(); s++)
+	{
+		VkSubpassDescription &subpass = subpasses[s];
+		subpass = {};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = static_cast<uint32_t>(colorReferences[s].size());
+		subpass.pColorAttachments = colorReferences[s].data();
+		subpass.inputAttachmentCount = static_cast<uint32_t>(inputReferences[s].size());
+		subpass.pInputAttachments = inputReferences[s].data();
+		subpass.pDepthStencilAttachment =
+			depthReferences[s].attachment == VK_ATTACHMENT_UNUSED ? nullptr : &depthReferences[s];
+	}
+
+	// 앞 subpass 가 쓴 attachment 를 뒤 subpass 가 쓰면 그 사이에 dependency 를 둔다.
+	// pass 앞뒤의 동기화는 execute 에서 pipeline barrier 로 하므로 external dependency 는 없다.
+	std::vector<VkSubpassDependency> dependencies;
+	for (uint32_t dst = 1; dst < pass.subpasses.size(); dst++)
+	{
+		for (uint32_t src = 0; src < dst; src++)
+		{
+			VkSubpassDependency dependency{};
+			dependency.srcSubpass = src;
+			dependency.dstSubpass = dst;
+			dependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+			for (const Attachment &written : pass.subpasses[src].attachments)
+			{
+				if (!isWrite(written.access))
+				{
+					continue;
+				}
+				for (const Attachment &read : pass.subpasses[dst].attachments)
+				{
+					if (read.image != written.image)
+					{
+						continue;
+					}
+					VkImageLayout layout;
+					VkPipelineStageFlags stage;
+					VkAccessFlags access;
+					getAccessState(written.access, layout, stage, access);
+					dependency.srcStageMask |= stage;
+					dependency.srcAccessMask |= access;
+					getAccessState(read.access, layout, stage, access);
+					dependency.dstStageMask |= stage;
+					dependency.dstAccessMask |= access;
+				}
+			}
+			if (dependency.srcStageMask != 0)
+			{
+				dependencies.push_back(dependency);
+			}
+		}
+	}
+
+	VkRenderPassCreateInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassInfo.attachmentCount = static_cast<uint32_t>(descriptions.size());
+	renderPassInfo.pAttachments = descriptions.data();
+	renderPassInfo.subpassCount = static_cast<uint32_t>(subpasses.size());
+	renderPassInfo.pSubpasses = subpasses.data();
+	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	renderPassInfo.pDependencies = dependencies.data();
+
+	if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &pass.renderPass) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create render graph render pass!");
+	}
+}
+
+void RenderGraph::createResources()
+{
+	auto &allocator = MemoryAllocator::getAllocator();
+	VkMemoryPropertyFlags lazyProperties =
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+	m_stats = RenderGraphStats{};
+	m_stats.passCount = static_cast<uint32_t>(m_passOrder.size());
+	m_stats.culledPassCount = static_cast<uint32_t>(m_passes.size() - m_passOrder.size());
+
+	std::vector<RenderGraphHandle> sharedImages;
+	for (uint32_t i = 0; i < m_images.size(); i++)
+	{
+		ImageResource &resource = m_images[i];
+		if (resource.firstPass == UINT32_MAX)
+		{
+			continue;
+		}
+		m_stats.imageCount++;
+
+		// resize 에서 남겨둔 image (크기가 고정된 persistent image)
+		if (resource.image != VK_NULL_HANDLE)
+		{
+			m_stats.requestedBytes += resource.requirements.size;
+			m_stats.allocatedBytes +=
+				resource.memoryOwner == UINT32_MAX ? resource.requirements.size : resource.allocation.size;
+			continue;
+		}
+
+		createImage(resource);
+		m_stats.requestedBytes += resource.requirements.size;
+		if (resource.memoryOwner != UINT32_MAX)
+		{
+			sharedImages.push_back(i);
+		}
+		else if (resource.info.persistent || resource.output)
+		{
+			resource.allocation = allocator.allocateImageMemory(resource.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			m_stats.allocatedBytes += resource.requirements.size;
+		}
+		else if (resource.transientAttachment &&
+				 allocator.hasMemoryType(resource.requirements.memoryTypeBits, lazyProperties))
+		{
+			resource.allocation = allocator.allocateImageMemory(resource.image, lazyProperties);
+			m_stats.lazyBytes += resource.requirements.size;
+		}
+	}
+
+	allocateSharedMemory(sharedImages);
+	allocateAliasGroups();
+	m_stats.aliasGroupCount = static_cast<uint32_t>(m_aliasGroups.size());
+
+	for (ImageResource &resource : m_images)
+	{
+		if (resource.image == VK_NULL_HANDLE || resource.imageView != VK_NULL_HANDLE)
+		{
+			continue;
+		}
+		if (resource.info.cube)
+		{
+			resource.imageView =
+				VulkanUtil::createCubeMapImageView(resource.image, resource.info.format, resource.viewAspect, 1);
+		}
+		else if (resource.info.layers == 1)
+		{
+			resource.imageView =
+				VulkanUtil::createImageView(resource.image, resource.info.format, resource.viewAspect, 1);
+		}
+		else
+		{
+			throw std::runtime_error("render graph does not support layered 2D images!");
+		}
+	}
+
+	for (RenderGraphHandle passIndex : m_passOrder)
+	{
+		createFramebuffer(m_passes[passIndex]);
+	}
+}
+
+void RenderGraph::destroyResources(bool keepFixedSize)
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+	auto &allocator = MemoryAllocator::getAllocator();
+
+	for (Pass &pass : m_passes)
+	{
+		if (pass.framebuffer != VK_NULL_HANDLE)
+		{
+			vkDestroyFramebuffer(device, pass.framebuffer, nullptr);
+			pass.framebuffer = VK_NULL_HANDLE;
+		}
+	}
+
+	for (ImageResource &resource : m_images)
+	{
+		// 크기가 고정된 persistent image 는 resize 에서 내용을 그대로 둔다. (캐시한 shadow map)
+		if (keepFixedSize && resource.info.persistent && resource.info.width != 0)
+		{
+			continue;
+		}
+		if (resource.imageView != VK_NULL_HANDLE)
+		{
+			vkDestroyImageView(device, resource.imageView, nullptr);
+			resource.imageView = VK_NULL_HANDLE;
+		}
+		if (resource.image != VK_NULL_HANDLE)
+		{
+			vkDestroyImage(device, resource.image, nullptr);
+			resource.image = VK_NULL_HANDLE;
+		}
+		allocator.free(resource.allocation);
+		resource.aliasGroup = UINT32_MAX;
+		resource.state = ImageState{};
+		resource.frame = UINT32_MAX;
+	}
+
+	for (AliasGroup &group : m_aliasGroups)
+	{
+		allocator.free(group.allocation);
+	}
+	m_aliasGroups.clear();
+}
+
+void RenderGraph::createImage(ImageResource &resource)
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.flags = resource.info.cube ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.extent.width = resource.info.width ? resource.info.width : m_extent.width;
+	imageInfo.extent.height = resource.info.height ? resource.info.height : m_extent.height;
+	imageInfo.extent.depth = 1;
+	imageInfo.mipLevels = 1;
+	imageInfo.arrayLayers = resource.info.layers;
+	imageInfo.format = resource.info.format;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageInfo.usage = resource.usage;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	if (vkCreateImage(device, &imageInfo, nullptr, &resource.image) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create render graph image!");
+	}
+	vkGetImageMemoryRequirements(device, resource.image, &resource.requirements);
+	resource.state = ImageState{};
+	resource.frame = UINT32_MAX;
+}
+
+/*
+	아직 메모리가 없는 transient image 를 처음 쓰는 순서대로 훑으면서,
+	살아있는 구간이 겹치지 않는 image 만 모인 group 에 넣는다. (first fit)
+	group 은 가장 큰 image 크기만큼 할당하고 모든 image 를 같은 offset 에 bind 한다.
+*/
+void RenderGraph::allocateAliasGroups()
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+
+	std::vector<RenderGraphHandle> candidates;
+	for (uint32_t i = 0; i < m_images.size(); i++)
+	{
+		if (m_images[i].image != VK_NULL_HANDLE && m_images[i].allocation.memory == VK_NULL_HANDLE &&
+			m_images[i].aliasGroup == UINT32_MAX && m_images[i].memoryOwner == UINT32_MAX)
+		{
+			candidates.push_back(i);
+		}
+	}
+	std::stable_sort(candidates.begin(), candidates.end(), [this](RenderGraphHandle a, RenderGraphHandle b) {
+		return m_images[a].firstPass < m_images[b].firstPass;
+	});
+
+	for (RenderGraphHandle candidate : candidates)
+	{
+		ImageResource &resource = m_images[candidate];
+		uint32_t groupIndex = UINT32_MAX;
+		for (uint32_t g = 0; g < m_aliasGroups.size() && groupIndex == UINT32_MAX; g++)
+		{
+			AliasGroup &group = m_aliasGroups[g];
+			if ((group.requirements.memoryTypeBits & resource.requirements.memoryTypeBits) == 0)
+			{
+				continue;
+			}
+			bool overlaps = false;
+			for (RenderGraphHandle member : group.images)
+			{
+				const ImageResource &other = m_images[member];
+				if (!(other.lastPass < resource.firstPass || resource.lastPass < other.firstPass))
+				{
+					overlaps = true;
+					break;
+				}
+			}
+			if (!overlaps)
+			{
+				groupIndex = g;
+			}
+		}
+
+		if (groupIndex == UINT32_MAX)
+		{
+			m_aliasGroups.emplace_back();
+			m_aliasGroups.back().requirements.memoryTypeBits = UINT32_MAX;
+			groupIndex = static_cast<uint32_t>(m_aliasGroups.size() - 1);
+		}
+
+		AliasGroup &group = m_aliasGroups[groupIndex];
+		group.images.push_back(candidate);
+		group.requirements.size = std::max(group.requirements.size, resource.requirements.size);
+		group.requirements.alignment = std::max(group.requirements.alignment, resource.requirements.alignment);
+		group.requirements.memoryTypeBits &= resource.requirements.memoryTypeBits;
+		resource.aliasGroup = groupIndex;
+	}
+
+	for (AliasGroup &group : m_aliasGroups)
+	{
+		group.allocation = MemoryAllocator::getAllocator().allocateImageMemory(group.requirements,
+																			   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		for (RenderGraphHandle image : group.images)
+		{
+			vkBindImageMemory(device, m_images[image].image, group.allocation.memory, group.allocation.offset);
+		}
+		m_stats.allocatedBytes += group.requirements.size;
+	}
+}
+
+/*
+	shareMemory 로 묶은 image 들은 가장 큰 requirements 로 한 번 할당하고 모두 같은 offset 에 bind 한다.
+	메모리는 묶음의 처음 image 가 가진다.
+*/
+void RenderGraph::allocateSharedMemory(const std::vector<RenderGraphHandle> &images)
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+
+	std::vector<RenderGraphHandle> sorted = images;
+	std::stable_sort(sorted.begin(), sorted.end(), [this](RenderGraphHandle a, RenderGraphHandle b) {
+		return m_images[a].memoryOwner < m_images[b].memoryOwner;
+	});
+
+	for (size_t begin = 0; begin < sorted.size();)
+	{
+		RenderGraphHandle owner = m_images[sorted[begin]].memoryOwner;
+		VkMemoryRequirements requirements{};
+		requirements.memoryTypeBits = UINT32_MAX;
+		size_t end = begin;
+		for (; end < sorted.size() && m_images[sorted[end]].memoryOwner == owner; end++)
+		{
+			const VkMemoryRequirements &member = m_images[sorted[end]].requirements;
+			requirements.size = std::max(requirements.size, member.size);
+			requirements.alignment = std::max(requirements.alignment, member.alignment);
+			requirements.memoryTypeBits &= member.memoryTypeBits;
+		}
+
+		ImageResource &holder = m_images[sorted[begin]];
+		holder.allocation =
+			MemoryAllocator::getAllocator().allocateImageMemory(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		for (size_t i = begin; i < end; i++)
+		{
+			vkBindImageMemory(device, m_images[sorted[i]].image, holder.allocation.memory, holder.allocation.offset);
+			// execute 전에 resize 가 여러 번 와도 한 번만 넣는다.
+			if (std::find(m_sharedLayoutImages.begin(), m_sharedLayoutImages.end(), sorted[i]) ==
+				m_sharedLayoutImages.end())
+			{
+				m_sharedLayoutImages.push_back(sorted[i]);
+			}
+		}
+		m_stats.allocatedBytes += requirements.size;
+		begin = end;
+	}
+}
+
+void RenderGraph::createFramebuffer(Pass &pass)
+{
+	VkDevice device = VulkanContext::getContext().getDevice();
+
+	std::vector<VkImageView> attachments;
+	uint32_t layers = UINT32_MAX;
+	for (RenderGraphHandle image : pass.attachmentImages)
+	{
+		const ImageResource &resource = m_images[image];
+		attachments.push_back(resource.imageView);
+		layers = std::min(layers, resource.info.layers);
+	}
+
+	const RenderGraphImageInfo &info = m_images[pass.attachmentImages[0]].info;
+	pass.extent.width = info.width ? info.width : m_extent.width;
+	pass.extent.height = info.height ? info.height : m_extent.height;
+
+	VkFramebufferCreateInfo framebufferInfo{};
+	framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+	framebufferInfo.renderPass = pass.renderPass;
+	framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+	framebufferInfo.pAttachments = attachments.data();
+	framebufferInfo.width = pass.extent.width;
+	framebufferInfo.height = pass.extent.height;
+	framebufferInfo.layers = layers;
+
+	if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &pass.framebuffer) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create render graph framebuffer!");
+	}
+}
+
+void RenderGraph::execute(VkCommandBuffer commandBuffer, GpuProfiler *profiler)
+{
+	m_frame++;
+	if (!m_sharedLayoutImages.empty())
+	{
+		recordSharedLayouts(commandBuffer);
+	}
+
+	for (uint32_t order = 0; order < m_passOrder.size(); order++)
+	{
+		Pass &pass = m_passes[m_passOrder[order]];
+		if (!pass.enabled)
+		{
+			continue;
+		}
+
+		recordBarriers(commandBuffer, pass);
+
+		// SECONDARY_COMMAND_BUFFERS subpass 안에서는 timestamp 를 쓸 수 없으므로 그 시간은 앞 subpass 에 합쳐진다.
+		uint32_t scope = profiler ? profiler->beginScope(commandBuffer, pass.subpasses[0].name) : UINT32_MAX;
+
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = pass.renderPass;
+		renderPassInfo.framebuffer = pass.framebuffer;
+		renderPassInfo.renderArea.offset = {0, 0};
+		renderPassInfo.renderArea.extent = pass.extent;
+		if (pass.renderArea.width != 0 && pass.renderArea.height != 0)
+		{
+			renderPassInfo.renderArea.extent.width = std::min(pass.renderArea.width, pass.extent.width);
+			renderPassInfo.renderArea.extent.height = std::min(pass.renderArea.height, pass.extent.height);
+		}
+		renderPassInfo.clearValueCount = static_cast<uint32_t>(pass.clearValues.size());
+		renderPassInfo.pClearValues = pass.clearValues.data();
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, pass.subpasses[0].contents);
+
+		for (size_t s = 0; s < pass.subpasses.size(); s++)
+		{
+			Subpass &subpass = pass.subpasses[s];
+			if (s > 0)
+			{
+				vkCmdNextSubpass(commandBuffer, subpass.contents);
+				if (profiler && subpass.contents == VK_SUBPASS_CONTENTS_INLINE)
+				{
+					profiler->endScope(commandBuffer, scope);
+					scope = profiler->beginScope(commandBuffer, subpass.name);
+				}
+			}
+			if (subpass.record)
+			{
+				subpass.record(commandBuffer);
+			}
+		}
+
+		vkCmdEndRenderPass(commandBuffer);
+		if (profiler)
+		{
+			profiler->endScope(commandBuffer, scope);
+		}
+
+		finishPass(pass);
+	}
+	recordOutputBarriers(commandBuffer);
+}
+
+/*
+	pass 에서 처음 쓰는 layout 으로 바꾸고, 이전 접근 (이전 pass, 이전 프레임, 같은 메모리를 쓰던 다른 image) 을 기다린다.
+	persistent 가 아닌 image 는 프레임의 첫 사용에서 내용을 버리므로 UNDEFINED 에서 바꾼다.
+*/
+void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, Pass &pass)
+{
+	std::vector<VkImageMemoryBarrier> barriers;
+	VkPipelineStageFlags srcStage = 0;
+	VkPipelineStageFlags dstStage = 0;
+
+	for (const ImageUsage &usage : pass.usages)
+	{
+		ImageResource &resource = m_images[usage.image];
+		ImageState src = resource.state;
+		bool firstUse = !resource.info.persistent && resource.frame != m_frame;
+		if (firstUse && resource.aliasGroup != UINT32_MAX)
+		{
+			src.stage = m_aliasGroups[resource.aliasGroup].state.stage;
+			src.access = m_aliasGroups[resource.aliasGroup].state.access;
+		}
+		resource.frame = m_frame;
+
+		VkImageLayout oldLayout = (firstUse || usage.discard) ? VK_IMAGE_LAYOUT_UNDEFINED : src.layout;
+		bool readOnly = (usage.firstAccess & (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+											  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)) == 0;
+		if (oldLayout == usage.firstLayout && src.access == 0 && readOnly)
+		{
+			continue;
+		}
+
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask = src.access;
+		barrier.dstAccessMask = usage.firstAccess;
+		barrier.oldLayout = oldLayout;
+		barrier.newLayout = usage.firstLayout;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = resource.image;
+		barrier.subresourceRange = {resource.aspect, 0, 1, 0, resource.info.layers};
+		barriers.push_back(barrier);
+
+		srcStage |= src.stage ? src.stage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		dstStage |= usage.firstStage;
+	}
+
+	if (!barriers.empty())
+	{
+		vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr,
+							 static_cast<uint32_t>(barriers.size()), barriers.data());
+	}
+}
+
+/*
+	shareMemory 로 묶은 image 는 어떤 pass 가 쓰기 전에 모두 한 번에 sampled layout 으로 바꿔둔다.
+	쓰지 않는 쪽을 나중에 UNDEFINED 에서 바꾸면 같은 메모리에 그려둔 다른 image 의 내용이 깨질 수 있다.
+	이후에는 그리는 pass 만 UNDEFINED 에서 바꾸고 (CLEAR), 읽기만 하는 쪽은 barrier 가 필요 없다.
+*/
+void RenderGraph::recordSharedLayouts(VkCommandBuffer commandBuffer)
+{
+	VkImageLayout layout;
+	VkPipelineStageFlags stage;
+	VkAccessFlags access;
+	getAccessState(RenderGraphAccess::SAMPLED, layout, stage, access);
+
+	std::vector<VkImageMemoryBarrier> barriers;
+	for (RenderGraphHandle image : m_sharedLayoutImages)
+	{
+		ImageResource &resource = m_images[image];
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = 0;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = layout;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = resource.image;
+		barrier.subresourceRange = {resource.aspect, 0, 1, 0, resource.info.layers};
+		barriers.push_back(barrier);
+
+		resource.state.layout = layout;
+		resource.state.stage = stage;
+		resource.state.access = 0;
+	}
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, stage, 0, 0, nullptr, 0, nullptr,
+						 static_cast<uint32_t>(barriers.size()), barriers.data());
+	m_sharedLayoutImages.clear();
+}
+
+void RenderGraph::finishPass(Pass &pass)
+{
+	for (const ImageUsage &usage : pass.usages)
+	{
+		ImageResource &resource = m_images[usage.image];
+		resource.state.layout = usage.lastLayout;
+		resource.state.stage = usage.stage;
+		resource.state.access = usage.writeAccess;
+		if (resource.aliasGroup != UINT32_MAX)
+		{
+			m_aliasGroups[resource.aliasGroup].state = resource.state;
+		}
+	}
+}
+
+void RenderGraph::recordOutputBarriers(VkCommandBuffer commandBuffer)
+{
+	for (ImageResource &resource : m_images)
+	{
+		if (!resource.output || resource.image == VK_NULL_HANDLE || resource.state.layout == resource.outputLayout)
+		{
+			continue;
+		}
+
+		VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkAccessFlags dstAccess = VK_ACCESS_MEMORY_READ_BIT;
+		if (resource.outputLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+		{
+			dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			dstAccess = VK_ACCESS_SHADER_READ_BIT;
+		}
+		else if (resource.outputLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+		{
+			dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			dstAccess = VK_ACCESS_TRANSFER_READ_BIT;
+		}
+
+		VulkanUtil::insertImageMemoryBarrier(
+			commandBuffer, resource.image, resource.state.access, dstAccess, resource.state.layout,
+			resource.outputLayout, resource.state.stage ? resource.state.stage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			dstStage, {resource.aspect, 0, 1, 0, resource.info.layers});
+		resource.state = {resource.outputLayout, dstStage, 0};
+	}
+}
+
+void RenderGraph::getAccessState(RenderGraphAccess access, VkImageLayout &layout, VkPipelineStageFlags &stage,
+								 VkAccessFlags &accessMask)
+{
+	switch (access)
+	{
+	case RenderGraphAccess::COLOR_ATTACHMENT:
+		layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		accessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		break;
+	case RenderGraphAccess::DEPTH_ATTACHMENT:
+		layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		stage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		accessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		break;
+	case RenderGraphAccess::INPUT_ATTACHMENT:
+		layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		accessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+		break;
+	case RenderGraphAccess::SAMPLED:
+		layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		accessMask = VK_ACCESS_SHADER_READ_BIT;
+		break;
+	}
+}
+
+bool RenderGraph::isWrite(RenderGraphAccess access)
+{
+	return access == RenderGraphAccess::COLOR_ATTACHMENT || access == RenderGraphAccess::DEPTH_ATTACHMENT;
+}
+
+} // namespace ale
@@ -142,130 +142,6 @@ void RenderPass::initRenderPass(VkFormat swapChainImageFormat)
 	}
 }
 
-std::unique_ptr<RenderPass> RenderPass::createDeferredRenderPass()
-{
-	std::unique_ptr<RenderPass> renderPass = std::unique_ptr<RenderPass>(new RenderPass());
-	renderPass->initDeferredRenderPass();
-	return renderPass;
-}
-
-void RenderPass::initDeferredRenderPass()
-{
-	auto &context = VulkanContext::getContext();
-	VkDevice device = context.getDevice();
-
-	// Position Attachment
-	VkAttachmentDescription positionAttachment{};
-	positionAttachment.format = VK_FORMAT_R16G16B16A16_SFLOAT;
-	positionAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	positionAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	positionAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	positionAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	positionAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-	// Normal Attachment
-	VkAttachmentDescription normalAttachment = positionAttachment;
-
-	// Albedo Attachment
-	VkAttachmentDescription albedoAttachment{};
-	albedoAttachment.format = VK_FORMAT_R8G8B8A8_UNORM;
-	albedoAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	albedoAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	albedoAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	albedoAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	albedoAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-	// PBR Attachment
-	VkAttachmentDescription pbrAttachment = albedoAttachment;
-
-	// Depth Attachment
-	VkAttachmentDescription depthAttachment{};
-	depthAttachment.format = VulkanUtil::findDepthFormat();
-	depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-	// result attachment
-	VkAttachmentDescription resultAttachment{};
-	resultAttachment.format = VK_FORMAT_R8G8B8A8_UNORM;
-	resultAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	resultAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	resultAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	resultAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	resultAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-	// Subpass 1 - Geometry Pass
-	VkAttachmentReference positionRef{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-	VkAttachmentReference normalRef{1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-	VkAttachmentReference albedoRef{2, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-	VkAttachmentReference pbrRef{3, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-	VkAttachmentReference depthRef{4, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
-
-	VkAttachmentReference geometryAttachments[] = {positionRef, normalRef, albedoRef, pbrRef};
-
-	VkSubpassDescription subpass1{};
-	subpass1.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass1.colorAttachmentCount = 4;
-	subpass1.pColorAttachments = geometryAttachments;
-	subpass1.pDepthStencilAttachment = &depthRef;
-
-	// Subpass 2 - Lighting Pass
-	VkAttachmentReference positionInputRef{0, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
-	VkAttachmentReference normalInputRef{1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
-	VkAttachmentReference albedoInputRef{2, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
-	VkAttachmentReference pbrInputRef{3, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
-	VkAttachmentReference swapChainRef{5, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-
-	VkAttachmentReference inputAttachments[] = {positionInputRef, normalInputRef, albedoInputRef, pbrInputRef};
-
-	VkSubpassDescription subpass2{};
-	subpass2.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass2.inputAttachmentCount = 4;
-	subpass2.pInputAttachments = inputAttachments;
-	subpass2.colorAttachmentCount = 1;
-	subpass2.pColorAttachments = &swapChainRef;
-
-	// Subpass Dependencies
-	std::array<VkSubpassDependency, 2> dependencies{};
-	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-	dependencies[0].dstSubpass = 0;
-	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependencies[0].srcAccessMask = 0;
-	dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-	dependencies[1].srcSubpass = 0;
-	dependencies[1].dstSubpass = 1;
-	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-	dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-	dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-	// Render Pass 생성
-	std::array<VkAttachmentDescription, 6> attachments = {positionAttachment, normalAttachment, albedoAttachment,
-														  pbrAttachment,	  depthAttachment,	resultAttachment};
-
-	VkSubpassDescription subpasses[] = {subpass1, subpass2};
-
-	VkRenderPassCreateInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-	renderPassInfo.pAttachments = attachments.data();
-	renderPassInfo.subpassCount = 2;
-	renderPassInfo.pSubpasses = subpasses;
-	renderPassInfo.dependencyCount = 2;
-	renderPassInfo.pDependencies = dependencies.data();
-
-	if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
-	{
-		throw std::runtime_error("failed to create deferred render pass!");
-	}
-}
-
 std::unique_ptr<RenderPass> RenderPass::createImGuiRenderPass(VkFormat swapChainImageFormat)
 {
 	std::unique_ptr<RenderPass> renderPass = std::unique_ptr<RenderPass>(new RenderPass());
@@ -325,170 +201,4 @@ void RenderPass::initImGuiRenderPass(VkFormat swapChainImageFormat)
 	}
 }
 
-std::unique_ptr<RenderPass> RenderPass::createShadowMapRenderPass()
-{
-	std::unique_ptr<RenderPass> renderPass = std::unique_ptr<RenderPass>(new RenderPass());
-	renderPass->initShadowMapRenderPass();
-	return renderPass;
-}
-
-void RenderPass::initShadowMapRenderPass()
-{
-	auto &context = VulkanContext::getContext();
-	VkDevice device = context.getDevice();
-
-	// Depth Attachment 설정
-	VkAttachmentDescription depthAttachment{};
-	depthAttachment.format = VulkanUtil::findDepthFormat();
-	depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-
-	// Subpass 설정
-	VkAttachmentReference depthAttachmentRef{};
-	depthAttachmentRef.attachment = 0; // Depth Attachment는 첫 번째 (0번째)
-	depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-	VkSubpassDescription subpass{};
-	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass.colorAttachmentCount = 0; // Color Attachment 없음
-	subpass.pDepthStencilAttachment = &depthAttachmentRef;
-
-	// Subpass 종속성 설정
-	VkSubpassDependency dependency{};
-	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-	dependency.dstSubpass = 0;
-	dependency.srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-	dependency.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	dependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-	dependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-
-	// RenderPass 생성
-	VkRenderPassCreateInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassInfo.attachmentCount = 1;
-	renderPassInfo.pAttachments = &depthAttachment;
-	renderPassInfo.subpassCount = 1;
-	renderPassInfo.pSubpasses = &subpass;
-	renderPassInfo.dependencyCount = 1;
-	renderPassInfo.pDependencies = &dependency;
-
-	if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
-	{
-		throw std::runtime_error("Failed to create shadow map render pass!");
-	}
-}
-
-std::unique_ptr<RenderPass> RenderPass::createSphericalMapRenderPass()
-{
-	std::unique_ptr<RenderPass> renderPass = std::unique_ptr<RenderPass>(new RenderPass());
-	renderPass->initSphericalMapRenderPass();
-	return renderPass;
-}
-
-void RenderPass::initSphericalMapRenderPass()
-{
-	auto &context = VulkanContext::getContext();
-	VkDevice device = context.getDevice();
-
-	VkAttachmentDescription colorAttachment{};
-	colorAttachment.format = VK_FORMAT_R16G16B16A16_SFLOAT;
-	colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-	VkAttachmentReference colorAttachmentRef{};
-	colorAttachmentRef.attachment = 0;
-	colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-	VkSubpassDescription subpass{};
-	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass.colorAttachmentCount = 1;
-	subpass.pColorAttachments = &colorAttachmentRef;
-
-	VkSubpassDependency dependency{};
-	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-	dependency.dstSubpass = 0;
-	dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependency.srcAccessMask = 0;
-	dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-	VkRenderPassCreateInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassInfo.attachmentCount = 1;
-	renderPassInfo.pAttachments = &colorAttachment;
-	renderPassInfo.subpassCount = 1;
-	renderPassInfo.pSubpasses = &subpass;
-	renderPassInfo.dependencyCount = 1;
-	renderPassInfo.pDependencies = &dependency;
-
-	if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
-	{
-		throw std::runtime_error("Failed to create Spherical Map Render Pass!");
-	}
-}
-
-std::unique_ptr<RenderPass> RenderPass::createBackgroundRenderPass()
-{
-	std::unique_ptr<RenderPass> renderPass = std::unique_ptr<RenderPass>(new RenderPass());
-	renderPass->initBackgroundRenderPass();
-	return renderPass;
-}
-
-void RenderPass::initBackgroundRenderPass()
-{
-	auto &context = VulkanContext::getContext();
-	VkDevice device = context.getDevice();
-
-	VkAttachmentDescription colorAttachment{};
-	colorAttachment.format = VK_FORMAT_R16G16B16A16_SFLOAT;
-	colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-	VkAttachmentReference colorAttachmentRef{};
-	colorAttachmentRef.attachment = 0;
-	colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-	VkSubpassDescription subpass{};
-	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpass.colorAttachmentCount = 1;
-	subpass.pColorAttachments = &colorAttachmentRef;
-
-	VkSubpassDependency dependency{};
-	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-	dependency.dstSubpass = 0;
-	dependency.srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-	dependency.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-	VkRenderPassCreateInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassInfo.attachmentCount = 1;
-	renderPassInfo.pAttachments = &colorAttachment;
-	renderPassInfo.subpassCount = 1;
-	renderPassInfo.pSubpasses = &subpass;
-	renderPassInfo.dependencyCount = 1;
-	renderPassInfo.pDependencies = &dependency;
-
-	if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
-	{
-		throw std::runtime_error("Failed to create Background RenderPass!");
-	}
-}
-
 } // namespace ale
\ No newline at end of file
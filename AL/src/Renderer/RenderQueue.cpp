@@ -0,0 +1,87 @@
+#include "Renderer/RenderQueue.h"
+#include "alpch.h"
+
+namespace ale
+{
+uint64_t RenderQueue::makeKey(uint32_t pipelineId, uint32_t materialId, uint32_t meshId, float depth, float maxDepth)
+{
+	constexpr uint64_t depthMask = (1ull << DEPTH_BITS) - 1;
+	constexpr uint64_t meshMask = (1ull << MESH_BITS) - 1;
+	constexpr uint64_t materialMask = (1ull << MATERIAL_BITS) - 1;
+	constexpr uint64_t pipelineMask = (1ull << PIPELINE_BITS) - 1;
+
+	// 카메라와의 거리를 [0, maxDepth] 구간에서 양자화 (멀리 있는 것은 마지막 bucket)
+	float normalizedDepth = std::clamp(depth / maxDepth, 0.0f, 1.0f);
+	uint64_t depthBucket = static_cast<uint64_t>(normalizedDepth * static_cast<float>(depthMask));
+
+	// mask 로 자르면 다른 material 과 섞이므로 범위를 넘는 id 는 마지막 값에 모은다. (정렬만 덜 묶일 뿐 batch 는 안전)
+	if (materialId > materialMask || meshId > meshMask)
+	{
+		static bool warned = false;
+		if (!warned)
+		{
+			AL_CORE_WARN("RenderQueue: material id {0} / mesh id {1} exceeds the sort key range", materialId, meshId);
+			warned = true;
+		}
+	}
+
+	uint64_t key = (static_cast<uint64_t>(pipelineId) & pipelineMask) << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS);
+	key |= std::min<uint64_t>(materialId, materialMask) << (MESH_BITS + DEPTH_BITS);
+	key |= std::min<uint64_t>(meshId, meshMask) << DEPTH_BITS;
+	key |= depthBucket & depthMask;
+	return key;
+}
+
+void RenderQueue::sort()
+{
+	uint32_t packetCount = static_cast<uint32_t>(m_packets.size());
+	if (packetCount < 2)
+	{
+		return;
+	}
+
+	// 8개 byte 의 histogram 을 한 번에 계산
+	uint32_t histograms[8][256] = {};
+	for (const RenderPacket &packet : m_packets)
+	{
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			histograms[pass][(packet.key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	m_sortBuffer.resize(packetCount);
+	RenderPacket *src = m_packets.data();
+	RenderPacket *dst = m_sortBuffer.data();
+	for (uint32_t pass = 0; pass < 8; pass++)
+	{
+		uint32_t *histogram = histograms[pass];
+
+		// 모든 packet 이 같은 값을 가진 byte 는 순서가 바뀌지 않으므로 생략
+		if (histogram[(src[0].key >> (pass * 8)) & 0xFF] == packetCount)
+		{
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t count = histogram[i];
+			histogram[i] = offset;
+			offset += count;
+		}
+
+		for (uint32_t i = 0; i < packetCount; i++)
+		{
+			dst[histogram[(src[i].key >> (pass * 8)) & 0xFF]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	if (src != m_packets.data())
+	{
+		m_packets.swap(m_sortBuffer);
+	}
+}
+
+} // namespace ale
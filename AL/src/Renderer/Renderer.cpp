@@ -1,13 +1,24 @@
 #include "Renderer/Renderer.h"
-#include "ALpch.h"
+#include "alpch.h"
+#include "Core/JobSystem.h"
 #include "ImGui/ImGuiLayer.h"
 #include "Renderer/CameraController.h"
+#include "Renderer/MeshPool.h"
 
 #include "Renderer/RenderingComponent.h"
+#include "Renderer/ShaderLibrary.h"
+#include "Renderer/UploadManager.h"
 #include "Scene/Component.h"
 
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb/stb_image_write.h"
+
 namespace ale
 {
+static constexpr std::chrono::milliseconds SHADER_RELOAD_INTERVAL(500);
+// viewport 가 render graph image 보다 커지면 이 pixel 단위로 올려서 다시 만든다.
+static constexpr uint32_t VIEWPORT_EXTENT_GRANULARITY = 256;
+
 std::unique_ptr<Renderer> Renderer::createRenderer(GLFWwindow *window)
 {
 	std::unique_ptr<Renderer> renderer = std::unique_ptr<Renderer>(new Renderer());
@@ -15,10 +26,22 @@ std::unique_ptr<Renderer> Renderer::createRenderer(GLFWwindow *window)
 	return renderer;
 }
 
+std::unique_ptr<Renderer> Renderer::createHeadlessRenderer(uint32_t width, uint32_t height)
+{
+	std::unique_ptr<Renderer> renderer = std::unique_ptr<Renderer>(new Renderer());
+	renderer->m_headless = true;
+	renderer->viewPortSize = glm::vec2(width, height);
+	renderer->init(nullptr);
+	return renderer;
+}
+
 void Renderer::init(GLFWwindow *window)
 {
 	this->window = window;
-	viewPortSize = {1024, 1024};
+	if (!m_headless)
+	{
+		viewPortSize = {1024, 1024};
+	}
 
 #pragma region Vulkan Context
 	auto &context = VulkanContext::getContext();
@@ -35,12 +58,16 @@ void Renderer::init(GLFWwindow *window)
 #pragma endregion
 
 #pragma region SwapChain
-	m_swapChain = SwapChain::createSwapChain(window);
-	swapChain = m_swapChain->getSwapChain();
-	swapChainImages = m_swapChain->getSwapChainImages();
-	swapChainImageFormat = m_swapChain->getSwapChainImageFormat();
-	swapChainExtent = m_swapChain->getSwapChainExtent();
-	swapChainImageViews = m_swapChain->getSwapChainImageViews();
+	// headless 는 present 하지 않으므로 swap chain / ImGui pass 를 만들지 않는다.
+	if (!m_headless)
+	{
+		m_swapChain = SwapChain::createSwapChain(window);
+		swapChain = m_swapChain->getSwapChain();
+		swapChainImages = m_swapChain->getSwapChainImages();
+		swapChainImageFormat = m_swapChain->getSwapChainImageFormat();
+		swapChainExtent = m_swapChain->getSwapChainExtent();
+		swapChainImageViews = m_swapChain->getSwapChainImageViews();
+	}
 #pragma endregion
 
 #pragma region sync
@@ -50,98 +77,58 @@ void Renderer::init(GLFWwindow *window)
 	inFlightFences = m_syncObjects->getInFlightFences();
 #pragma endregion
 
-	m_sphericalMapTexture = Texture::createTexture("./Sandbox/assets/defaultSkybox.hdr");
-
-	m_sphericalMapRenderPass = RenderPass::createSphericalMapRenderPass();
-	sphericalMapRenderPass = m_sphericalMapRenderPass->getRenderPass();
-
-	m_sphericalMapFrameBuffers = FrameBuffers::createSphericalMapFrameBuffers(sphericalMapRenderPass);
-	sphericalMapFramebuffers = m_sphericalMapFrameBuffers->getFramebuffers();
-	sphericalMapImageView = m_sphericalMapFrameBuffers->getSphericalMapImageView();
-	sphericalMapSampler = Texture::createSphericalMapSampler();
-
-	m_sphericalMapDescriptorSetLayout = DescriptorSetLayout::createSphericalMapDescriptorSetLayout();
-	sphericalMapDescriptorSetLayout = m_sphericalMapDescriptorSetLayout->getDescriptorSetLayout();
-
-	m_sphericalMapPipeline =
-		Pipeline::createSphericalMapPipeline(sphericalMapRenderPass, sphericalMapDescriptorSetLayout);
-	sphericalMapPipelineLayout = m_sphericalMapPipeline->getPipelineLayout();
-	sphericalMapGraphicsPipeline = m_sphericalMapPipeline->getPipeline();
-
-	m_sphericalMapShaderResourceManager = ShaderResourceManager::createSphericalMapShaderResourceManager(
-		sphericalMapDescriptorSetLayout, m_sphericalMapTexture->getImageView(), m_sphericalMapTexture->getSampler());
-	sphericalMapDescriptorSets = m_sphericalMapShaderResourceManager->getDescriptorSets();
-	sphericalMapUniformBuffers = m_sphericalMapShaderResourceManager->getUniformBuffers();
-
-	recordSphericalMapCommandBuffer();
-
-	m_backgroundRenderPass = RenderPass::createBackgroundRenderPass();
-	backgroundRenderPass = m_backgroundRenderPass->getRenderPass();
+	m_skyboxPath = "./Sandbox/assets/defaultSkybox.hdr";
+	m_environmentMap = EnvironmentMap::createEnvironmentMap(m_skyboxPath);
 
 	m_backgroundDescriptorSetLayout = DescriptorSetLayout::createBackgroundDescriptorSetLayout();
 	backgroundDescriptorSetLayout = m_backgroundDescriptorSetLayout->getDescriptorSetLayout();
-
-	m_backgroundPipeline = Pipeline::createBackgroundPipeline(backgroundRenderPass, backgroundDescriptorSetLayout);
-	backgroundPipelineLayout = m_backgroundPipeline->getPipelineLayout();
-	backgroundGraphicsPipeline = m_backgroundPipeline->getPipeline();
-
-	m_backgroundFrameBuffers = FrameBuffers::createBackgroundFrameBuffers(viewPortSize, backgroundRenderPass);
-	backgroundFramebuffers = m_backgroundFrameBuffers->getFramebuffers();
-	backgroundImageView = m_backgroundFrameBuffers->getBackgroundImageView();
 	backgroundSampler = Texture::createBackgroundSampler();
 
 	m_backgroundShaderResourceManager = ShaderResourceManager::createBackgroundShaderResourceManager(
-		backgroundDescriptorSetLayout, sphericalMapImageView, sphericalMapSampler);
+		backgroundDescriptorSetLayout, m_environmentMap->getSpecularImageView(), m_environmentMap->getSampler());
 	backgroundDescriptorSets = m_backgroundShaderResourceManager->getDescriptorSets();
 	backgroundUniformBuffers = m_backgroundShaderResourceManager->getUniformBuffers();
 
 #pragma region RenderPass
-	m_deferredRenderPass = RenderPass::createDeferredRenderPass();
-
-	deferredRenderPass = m_deferredRenderPass->getRenderPass();
-
-	m_ImGuiRenderPass = RenderPass::createImGuiRenderPass(swapChainImageFormat);
-	imGuiRenderPass = m_ImGuiRenderPass->getRenderPass();
-
-	for (size_t i = 0; i < 4; i++)
+	if (!m_headless)
 	{
-		m_shadowMapRenderPass.push_back(RenderPass::createShadowMapRenderPass());
-		shadowMapRenderPass.push_back(m_shadowMapRenderPass[i]->getRenderPass());
+		m_ImGuiRenderPass = RenderPass::createImGuiRenderPass(swapChainImageFormat);
+		imGuiRenderPass = m_ImGuiRenderPass->getRenderPass();
 	}
 
+	// viewport 에 그리는 pass (shadow, background, deferred) 의 render pass / attachment 는 render graph 가 만든다.
+	buildRenderGraph();
+	deferredRenderPass = m_renderGraph->getRenderPass(m_deferredPass);
+	backgroundRenderPass = m_renderGraph->getRenderPass(m_backgroundPass);
 	for (size_t i = 0; i < 4; i++)
 	{
-		m_shadowCubeMapRenderPass.push_back(RenderPass::createShadowMapRenderPass());
-		shadowCubeMapRenderPass.push_back(m_shadowCubeMapRenderPass[i]->getRenderPass());
+		shadowMapRenderPass.push_back(m_renderGraph->getRenderPass(m_shadowMapPasses[i]));
+		shadowCubeMapRenderPass.push_back(m_renderGraph->getRenderPass(m_shadowCubeMapPasses[i]));
 	}
 #pragma endregion
 
 #pragma region Framebuffer
-	m_viewPortFrameBuffers = FrameBuffers::createViewPortFrameBuffers(viewPortSize, deferredRenderPass);
-	viewPortFramebuffers = m_viewPortFrameBuffers->getFramebuffers();
-	viewPortImageView = m_viewPortFrameBuffers->getViewPortImageView();
+	viewPortImageView = m_renderGraph->getImageView(m_viewPortImage);
+	backgroundImageView = m_renderGraph->getImageView(m_backgroundImage);
 	viewPortSampler = VulkanUtil::createSampler();
 
-	m_ImGuiSwapChainFrameBuffers = FrameBuffers::createImGuiFrameBuffers(m_swapChain.get(), imGuiRenderPass);
-	imGuiSwapChainFrameBuffers = m_ImGuiSwapChainFrameBuffers->getFramebuffers();
-
-	for (size_t i = 0; i < 4; i++)
+	if (!m_headless)
 	{
-		m_shadowMapFrameBuffers.push_back(FrameBuffers::createShadowMapFrameBuffers(shadowMapRenderPass[i]));
-		shadowMapFramebuffers.push_back(m_shadowMapFrameBuffers[i]->getFramebuffers());
-		shadowMapImageViews.push_back(m_shadowMapFrameBuffers[i]->getDepthImageView());
+		m_ImGuiSwapChainFrameBuffers = FrameBuffers::createImGuiFrameBuffers(m_swapChain.get(), imGuiRenderPass);
+		imGuiSwapChainFrameBuffers = m_ImGuiSwapChainFrameBuffers->getFramebuffers();
 	}
 
 	for (size_t i = 0; i < 4; i++)
 	{
-		m_shadowCubeMapFrameBuffers.push_back(
-			FrameBuffers::createShadowCubeMapFrameBuffers(shadowCubeMapRenderPass[i]));
-		shadowCubeMapFramebuffers.push_back(m_shadowCubeMapFrameBuffers[i]->getFramebuffers());
-		shadowCubeMapImageViews.push_back(m_shadowCubeMapFrameBuffers[i]->getDepthImageView());
+		shadowMapImageViews.push_back(m_renderGraph->getImageView(m_shadowMapImages[i]));
+		shadowCubeMapImageViews.push_back(m_renderGraph->getImageView(m_shadowCubeMapImages[i]));
 	}
 #pragma endregion
 
 #pragma region DescriptorSetLaytout
+	m_geometryPassFrameDescriptorSetLayout = DescriptorSetLayout::createGeometryPassFrameDescriptorSetLayout();
+	geometryPassFrameDescriptorSetLayout = m_geometryPassFrameDescriptorSetLayout->getDescriptorSetLayout();
+
 	m_geometryPassDescriptorSetLayout = DescriptorSetLayout::createGeometryPassDescriptorSetLayout();
 	geometryPassDescriptorSetLayout = m_geometryPassDescriptorSetLayout->getDescriptorSetLayout();
 	context.setGeometryPassDescriptorSetLayout(geometryPassDescriptorSetLayout);
@@ -157,34 +144,21 @@ void Renderer::init(GLFWwindow *window)
 	shadowCubeMapDescriptorSetLayout = m_shadowCubeMapDescriptorSetLayout->getDescriptorSetLayout();
 	context.setShadowCubeMapDescriptorSetLayout(shadowCubeMapDescriptorSetLayout);
 
+	// ImGui viewport 와 upscale pass 가 같이 쓴다. (combined image sampler 하나)
+	m_viewPortDescriptorSetLayout = DescriptorSetLayout::createViewPortDescriptorSetLayout();
+	viewPortDescriptorSetLayout = m_viewPortDescriptorSetLayout->getDescriptorSetLayout();
+
 #pragma endregion
 
 #pragma region Pipeline
-
-	m_geometryPassPipeline = Pipeline::createGeometryPassPipeline(deferredRenderPass, geometryPassDescriptorSetLayout);
-	geometryPassPipelineLayout = m_geometryPassPipeline->getPipelineLayout();
-	geometryPassGraphicsPipeline = m_geometryPassPipeline->getPipeline();
-
-	m_lightingPassPipeline = Pipeline::createLightingPassPipeline(deferredRenderPass, lightingPassDescriptorSetLayout);
-	lightingPassPipelineLayout = m_lightingPassPipeline->getPipelineLayout();
-	lightingPassGraphicsPipeline = m_lightingPassPipeline->getPipeline();
-
-	for (size_t i = 0; i < 4; i++)
-	{
-		m_shadowMapPipeline.push_back(
-			Pipeline::createShadowMapPipeline(shadowMapRenderPass[i], shadowMapDescriptorSetLayout));
-		shadowMapPipelineLayout.push_back(m_shadowMapPipeline[i]->getPipelineLayout());
-		shadowMapGraphicsPipeline.push_back(m_shadowMapPipeline[i]->getPipeline());
-	}
-
-	for (size_t i = 0; i < 4; i++)
-	{
-		m_shadowCubeMapPipeline.push_back(
-			Pipeline::createShadowCubeMapPipeline(shadowCubeMapRenderPass[i], shadowCubeMapDescriptorSetLayout));
-		shadowCubeMapPipelineLayout.push_back(m_shadowCubeMapPipeline[i]->getPipelineLayout());
-		shadowCubeMapGraphicsPipeline.push_back(m_shadowCubeMapPipeline[i]->getPipeline());
-	}
-
+	createPipelines();
+	updatePipelineHandles();
+	m_shaderHotReload = !m_headless;
+	m_lastShaderCheck = std::chrono::steady_clock::now();
+
+	ShaderLibraryStats shaderStats = ShaderLibrary::getShaderLibrary().getStats();
+	AL_CORE_INFO("ShaderLibrary: {0} shaders, {1} compiled, {2} loaded from cache", shaderStats.shaderCount,
+				 shaderStats.compileCount, shaderStats.cacheHitCount);
 #pragma endregion
 
 #pragma region etc(Sampler, ShaderResourceManager, Commandbuffer)
@@ -192,19 +166,20 @@ void Renderer::init(GLFWwindow *window)
 	shadowCubeMapSampler = Texture::createShadowCubeMapSampler();
 
 	m_lightingPassShaderResourceManager = ShaderResourceManager::createLightingPassShaderResourceManager(
-		lightingPassDescriptorSetLayout, m_viewPortFrameBuffers->getPositionImageView(),
-		m_viewPortFrameBuffers->getNormalImageView(), m_viewPortFrameBuffers->getAlbedoImageView(),
-		m_viewPortFrameBuffers->getPbrImageView(), shadowMapImageViews, shadowMapSampler, shadowCubeMapImageViews,
+		lightingPassDescriptorSetLayout, m_renderGraph->getImageView(m_positionImage),
+		m_renderGraph->getImageView(m_normalImage), m_renderGraph->getImageView(m_albedoImage),
+		m_renderGraph->getImageView(m_pbrImage), shadowMapImageViews, shadowMapSampler, shadowCubeMapImageViews,
 		shadowCubeMapSampler, backgroundImageView, backgroundSampler);
 
 	lightingPassDescriptorSets = m_lightingPassShaderResourceManager->getDescriptorSets();
 	lightingPassFragmentUniformBuffers = m_lightingPassShaderResourceManager->getFragmentUniformBuffers();
 
-	m_viewPortDescriptorSetLayout = DescriptorSetLayout::createViewPortDescriptorSetLayout();
-	viewPortDescriptorSetLayout = m_viewPortDescriptorSetLayout->getDescriptorSetLayout();
 	m_viewPortShaderResourceManager = ShaderResourceManager::createViewPortShaderResourceManager(
 		viewPortDescriptorSetLayout, viewPortImageView, viewPortSampler);
 	viewPortDescriptorSets = m_viewPortShaderResourceManager->getDescriptorSets();
+	m_upscaleShaderResourceManager = ShaderResourceManager::createViewPortShaderResourceManager(
+		viewPortDescriptorSetLayout, m_renderGraph->getImageView(m_sceneColorImage), viewPortSampler);
+	upscaleDescriptorSets = m_upscaleShaderResourceManager->getDescriptorSets();
 
 	m_noCamTexture = Texture::createTexture("./Sandbox/assets/noCam.png");
 	m_noCamShaderResourceManager = ShaderResourceManager::createViewPortShaderResourceManager(
@@ -214,28 +189,83 @@ void Renderer::init(GLFWwindow *window)
 	m_commandBuffers = CommandBuffers::createCommandBuffers();
 	commandBuffers = m_commandBuffers->getCommandBuffers();
 
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		m_instanceBuffers.push_back(InstanceBuffer::createInstanceBuffer(1024));
+	}
+
+	// camera / shadow 행렬은 프레임별 ring buffer 에 쌓고 dynamic offset 으로 가리킨다.
+	std::vector<VkBuffer> ringBuffers;
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		m_uniformRingBuffers.push_back(UniformRingBuffer::createUniformRingBuffer(1024 * 1024));
+		ringBuffers.push_back(m_uniformRingBuffers[i]->getBuffer());
+		m_boneBuffers.push_back(StorageBuffer::createStorageBuffer(sizeof(glm::mat4) * MAX_BONES * 16));
+	}
+	std::vector<VkDeviceSize> geometryPassRanges = {sizeof(GeometryPassCameraUniformBufferObject)};
+	m_geometryPassFrameShaderResourceManager = ShaderResourceManager::createDynamicUniformShaderResourceManager(
+		geometryPassFrameDescriptorSetLayout, ringBuffers, geometryPassRanges);
+
+	// material table 은 프레임별 storage buffer (set 0), texture 는 전역 texture 배열 (set 1)
+	m_materialTable = MaterialTable::createMaterialTable(geometryPassDescriptorSetLayout);
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		m_materialBuffers.push_back(StorageBuffer::createStorageBuffer(sizeof(MaterialData) * 256));
+		m_geometryPassFrameShaderResourceManager->updateStorageBufferDescriptorSet(i, 1,
+																				   m_materialBuffers[i]->getBuffer());
+		m_geometryPassFrameShaderResourceManager->updateStorageBufferDescriptorSet(i, 2, m_boneBuffers[i]->getBuffer());
+	}
+
+	// clustered lighting 용 storage buffer (부족하면 프레임마다 2배씩 늘린다)
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		m_lightBuffers.push_back(StorageBuffer::createStorageBuffer(sizeof(Light) * 64));
+		m_clusterBuffers.push_back(
+			StorageBuffer::createStorageBuffer(sizeof(LightClusterRange) * LightCluster::CLUSTER_COUNT));
+		m_lightIndexBuffers.push_back(StorageBuffer::createStorageBuffer(sizeof(uint32_t) * 4096));
+	}
+	updateLightingPassStorageBufferDescriptorSets();
+	std::vector<VkDeviceSize> shadowMapRanges = {sizeof(ShadowMapUniformBufferObject)};
+	m_shadowMapFrameShaderResourceManager = ShaderResourceManager::createDynamicUniformShaderResourceManager(
+		shadowMapDescriptorSetLayout, ringBuffers, shadowMapRanges);
+	std::vector<VkDeviceSize> shadowCubeMapRanges = {sizeof(ShadowCubeMapUniformBufferObject),
+													 sizeof(ShadowCubeMapLayerIndex)};
+	m_shadowCubeMapFrameShaderResourceManager = ShaderResourceManager::createDynamicUniformShaderResourceManager(
+		shadowCubeMapDescriptorSetLayout, ringBuffers, shadowCubeMapRanges);
+
+	// main thread + JobSystem worker 마다 secondary command buffer pool
+	m_secondaryCommandBuffers = SecondaryCommandBuffers::createSecondaryCommandBuffers(JobSystem::getWorkerCount() + 1);
+
+	// pass 별 GPU 시간 측정
+	m_gpuProfiler = GpuProfiler::createGpuProfiler();
+
+	// headless (benchmark / capture) 는 결과가 매번 같도록 항상 viewport 해상도로 그린다.
+	m_dynamicResolution.setEnabled(!m_headless && m_gpuProfiler->isSupported());
+	updateRenderExtent();
+
 #pragma endregion
 }
 
 void Renderer::cleanup()
 {
 	// texture
-	m_sphericalMapTexture->cleanup();
+	m_environmentMap->cleanup();
 	m_noCamTexture->cleanup();
 
 	// framebuffer
-	m_viewPortFrameBuffers->cleanup();
-	m_ImGuiSwapChainFrameBuffers->cleanup();
-	for (size_t i = 0; i < 4; i++)
+	if (!m_headless)
 	{
-		m_shadowMapFrameBuffers[i]->cleanup();
-		m_shadowCubeMapFrameBuffers[i]->cleanup();
+		m_ImGuiSwapChainFrameBuffers->cleanup();
 	}
-	m_sphericalMapFrameBuffers->cleanup();
-	m_backgroundFrameBuffers->cleanup();
+
+	// render graph (render pass, framebuffer, attachment image)
+	m_renderGraph->cleanup();
 
 	// swapchain
-	m_swapChain->cleanup();
+	if (!m_headless)
+	{
+		m_swapChain->cleanup();
+	}
 	// model
 	for (auto &model : m_modelsMap)
 	{
@@ -243,48 +273,94 @@ void Renderer::cleanup()
 	}
 
 	// pipeline
-	m_geometryPassPipeline->cleanup();
+	for (auto &pipeline : m_geometryPassPipelines)
+	{
+		pipeline->cleanup();
+	}
 	m_lightingPassPipeline->cleanup();
+	m_upscalePipeline->cleanup();
 	for (size_t i = 0; i < 4; i++)
 	{
 		m_shadowMapPipeline[i]->cleanup();
 		m_shadowCubeMapPipeline[i]->cleanup();
 	}
-	m_sphericalMapPipeline->cleanup();
 	m_backgroundPipeline->cleanup();
 
 	// renderpass
-	m_deferredRenderPass->cleanup();
-	m_sphericalMapRenderPass->cleanup();
-	m_backgroundRenderPass->cleanup();
-	for (size_t i = 0; i < 4; i++)
+	if (!m_headless)
 	{
-		m_shadowMapRenderPass[i]->cleanup();
-		m_shadowCubeMapRenderPass[i]->cleanup();
+		m_ImGuiRenderPass->cleanup();
 	}
-	m_ImGuiRenderPass->cleanup();
 
 	// sampler
-	vkDestroySampler(device, sphericalMapSampler, nullptr);
 	vkDestroySampler(device, backgroundSampler, nullptr);
 	vkDestroySampler(device, shadowMapSampler, nullptr);
 	vkDestroySampler(device, shadowCubeMapSampler, nullptr);
 	vkDestroySampler(device, viewPortSampler, nullptr);
 
 	// shaderResourceManager
-	m_sphericalMapShaderResourceManager->cleanup();
 	m_backgroundShaderResourceManager->cleanup();
 	m_viewPortShaderResourceManager->cleanup();
+	m_upscaleShaderResourceManager->cleanup();
 	m_noCamShaderResourceManager->cleanup();
 	m_lightingPassShaderResourceManager->cleanup();
 
+	// instance buffer
+	for (auto &instanceBuffer : m_instanceBuffers)
+	{
+		instanceBuffer->cleanup();
+	}
+
+	// gpu culling
+	if (m_gpuCullingPipeline)
+	{
+		m_gpuCullingPipeline->cleanup();
+		m_gpuCullingShaderResourceManager->cleanup();
+		m_gpuCullingDescriptorSetLayout->cleanup();
+		for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			m_gpuCullInstanceBuffers[i]->cleanup();
+			m_culledInstanceBuffers[i]->cleanup();
+			m_indirectBuffers[i]->cleanup();
+		}
+	}
+
+	// uniform ring buffer
+	m_geometryPassFrameShaderResourceManager->cleanup();
+	m_shadowMapFrameShaderResourceManager->cleanup();
+	m_shadowCubeMapFrameShaderResourceManager->cleanup();
+	for (auto &uniformRingBuffer : m_uniformRingBuffers)
+	{
+		uniformRingBuffer->cleanup();
+	}
+	for (auto &boneBuffer : m_boneBuffers)
+	{
+		boneBuffer->cleanup();
+	}
+	for (auto &materialBuffer : m_materialBuffers)
+	{
+		materialBuffer->cleanup();
+	}
+	m_materialTable->cleanup();
+	for (size_t i = 0; i < m_lightBuffers.size(); i++)
+	{
+		m_lightBuffers[i]->cleanup();
+		m_clusterBuffers[i]->cleanup();
+		m_lightIndexBuffers[i]->cleanup();
+	}
+
+	// secondary command buffer
+	m_secondaryCommandBuffers->cleanup();
+	m_gpuProfiler->cleanup();
+	m_framePacer.cleanup();
+
 	// descriptorSetLayout
+	m_geometryPassFrameDescriptorSetLayout->cleanup();
 	m_geometryPassDescriptorSetLayout->cleanup();
 	m_lightingPassDescriptorSetLayout->cleanup();
 	m_viewPortDescriptorSetLayout->cleanup();
 	m_shadowMapDescriptorSetLayout->cleanup();
 	m_shadowCubeMapDescriptorSetLayout->cleanup();
-	m_sphericalMapDescriptorSetLayout->cleanup();
 	m_backgroundDescriptorSetLayout->cleanup();
 
 	m_syncObjects->cleanup();
@@ -324,6 +400,44 @@ void Renderer::recreateSwapChain()
 	imGuiSwapChainFrameBuffers = m_ImGuiSwapChainFrameBuffers->getFramebuffers();
 }
 
+void Renderer::captureViewPort(const std::string &path)
+{
+	vkDeviceWaitIdle(device);
+
+	uint32_t width = static_cast<uint32_t>(viewPortSize.x);
+	uint32_t height = static_cast<uint32_t>(viewPortSize.y);
+	std::unique_ptr<ReadbackBuffer> readbackBuffer =
+		ReadbackBuffer::createReadbackBuffer(static_cast<VkDeviceSize>(width) * height * 4);
+
+	// render graph 가 프레임 끝에서 SHADER_READ_ONLY 로 바꿔둔 viewport image 를 잠시 복사 원본으로 바꿔서 읽는다.
+	VkImage viewPortImage = m_renderGraph->getImage(m_viewPortImage);
+	VkImageSubresourceRange subresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+	VkCommandBuffer commandBuffer = VulkanUtil::beginSingleTimeCommands(device, commandPool);
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, viewPortImage, VK_ACCESS_SHADER_READ_BIT,
+										 VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+										 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+										 VK_PIPELINE_STAGE_TRANSFER_BIT, subresourceRange);
+
+	VkBufferImageCopy region{};
+	region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+	region.imageExtent = {width, height, 1};
+	vkCmdCopyImageToBuffer(commandBuffer, viewPortImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+						   readbackBuffer->getBuffer(), 1, &region);
+
+	VulkanUtil::insertImageMemoryBarrier(commandBuffer, viewPortImage, VK_ACCESS_TRANSFER_READ_BIT,
+										 VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+										 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+										 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, subresourceRange);
+	VulkanUtil::endSingleTimeCommands(device, graphicsQueue, commandPool, commandBuffer);
+
+	// viewport image 는 R8G8B8A8_UNORM 이므로 그대로 PNG 로 쓴다.
+	if (!stbi_write_png(path.c_str(), width, height, 4, readbackBuffer->getData(), width * 4))
+	{
+		AL_CORE_ERROR("Renderer: failed to write capture '{0}'", path);
+	}
+	readbackBuffer->cleanup();
+}
+
 void Renderer::recreateViewPort()
 {
 	while (viewPortSize.x == 0 || viewPortSize.y == 0)
@@ -333,65 +447,49 @@ void Renderer::recreateViewPort()
 		glfwWaitEvents();
 	}
 
+	// image 안에 들어가는 크기면 그리는 영역만 바뀐다. (updateRenderExtent)
+	VkExtent2D extent = m_renderGraph->getExtent();
+	uint32_t width = static_cast<uint32_t>(viewPortSize.x);
+	uint32_t height = static_cast<uint32_t>(viewPortSize.y);
+	updateRenderExtent();
+	if (width <= extent.width && height <= extent.height)
+	{
+		return;
+	}
+
+	// 더 커지면 다음 변경에도 버티도록 VIEWPORT_EXTENT_GRANULARITY 단위로 올려서 키운다.
+	// render pass 는 크기와 상관없으므로 attachment / framebuffer 와 그 image 를 가리키는 descriptor 만 다시 만든다.
+	auto grow = [](uint32_t current, uint32_t size) {
+		uint32_t aligned =
+			(size + VIEWPORT_EXTENT_GRANULARITY - 1) / VIEWPORT_EXTENT_GRANULARITY * VIEWPORT_EXTENT_GRANULARITY;
+		return std::max(current, aligned);
+	};
 	vkDeviceWaitIdle(device);
-	// 스왑 체인 관련 리소스 정리
 	m_lightingPassShaderResourceManager->cleanup();
-	m_geometryPassPipeline->cleanup();
-	m_lightingPassPipeline->cleanup();
-	m_deferredRenderPass->cleanup();
-
-	m_viewPortFrameBuffers->cleanup();
 	m_viewPortShaderResourceManager->cleanup();
+	m_upscaleShaderResourceManager->cleanup();
 	m_noCamShaderResourceManager->cleanup();
 
-	m_backgroundShaderResourceManager->cleanup();
-	m_backgroundFrameBuffers->cleanup();
-	m_backgroundPipeline->cleanup();
-	m_backgroundRenderPass->cleanup();
-
-	m_backgroundRenderPass->initBackgroundRenderPass();
-	backgroundRenderPass = m_backgroundRenderPass->getRenderPass();
-
-	m_backgroundPipeline->initBackgroundPipeline(backgroundRenderPass, backgroundDescriptorSetLayout);
-	backgroundPipelineLayout = m_backgroundPipeline->getPipelineLayout();
-	backgroundGraphicsPipeline = m_backgroundPipeline->getPipeline();
-
-	m_backgroundFrameBuffers->initBackgroundFrameBuffers(viewPortSize, backgroundRenderPass);
-	backgroundFramebuffers = m_backgroundFrameBuffers->getFramebuffers();
-	backgroundImageView = m_backgroundFrameBuffers->getBackgroundImageView();
-
-	m_backgroundShaderResourceManager->initBackgroundShaderResourceManager(backgroundDescriptorSetLayout,
-																		   sphericalMapImageView, sphericalMapSampler);
-	backgroundDescriptorSets = m_backgroundShaderResourceManager->getDescriptorSets();
-	backgroundUniformBuffers = m_backgroundShaderResourceManager->getUniformBuffers();
-
-	m_deferredRenderPass->initDeferredRenderPass();
-	deferredRenderPass = m_deferredRenderPass->getRenderPass();
-
-	m_viewPortFrameBuffers->initViewPortFrameBuffers(viewPortSize, deferredRenderPass);
-	viewPortFramebuffers = m_viewPortFrameBuffers->getFramebuffers();
-	viewPortImageView = m_viewPortFrameBuffers->getViewPortImageView();
-
-	m_geometryPassPipeline->initGeometryPassPipeline(deferredRenderPass, geometryPassDescriptorSetLayout);
-	geometryPassPipelineLayout = m_geometryPassPipeline->getPipelineLayout();
-	geometryPassGraphicsPipeline = m_geometryPassPipeline->getPipeline();
-
-	m_lightingPassPipeline->initLightingPassPipeline(deferredRenderPass, lightingPassDescriptorSetLayout);
-	lightingPassPipelineLayout = m_lightingPassPipeline->getPipelineLayout();
-	lightingPassGraphicsPipeline = m_lightingPassPipeline->getPipeline();
+	m_renderGraph->resize({grow(extent.width, width), grow(extent.height, height)});
+	viewPortImageView = m_renderGraph->getImageView(m_viewPortImage);
+	backgroundImageView = m_renderGraph->getImageView(m_backgroundImage);
 
 	m_lightingPassShaderResourceManager->initLightingPassShaderResourceManager(
-		lightingPassDescriptorSetLayout, m_viewPortFrameBuffers->getPositionImageView(),
-		m_viewPortFrameBuffers->getNormalImageView(), m_viewPortFrameBuffers->getAlbedoImageView(),
-		m_viewPortFrameBuffers->getPbrImageView(), shadowMapImageViews, shadowMapSampler, shadowCubeMapImageViews,
+		lightingPassDescriptorSetLayout, m_renderGraph->getImageView(m_positionImage),
+		m_renderGraph->getImageView(m_normalImage), m_renderGraph->getImageView(m_albedoImage),
+		m_renderGraph->getImageView(m_pbrImage), shadowMapImageViews, shadowMapSampler, shadowCubeMapImageViews,
 		shadowCubeMapSampler, backgroundImageView, backgroundSampler);
 
 	lightingPassDescriptorSets = m_lightingPassShaderResourceManager->getDescriptorSets();
 	lightingPassFragmentUniformBuffers = m_lightingPassShaderResourceManager->getFragmentUniformBuffers();
+	updateLightingPassStorageBufferDescriptorSets();
 
 	m_viewPortShaderResourceManager->initViewPortShaderResourceManager(viewPortDescriptorSetLayout, viewPortImageView,
 																	   viewPortSampler);
 	viewPortDescriptorSets = m_viewPortShaderResourceManager->getDescriptorSets();
+	m_upscaleShaderResourceManager->initViewPortShaderResourceManager(
+		viewPortDescriptorSetLayout, m_renderGraph->getImageView(m_sceneColorImage), viewPortSampler);
+	upscaleDescriptorSets = m_upscaleShaderResourceManager->getDescriptorSets();
 	m_noCamShaderResourceManager->initViewPortShaderResourceManager(
 		viewPortDescriptorSetLayout, m_noCamTexture->getImageView(), m_noCamTexture->getSampler());
 	noCamDescriptorSets = m_noCamShaderResourceManager->getDescriptorSets();
@@ -401,62 +499,18 @@ void Renderer::updateSkybox(std::string path)
 {
 	vkDeviceWaitIdle(device);
 
-	// clean up은 초기화의 역순
-
-	m_lightingPassShaderResourceManager->cleanup();
+	// background pass 의 render pass / attachment 는 render graph 것이라 skybox 를 가리키는 descriptor 만 바꾼다.
 	m_backgroundShaderResourceManager->cleanup();
-	m_backgroundFrameBuffers->cleanup();
-	m_backgroundPipeline->cleanup();
-	m_backgroundRenderPass->cleanup();
-	m_sphericalMapShaderResourceManager->cleanup();
-	m_sphericalMapPipeline->cleanup();
-	m_sphericalMapFrameBuffers->cleanup();
-	m_sphericalMapRenderPass->cleanup();
-	m_sphericalMapTexture->cleanup();
-
-	// 새로운 텍스쳐 로드
-	m_sphericalMapTexture->initTexture(path);
-
-	m_sphericalMapRenderPass->initSphericalMapRenderPass();
-	sphericalMapRenderPass = m_sphericalMapRenderPass->getRenderPass();
-
-	m_sphericalMapFrameBuffers->initSphericalMapFrameBuffers(sphericalMapRenderPass);
-	sphericalMapFramebuffers = m_sphericalMapFrameBuffers->getFramebuffers();
-	sphericalMapImageView = m_sphericalMapFrameBuffers->getSphericalMapImageView();
-	// sphericalMapSampler = Texture::createSphericalMapSampler();
-	m_sphericalMapPipeline->initSphericalMapPipeline(sphericalMapRenderPass, sphericalMapDescriptorSetLayout);
-	sphericalMapPipelineLayout = m_sphericalMapPipeline->getPipelineLayout();
-	sphericalMapGraphicsPipeline = m_sphericalMapPipeline->getPipeline();
-
-	m_sphericalMapShaderResourceManager->initSphericalMapShaderResourceManager(
-		sphericalMapDescriptorSetLayout, m_sphericalMapTexture->getImageView(), m_sphericalMapTexture->getSampler());
-	sphericalMapDescriptorSets = m_sphericalMapShaderResourceManager->getDescriptorSets();
-	sphericalMapUniformBuffers = m_sphericalMapShaderResourceManager->getUniformBuffers();
-
-	recordSphericalMapCommandBuffer();
-	m_backgroundRenderPass->initBackgroundRenderPass();
-	backgroundRenderPass = m_backgroundRenderPass->getRenderPass();
-	m_backgroundPipeline->initBackgroundPipeline(backgroundRenderPass, backgroundDescriptorSetLayout);
-	backgroundPipelineLayout = m_backgroundPipeline->getPipelineLayout();
-	backgroundGraphicsPipeline = m_backgroundPipeline->getPipeline();
+	m_environmentMap->cleanup();
 
-	m_backgroundFrameBuffers->initBackgroundFrameBuffers(viewPortSize, backgroundRenderPass);
-	backgroundFramebuffers = m_backgroundFrameBuffers->getFramebuffers();
-	backgroundImageView = m_backgroundFrameBuffers->getBackgroundImageView();
+	// 이미 만든 적 있는 skybox 는 cache 파일을 읽어 업로드만 한다.
+	m_skyboxPath = path;
+	m_environmentMap = EnvironmentMap::createEnvironmentMap(m_skyboxPath);
 
-	m_backgroundShaderResourceManager->initBackgroundShaderResourceManager(backgroundDescriptorSetLayout,
-																		   sphericalMapImageView, sphericalMapSampler);
+	m_backgroundShaderResourceManager->initBackgroundShaderResourceManager(
+		backgroundDescriptorSetLayout, m_environmentMap->getSpecularImageView(), m_environmentMap->getSampler());
 	backgroundDescriptorSets = m_backgroundShaderResourceManager->getDescriptorSets();
 	backgroundUniformBuffers = m_backgroundShaderResourceManager->getUniformBuffers();
-
-	m_lightingPassShaderResourceManager->initLightingPassShaderResourceManager(
-		lightingPassDescriptorSetLayout, m_viewPortFrameBuffers->getPositionImageView(),
-		m_viewPortFrameBuffers->getNormalImageView(), m_viewPortFrameBuffers->getAlbedoImageView(),
-		m_viewPortFrameBuffers->getPbrImageView(), shadowMapImageViews, shadowMapSampler, shadowCubeMapImageViews,
-		shadowCubeMapSampler, backgroundImageView, backgroundSampler);
-
-	lightingPassDescriptorSets = m_lightingPassShaderResourceManager->getDescriptorSets();
-	lightingPassFragmentUniformBuffers = m_lightingPassShaderResourceManager->getFragmentUniformBuffers();
 }
 
 void Renderer::loadScene(Scene *scene)
@@ -467,7 +521,7 @@ void Renderer::beginScene(Scene *scene, EditorCamera &camera)
 {
 	// frustum culling
 	// AL_CORE_INFO("frustum culling start");
-	scene->frustumCulling(camera.getFrustum());
+	cullScene(scene, camera);
 	// AL_CORE_INFO("frustum culling finish");
 
 	camera.setAspectRatio(viewPortSize.x / viewPortSize.y);
@@ -475,12 +529,6 @@ void Renderer::beginScene(Scene *scene, EditorCamera &camera)
 	viewMatirx = camera.getView();
 
 	drawFrame(scene);
-
-	// AL_CORE_INFO("before init Frustum");
-	// scene->printCullTree();
-	scene->initFrustumDrawFlag();
-	// AL_CORE_INFO("after init Frustum");
-	// scene->printCullTree();
 }
 
 void Renderer::beginScene(Scene *scene, Camera &camera)
@@ -491,10 +539,32 @@ void Renderer::beginScene(Scene *scene, Camera &camera)
 	projMatrix = camera.getProjection();
 	viewMatirx = camera.getView();
 
-	scene->frustumCulling(camera.getFrustum());
+	cullScene(scene, camera);
 	drawFrame(scene);
+}
+
+// CPU 모드는 CullTree 로 보이는 entity 만 고르고 (occlusion culling 포함), GPU 모드는 모든 entity 를 후보로 두고
+// frustum 은 compute shader 에서 쓴다.
+void Renderer::cullScene(Scene *scene, Camera &camera)
+{
+	const Frustum &frustum = camera.getFrustum();
+	m_gpuCulling = m_cullingMode == ECullingMode::GPU && isGpuCullingSupported();
+	if (m_gpuCulling && !m_gpuCullingPipeline && !initGpuCulling())
+	{
+		// GpuCulling.comp 를 쓸 수 없으면 CPU culling 으로 되돌린다.
+		m_cullingMode = ECullingMode::CPU;
+		m_gpuCulling = false;
+	}
+	if (!m_gpuCulling)
+	{
+		// frustum 과 같은 시점의 행렬을 쓴다. (EditorCamera 는 이 뒤에 aspect ratio 를 바꾼다)
+		m_occlusionCuller.setCamera(camera.getProjection() * camera.getView(), camera.getPosition());
+		scene->frustumCulling(frustum, m_occlusionCuller.isEnabled() ? &m_occlusionCuller : nullptr);
+		return;
+	}
 
-	scene->initFrustumDrawFlag();
+	m_cullFrustum = frustum;
+	scene->collectCullCandidates(m_cullSpheres);
 }
 
 void Renderer::biginNoCamScene()
@@ -504,50 +574,69 @@ void Renderer::biginNoCamScene()
 
 void Renderer::drawFrame(Scene *scene)
 {
+	// shader source 가 바뀌었으면 fence 를 기다리기 전에 pipeline 을 다시 만든다. (device idle 대기 포함)
+	if (m_shaderHotReload && std::chrono::steady_clock::now() - m_lastShaderCheck > SHADER_RELOAD_INTERVAL)
+	{
+		m_lastShaderCheck = std::chrono::steady_clock::now();
+		reloadShaders();
+	}
+
 	// [이전 GPU 작업 대기]
 	// 동시에 작업 가능한 최대 Frame 개수만큼 작업 중인 경우 대기 (가장 먼저 시작한 Frame 작업이 끝나서 Fence에 signal을
 	// 보내기를 기다림)
+	FramePacer::Clock::time_point fenceWaitStart = FramePacer::Clock::now();
 	vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+	m_framePacer.onFenceWaited(currentFrame, fenceWaitStart);
 
 	// [작업할 image 준비]
-	// 이번 Frame 에서 사용할 이미지 준비 및 해당 이미지 index 받아오기 (준비가 끝나면 signal 보낼 세마포어 등록)
-	// vkAcquireNextImageKHR 함수는 CPU에서 swapChain과 surface의 호환성을 확인하고 GPU에 이미지 준비 명령을 내리는 함수
-	// 만약 image가 프레젠테이션 큐에 작업이 진행 중이거나 대기 중이면 해당 image는 사용하지 않고 대기한다.
-	uint32_t imageIndex;
-	VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame],
-											VK_NULL_HANDLE, &imageIndex);
-
-	// image 준비 실패로 인한 오류 처리
-	if (result == VK_ERROR_OUT_OF_DATE_KHR)
+	// headless 는 swap chain image 없이 offscreen viewport 에만 그리고, ImGui 창도 없다.
+	uint32_t imageIndex = 0;
+	if (!m_headless)
 	{
-		// 스왑 체인이 surface 크기와 호환되지 않는 경우로(창 크기 변경), 스왑 체인 재생성 후 다시 draw
-		recreateSwapChain();
-		return;
-	}
-	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
-	{
-		// 진짜 오류 gg
-		throw std::runtime_error("failed to acquire swap chain image!");
-	}
+		// 이번 Frame 에서 사용할 이미지 준비 및 해당 이미지 index 받아오기 (준비가 끝나면 signal 보낼 세마포어 등록)
+		// vkAcquireNextImageKHR 함수는 CPU에서 swapChain과 surface의 호환성을 확인하고
+		// GPU에 이미지 준비 명령을 내리는 함수
+		// 만약 image가 프레젠테이션 큐에 작업이 진행 중이거나 대기 중이면 해당 image는 사용하지 않고 대기한다.
+		VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame],
+												VK_NULL_HANDLE, &imageIndex);
+
+		// image 준비 실패로 인한 오류 처리
+		if (result == VK_ERROR_OUT_OF_DATE_KHR)
+		{
+			// 스왑 체인이 surface 크기와 호환되지 않는 경우로(창 크기 변경), 스왑 체인 재생성 후 다시 draw
+			recreateSwapChain();
+			return;
+		}
+		else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+		{
+			// 진짜 오류 gg
+			throw std::runtime_error("failed to acquire swap chain image!");
+		}
 
-	if (firstFrame)
-	{
-		ImGui::Begin("ViewPort");
-		ImGui::Image(reinterpret_cast<ImTextureID>(viewPortDescriptorSets[0]), ImVec2{viewPortSize.x, viewPortSize.y});
-		ImGui::End();
-		firstFrame = false;
-	}
-	else
-	{
-		ImGui::Begin("ViewPort");
-		ImVec2 guiViewPortSize = ImGui::GetContentRegionAvail();
-		if (guiViewPortSize.x != viewPortSize.x || guiViewPortSize.y != viewPortSize.y)
+		if (firstFrame)
 		{
-			viewPortSize = glm::vec2(guiViewPortSize.x, guiViewPortSize.y);
-			recreateViewPort();
+			ImGui::Begin("ViewPort");
+			glm::vec2 uv = getViewPortUV();
+			ImGui::Image(reinterpret_cast<ImTextureID>(viewPortDescriptorSets[0]),
+						 ImVec2{viewPortSize.x, viewPortSize.y}, ImVec2{0.0f, 0.0f}, ImVec2{uv.x, uv.y});
+			ImGui::End();
+			firstFrame = false;
+		}
+		else
+		{
+			ImGui::Begin("ViewPort");
+			ImVec2 guiViewPortSize = ImGui::GetContentRegionAvail();
+			if (guiViewPortSize.x != viewPortSize.x || guiViewPortSize.y != viewPortSize.y)
+			{
+				viewPortSize = glm::vec2(guiViewPortSize.x, guiViewPortSize.y);
+				recreateViewPort();
+			}
+			// viewport image 는 viewport 보다 클 수 있으므로 그린 영역의 uv 까지만 보여준다.
+			glm::vec2 uv = getViewPortUV();
+			ImGui::Image(reinterpret_cast<ImTextureID>(viewPortDescriptorSets[0]),
+						 ImVec2{viewPortSize.x, viewPortSize.y}, ImVec2{0.0f, 0.0f}, ImVec2{uv.x, uv.y});
+			ImGui::End();
 		}
-		ImGui::Image(reinterpret_cast<ImTextureID>(viewPortDescriptorSets[0]), ImVec2{viewPortSize.x, viewPortSize.y});
-		ImGui::End();
 	}
 
 	// [Fence 초기화]
@@ -568,9 +657,16 @@ void Renderer::drawFrame(Scene *scene)
 		throw std::runtime_error("failed to begin recording command buffer!");
 	}
 
-	auto view = scene->getAllEntitiesWith<LightComponent, TagComponent>();
+	// 이 프레임 slot 의 이전 GPU 시간을 읽고 query 를 reset
+	m_gpuProfiler->beginFrame(commandBuffers[currentFrame], currentFrame);
 
-	uint32_t shadowMapIndex = 0;
+	// 방금 읽은 GPU 프레임 시간으로 이번 프레임의 내부 해상도를 정한다.
+	m_dynamicResolution.update(m_gpuProfiler->getFrameMs());
+	updateRenderExtent();
+
+	// shadow map 을 만드는 light 는 최대 4개
+	std::vector<Light *> shadowLights;
+	auto view = scene->getAllEntitiesWith<LightComponent, TagComponent>();
 	for (auto entity : view)
 	{
 		if (!view.get<TagComponent>(entity).m_isActive)
@@ -578,37 +674,51 @@ void Renderer::drawFrame(Scene *scene)
 			continue;
 		}
 		std::shared_ptr<Light> light = view.get<LightComponent>(entity).m_Light;
-		if (light->onShadowMap == 1 && shadowMapIndex < 4)
+		if (light->onShadowMap == 1 && shadowLights.size() < 4)
 		{
-			recordShadowMapCommandBuffer(scene, commandBuffers[currentFrame], *light.get(), shadowMapIndex);
-			recordShadowCubeMapCommandBuffer(scene, commandBuffers[currentFrame], *light.get(), shadowMapIndex);
-			shadowMapIndex++;
+			shadowLights.push_back(light.get());
 		}
 	}
+	uint32_t shadowMapIndex = static_cast<uint32_t>(shadowLights.size());
+
+	// 이번 프레임의 instance buffer / uniform ring buffer 는 fence 대기 후이므로 GPU 가 더 이상 읽지 않는다.
+	// shadow caster 는 camera 에 보이지 않아도 그림자를 드리우므로 light 마다 따로 culling 해서 뒤에 이어 붙인다.
+	buildInstanceBatches(scene);
+	buildShadowPasses(scene, shadowLights);
+	uploadInstanceData();
+	uploadMaterialTable();
+	if (m_gpuCulling)
+	{
+		uploadIndirectCommands();
+	}
+	prepareFrameUniforms();
+	prepareLights(scene, shadowMapIndex);
 
-	recordBackgroundCommandBuffer(commandBuffers[currentFrame]);
-	recordDeferredRenderPassCommandBuffer(scene, commandBuffers[currentFrame], imageIndex,
-										  shadowMapIndex); // 현재 작업할 image의 index와 commandBuffer를 전송
-
-	VkImageMemoryBarrier barrier{};
-	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	barrier.image = m_viewPortFrameBuffers->getViewPortImage();
-	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	barrier.subresourceRange.baseMipLevel = 0;
-
-	barrier.subresourceRange.levelCount = 1;
-	barrier.subresourceRange.baseArrayLayer = 0;
-	barrier.subresourceRange.layerCount = 1;
+	// shadow / geometry pass 의 draw 는 worker thread 에서 secondary command buffer 로 기록
+	recordSecondaryCommandBuffers(shadowLights);
 
-	barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	// GPU culling 은 render pass 밖에서 먼저 실행해야 geometry pass 의 indirect draw 가 결과를 읽을 수 있다.
+	if (m_gpuCulling)
+	{
+		uint32_t cullingScope = m_gpuProfiler->beginScope(commandBuffers[currentFrame], "GPU culling");
+		recordGpuCulling(commandBuffers[currentFrame]);
+		m_gpuProfiler->endScope(commandBuffers[currentFrame], cullingScope);
+	}
 
-	vkCmdPipelineBarrier(commandBuffers[currentFrame], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-						 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	// light 마다 2D / cube map 중 하나만 그리고, 캐시가 유효한 shadow map 은 pass 를 건너뛴다.
+	// layout 전환과 barrier 는 render graph 가 pass 선언을 보고 넣는다.
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		bool render = i < shadowMapIndex && m_shadowPasses[i].render;
+		m_renderGraph->setPassEnabled(m_shadowMapPasses[i], render && !m_shadowPasses[i].cube);
+		m_renderGraph->setPassEnabled(m_shadowCubeMapPasses[i], render && m_shadowPasses[i].cube);
+	}
+	m_renderGraph->execute(commandBuffers[currentFrame], m_gpuProfiler.get());
 
-	recordImGuiCommandBuffer(commandBuffers[currentFrame], imageIndex);
+	if (!m_headless)
+	{
+		recordImGuiCommandBuffer(commandBuffers[currentFrame], imageIndex);
+	}
 
 	if (vkEndCommandBuffer(commandBuffers[currentFrame]) != VK_SUCCESS)
 	{
@@ -623,7 +733,7 @@ void Renderer::drawFrame(Scene *scene)
 	// 작업 실행 신호를 받을 대기 세마포어 설정 (해당 세마포어가 signal 상태가 되기 전엔 대기)
 	VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
 	VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-	submitInfo.waitSemaphoreCount = 1;			 // 대기 세마포어 개수
+	submitInfo.waitSemaphoreCount = m_headless ? 0 : 1; // 대기 세마포어 개수 (headless 는 acquire 하지 않음)
 	submitInfo.pWaitSemaphores = waitSemaphores; // 대기 세마포어 등록
 	submitInfo.pWaitDstStageMask = waitStages;	 // 대기할 시점 등록 (그 전까지는 세마포어 상관없이 그냥 진행)
 
@@ -633,14 +743,25 @@ void Renderer::drawFrame(Scene *scene)
 
 	// 작업이 완료된 후 신호를 보낼 세마포어 설정 (작업이 끝나면 해당 세마포어 signal 상태로 변경)
 	VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-	submitInfo.signalSemaphoreCount = 1;			 // 작업 끝나고 신호를 보낼 세마포어 개수
+	submitInfo.signalSemaphoreCount = m_headless ? 0 : 1; // 작업 끝나고 신호를 보낼 세마포어 개수 (present 할 때만)
 	submitInfo.pSignalSemaphores = signalSemaphores; // 작업 끝나고 신호를 보낼 세마포어 등록
 
+	// 이번 프레임에 쌓인 업로드를 먼저 제출 (같은 graphics queue 에서 렌더링보다 앞선다)
+	UploadManager::getUploadManager().flush();
+
 	// 커맨드 버퍼 제출
+	m_gpuProfiler->endFrame(currentFrame);
 	if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to submit draw command buffer!");
 	}
+	m_framePacer.onSubmit(currentFrame);
+
+	if (m_headless)
+	{
+		currentFrame = (currentFrame + 1) % m_framesInFlight;
+		return;
+	}
 
 	// [프레젠테이션 Command Buffer 제출]
 	// 프레젠테이션 커맨드 버퍼 제출 정보 객체 생성
@@ -658,7 +779,8 @@ void Renderer::drawFrame(Scene *scene)
 	presentInfo.pImageIndices = &imageIndex; // 스왑체인에서 표시할 이미지 핸들 등록
 
 	// 프레젠테이션 큐에 이미지 제출
-	result = vkQueuePresentKHR(presentQueue, &presentInfo);
+	VkResult result = vkQueuePresentKHR(presentQueue, &presentInfo);
+	m_framePacer.onPresent(currentFrame);
 
 	// 프레젠테이션 실패 오류 발생 시
 	// if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) { <-
@@ -675,15 +797,23 @@ void Renderer::drawFrame(Scene *scene)
 	}
 	// [프레임 인덱스 증가]
 	// 다음 작업할 프레임 변경
-	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	currentFrame = (currentFrame + 1) % m_framesInFlight;
 }
 
 void Renderer::drawNoCamFrame()
 {
+	// headless 는 ImGui 로 보여줄 창이 없으므로 camera 가 없으면 그릴 것도 없다.
+	if (m_headless)
+	{
+		return;
+	}
+
 	// [이전 GPU 작업 대기]
 	// 동시에 작업 가능한 최대 Frame 개수만큼 작업 중인 경우 대기 (가장 먼저 시작한 Frame 작업이 끝나서 Fence에 signal을
 	// 보내기를 기다림)
+	FramePacer::Clock::time_point fenceWaitStart = FramePacer::Clock::now();
 	vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+	m_framePacer.onFenceWaited(currentFrame, fenceWaitStart);
 
 	// [작업할 image 준비]
 	// 이번 Frame 에서 사용할 이미지 준비 및 해당 이미지 index 받아오기 (준비가 끝나면 signal 보낼 세마포어 등록)
@@ -744,6 +874,9 @@ void Renderer::drawNoCamFrame()
 		throw std::runtime_error("failed to begin recording command buffer!");
 	}
 
+	// 이 프레임 slot 의 이전 GPU 시간을 읽고 query 를 reset
+	m_gpuProfiler->beginFrame(commandBuffers[currentFrame], currentFrame);
+
 	recordImGuiCommandBuffer(commandBuffers[currentFrame], imageIndex);
 
 	if (vkEndCommandBuffer(commandBuffers[currentFrame]) != VK_SUCCESS)
@@ -772,11 +905,16 @@ void Renderer::drawNoCamFrame()
 	submitInfo.signalSemaphoreCount = 1;			 // 작업 끝나고 신호를 보낼 세마포어 개수
 	submitInfo.pSignalSemaphores = signalSemaphores; // 작업 끝나고 신호를 보낼 세마포어 등록
 
+	// 이번 프레임에 쌓인 업로드를 먼저 제출 (같은 graphics queue 에서 렌더링보다 앞선다)
+	UploadManager::getUploadManager().flush();
+
 	// 커맨드 버퍼 제출
+	m_gpuProfiler->endFrame(currentFrame);
 	if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to submit draw command buffer!");
 	}
+	m_framePacer.onSubmit(currentFrame);
 
 	// [프레젠테이션 Command Buffer 제출]
 	// 프레젠테이션 커맨드 버퍼 제출 정보 객체 생성
@@ -795,6 +933,7 @@ void Renderer::drawNoCamFrame()
 
 	// 프레젠테이션 큐에 이미지 제출
 	result = vkQueuePresentKHR(presentQueue, &presentInfo);
+	m_framePacer.onPresent(currentFrame);
 
 	// 프레젠테이션 실패 오류 발생 시
 	// if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) { <-
@@ -811,255 +950,1278 @@ void Renderer::drawNoCamFrame()
 	}
 	// [프레임 인덱스 증가]
 	// 다음 작업할 프레임 변경
-	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
-}
-
-void Renderer::recordImGuiCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex)
-{
-	// 렌더 패스 시작
-	VkRenderPassBeginInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassInfo.renderPass = imGuiRenderPass;
-	renderPassInfo.framebuffer = imGuiSwapChainFrameBuffers[imageIndex];
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = swapChainExtent;
-
-	std::array<VkClearValue, 1> clearValues{};
-	clearValues[0].color = {0.0f, 0.0f, 0.0f, 1.0f};
-
-	renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-	renderPassInfo.pClearValues = clearValues.data();
-
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-	ImGuiLayer::renderDrawData(commandBuffer);
-	vkCmdEndRenderPass(commandBuffer);
+	currentFrame = (currentFrame + 1) % m_framesInFlight;
 }
 
 /*
-	[커맨드 버퍼에 작업 기록]
-	1. 커맨드 버퍼 기록 시작
-	2. 렌더패스 시작하는 명령 기록
-	3. 파이프라인 설정 명령 기록
-	4. 렌더링 명령 기록
-	5. 렌더 패스 종료 명령 기록
-	6. 커맨드 버퍼 기록 종료
+	frustum culling 을 통과한 entity 를 (Model, mesh, material) 별로 묶고
+	각 묶음의 world transform 을 이번 프레임의 instance buffer 에 연속으로 기록한다.
+	skeletal animation 이 있는 entity 는 bone 행렬이 entity 마다 다르므로 따로 그린다.
 */
-void Renderer::recordDeferredRenderPassCommandBuffer(Scene *scene, VkCommandBuffer commandBuffer, uint32_t imageIndex,
-													 uint32_t shadowMapIndex)
+void Renderer::buildInstanceBatches(Scene *scene)
 {
-	// 렌더 패스 시작
-	VkRenderPassBeginInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassInfo.renderPass = deferredRenderPass;
-	renderPassInfo.framebuffer = viewPortFramebuffers[currentFrame];
+	m_instanceRecords.clear();
+	m_bonePalette.clear();
+	glm::vec3 camPos = scene->getCamPos();
+	auto &visibleEntities = scene->getVisibleEntities();
+	for (uint32_t cullIndex = 0; cullIndex < visibleEntities.size(); cullIndex++)
+	{
+		entt::entity entity = visibleEntities[cullIndex];
+		MeshRendererComponent &meshRendererComponent = scene->getComponent<MeshRendererComponent>(entity);
+		if (!scene->getComponent<TagComponent>(entity).m_isActive || meshRendererComponent.type == 0)
+		{
+			continue;
+		}
 
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
-
-	// ClearValues 수정
-	std::array<VkClearValue, 6> clearValues{};
-	// clearValues[0].color = {0.0f, 0.0f, 0.0f, 1.0f};
-	clearValues[0].color = {INFINITY, INFINITY, INFINITY, 1.0f};
-	clearValues[1].color = {0.0f, 0.0f, 0.0f, 1.0f};
-	clearValues[2].color = {0.0f, 0.0f, 0.0f, 1.0f};
-	clearValues[3].color = {0.0f, 0.0f, 0.0f, 1.0f};
-	clearValues[4].depthStencil = {1.0f, 0};
-	clearValues[5].color = {0.0f, 0.0f, 0.0f, 1.0f};
+		RenderingComponent *renderingComponent = meshRendererComponent.m_RenderingComponent.get();
+		Model *model = renderingComponent->getModel().get();
+		auto &materials = renderingComponent->getMaterials();
 
-	renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+		// skinning 행렬은 skeleton 마다 실제 bone 개수만큼 한 번만 palette 에 올리고, 모든 mesh 가 offset 으로 공유
+		bool skinned = false;
+		uint32_t boneOffset = 0;
+		if (auto *animator = scene->tryGet<SkeletalAnimatorComponent>(entity))
+		{
+			auto *sac = (SAComponent *)animator->sac.get();
+			std::vector<glm::mat4> &pose = sac->getCurrentPose();
+			skinned = true;
+			boneOffset = static_cast<uint32_t>(m_bonePalette.size());
+
+			// 첫 animation update 전 (editor 등) 에는 pose 가 비어 있거나 짧으므로 skeleton 의 bone 수까지 단위 행렬로
+			// 채운다. 그렇지 않으면 다음 entity 의 bone 이나 palette 끝 너머를 읽는다.
+			auto &skeleton = model->getSkeleton();
+			size_t boneCount = std::max(pose.size(), skeleton ? skeleton->m_Bones.size() : size_t(0));
+			boneCount = std::clamp<size_t>(boneCount, 1, MAX_BONES);
+			size_t poseCount = std::min(pose.size(), boneCount);
+			m_bonePalette.insert(m_bonePalette.end(), pose.begin(), pose.begin() + poseCount);
+			m_bonePalette.resize(boneOffset + boneCount, glm::mat4(1.0f));
+		}
+
+		// 같은 batch 안에서는 카메라에 가까운 instance 부터 그린다.
+		glm::vec3 position = glm::vec3(scene->getComponent<TransformComponent>(entity).m_WorldTransform[3]);
+		float depth = glm::length(position - camPos);
+
+		for (uint32_t i = 0; i < model->getMeshCount(); i++)
+		{
+			// height map 을 쓰는 material 만 displacement 가 들어간 vertex shader 로 그린다.
+			Material *material = materials[i].get();
+			uint32_t variant = skinned ? GEOMETRY_PASS_SKINNED : 0;
+			variant |= material->getHeightMap().flag ? GEOMETRY_PASS_HEIGHT_MAP : 0;
+			m_instanceRecords.push_back(
+				{model, i, material, variant, boneOffset, depth, renderingComponent, entity, cullIndex});
+		}
+	}
+
+	// (pipeline, material, mesh, depth) 64bit key 로 정렬
+	// 같은 pipeline variant 끼리 모여서 pipeline 교체는 variant 당 한 번이고, material / mesh 가 이어지는 batch 는 bind 를
+	// 생략한다.
+	// palette 위치는 instance 마다 따로 있으므로 같은 mesh 를 쓰는 skinned entity 도 한 batch 로 묶인다.
+	constexpr float maxSortDepth = 1000.0f;
+	m_materialIds.clear();
+	m_modelMeshIds.clear();
+	m_visibleMaterials.clear();
+	m_renderQueue.clear();
+	uint32_t meshIdCount = 0;
+	for (uint32_t i = 0; i < m_instanceRecords.size(); i++)
+	{
+		const InstanceRecord &record = m_instanceRecords[i];
+		auto materialId = m_materialIds.emplace(record.material, static_cast<uint32_t>(m_materialIds.size()));
+		if (materialId.second)
+		{
+			m_visibleMaterials.push_back(record.material);
+		}
+		auto modelMeshId = m_modelMeshIds.emplace(record.model, meshIdCount);
+		if (modelMeshId.second)
+		{
+			meshIdCount += record.model->getMeshCount();
+		}
+
+		uint64_t key = RenderQueue::makeKey(record.variant, materialId.first->second,
+											modelMeshId.first->second + record.meshIndex, record.depth, maxSortDepth);
+		m_renderQueue.push(key, i);
+	}
+	m_renderQueue.sort();
+
+	m_instanceBatches.clear();
+	m_instanceData.resize(m_instanceRecords.size());
+	m_gpuCullInstances.resize(m_gpuCulling ? m_instanceRecords.size() : 0);
+	auto &packets = m_renderQueue.getPackets();
+	for (uint32_t i = 0; i < packets.size(); i++)
+	{
+		const InstanceRecord &record = m_instanceRecords[packets[i].index];
+		m_instanceData[i].model = scene->getComponent<TransformComponent>(record.entity).m_WorldTransform;
+		m_instanceData[i].boneOffset = record.boneOffset;
+
+		// key 가 같아도 (id 가 key 범위를 넘은 경우) material / mesh 가 다르면 batch 를 나눈다.
+		const InstanceRecord *previous = i == 0 ? nullptr : &m_instanceRecords[packets[i - 1].index];
+		if (!previous || RenderQueue::getBatchKey(packets[i - 1].key) != RenderQueue::getBatchKey(packets[i].key) ||
+			previous->material != record.material || previous->model != record.model ||
+			previous->meshIndex != record.meshIndex)
+		{
+			m_instanceBatches.push_back({record.renderingComponent, record.meshIndex, i, 0, record.variant,
+										 m_materialIds[record.material]});
+		}
+		m_instanceBatches.back().instanceCount++;
+
+		// GPU culling 은 entity 의 sphere 로 instance 를 검사하고 batch 의 indirect command 구간에 모은다.
+		if (m_gpuCulling)
+		{
+			const CullSphere &sphere = m_cullSpheres[record.cullIndex];
+			m_gpuCullInstances[i].sphere = glm::vec4(sphere.center, sphere.radius);
+			m_gpuCullInstances[i].batchIndex = static_cast<uint32_t>(m_instanceBatches.size() - 1);
+		}
+	}
+	m_visibleInstanceCount = static_cast<uint32_t>(m_instanceData.size());
+}
+
+// 카메라 / shadow caster instance 와 skinning palette 를 이번 프레임 buffer 에 올린다.
+void Renderer::uploadInstanceData()
+{
+	uint32_t instanceCount = static_cast<uint32_t>(m_instanceData.size());
+	if (instanceCount == 0)
+	{
+		return;
+	}
+
+	// 용량이 부족하면 2배씩 늘려서 다시 만든다.
+	auto &instanceBuffer = m_instanceBuffers[currentFrame];
+	if (instanceCount > instanceBuffer->getCapacity())
+	{
+		uint32_t capacity = std::max(instanceCount, instanceBuffer->getCapacity() * 2);
+		instanceBuffer->cleanup();
+		instanceBuffer = InstanceBuffer::createInstanceBuffer(capacity);
+		m_gpuCullingSetDirty[currentFrame] = true;
+	}
+	instanceBuffer->updateInstanceBuffer(m_instanceData.data(), instanceCount);
+
+	if (m_bonePalette.empty())
+	{
+		return;
+	}
+
+	auto &boneBuffer = m_boneBuffers[currentFrame];
+	VkDeviceSize paletteSize = sizeof(glm::mat4) * m_bonePalette.size();
+	if (paletteSize > boneBuffer->getSize())
+	{
+		VkDeviceSize size = std::max(paletteSize, boneBuffer->getSize() * 2);
+		boneBuffer->cleanup();
+		boneBuffer = StorageBuffer::createStorageBuffer(size);
+		m_geometryPassFrameShaderResourceManager->updateStorageBufferDescriptorSet(currentFrame, 2,
+																				   boneBuffer->getBuffer());
+	}
+	boneBuffer->updateStorageBuffer(m_bonePalette.data(), paletteSize);
+}
+
+// 이번 프레임에 그릴 material 을 material table 로 만들어 올리고, 새로 쓰인 texture 를 이번 프레임 texture 배열에 쓴다.
+void Renderer::uploadMaterialTable()
+{
+	m_materialTable->update(currentFrame, m_visibleMaterials);
+
+	auto &materialData = m_materialTable->getMaterialData();
+	if (materialData.empty())
+	{
+		return;
+	}
+
+	auto &materialBuffer = m_materialBuffers[currentFrame];
+	VkDeviceSize tableSize = sizeof(MaterialData) * materialData.size();
+	if (tableSize > materialBuffer->getSize())
+	{
+		VkDeviceSize size = std::max(tableSize, materialBuffer->getSize() * 2);
+		materialBuffer->cleanup();
+		materialBuffer = StorageBuffer::createStorageBuffer(size);
+		m_geometryPassFrameShaderResourceManager->updateStorageBufferDescriptorSet(currentFrame, 1,
+																				   materialBuffer->getBuffer());
+	}
+	materialBuffer->updateStorageBuffer(materialData.data(), tableSize);
+}
+
+static Mesh *getBatchMesh(const InstanceBatch &batch)
+{
+	return batch.renderingComponent->getModel()->getMeshes()[batch.meshIndex].get();
+}
+
+// GPU culling pipeline 과 프레임별 buffer 는 GPU 모드를 처음 쓸 때 만든다.
+// shader 를 compile 하거나 pipeline 을 만들지 못하면 false 를 돌려준다.
+bool Renderer::initGpuCulling()
+{
+	m_gpuCullingDescriptorSetLayout = DescriptorSetLayout::createGpuCullingDescriptorSetLayout();
+	VkDescriptorSetLayout descriptorSetLayout = m_gpuCullingDescriptorSetLayout->getDescriptorSetLayout();
+	try
+	{
+		m_gpuCullingPipeline = Pipeline::createGpuCullingPipeline(descriptorSetLayout);
+	}
+	catch (const std::exception &e)
+	{
+		AL_CORE_ERROR("Renderer: GPU culling is unavailable, falling back to CPU culling ({0})", e.what());
+		m_gpuCullingDescriptorSetLayout->cleanup();
+		m_gpuCullingDescriptorSetLayout.reset();
+		return false;
+	}
+	m_gpuCullingShaderResourceManager =
+		ShaderResourceManager::createStorageBufferShaderResourceManager(descriptorSetLayout);
+
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		m_gpuCullInstanceBuffers.push_back(StorageBuffer::createStorageBuffer(sizeof(GpuCullInstance) * 1024));
+		m_culledInstanceBuffers.push_back(InstanceBuffer::createCulledInstanceBuffer(1024));
+		m_indirectBuffers.push_back(IndirectBuffer::createIndirectBuffer(1024));
+		m_gpuCullingSetDirty[i] = true;
+		m_gpuCullBatchCount[i] = 0;
+	}
+	return true;
+}
+
+/*
+	GPU culling 모드의 indirect command 를 채운다.
+	- 앞쪽은 camera batch 마다 하나, instanceCount 는 0 으로 두고 compute shader 가 보이는 instance 수만큼 올린다.
+	- 뒤쪽은 이번 프레임에 다시 그리는 shadow view 의 batch 마다 하나, caster 는 CPU 에서 이미 골랐으므로 개수를 그대로 쓴다.
+	buffer 를 덮어쓰기 전에, 이 buffer 를 마지막으로 쓴 프레임의 culling 결과(보인 instance 수)를 읽어둔다.
+*/
+void Renderer::uploadIndirectCommands()
+{
+	auto &indirectBuffer = m_indirectBuffers[currentFrame];
+	uint32_t gpuVisibleCount = 0;
+	for (uint32_t i = 0; i < m_gpuCullBatchCount[currentFrame]; i++)
+	{
+		gpuVisibleCount += indirectBuffer->getCommands()[i].instanceCount;
+	}
+	m_gpuVisibleInstanceCount = gpuVisibleCount;
+
+	uint32_t batchCount = static_cast<uint32_t>(m_instanceBatches.size());
+	uint32_t commandCount = batchCount;
+	for (const ShadowPass &pass : m_shadowPasses)
+	{
+		if (!pass.render)
+		{
+			continue;
+		}
+		uint32_t viewCount = pass.cube ? 6 : 1;
+		for (uint32_t face = 0; face < viewCount; face++)
+		{
+			commandCount += static_cast<uint32_t>(pass.batches[face].size());
+		}
+	}
+
+	// 용량이 부족하면 2배씩 늘리고, 다시 만든 buffer 는 culling 디스크립터 셋에 다시 쓴다.
+	if (commandCount > indirectBuffer->getCapacity())
+	{
+		uint32_t capacity = std::max(commandCount, indirectBuffer->getCapacity() * 2);
+		indirectBuffer->cleanup();
+		indirectBuffer = IndirectBuffer::createIndirectBuffer(capacity);
+		m_gpuCullingSetDirty[currentFrame] = true;
+	}
+	auto &cullInstanceBuffer = m_gpuCullInstanceBuffers[currentFrame];
+	VkDeviceSize cullInstanceSize = sizeof(GpuCullInstance) * m_visibleInstanceCount;
+	if (cullInstanceSize > cullInstanceBuffer->getSize())
+	{
+		VkDeviceSize size = std::max(cullInstanceSize, cullInstanceBuffer->getSize() * 2);
+		cullInstanceBuffer->cleanup();
+		cullInstanceBuffer = StorageBuffer::createStorageBuffer(size);
+		m_gpuCullingSetDirty[currentFrame] = true;
+	}
+	auto &culledInstanceBuffer = m_culledInstanceBuffers[currentFrame];
+	if (m_visibleInstanceCount > culledInstanceBuffer->getCapacity())
+	{
+		uint32_t capacity = std::max(m_visibleInstanceCount, culledInstanceBuffer->getCapacity() * 2);
+		culledInstanceBuffer->cleanup();
+		culledInstanceBuffer = InstanceBuffer::createCulledInstanceBuffer(capacity);
+		m_gpuCullingSetDirty[currentFrame] = true;
+	}
+
+	VkDrawIndexedIndirectCommand *commands = indirectBuffer->getCommands();
+	for (uint32_t i = 0; i < batchCount; i++)
+	{
+		const InstanceBatch &batch = m_instanceBatches[i];
+		commands[i] = getBatchMesh(batch)->getDrawCommand(0, batch.firstInstance);
+	}
+
+	uint32_t commandIndex = batchCount;
+	for (ShadowPass &pass : m_shadowPasses)
+	{
+		if (!pass.render)
+		{
+			continue;
+		}
+		uint32_t viewCount = pass.cube ? 6 : 1;
+		for (uint32_t face = 0; face < viewCount; face++)
+		{
+			pass.commandOffset[face] = commandIndex;
+			for (const InstanceBatch &batch : pass.batches[face])
+			{
+				commands[commandIndex++] =
+					getBatchMesh(batch)->getDrawCommand(batch.instanceCount, batch.firstInstance);
+			}
+		}
+	}
+
+	if (cullInstanceSize > 0)
+	{
+		cullInstanceBuffer->updateStorageBuffer(m_gpuCullInstances.data(), cullInstanceSize);
+	}
+	m_gpuCullBatchCount[currentFrame] = batchCount;
+
+	if (m_gpuCullingSetDirty[currentFrame])
+	{
+		m_gpuCullingShaderResourceManager->updateStorageBufferDescriptorSet(currentFrame, 0,
+																			cullInstanceBuffer->getBuffer());
+		m_gpuCullingShaderResourceManager->updateStorageBufferDescriptorSet(
+			currentFrame, 1, m_instanceBuffers[currentFrame]->getBuffer());
+		m_gpuCullingShaderResourceManager->updateStorageBufferDescriptorSet(currentFrame, 2,
+																			culledInstanceBuffer->getBuffer());
+		m_gpuCullingShaderResourceManager->updateStorageBufferDescriptorSet(currentFrame, 3,
+																			indirectBuffer->getBuffer());
+		m_gpuCullingSetDirty[currentFrame] = false;
+	}
+}
+
+static void hashCombine(uint64_t &hash, uint64_t value)
+{
+	hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+}
+
+static void hashMatrix(uint64_t &hash, const glm::mat4 &matrix)
+{
+	const float *values = &matrix[0][0];
+	for (uint32_t i = 0; i < 16; i += 2)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, values + i, sizeof(bits));
+		hashCombine(hash, bits);
+	}
+}
+
+// LightingPass 에서 shadow map 을 샘플링할 때와 같은 light 행렬
+static void computeShadowMatrices(const Light &lightInfo, ShadowPass &pass)
+{
+	glm::vec3 lightPos = lightInfo.position;
+	if (pass.cube)
+	{
+		pass.proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+		pass.view[0] = glm::lookAt(lightPos, lightPos + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
+		pass.view[1] = glm::lookAt(lightPos, lightPos + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
+		pass.view[2] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0));
+		pass.view[3] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, -1.0));
+		pass.view[4] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, -1.0, 0.0));
+		pass.view[5] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, -1.0, 0.0));
+		return;
+	}
+
+	glm::vec3 lightDir = glm::normalize(lightInfo.direction);
+	float outerCutoff = lightInfo.outerCutoff;
+	glm::vec3 up = (glm::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+	pass.view[0] = glm::mat4(1.0f);
+	pass.proj = glm::mat4(1.0f);
+	if (lightInfo.type == 1)
+	{ // spotlight
+		pass.view[0] = glm::lookAt(lightPos, lightPos + lightDir, up);
+		pass.proj = glm::perspective(glm::acos(outerCutoff) * 2.0f, 1.0f, 0.1f, 100.0f);
+		pass.proj[1][1] *= -1;
+	}
+	else if (lightInfo.type == 2)
+	{												   // directional light
+		lightPos = glm::vec3(0.0f) - lightDir * 10.0f; // 광원을 기준으로 카메라처럼 뒤쪽으로 멀어짐
+		pass.view[0] = glm::lookAt(lightPos, glm::vec3(0.0f), up);
+		float orthoSize = 10.0f; // 광원의 영향을 받는 영역의 크기
+		pass.proj = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, -10.0f, 20.0f);
+		// Vulkan 좌표계 보정
+		pass.proj[1][1] *= -1;
+	}
+}
+
+/*
+	shadow map 을 그리는 light 마다 light frustum (point light 는 cube map 면마다) 으로 cull tree 를 검사해서 caster 를 모은다.
+	light 행렬과 caster 목록 / transform 으로 만든 signature 가 shadow map 에 들어있는 내용과 같으면 다시 그리지 않는다.
+	skinned caster 도 shadow pass 에서는 bind pose 로 그려지므로 animation 만으로는 다시 그리지 않는다.
+*/
+void Renderer::buildShadowPasses(Scene *scene, const std::vector<Light *> &shadowLights)
+{
+	m_shadowRenderCount = 0;
+	m_shadowCachedCount = 0;
+	m_shadowCasterCount = 0;
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		ShadowPass &pass = m_shadowPasses[i];
+		if (i >= shadowLights.size())
+		{
+			// 쓰지 않는 slot 은 다른 light 가 들어오면 다시 그린다.
+			pass.render = false;
+			pass.light = nullptr;
+			m_shadowCacheValid[i] = false;
+			continue;
+		}
+
+		const Light &lightInfo = *shadowLights[i];
+		pass.light = shadowLights[i];
+		pass.cube = lightInfo.type == 0;
+		computeShadowMatrices(lightInfo, pass);
+
+		uint64_t signature = static_cast<uint64_t>(lightInfo.type);
+		hashMatrix(signature, pass.proj);
+		uint32_t viewCount = pass.cube ? 6 : 1;
+		for (uint32_t face = 0; face < viewCount; face++)
+		{
+			hashMatrix(signature, pass.view[face]);
+
+			Frustum frustum;
+			frustum.setFromViewProjection(pass.proj * pass.view[face]);
+			std::vector<entt::entity> &casters = m_shadowCasters[face];
+			scene->shadowCasterCulling(frustum, casters);
+
+			// 그리지 않는 entity 는 빼고, 남은 caster 의 Model / transform 을 signature 에 섞는다.
+			uint32_t casterCount = 0;
+			for (entt::entity entity : casters)
+			{
+				MeshRendererComponent &meshRendererComponent = scene->getComponent<MeshRendererComponent>(entity);
+				if (!scene->getComponent<TagComponent>(entity).m_isActive || meshRendererComponent.type == 0)
+				{
+					continue;
+				}
+				casters[casterCount++] = entity;
+
+				Model *model = meshRendererComponent.m_RenderingComponent->getModel().get();
+				hashCombine(signature, static_cast<uint32_t>(entity));
+				hashCombine(signature, reinterpret_cast<uintptr_t>(model));
+				hashMatrix(signature, scene->getComponent<TransformComponent>(entity).m_WorldTransform);
+			}
+			casters.resize(casterCount);
+			hashCombine(signature, casterCount);
+		}
+
+		pass.signature = signature;
+		pass.render = !m_shadowCacheValid[i] || m_shadowSignatures[i] != signature;
+		if (!pass.render)
+		{
+			m_shadowCachedCount++;
+			continue;
+		}
+
+		for (uint32_t face = 0; face < viewCount; face++)
+		{
+			buildShadowBatches(scene, m_shadowCasters[face], pass.batches[face]);
+		}
+		m_shadowSignatures[i] = signature;
+		m_shadowCacheValid[i] = true;
+		m_shadowRenderCount++;
+	}
+}
+
+// caster 를 (Model, mesh) 별로 묶어서 m_instanceData 뒤에 이어 붙인다. shadow pass 는 material 을 쓰지 않는다.
+void Renderer::buildShadowBatches(Scene *scene, const std::vector<entt::entity> &casters,
+								  std::vector<InstanceBatch> &batches)
+{
+	batches.clear();
+	m_shadowRecords.clear();
+	for (entt::entity entity : casters)
+	{
+		RenderingComponent *renderingComponent =
+			scene->getComponent<MeshRendererComponent>(entity).m_RenderingComponent.get();
+		Model *model = renderingComponent->getModel().get();
+		for (uint32_t i = 0; i < model->getMeshCount(); i++)
+		{
+			m_shadowRecords.push_back({model, i, nullptr, 0, 0, 0.0f, renderingComponent, entity, 0});
+		}
+	}
+
+	std::sort(m_shadowRecords.begin(), m_shadowRecords.end(), [](const InstanceRecord &a, const InstanceRecord &b) {
+		if (a.model != b.model)
+		{
+			return std::less<Model *>()(a.model, b.model);
+		}
+		return a.meshIndex < b.meshIndex;
+	});
+
+	uint32_t firstInstance = static_cast<uint32_t>(m_instanceData.size());
+	m_instanceData.resize(firstInstance + m_shadowRecords.size());
+	for (uint32_t i = 0; i < m_shadowRecords.size(); i++)
+	{
+		const InstanceRecord &record = m_shadowRecords[i];
+		m_instanceData[firstInstance + i].model =
+			scene->getComponent<TransformComponent>(record.entity).m_WorldTransform;
+		m_instanceData[firstInstance + i].boneOffset = 0;
+
+		if (i == 0 || record.model != m_shadowRecords[i - 1].model ||
+			record.meshIndex != m_shadowRecords[i - 1].meshIndex)
+		{
+			batches.push_back({record.renderingComponent, record.meshIndex, firstInstance + i, 0, 0});
+		}
+		batches.back().instanceCount++;
+	}
+	m_shadowCasterCount += static_cast<uint32_t>(m_shadowRecords.size());
+}
+
+/*
+	lighting pass 의 light 목록을 만들고 cluster 에 배정해서 이번 프레임 buffer 에 올린다.
+	directional light 와 shadow map 을 쓰는 light 는 모든 pixel 이 같은 순서로 계산하도록 목록 앞쪽에 두고
+	(shadow map 배열 index 가 pixel 마다 달라지지 않게), 나머지 point / spot light 만 cluster 로 나눈다.
+*/
+void Renderer::prepareLights(Scene *scene, uint32_t shadowMapCount)
+{
+	LightingPassUniformBufferObject lightingPassUbo{};
+	std::memset(&lightingPassUbo, 0, sizeof(lightingPassUbo));
+
+	m_lights.clear();
+	m_clusteredLights.clear();
+	auto lightView = scene->getAllEntitiesWith<TransformComponent, LightComponent>();
+	for (auto entity : lightView)
+	{
+		const Light *sourceLight = lightView.get<LightComponent>(entity).m_Light.get();
+		Light light = *sourceLight;
+		light.range = LightCluster::computeLightRange(light);
+		light.shadowMapIndex = UINT32_MAX;
+		for (uint32_t i = 0; i < shadowMapCount; i++)
+		{
+			if (m_shadowPasses[i].light == sourceLight)
+			{
+				light.shadowMapIndex = i;
+			}
+		}
+
+		if (light.type == 2 || light.shadowMapIndex != UINT32_MAX)
+		{
+			m_lights.push_back(light);
+		}
+		else
+		{
+			m_clusteredLights.push_back(light);
+		}
+	}
+	uint32_t globalLightCount = static_cast<uint32_t>(m_lights.size());
+	m_lights.insert(m_lights.end(), m_clusteredLights.begin(), m_clusteredLights.end());
+
+	// shadow map 행렬은 shadow pass 에서 그린 것과 같은 행렬
+	for (uint32_t i = 0; i < shadowMapCount; i++)
+	{
+		const ShadowPass &pass = m_shadowPasses[i];
+		for (uint32_t face = 0; face < (pass.cube ? 6u : 1u); face++)
+		{
+			lightingPassUbo.view[i][face] = pass.view[face];
+		}
+		lightingPassUbo.proj[i] = pass.proj;
+	}
+
+	glm::mat4 projection = projMatrix;
+	projection[1][1] *= -1;
+	m_lightCluster.build(m_lights, globalLightCount, viewMatirx, projection,
+						 glm::vec2(m_renderExtent.width, m_renderExtent.height));
+
+	if (!m_lights.empty())
+	{
+		uploadLightingStorageBuffer(m_lightBuffers[currentFrame], 8, m_lights.data(), sizeof(Light) * m_lights.size());
+	}
+	auto &clusters = m_lightCluster.getClusters();
+	uploadLightingStorageBuffer(m_clusterBuffers[currentFrame], 9, clusters.data(),
+								sizeof(LightClusterRange) * clusters.size());
+	auto &lightIndices = m_lightCluster.getLightIndices();
+	if (!lightIndices.empty())
+	{
+		uploadLightingStorageBuffer(m_lightIndexBuffers[currentFrame], 10, lightIndices.data(),
+									sizeof(uint32_t) * lightIndices.size());
+	}
+
+	lightingPassUbo.cameraView = viewMatirx;
+	lightingPassUbo.cameraPos = scene->getCamPos();
+	lightingPassUbo.clusterGrid = m_lightCluster.getGrid(globalLightCount);
+	lightingPassUbo.clusterParams = m_lightCluster.getParams();
+	lightingPassUbo.numLights = static_cast<uint32_t>(m_lights.size());
+	lightingPassUbo.ambientStrength = scene->getAmbientStrength();
+	lightingPassFragmentUniformBuffers[currentFrame]->updateUniformBuffer(&lightingPassUbo, sizeof(lightingPassUbo));
+}
+
+// 용량이 부족하면 2배씩 늘려서 다시 만들고 이번 프레임의 lighting pass descriptor 를 새 buffer 로 바꾼다.
+void Renderer::uploadLightingStorageBuffer(std::unique_ptr<StorageBuffer> &storageBuffer, uint32_t binding,
+										   const void *data, VkDeviceSize size)
+{
+	if (size > storageBuffer->getSize())
+	{
+		VkDeviceSize newSize = std::max(size, storageBuffer->getSize() * 2);
+		storageBuffer->cleanup();
+		storageBuffer = StorageBuffer::createStorageBuffer(newSize);
+		m_lightingPassShaderResourceManager->updateStorageBufferDescriptorSet(currentFrame, binding,
+																			  storageBuffer->getBuffer());
+	}
+	storageBuffer->updateStorageBuffer(data, size);
+}
+
+// lighting pass descriptor set 을 새로 만들었을 때 (swap chain / viewport 재생성) storage buffer 를 다시 연결
+void Renderer::updateLightingPassStorageBufferDescriptorSets()
+{
+	for (uint32_t i = 0; i < m_lightBuffers.size(); i++)
+	{
+		m_lightingPassShaderResourceManager->updateStorageBufferDescriptorSet(i, 8, m_lightBuffers[i]->getBuffer());
+		m_lightingPassShaderResourceManager->updateStorageBufferDescriptorSet(i, 9, m_clusterBuffers[i]->getBuffer());
+		m_lightingPassShaderResourceManager->updateStorageBufferDescriptorSet(i, 10,
+																			  m_lightIndexBuffers[i]->getBuffer());
+	}
+}
+
+/*
+	이번 프레임의 uniform ring buffer 를 비우고 모든 draw 가 공유하는 값(cube map layer index)을 올린다.
+	필요한 크기를 미리 계산해서 부족하면 2배씩 늘려 다시 만든다.
+*/
+void Renderer::prepareFrameUniforms()
+{
+	auto &uniformRingBuffer = m_uniformRingBuffers[currentFrame];
+
+	VkDeviceSize requiredSize = uniformRingBuffer->getAlignedSize(sizeof(GeometryPassCameraUniformBufferObject)) +
+								4 * (uniformRingBuffer->getAlignedSize(sizeof(ShadowMapUniformBufferObject)) +
+									 uniformRingBuffer->getAlignedSize(sizeof(ShadowCubeMapUniformBufferObject))) +
+								6 * uniformRingBuffer->getAlignedSize(sizeof(ShadowCubeMapLayerIndex));
+
+	if (requiredSize > uniformRingBuffer->getSize())
+	{
+		VkDeviceSize size = std::max(requiredSize, uniformRingBuffer->getSize() * 2);
+		uniformRingBuffer->cleanup();
+		uniformRingBuffer = UniformRingBuffer::createUniformRingBuffer(size);
+
+		VkBuffer buffer = uniformRingBuffer->getBuffer();
+		m_geometryPassFrameShaderResourceManager->updateDynamicUniformDescriptorSet(currentFrame, buffer);
+		m_shadowMapFrameShaderResourceManager->updateDynamicUniformDescriptorSet(currentFrame, buffer);
+		m_shadowCubeMapFrameShaderResourceManager->updateDynamicUniformDescriptorSet(currentFrame, buffer);
+	}
+
+	uniformRingBuffer->reset();
+
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		ShadowCubeMapLayerIndex layerIndexUbo{};
+		layerIndexUbo.layerIndex = i;
+		m_layerIndexOffsets[i] = uniformRingBuffer->push(&layerIndexUbo, sizeof(layerIndexUbo));
+	}
+}
+
+void Renderer::recordImGuiCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+{
+	// 렌더 패스 시작
+	VkRenderPassBeginInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassInfo.renderPass = imGuiRenderPass;
+	renderPassInfo.framebuffer = imGuiSwapChainFrameBuffers[imageIndex];
+	renderPassInfo.renderArea.offset = {0, 0};
+	renderPassInfo.renderArea.extent = swapChainExtent;
+
+	std::array<VkClearValue, 1> clearValues{};
+	clearValues[0].color = {0.0f, 0.0f, 0.0f, 1.0f};
+
+	renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
 	renderPassInfo.pClearValues = clearValues.data();
 
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	uint32_t scope = m_gpuProfiler->beginScope(commandBuffer, "ImGui");
+	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	ImGuiLayer::renderDrawData(commandBuffer);
+	vkCmdEndRenderPass(commandBuffer);
+	m_gpuProfiler->endScope(commandBuffer, scope);
+}
+
+/*
+	[커맨드 버퍼에 작업 기록]
+	1. 커맨드 버퍼 기록 시작
+	2. 렌더패스 시작하는 명령 기록
+	3. 파이프라인 설정 명령 기록
+	4. 렌더링 명령 기록
+	5. 렌더 패스 종료 명령 기록
+	6. 커맨드 버퍼 기록 종료
+*/
+/*
+	viewport 에 그리는 pass 와 attachment 를 선언한다. (선언 순서가 실행 순서)
+	- shadow map 은 static shadow 캐시 때문에 프레임이 지나도 내용이 남아야 해서 persistent 로 둔다.
+	  slot 마다 2D / cube 중 하나만 그리므로 둘이 메모리를 나눠 쓴다. (signature 에 light type 이 들어가서
+	  종류가 바뀌면 캐시도 맞지 않게 된다)
+	- G-buffer / depth 는 deferred pass 안에서만 쓰이므로 store 하지 않고, tiler 에서는 lazily allocated 메모리에 둔다.
+	- viewport image 는 ImGui / capture 가 읽으므로 프레임 끝에 SHADER_READ_ONLY 로 둔다.
+	- image 는 window 크기로 잡고, background / deferred pass 는 내부 해상도 만큼, upscale pass 는 viewport 크기
+	  만큼만 그린다. (dynamic resolution, viewport 크기 변경에 image 를 다시 만들지 않는다)
+*/
+void Renderer::buildRenderGraph()
+{
+	// viewport 는 ImGui 창 안에 있으므로 window 보다 클 일이 거의 없다. (더 커지면 recreateViewPort 에서 키운다)
+	VkExtent2D extent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
+	if (!m_headless)
+	{
+		extent.width = std::max(extent.width, swapChainExtent.width);
+		extent.height = std::max(extent.height, swapChainExtent.height);
+	}
+	m_renderGraph = RenderGraph::createRenderGraph(extent);
+
+	VkClearValue depthClear{};
+	depthClear.depthStencil = {1.0f, 0};
+	VkClearValue blackClear{};
+	blackClear.color = {0.0f, 0.0f, 0.0f, 1.0f};
+	VkClearValue positionClear{};
+	positionClear.color = {INFINITY, INFINITY, INFINITY, 1.0f};
+
+	RenderGraphImageInfo shadowMapInfo{};
+	shadowMapInfo.format = VK_FORMAT_D32_SFLOAT;
+	shadowMapInfo.width = 2048;
+	shadowMapInfo.height = 2048;
+	shadowMapInfo.persistent = true;
+	RenderGraphImageInfo shadowCubeMapInfo = shadowMapInfo;
+	shadowCubeMapInfo.layers = 6;
+	shadowCubeMapInfo.cube = true;
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		m_shadowMapImages[i] = m_renderGraph->createImage("Shadow map", shadowMapInfo);
+		m_shadowMapPasses[i] = m_renderGraph->addPass("Shadow maps", VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		m_renderGraph->writeDepth(m_shadowMapPasses[i], 0, m_shadowMapImages[i], VK_ATTACHMENT_LOAD_OP_CLEAR,
+								  depthClear);
+		m_renderGraph->setRecord(m_shadowMapPasses[i], 0, [this, i](VkCommandBuffer commandBuffer) {
+			vkCmdExecuteCommands(commandBuffer, 1, &m_shadowMapSecondaryCommandBuffers[i]);
+		});
+	}
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		m_shadowCubeMapImages[i] = m_renderGraph->createImage("Shadow cube map", shadowCubeMapInfo);
+		m_shadowCubeMapPasses[i] =
+			m_renderGraph->addPass("Shadow cube maps", VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		m_renderGraph->writeDepth(m_shadowCubeMapPasses[i], 0, m_shadowCubeMapImages[i],
+								  VK_ATTACHMENT_LOAD_OP_CLEAR, depthClear);
+		m_renderGraph->setRecord(m_shadowCubeMapPasses[i], 0, [this, i](VkCommandBuffer commandBuffer) {
+			vkCmdExecuteCommands(commandBuffer, 1, &m_shadowCubeMapSecondaryCommandBuffers[i]);
+		});
+		m_renderGraph->shareMemory(m_shadowCubeMapImages[i], m_shadowMapImages[i]);
+	}
+
+	RenderGraphImageInfo colorInfo{};
+	colorInfo.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+	m_backgroundImage = m_renderGraph->createImage("Background", colorInfo);
+	m_positionImage = m_renderGraph->createImage("Position", colorInfo);
+	m_normalImage = m_renderGraph->createImage("Normal", colorInfo);
+	colorInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+	m_albedoImage = m_renderGraph->createImage("Albedo", colorInfo);
+	m_pbrImage = m_renderGraph->createImage("Pbr", colorInfo);
+
+	RenderGraphImageInfo depthInfo{};
+	depthInfo.format = VulkanUtil::findDepthFormat();
+	m_depthImage = m_renderGraph->createImage("Depth", depthInfo);
+
+	// lighting 결과 (내부 해상도), upscale pass 가 viewport image 로 늘린다.
+	RenderGraphImageInfo sceneColorInfo{};
+	sceneColorInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+	m_sceneColorImage = m_renderGraph->createImage("Scene color", sceneColorInfo);
+
+	// ImGui 가 샘플링하고, headless 모드에서 프레임을 파일로 저장할 수 있도록 복사 원본으로도 쓴다.
+	RenderGraphImageInfo viewPortInfo{};
+	viewPortInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+	viewPortInfo.persistent = true;
+	viewPortInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+	m_viewPortImage = m_renderGraph->createImage("ViewPort", viewPortInfo);
+	m_renderGraph->setOutput(m_viewPortImage, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+	m_backgroundPass = m_renderGraph->addPass("Background");
+	m_renderGraph->writeColor(m_backgroundPass, 0, m_backgroundImage, VK_ATTACHMENT_LOAD_OP_CLEAR, blackClear);
+	m_renderGraph->setRecord(m_backgroundPass, 0,
+							 [this](VkCommandBuffer commandBuffer) { recordBackgroundCommandBuffer(commandBuffer); });
+
+	// geometry subpass 는 worker thread 들이 batch 구간별로 기록한 secondary command buffer 를 순서대로 실행
+	// (secondary 로 기록하는 subpass 안에는 timestamp 를 쓸 수 없어서 geometry 의 끝은 lighting subpass 시작에서 잰다)
+	m_deferredPass = m_renderGraph->addPass("Geometry", VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	m_renderGraph->writeColor(m_deferredPass, 0, m_positionImage, VK_ATTACHMENT_LOAD_OP_CLEAR, positionClear);
+	m_renderGraph->writeColor(m_deferredPass, 0, m_normalImage, VK_ATTACHMENT_LOAD_OP_CLEAR, blackClear);
+	m_renderGraph->writeColor(m_deferredPass, 0, m_albedoImage, VK_ATTACHMENT_LOAD_OP_CLEAR, blackClear);
+	m_renderGraph->writeColor(m_deferredPass, 0, m_pbrImage, VK_ATTACHMENT_LOAD_OP_CLEAR, blackClear);
+	m_renderGraph->writeDepth(m_deferredPass, 0, m_depthImage, VK_ATTACHMENT_LOAD_OP_CLEAR, depthClear);
+	m_renderGraph->setRecord(m_deferredPass, 0, [this](VkCommandBuffer commandBuffer) {
+		if (!m_geometrySecondaryCommandBuffers.empty())
+		{
+			vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(m_geometrySecondaryCommandBuffers.size()),
+								 m_geometrySecondaryCommandBuffers.data());
+		}
+	});
+
+	uint32_t lightingSubpass = m_renderGraph->addSubpass(m_deferredPass, "Lighting");
+	m_renderGraph->readInput(m_deferredPass, lightingSubpass, m_positionImage);
+	m_renderGraph->readInput(m_deferredPass, lightingSubpass, m_normalImage);
+	m_renderGraph->readInput(m_deferredPass, lightingSubpass, m_albedoImage);
+	m_renderGraph->readInput(m_deferredPass, lightingSubpass, m_pbrImage);
+	m_renderGraph->writeColor(m_deferredPass, lightingSubpass, m_sceneColorImage, VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+	m_renderGraph->readSampled(m_deferredPass, m_backgroundImage);
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		m_renderGraph->readSampled(m_deferredPass, m_shadowMapImages[i]);
+		m_renderGraph->readSampled(m_deferredPass, m_shadowCubeMapImages[i]);
+	}
+	m_renderGraph->setRecord(m_deferredPass, lightingSubpass,
+							 [this](VkCommandBuffer commandBuffer) { recordLightingCommandBuffer(commandBuffer); });
+
+	m_upscalePass = m_renderGraph->addPass("Upscale");
+	m_renderGraph->readSampled(m_upscalePass, m_sceneColorImage);
+	m_renderGraph->writeColor(m_upscalePass, 0, m_viewPortImage, VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+	m_renderGraph->setRecord(m_upscalePass, 0,
+							 [this](VkCommandBuffer commandBuffer) { recordUpscaleCommandBuffer(commandBuffer); });
+
+	m_renderGraph->compile();
+}
+
+// dynamic resolution scale 과 viewport 크기로 이번 프레임에 그릴 영역을 정한다.
+void Renderer::updateRenderExtent()
+{
+	VkExtent2D displayExtent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
+	m_renderExtent = m_dynamicResolution.getRenderExtent(displayExtent);
+
+	m_renderGraph->setRenderArea(m_backgroundPass, m_renderExtent);
+	m_renderGraph->setRenderArea(m_deferredPass, m_renderExtent);
+	m_renderGraph->setRenderArea(m_upscalePass, displayExtent);
+}
+
+void Renderer::setFramesInFlight(uint32_t count)
+{
+	count = std::clamp(count, 1u, static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT));
+	if (count == m_framesInFlight)
+	{
+		return;
+	}
+
+	// 진행 중인 프레임이 모두 끝나야 slot 순서를 바꿀 수 있다.
+	vkDeviceWaitIdle(device);
+	m_framesInFlight = count;
+	currentFrame = 0;
+	m_gpuProfiler->resetFrames();
+	m_framePacer.resetFrames();
+	m_dynamicResolution.setLatencyFrames(count);
+	m_materialTable->setFrameCount(count);
+}
+
+void Renderer::setPresentMode(VkPresentModeKHR presentMode)
+{
+	if (m_headless || m_swapChain->getPreferredPresentMode() == presentMode)
+	{
+		return;
+	}
+	m_swapChain->setPreferredPresentMode(presentMode);
+	recreateSwapChain();
+}
+
+VkPresentModeKHR Renderer::getPresentMode()
+{
+	return m_headless ? VK_PRESENT_MODE_IMMEDIATE_KHR : m_swapChain->getPresentMode();
+}
+
+glm::vec2 Renderer::getViewPortUV()
+{
+	VkExtent2D extent = m_renderGraph->getExtent();
+	return glm::vec2(viewPortSize.x / extent.width, viewPortSize.y / extent.height);
+}
+
+// 서로 의존하지 않는 pipeline 들은 worker 에서 동시에 만든다. (PipelineCache 를 공유하고, shader 는 한 번만 컴파일)
+void Renderer::createPipelines()
+{
+	JobCounter counter;
+	std::mutex errorMutex;
+	std::exception_ptr error;
+	auto createAsync = [&counter, &errorMutex, &error](std::function<void()> create) {
+		JobSystem::execute(
+			[&errorMutex, &error, create]() {
+				try
+				{
+					create();
+				}
+				catch (...)
+				{
+					std::lock_guard lock(errorMutex);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+				}
+			},
+			&counter);
+	};
+
+	createAsync([this]() {
+		m_backgroundPipeline = Pipeline::createBackgroundPipeline(backgroundRenderPass, backgroundDescriptorSetLayout);
+	});
+	// skinning / height map 유무로 나뉜 geometry pass permutation
+	for (uint32_t variant = 0; variant < GEOMETRY_PASS_VARIANT_COUNT; variant++)
+	{
+		createAsync([this, variant]() {
+			m_geometryPassPipelines[variant] = Pipeline::createGeometryPassPipeline(
+				deferredRenderPass, geometryPassFrameDescriptorSetLayout, geometryPassDescriptorSetLayout,
+				(variant & GEOMETRY_PASS_SKINNED) != 0, (variant & GEOMETRY_PASS_HEIGHT_MAP) != 0);
+		});
+	}
+	createAsync([this]() {
+		m_lightingPassPipeline =
+			Pipeline::createLightingPassPipeline(deferredRenderPass, lightingPassDescriptorSetLayout);
+	});
+	createAsync([this]() {
+		m_upscalePipeline =
+			Pipeline::createUpscalePipeline(m_renderGraph->getRenderPass(m_upscalePass), viewPortDescriptorSetLayout);
+	});
+
+	m_shadowMapPipeline.resize(4);
+	m_shadowCubeMapPipeline.resize(4);
+	for (size_t i = 0; i < 4; i++)
+	{
+		createAsync([this, i]() {
+			m_shadowMapPipeline[i] =
+				Pipeline::createShadowMapPipeline(shadowMapRenderPass[i], shadowMapDescriptorSetLayout);
+		});
+		createAsync([this, i]() {
+			m_shadowCubeMapPipeline[i] =
+				Pipeline::createShadowCubeMapPipeline(shadowCubeMapRenderPass[i], shadowCubeMapDescriptorSetLayout);
+		});
+	}
+
+	JobSystem::wait(counter);
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+// pipeline 을 다시 만든 뒤 (hot reload) 기록에 쓰는 handle 을 갱신한다.
+void Renderer::updatePipelineHandles()
+{
+	backgroundPipelineLayout = m_backgroundPipeline->getPipelineLayout();
+	backgroundGraphicsPipeline = m_backgroundPipeline->getPipeline();
+
+	geometryPassPipelineLayout = m_geometryPassPipelines[0]->getPipelineLayout();
+	for (uint32_t variant = 0; variant < GEOMETRY_PASS_VARIANT_COUNT; variant++)
+	{
+		geometryPassGraphicsPipelines[variant] = m_geometryPassPipelines[variant]->getPipeline();
+	}
+
+	lightingPassPipelineLayout = m_lightingPassPipeline->getPipelineLayout();
+	lightingPassGraphicsPipeline = m_lightingPassPipeline->getPipeline();
+
+	upscalePipelineLayout = m_upscalePipeline->getPipelineLayout();
+	upscaleGraphicsPipeline = m_upscalePipeline->getPipeline();
+
+	shadowMapPipelineLayout.resize(4);
+	shadowMapGraphicsPipeline.resize(4);
+	shadowCubeMapPipelineLayout.resize(4);
+	shadowCubeMapGraphicsPipeline.resize(4);
+	for (size_t i = 0; i < 4; i++)
+	{
+		shadowMapPipelineLayout[i] = m_shadowMapPipeline[i]->getPipelineLayout();
+		shadowMapGraphicsPipeline[i] = m_shadowMapPipeline[i]->getPipeline();
+		shadowCubeMapPipelineLayout[i] = m_shadowCubeMapPipeline[i]->getPipelineLayout();
+		shadowCubeMapGraphicsPipeline[i] = m_shadowCubeMapPipeline[i]->getPipeline();
+	}
+}
+
+uint32_t Renderer::reloadShaders()
+{
+	std::set<std::string> changedShaders = ShaderLibrary::getShaderLibrary().reloadChangedShaders();
+	if (changedShaders.empty())
+	{
+		return 0;
+	}
+
+	// 다시 만들 pipeline 을 GPU 가 쓰고 있을 수 있으므로 기다린다.
+	vkDeviceWaitIdle(device);
+
+	std::vector<Pipeline *> pipelines = {m_backgroundPipeline.get(), m_lightingPassPipeline.get(),
+										 m_upscalePipeline.get(), m_gpuCullingPipeline.get()};
+	for (auto &pipeline : m_geometryPassPipelines)
+	{
+		pipelines.push_back(pipeline.get());
+	}
+	for (size_t i = 0; i < 4; i++)
+	{
+		pipelines.push_back(m_shadowMapPipeline[i].get());
+		pipelines.push_back(m_shadowCubeMapPipeline[i].get());
+	}
+
+	uint32_t reloadCount = 0;
+	for (Pipeline *pipeline : pipelines)
+	{
+		if (pipeline && pipeline->reload(changedShaders))
+		{
+			reloadCount++;
+		}
+	}
+	updatePipelineHandles();
+
+	// 전처리 shader 가 바뀌면 cache key 도 바뀌므로 skybox 를 다시 만든다.
+	if (std::any_of(changedShaders.begin(), changedShaders.end(), EnvironmentMap::usesShader))
+	{
+		updateSkybox(m_skyboxPath);
+	}
+
+	AL_CORE_INFO("Renderer: reloaded {0} pipelines for {1} changed shaders", reloadCount, changedShaders.size());
+	return reloadCount;
+}
 
-	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, geometryPassGraphicsPipeline);
+void Renderer::recordLightingCommandBuffer(VkCommandBuffer commandBuffer)
+{
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, lightingPassGraphicsPipeline);
 
 	VkViewport viewport{};
 	viewport.x = 0.0f;
 	viewport.y = 0.0f;
-	viewport.width = viewPortSize.x;
-	viewport.height = viewPortSize.y;
+	viewport.width = static_cast<float>(m_renderExtent.width);
+	viewport.height = static_cast<float>(m_renderExtent.height);
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
 	VkRect2D scissor{};
 	scissor.offset = {0, 0};
-	scissor.extent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
+	scissor.extent = m_renderExtent;
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-	DrawInfo drawInfo;
-	drawInfo.currentFrame = currentFrame;
-	drawInfo.pipelineLayout = geometryPassPipelineLayout;
-	drawInfo.commandBuffer = commandBuffer;
-	drawInfo.view = viewMatirx;
-	drawInfo.projection = projMatrix;
-	// drawInfo.projection = glm::perspective(glm::radians(45.0f), viewPortSize.x / viewPortSize.y, 0.01f, 100.0f);
-	drawInfo.projection[1][1] *= -1;
-	
-	for (size_t i = 0; i < MAX_BONES; ++i) // 항등행렬 초기화
-		drawInfo.finalBonesMatrices[i] = glm::mat4(1.0f);
-
-	// int32_t drawNum = 0;
-	auto view = scene->getAllEntitiesWith<TransformComponent, TagComponent, MeshRendererComponent>();
-	for (auto entity : view)
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, lightingPassPipelineLayout, 0, 1,
+							&lightingPassDescriptorSets[currentFrame], 0, nullptr);
+
+	// light 목록 / cluster 는 prepareLights 에서 이번 프레임 buffer 에 올려두었다.
+	vkCmdDraw(commandBuffer, 6, 1, 0, 0);
+}
+
+// camera 후보 instance 를 frustum 으로 검사해서 culled instance buffer 와 indirect command 의 instanceCount 를 채운다.
+void Renderer::recordGpuCulling(VkCommandBuffer commandBuffer)
+{
+	if (m_visibleInstanceCount > 0)
 	{
-		if (!view.get<TagComponent>(entity).m_isActive || view.get<MeshRendererComponent>(entity).type == 0)
+		GpuCullingPushConstants pushConstants{};
+		for (uint32_t i = 0; i < 6; i++)
 		{
-			continue;
+			const FrustumPlane &plane = m_cullFrustum.plane[i];
+			pushConstants.planes[i] = glm::vec4(plane.normal, plane.distance);
 		}
-		drawInfo.model = view.get<TransformComponent>(entity).m_WorldTransform;
-		if (auto* sa = scene->tryGet<SkeletalAnimatorComponent>(entity)) //SA 컴포넌트 있으면 데이터 전달
-		{
-			auto* sac = (SAComponent *)sa->sac.get();
-			std::vector<glm::mat4> matrices = sac->getCurrentPose();
+		pushConstants.instanceCount = m_visibleInstanceCount;
+
+		VkPipelineLayout pipelineLayout = m_gpuCullingPipeline->getPipelineLayout();
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_gpuCullingPipeline->getPipeline());
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1,
+								&m_gpuCullingShaderResourceManager->getDescriptorSets()[currentFrame], 0, nullptr);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants),
+						   &pushConstants);
+		vkCmdDispatch(commandBuffer, (m_visibleInstanceCount + 63) / 64, 1, 1);
+	}
+
+	// indirect command / culled instance 를 draw 에서 읽고, 다음에 이 프레임 buffer 를 쓸 때 CPU 가 결과를 읽는다.
+	VkMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask =
+		VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+						 VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+							 VK_PIPELINE_STAGE_HOST_BIT,
+						 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+/*
+	GPU culling 모드의 draw: batches[begin, end) 는 indirect command 의 firstCommand + begin 번부터 연속으로 놓여 있다.
+	MeshPool page 가 같은 batch 는 vertex / index buffer 를 공유하므로 구간마다 indirect 호출 하나로 그린다.
+*/
+void Renderer::drawIndirectBatches(VkCommandBuffer commandBuffer, const std::vector<InstanceBatch> &batches,
+								   uint32_t begin, uint32_t end, uint32_t firstCommand, DrawState &state)
+{
+	VkBuffer indirectBuffer = m_indirectBuffers[currentFrame]->getBuffer();
+	constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
 
-			for (size_t i = 0; i < matrices.size(); ++i)
-				drawInfo.finalBonesMatrices[i] = matrices[i];
+	uint32_t runBegin = begin;
+	while (runBegin < end)
+	{
+		uint32_t page = getBatchMesh(batches[runBegin])->getPage();
+		uint32_t runEnd = runBegin + 1;
+		while (runEnd < end && getBatchMesh(batches[runEnd])->getPage() == page)
+		{
+			runEnd++;
 		}
-		
-		MeshRendererComponent &meshRendererComponent = view.get<MeshRendererComponent>(entity);
-		if (meshRendererComponent.cullState == ECullState::RENDER)
+
+		if (state.meshPage != page)
 		{
-			// drawNum++;
-			meshRendererComponent.m_RenderingComponent->draw(drawInfo);
+			state.meshPage = page;
+			MeshPool::getMeshPool().bind(commandBuffer, page);
+			state.bindCount++;
 		}
+		VkDeviceSize offset = static_cast<VkDeviceSize>(firstCommand + runBegin) * stride;
+		vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, offset, runEnd - runBegin, stride);
+		state.drawCount++;
+		runBegin = runEnd;
 	}
+}
 
-	// AL_CORE_INFO("draw Num = {}", drawNum);
-
-	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+void Renderer::recordSecondaryCommandBuffers(const std::vector<Light *> &shadowLights)
+{
+	auto start = std::chrono::steady_clock::now();
 
-	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, lightingPassGraphicsPipeline);
+	// 이번 프레임의 secondary command buffer 는 fence 대기 후이므로 pool 째로 재사용
+	m_secondaryCommandBuffers->reset(currentFrame);
 
-	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, lightingPassPipelineLayout, 0, 1,
-							&lightingPassDescriptorSets[currentFrame], 0, nullptr);
+	// camera 는 모든 geometry batch 가 공유하므로 job 을 나누기 전에 한 번만 올린다.
+	GeometryPassCameraUniformBufferObject cameraUbo{};
+	cameraUbo.view = viewMatirx;
+	cameraUbo.proj = projMatrix;
+	cameraUbo.proj[1][1] *= -1;
+	uint32_t cameraOffset = m_uniformRingBuffers[currentFrame]->push(&cameraUbo, sizeof(cameraUbo));
 
-	LightingPassUniformBufferObject lightingPassUbo{};
+	// light 마다 샘플링하는 shadow map 하나만, 캐시를 쓰지 못하는 경우에만 job 하나로 기록
+	JobCounter counter;
+	for (uint32_t i = 0; i < shadowLights.size(); i++)
+	{
+		m_shadowMapDrawStates[i] = DrawState{};
+		m_shadowCubeMapDrawStates[i] = DrawState{};
+		if (!m_shadowPasses[i].render)
+		{
+			continue;
+		}
 
-	std::memset(&lightingPassUbo, 0, sizeof(lightingPassUbo));
-	// auto &lights = scene->getLights();
+		if (m_shadowPasses[i].cube)
+		{
+			JobSystem::execute([this, i]() { recordShadowCubeMapDraws(i); }, &counter);
+		}
+		else
+		{
+			JobSystem::execute([this, i]() { recordShadowMapDraws(i); }, &counter);
+		}
+	}
 
-	// get light component
-	auto lightView = scene->getAllEntitiesWith<TransformComponent, LightComponent>();
-	size_t lightSize = 0;
-	for (auto entity : lightView)
+	// geometry pass 는 batch 를 구간별로 나눠 기록하고, primary 에서 구간 순서대로 실행해서 draw 순서를 유지
+	uint32_t batchCount = static_cast<uint32_t>(m_instanceBatches.size());
+	uint32_t jobCount = m_secondaryCommandBuffers->getThreadCount() * 2;
+	uint32_t grainSize = std::max(32u, (batchCount + jobCount - 1) / jobCount);
+	uint32_t chunkCount = (batchCount + grainSize - 1) / grainSize;
+	m_geometrySecondaryCommandBuffers.assign(chunkCount, VK_NULL_HANDLE);
+	m_geometryDrawStates.assign(chunkCount, DrawState{});
+	JobSystem::parallelFor(batchCount, grainSize, [this, grainSize, cameraOffset](uint32_t begin, uint32_t end) {
+		uint32_t chunk = begin / grainSize;
+		m_geometrySecondaryCommandBuffers[chunk] =
+			recordGeometryPassDraws(begin, end, cameraOffset, m_geometryDrawStates[chunk]);
+	});
+
+	JobSystem::wait(counter);
+
+	m_bindCount = 0;
+	m_drawCount = 0;
+	auto addDrawState = [this](const DrawState &state) {
+		m_bindCount += state.bindCount;
+		m_drawCount += state.drawCount;
+	};
+	for (const DrawState &state : m_geometryDrawStates)
 	{
-		lightSize++;
+		addDrawState(state);
+	}
+	for (uint32_t i = 0; i < shadowLights.size(); i++)
+	{
+		addDrawState(m_shadowMapDrawStates[i]);
+		addDrawState(m_shadowCubeMapDrawStates[i]);
 	}
 
-	uint32_t index = 0;
-	size_t i = 0;
-	for (auto entity : lightView)
+	m_recordTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+VkCommandBuffer Renderer::recordGeometryPassDraws(uint32_t begin, uint32_t end, uint32_t cameraOffset,
+												 DrawState &state)
+{
+	VkCommandBuffer commandBuffer =
+		m_secondaryCommandBuffers->begin(currentFrame, deferredRenderPass, 0,
+										 m_renderGraph->getFramebuffer(m_deferredPass));
+
+	// batch 는 pipeline variant 순서로 정렬되어 있으므로 구간의 첫 batch 에 맞는 pipeline 으로 시작
+	uint32_t boundVariant = m_instanceBatches[begin].variant;
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, geometryPassGraphicsPipelines[boundVariant]);
+	state.bindCount++;
+
+	VkViewport viewport{};
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.width = static_cast<float>(m_renderExtent.width);
+	viewport.height = static_cast<float>(m_renderExtent.height);
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+	VkRect2D scissor{};
+	scissor.offset = {0, 0};
+	scissor.extent = m_renderExtent;
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+	// set 0: camera (dynamic offset) / material table / bone palette, set 1: 전역 texture 배열
+	// 모든 variant pipeline 은 layout 이 같으므로 구간 시작에서 한 번만 bind 한다.
+	std::array<VkDescriptorSet, 2> descriptorSets = {
+		m_geometryPassFrameShaderResourceManager->getDescriptorSets()[currentFrame],
+		m_materialTable->getDescriptorSet(currentFrame)};
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, geometryPassPipelineLayout, 0,
+							static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 1, &cameraOffset);
+	state.bindCount++;
+
+	// GPU culling 모드: compute shader 가 보이는 instance 만 batch 구간 앞쪽에 모아둔 culled instance buffer 를 읽고,
+	// pipeline / material 이 같은 batch 를 indirect 호출로 묶어서 그린다.
+	if (m_gpuCulling)
 	{
-		std::shared_ptr<Light> light = lightView.get<LightComponent>(entity).m_Light;
-		glm::vec3 lightPos = light->position;
-		glm::vec3 lightDir = glm::normalize(light->direction);
-		float outerCutoff = light->outerCutoff;
-		lightingPassUbo.lights[i] = *light.get();
-		glm::vec3 up = (glm::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		m_culledInstanceBuffers[currentFrame]->bind(commandBuffer);
+		state.bindCount++;
 
-		if (light->onShadowMap == 1 && index < shadowMapIndex)
+		uint32_t runBegin = begin;
+		while (runBegin < end)
 		{
-			if (light->type == 0)
+			const InstanceBatch &batch = m_instanceBatches[runBegin];
+			uint32_t runEnd = runBegin + 1;
+			while (runEnd < end && m_instanceBatches[runEnd].variant == batch.variant &&
+				   m_instanceBatches[runEnd].materialIndex == batch.materialIndex)
 			{
-				lightingPassUbo.view[index][0] =
-					glm::lookAt(lightPos, lightPos + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
-				lightingPassUbo.view[index][1] =
-					glm::lookAt(lightPos, lightPos + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
-				lightingPassUbo.view[index][2] =
-					glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0));
-				lightingPassUbo.view[index][3] =
-					glm::lookAt(lightPos, lightPos + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, -1.0));
-				lightingPassUbo.view[index][4] =
-					glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, -1.0, 0.0));
-				lightingPassUbo.view[index][5] =
-					glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, -1.0, 0.0));
-				lightingPassUbo.proj[index] = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
-				// lightingPassUbo.proj[index][1][1] *= -1;
+				runEnd++;
 			}
-			else if (light->type == 1)
+
+			if (batch.variant != boundVariant)
 			{
-				lightingPassUbo.view[index][0] = glm::lookAt(lightPos, lightPos + lightDir, up);
-				lightingPassUbo.proj[index] = glm::perspective(glm::acos(outerCutoff) * 2.0f, 1.0f, 0.1f, 100.0f);
-				lightingPassUbo.proj[index][1][1] *= -1;
+				boundVariant = batch.variant;
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+								  geometryPassGraphicsPipelines[boundVariant]);
+				state.bindCount++;
 			}
-			else if (light->type == 2)
+			if (state.materialIndex != batch.materialIndex)
 			{
-				lightPos = glm::vec3(0.0f) - lightDir * 10.0f;
-				lightingPassUbo.view[index][0] = glm::lookAt(lightPos, glm::vec3(0.0f), up);
-				float orthoSize = 10.0f;
-				lightingPassUbo.proj[index] = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, -10.0f, 20.0f);
-				lightingPassUbo.proj[index][1][1] *= -1;
+				state.materialIndex = batch.materialIndex;
+				vkCmdPushConstants(commandBuffer, geometryPassPipelineLayout,
+								   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(uint32_t),
+								   &state.materialIndex);
+				state.bindCount++;
 			}
-			index++;
+
+			drawIndirectBatches(commandBuffer, m_instanceBatches, runBegin, runEnd, 0, state);
+			runBegin = runEnd;
 		}
-		i++;
+
+		m_secondaryCommandBuffers->end(commandBuffer);
+		return commandBuffer;
 	}
 
-	lightingPassUbo.numLights = static_cast<uint32_t>(lightSize);
-	lightingPassUbo.cameraPos = scene->getCamPos();
-	lightingPassUbo.ambientStrength = scene->getAmbientStrength();
-	lightingPassFragmentUniformBuffers[currentFrame]->updateUniformBuffer(&lightingPassUbo, sizeof(lightingPassUbo));
-	vkCmdDraw(commandBuffer, 6, 1, 0, 0);
+	DrawInfo drawInfo;
+	drawInfo.pipelineLayout = geometryPassPipelineLayout;
+	drawInfo.commandBuffer = commandBuffer;
+	drawInfo.state = &state;
 
-	vkCmdEndRenderPass(commandBuffer);
+	// frustum culling 을 통과한 entity 를 (Model, mesh, material) 별로 묶어서 instanced draw
+	m_instanceBuffers[currentFrame]->bind(commandBuffer);
+	state.bindCount++;
+	for (uint32_t i = begin; i < end; i++)
+	{
+		auto &batch = m_instanceBatches[i];
+		drawInfo.meshIndex = batch.meshIndex;
+		drawInfo.materialIndex = batch.materialIndex;
+		drawInfo.firstInstance = batch.firstInstance;
+		drawInfo.instanceCount = batch.instanceCount;
+
+		// skinning 행렬은 buildInstanceBatches 에서 bone storage buffer 에 올라가 있다.
+		if (batch.variant != boundVariant)
+		{
+			boundVariant = batch.variant;
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+							  geometryPassGraphicsPipelines[boundVariant]);
+			state.bindCount++;
+		}
 
-	for (size_t i = 0; i < shadowMapIndex; i++)
-	{
-		VkImageMemoryBarrier barrierToDepthWrite{};
-		barrierToDepthWrite.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrierToDepthWrite.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrierToDepthWrite.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-		barrierToDepthWrite.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		barrierToDepthWrite.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		barrierToDepthWrite.image = m_shadowMapFrameBuffers[i]->getDepthImage();
-		barrierToDepthWrite.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-		barrierToDepthWrite.subresourceRange.baseMipLevel = 0;
-		barrierToDepthWrite.subresourceRange.levelCount = 1;
-		barrierToDepthWrite.subresourceRange.baseArrayLayer = 0;
-		barrierToDepthWrite.subresourceRange.layerCount = 1;
-
-		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-							 VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, 0, 0, nullptr, 0, nullptr, 1,
-							 &barrierToDepthWrite);
-
-		barrierToDepthWrite.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrierToDepthWrite.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrierToDepthWrite.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-		barrierToDepthWrite.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		barrierToDepthWrite.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		barrierToDepthWrite.image = m_shadowCubeMapFrameBuffers[i]->getDepthImage();
-		barrierToDepthWrite.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-		barrierToDepthWrite.subresourceRange.baseMipLevel = 0;
-		barrierToDepthWrite.subresourceRange.levelCount = 1;
-		barrierToDepthWrite.subresourceRange.baseArrayLayer = 0;
-		barrierToDepthWrite.subresourceRange.layerCount = 6;
-
-		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-							 VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, 0, 0, nullptr, 0, nullptr, 1,
-							 &barrierToDepthWrite);
+		batch.renderingComponent->draw(drawInfo);
 	}
+
+	m_secondaryCommandBuffers->end(commandBuffer);
+	return commandBuffer;
 }
 
-void Renderer::recordShadowMapCommandBuffer(Scene *scene, VkCommandBuffer commandBuffer, Light &lightInfo,
-											uint32_t shadowMapIndex)
+void Renderer::recordShadowMapDraws(uint32_t shadowMapIndex)
 {
-	// Clear 값 설정
-	VkClearValue clearValue{};
-	clearValue.depthStencil = {1.0f, 0};
-
-	// Render Pass 시작 정보 설정
-	VkRenderPassBeginInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassInfo.renderPass = shadowMapRenderPass[shadowMapIndex];				  // Shadow Map 전용 RenderPass
-	renderPassInfo.framebuffer = shadowMapFramebuffers[shadowMapIndex][currentFrame]; // 첫 번째 Framebuffer
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = {2048, 2048}; // 고정된 Shadow Map 크기
-	renderPassInfo.clearValueCount = 1;
-	renderPassInfo.pClearValues = &clearValue;
+	const ShadowPass &pass = m_shadowPasses[shadowMapIndex];
 
-	// Render Pass 시작
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	VkCommandBuffer commandBuffer =
+		m_secondaryCommandBuffers->begin(currentFrame, shadowMapRenderPass[shadowMapIndex], 0,
+										 m_renderGraph->getFramebuffer(m_shadowMapPasses[shadowMapIndex]));
 
 	// Shadow Map 파이프라인 바인딩
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowMapGraphicsPipeline[shadowMapIndex]);
@@ -1082,98 +2244,51 @@ void Renderer::recordShadowMapCommandBuffer(Scene *scene, VkCommandBuffer comman
 	// Depth Bias 설정
 	vkCmdSetDepthBias(commandBuffer, 1.25f, 0.0f, 1.75f);
 
-	glm::vec3 lightPos = lightInfo.position;
-	glm::vec3 lightDir = glm::normalize(lightInfo.direction);
-	float outerCutoff = lightInfo.outerCutoff;
-	glm::vec3 up = (glm::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
-	glm::mat4 lightView = glm::mat4(1.0f);
-	glm::mat4 lightProj = glm::mat4(1.0f);
-	if (lightInfo.type == 1)
-	{ // spotlight
-		lightView = glm::lookAt(lightPos, lightPos + lightDir, up);
-		lightProj = glm::perspective(glm::acos(outerCutoff) * 2.0f, 1.0f, 0.1f, 100.0f);
-		lightProj[1][1] *= -1;
-	}
-	else if (lightInfo.type == 2)
-	{												   // directional light
-		lightPos = glm::vec3(0.0f) - lightDir * 10.0f; // 광원을 기준으로 카메라처럼 뒤쪽으로 멀어짐
-		// View 행렬 계산
-		lightView = glm::lookAt(lightPos,		 // 광원이 가리키는 가상의 위치
-								glm::vec3(0.0f), // 광원이 비추는 중심 (월드 좌표계 원점)
-								up				 // 카메라의 상단 방향
-		);
-		// Projection 행렬 계산 (Orthographic)
-		float orthoSize = 10.0f;					  // 광원의 영향을 받는 영역의 크기
-		lightProj = glm::ortho(-orthoSize, orthoSize, // 좌/우 클립 경계
-							   -orthoSize, orthoSize, // 아래/위 클립 경계
-							   -10.0f, 20.0f		  // 근/원 클립 경계
-		);
-		// Vulkan 좌표계 보정
-		lightProj[1][1] *= -1;
-	}
+	// light 행렬은 pass 마다 한 번만 올리고 모든 batch 가 공유
+	ShadowMapUniformBufferObject shadowMapUbo{};
+	shadowMapUbo.view = pass.view[0];
+	shadowMapUbo.proj = pass.proj;
+	uint32_t shadowMapOffset = m_uniformRingBuffers[currentFrame]->push(&shadowMapUbo, sizeof(shadowMapUbo));
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowMapPipelineLayout[shadowMapIndex], 0,
+							1, &m_shadowMapFrameShaderResourceManager->getDescriptorSets()[currentFrame], 1,
+							&shadowMapOffset);
 
-	auto view = scene->getAllEntitiesWith<TransformComponent, TagComponent, MeshRendererComponent>();
-	for (auto entity : view)
-	{
-		if (!view.get<TagComponent>(entity).m_isActive || view.get<MeshRendererComponent>(entity).type == 0)
-		{
-			continue;
-		}
+	DrawState &state = m_shadowMapDrawStates[shadowMapIndex];
+	state = DrawState{};
+	state.bindCount = 3; // pipeline, light 행렬 set, instance buffer
 
-		ShadowMapDrawInfo drawInfo;
-		drawInfo.view = lightView;
-		drawInfo.projection = lightProj;
-		drawInfo.commandBuffer = commandBuffer;
-		drawInfo.pipelineLayout = shadowMapPipelineLayout[shadowMapIndex];
-		drawInfo.currentFrame = currentFrame;
-		drawInfo.model = view.get<TransformComponent>(entity).m_WorldTransform;
+	ShadowMapDrawInfo drawInfo;
+	drawInfo.commandBuffer = commandBuffer;
+	drawInfo.state = &state;
 
-		MeshRendererComponent &meshRendererComponent = view.get<MeshRendererComponent>(entity);
-		if (meshRendererComponent.cullState == ECullState::RENDER)
+	m_instanceBuffers[currentFrame]->bind(commandBuffer);
+	if (m_gpuCulling)
+	{
+		drawIndirectBatches(commandBuffer, pass.batches[0], 0, static_cast<uint32_t>(pass.batches[0].size()),
+							pass.commandOffset[0], state);
+	}
+	else
+	{
+		for (auto &batch : pass.batches[0])
 		{
-			meshRendererComponent.m_RenderingComponent->drawShadow(drawInfo, shadowMapIndex);
+			drawInfo.meshIndex = batch.meshIndex;
+			drawInfo.firstInstance = batch.firstInstance;
+			drawInfo.instanceCount = batch.instanceCount;
+			batch.renderingComponent->drawShadow(drawInfo);
 		}
 	}
 
-	// Render Pass 종료
-	vkCmdEndRenderPass(commandBuffer);
-
-	VkImageMemoryBarrier barrierToShaderRead{};
-	barrierToShaderRead.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrierToShaderRead.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-	barrierToShaderRead.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	barrierToShaderRead.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-	barrierToShaderRead.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	barrierToShaderRead.image = m_shadowMapFrameBuffers[shadowMapIndex]->getDepthImage();
-	barrierToShaderRead.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-	barrierToShaderRead.subresourceRange.baseMipLevel = 0;
-	barrierToShaderRead.subresourceRange.levelCount = 1;
-	barrierToShaderRead.subresourceRange.baseArrayLayer = 0;
-	barrierToShaderRead.subresourceRange.layerCount = 1;
-
-	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-						 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrierToShaderRead);
+	m_secondaryCommandBuffers->end(commandBuffer);
+	m_shadowMapSecondaryCommandBuffers[shadowMapIndex] = commandBuffer;
 }
 
-void Renderer::recordShadowCubeMapCommandBuffer(Scene *scene, VkCommandBuffer commandBuffer, Light &lightInfo,
-												uint32_t shadowMapIndex)
+void Renderer::recordShadowCubeMapDraws(uint32_t shadowMapIndex)
 {
+	const ShadowPass &pass = m_shadowPasses[shadowMapIndex];
 
-	VkClearValue clearValue{};
-	clearValue.depthStencil = {1.0f, 0};
-
-	// Render Pass 시작 정보 설정
-	VkRenderPassBeginInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassInfo.renderPass = shadowCubeMapRenderPass[shadowMapIndex];				  // Shadow Map 전용 RenderPass
-	renderPassInfo.framebuffer = shadowCubeMapFramebuffers[shadowMapIndex][currentFrame]; // 첫 번째 Framebuffer
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = {2048, 2048}; // 고정된 Shadow Map 크기
-	renderPassInfo.clearValueCount = 1;
-	renderPassInfo.pClearValues = &clearValue;
-
-	// Render Pass 시작
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	VkCommandBuffer commandBuffer =
+		m_secondaryCommandBuffers->begin(currentFrame, shadowCubeMapRenderPass[shadowMapIndex], 0,
+										 m_renderGraph->getFramebuffer(m_shadowCubeMapPasses[shadowMapIndex]));
 
 	// Shadow Map 파이프라인 바인딩
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowCubeMapGraphicsPipeline[shadowMapIndex]);
@@ -1196,141 +2311,77 @@ void Renderer::recordShadowCubeMapCommandBuffer(Scene *scene, VkCommandBuffer co
 	// Depth Bias 설정
 	vkCmdSetDepthBias(commandBuffer, 1.25f, 0.0f, 1.75f);
 
-	glm::vec3 lightPos = lightInfo.position;
-	glm::mat4 lightProj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
-	// lightProj[1][1] *= -1;
-
-	ShadowCubeMapDrawInfo drawInfo;
-	drawInfo.view[0] = glm::lookAt(lightPos, lightPos + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
-	drawInfo.view[1] = glm::lookAt(lightPos, lightPos + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
-	drawInfo.view[2] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0));
-	drawInfo.view[3] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, -1.0));
-	drawInfo.view[4] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, -1.0, 0.0));
-	drawInfo.view[5] = glm::lookAt(lightPos, lightPos + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, -1.0, 0.0));
-	drawInfo.projection = lightProj;
+	ShadowCubeMapUniformBufferObject shadowCubeMapUbo{};
+	for (uint32_t face = 0; face < 6; face++)
+	{
+		shadowCubeMapUbo.view[face] = pass.view[face];
+	}
+	shadowCubeMapUbo.proj = pass.proj;
+	uint32_t shadowCubeMapOffset =
+		m_uniformRingBuffers[currentFrame]->push(&shadowCubeMapUbo, sizeof(shadowCubeMapUbo));
+
+	DrawState &state = m_shadowCubeMapDrawStates[shadowMapIndex];
+	state = DrawState{};
+	state.bindCount = 2; // pipeline, instance buffer
+
+	ShadowMapDrawInfo drawInfo;
 	drawInfo.commandBuffer = commandBuffer;
-	drawInfo.pipelineLayout = shadowCubeMapPipelineLayout[shadowMapIndex];
-	drawInfo.currentFrame = currentFrame;
+	drawInfo.state = &state;
 
-	auto view = scene->getAllEntitiesWith<TransformComponent, TagComponent, MeshRendererComponent>();
-	for (auto entity : view)
+	m_instanceBuffers[currentFrame]->bind(commandBuffer);
+	for (uint32_t face = 0; face < 6; face++)
 	{
-		if (!view.get<TagComponent>(entity).m_isActive || view.get<MeshRendererComponent>(entity).type == 0)
+		// 면마다 그 면의 frustum 안에 있는 caster 만 그린다.
+		if (pass.batches[face].empty())
 		{
 			continue;
 		}
-		drawInfo.model = view.get<TransformComponent>(entity).m_WorldTransform;
-		MeshRendererComponent &meshRendererComponent = view.get<MeshRendererComponent>(entity);
-		if (meshRendererComponent.cullState == ECullState::RENDER)
-		{
-			meshRendererComponent.m_RenderingComponent->drawShadowCubeMap(drawInfo, shadowMapIndex);
-		}
-	}
-
-	// Render Pass 종료
-	vkCmdEndRenderPass(commandBuffer);
-
-	VkImageMemoryBarrier barrierToShaderRead{};
-	barrierToShaderRead.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrierToShaderRead.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-	barrierToShaderRead.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	barrierToShaderRead.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-	barrierToShaderRead.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	barrierToShaderRead.image = m_shadowCubeMapFrameBuffers[shadowMapIndex]->getDepthImage();
-	barrierToShaderRead.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-	barrierToShaderRead.subresourceRange.baseMipLevel = 0;
-	barrierToShaderRead.subresourceRange.levelCount = 1;
-	barrierToShaderRead.subresourceRange.baseArrayLayer = 0;
-	barrierToShaderRead.subresourceRange.layerCount = 6;
-
-	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-						 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrierToShaderRead);
-}
-
-void Renderer::recordSphericalMapCommandBuffer()
-{
-	VkCommandBuffer commandBuffer = VulkanUtil::beginSingleTimeCommands(device, commandPool);
-	VkClearValue clearValue{};
-	clearValue.color = {0.0f, 0.0f, 0.0f, 1.0f};
-
-	VkRenderPassBeginInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassInfo.renderPass = sphericalMapRenderPass;
-	renderPassInfo.framebuffer = sphericalMapFramebuffers[0];
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = {2048, 2048};
-	renderPassInfo.clearValueCount = 1;
-	renderPassInfo.pClearValues = &clearValue;
-
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sphericalMapGraphicsPipeline);
-
-	auto projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
-	projection[1][1] *= -1;
-	std::vector<glm::mat4> views = {
-		// **Right (+X) - layerIndex 0**
-		glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
-
-		// **Left (-X) - layerIndex 1**
-		glm::lookAt(glm::vec3(0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
-
-		// **Top (+Y) - layerIndex 2**
-		glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f)),
 
-		// **Bottom (-Y) - layerIndex 3**
-		glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)),
+		// 6 면의 view 행렬은 공유하고 layer index 만 dynamic offset 으로 바꿔서 bind
+		std::array<uint32_t, 2> dynamicOffsets = {shadowCubeMapOffset, m_layerIndexOffsets[face]};
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+								shadowCubeMapPipelineLayout[shadowMapIndex], 0, 1,
+								&m_shadowCubeMapFrameShaderResourceManager->getDescriptorSets()[currentFrame],
+								static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+		state.bindCount++;
 
-		// **Front (+Z) - layerIndex 4**
-		glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
-
-		// **Back (-Z) - layerIndex 5**
-		glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f))};
+		if (m_gpuCulling)
+		{
+			drawIndirectBatches(commandBuffer, pass.batches[face], 0, static_cast<uint32_t>(pass.batches[face].size()),
+								pass.commandOffset[face], state);
+			continue;
+		}
 
-	for (size_t i = 0; i < 6; i++)
-	{
-		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sphericalMapPipelineLayout, 0, 1,
-								&sphericalMapDescriptorSets[i], 0, nullptr);
-		SphericalMapUniformBufferObject ubo;
-		ubo.transform = projection * views[i];
-		ubo.layerIndex = i;
-		sphericalMapUniformBuffers[i]->updateUniformBuffer(&ubo, sizeof(ubo));
-		vkCmdDraw(commandBuffer, 36, 1, 0, 0);
+		for (auto &batch : pass.batches[face])
+		{
+			drawInfo.meshIndex = batch.meshIndex;
+			drawInfo.firstInstance = batch.firstInstance;
+			drawInfo.instanceCount = batch.instanceCount;
+			batch.renderingComponent->drawShadow(drawInfo);
+		}
 	}
-	vkCmdEndRenderPass(commandBuffer);
-	VulkanUtil::endSingleTimeCommands(device, graphicsQueue, commandPool, commandBuffer);
+
+	m_secondaryCommandBuffers->end(commandBuffer);
+	m_shadowCubeMapSecondaryCommandBuffers[shadowMapIndex] = commandBuffer;
 }
 
+// render graph 의 background pass 안에서 호출된다.
 void Renderer::recordBackgroundCommandBuffer(VkCommandBuffer commandBuffer)
 {
-	VkClearValue clearValue{};
-	clearValue.color = {0.0f, 0.0f, 0.0f, 1.0f};
-
-	VkRenderPassBeginInfo renderPassInfo{};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassInfo.renderPass = backgroundRenderPass;
-	renderPassInfo.framebuffer = backgroundFramebuffers[currentFrame];
-	renderPassInfo.renderArea.offset = {0, 0};
-	renderPassInfo.renderArea.extent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
-	renderPassInfo.clearValueCount = 1;
-	renderPassInfo.pClearValues = &clearValue;
-
-	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, backgroundGraphicsPipeline);
 
 	VkViewport viewport{};
 	viewport.x = 0.0f;
 	viewport.y = 0.0f;
-	viewport.width = viewPortSize.x;
-	viewport.height = viewPortSize.y;
+	viewport.width = static_cast<float>(m_renderExtent.width);
+	viewport.height = static_cast<float>(m_renderExtent.height);
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
 	VkRect2D scissor{};
 	scissor.offset = {0, 0};
-	scissor.extent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
+	scissor.extent = m_renderExtent;
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
 	glm::mat4 projection = glm::perspective(glm::radians(45.0f), viewPortSize.x / viewPortSize.y, 0.01f, 100.0f);
@@ -1347,8 +2398,39 @@ void Renderer::recordBackgroundCommandBuffer(VkCommandBuffer commandBuffer)
 	backgroundUniformBuffers[currentFrame]->updateUniformBuffer(&ubo, sizeof(ubo));
 
 	vkCmdDraw(commandBuffer, 36, 1, 0, 0);
+}
 
-	vkCmdEndRenderPass(commandBuffer);
+// render graph 의 upscale pass 안에서 호출된다. 내부 해상도의 scene color 를 viewport 크기로 늘린다.
+void Renderer::recordUpscaleCommandBuffer(VkCommandBuffer commandBuffer)
+{
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, upscaleGraphicsPipeline);
+
+	VkViewport viewport{};
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.width = viewPortSize.x;
+	viewport.height = viewPortSize.y;
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+	VkRect2D scissor{};
+	scissor.offset = {0, 0};
+	scissor.extent = {static_cast<uint32_t>(viewPortSize.x), static_cast<uint32_t>(viewPortSize.y)};
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, upscalePipelineLayout, 0, 1,
+							&upscaleDescriptorSets[0], 0, nullptr);
+
+	VkExtent2D extent = m_renderGraph->getExtent();
+	UpscalePushConstants pushConstants{};
+	pushConstants.uvScale = glm::vec2(static_cast<float>(m_renderExtent.width) / extent.width,
+									  static_cast<float>(m_renderExtent.height) / extent.height);
+	pushConstants.texelSize = glm::vec2(1.0f / extent.width, 1.0f / extent.height);
+	vkCmdPushConstants(commandBuffer, upscalePipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pushConstants),
+					   &pushConstants);
+
+	vkCmdDraw(commandBuffer, 3, 1, 0, 0);
 }
 
-} // namespace ale
\ No newline at end of file
+} // namespace ale
@@ -16,15 +16,6 @@ void RenderingComponent::initRenderingComponent(std::shared_ptr<Model> model)
 {
 	m_model = model;
 	m_materials = m_model->getMaterials();
-	m_shaderResourceManager = ShaderResourceManager::createGeometryPassShaderResourceManager(m_model.get());
-	for (size_t i = 0; i < 4; i++)
-	{
-		m_shadowMapResourceManager.push_back(ShaderResourceManager::createShadowMapShaderResourceManager());
-	}
-	for (size_t i = 0; i < 4; i++)
-	{
-		m_shadowCubeMapResourceManager.push_back(ShaderResourceManager::createShadowCubeMapShaderResourceManager());
-	}
 }
 
 void RenderingComponent::updateMaterial(std::vector<std::shared_ptr<Material>> materials)
@@ -33,7 +24,6 @@ void RenderingComponent::updateMaterial(std::vector<std::shared_ptr<Material>> m
 	{
 		m_materials[i] = materials[i];
 	}
-	m_shaderResourceManager->updateDescriptorSets(m_model.get(), materials);
 }
 
 void RenderingComponent::updateMaterial(std::shared_ptr<Model> model)
@@ -42,28 +32,18 @@ void RenderingComponent::updateMaterial(std::shared_ptr<Model> model)
 	{
 		m_materials[i] = model->getMaterials()[i];
 	}
-	m_shaderResourceManager->updateDescriptorSets(m_model.get(), m_materials);
 }
 
 void RenderingComponent::draw(DrawInfo &drawInfo)
 {
-	drawInfo.shaderResourceManager = m_shaderResourceManager.get();
-	drawInfo.materials = m_materials;
 	m_model->draw(drawInfo);
 }
 
-void RenderingComponent::drawShadow(ShadowMapDrawInfo &drawInfo, uint32_t index)
+void RenderingComponent::drawShadow(ShadowMapDrawInfo &drawInfo)
 {
-	drawInfo.shaderResourceManager = m_shadowMapResourceManager[index].get();
 	m_model->drawShadow(drawInfo);
 }
 
-void RenderingComponent::drawShadowCubeMap(ShadowCubeMapDrawInfo &drawInfo, uint32_t index)
-{
-	drawInfo.shaderResourceManager = m_shadowCubeMapResourceManager[index].get();
-	m_model->drawShadowCubeMap(drawInfo);
-}
-
 CullSphere RenderingComponent::getCullSphere()
 {
 	return m_model->initCullSphere();
@@ -72,15 +52,6 @@ CullSphere RenderingComponent::getCullSphere()
 void RenderingComponent::cleanup()
 {
 	// m_model->cleanup();
-	m_shaderResourceManager->cleanup();
-	for (size_t i = 0; i < 4; i++)
-	{
-		m_shadowMapResourceManager[i]->cleanup();
-	}
-	for (size_t i = 0; i < 4; i++)
-	{
-		m_shadowCubeMapResourceManager[i]->cleanup();
-	}
 	// for (size_t i = 0; i < m_materials.size(); i++)
 	// {
 	// 	m_materials[i]->cleanup();
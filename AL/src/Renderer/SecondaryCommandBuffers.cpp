@@ -0,0 +1,125 @@
+#include "Renderer/SecondaryCommandBuffers.h"
+#include "alpch.h"
+#include "Core/JobSystem.h"
+
+namespace ale
+{
+std::unique_ptr<SecondaryCommandBuffers> SecondaryCommandBuffers::createSecondaryCommandBuffers(uint32_t threadCount)
+{
+	std::unique_ptr<SecondaryCommandBuffers> secondaryCommandBuffers =
+		std::unique_ptr<SecondaryCommandBuffers>(new SecondaryCommandBuffers());
+	secondaryCommandBuffers->initSecondaryCommandBuffers(threadCount);
+	return secondaryCommandBuffers;
+}
+
+void SecondaryCommandBuffers::cleanup()
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	// pool 을 제거하면 할당된 command buffer 도 함께 해제된다.
+	for (auto &threadCommandPool : m_threadCommandPools)
+	{
+		vkDestroyCommandPool(device, threadCommandPool.commandPool, nullptr);
+	}
+	m_threadCommandPools.clear();
+}
+
+void SecondaryCommandBuffers::reset(uint32_t frame)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	for (uint32_t i = 0; i < m_threadCount; i++)
+	{
+		ThreadCommandPool &threadCommandPool = m_threadCommandPools[frame * m_threadCount + i];
+		vkResetCommandPool(device, threadCommandPool.commandPool, 0);
+		threadCommandPool.usedCount = 0;
+	}
+}
+
+VkCommandBuffer SecondaryCommandBuffers::begin(uint32_t frame, VkRenderPass renderPass, uint32_t subpass,
+											   VkFramebuffer framebuffer)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	ThreadCommandPool &threadCommandPool = getThreadCommandPool(frame);
+	if (threadCommandPool.usedCount == threadCommandPool.commandBuffers.size())
+	{
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = threadCommandPool.commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY; // primary 의 vkCmdExecuteCommands 로만 실행
+		allocInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to allocate secondary command buffer!");
+		}
+		threadCommandPool.commandBuffers.push_back(commandBuffer);
+	}
+	VkCommandBuffer commandBuffer = threadCommandPool.commandBuffers[threadCommandPool.usedCount++];
+
+	// 어떤 render pass 의 몇 번째 subpass 안에서 실행될지 지정
+	VkCommandBufferInheritanceInfo inheritanceInfo{};
+	inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritanceInfo.renderPass = renderPass;
+	inheritanceInfo.subpass = subpass;
+	inheritanceInfo.framebuffer = framebuffer;
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to begin recording secondary command buffer!");
+	}
+	return commandBuffer;
+}
+
+void SecondaryCommandBuffers::end(VkCommandBuffer commandBuffer)
+{
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to record secondary command buffer!");
+	}
+}
+
+void SecondaryCommandBuffers::initSecondaryCommandBuffers(uint32_t threadCount)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	m_threadCount = threadCount;
+	m_threadCommandPools.resize(MAX_FRAMES_IN_FLIGHT * m_threadCount);
+
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; // 매 프레임 pool 단위로 reset
+	poolInfo.queueFamilyIndex = context.getQueueFamily();
+
+	for (auto &threadCommandPool : m_threadCommandPools)
+	{
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &threadCommandPool.commandPool) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create secondary command pool!");
+		}
+	}
+}
+
+SecondaryCommandBuffers::ThreadCommandPool &SecondaryCommandBuffers::getThreadCommandPool(uint32_t frame)
+{
+	// job system 이 없으면 모든 기록이 호출한 thread 에서 순서대로 실행되므로 0번 pool 사용
+	uint32_t threadIndex = JobSystem::isInitialized() ? JobSystem::getThreadIndex() : 0;
+	if (threadIndex >= m_threadCount)
+	{
+		throw std::runtime_error("secondary command buffer requested from a thread outside the job system!");
+	}
+	return m_threadCommandPools[frame * m_threadCount + threadIndex];
+}
+
+} // namespace ale
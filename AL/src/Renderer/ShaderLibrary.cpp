@@ -0,0 +1,372 @@
+#include "Renderer/ShaderLibrary.h"
+#include "alpch.h"
+#include "Renderer/VulkanUtil.h"
+
+#include <cstdio>
+#include <iterator>
+
+namespace ale
+{
+// 컴파일 옵션이나 cache 파일 형식을 바꾸면 올려서 이전 cache 를 쓰지 않게 한다.
+static constexpr uint32_t SHADER_CACHE_VERSION = 1;
+static constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
+// #include "..." 는 include 한 파일 기준, #include <...> 는 source 폴더 기준으로 찾고 찾은 파일을 dependencies 에 모은다.
+class ShaderIncluder : public shaderc::CompileOptions::IncluderInterface
+{
+  public:
+	ShaderIncluder(const std::filesystem::path &sourceDirectory, std::vector<std::filesystem::path> &dependencies)
+		: m_sourceDirectory(sourceDirectory), m_dependencies(dependencies)
+	{
+	}
+
+	shaderc_include_result *GetInclude(const char *requestedSource, shaderc_include_type type,
+									   const char *requestingSource, size_t includeDepth) override
+	{
+		std::filesystem::path path = type == shaderc_include_type_relative
+										 ? std::filesystem::path(requestingSource).parent_path() / requestedSource
+										 : m_sourceDirectory / requestedSource;
+		path = path.lexically_normal();
+
+		IncludeData *include = new IncludeData();
+		std::ifstream file(path, std::ios::binary);
+		if (file)
+		{
+			include->sourceName = path.generic_string();
+			include->content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			if (std::find(m_dependencies.begin(), m_dependencies.end(), path) == m_dependencies.end())
+			{
+				m_dependencies.push_back(path);
+			}
+		}
+		else
+		{
+			// source_name 이 비어 있으면 shaderc 는 content 를 error message 로 쓴다.
+			include->content = "could not open " + path.generic_string();
+		}
+
+		include->result.source_name = include->sourceName.c_str();
+		include->result.source_name_length = include->sourceName.size();
+		include->result.content = include->content.c_str();
+		include->result.content_length = include->content.size();
+		include->result.user_data = include;
+		return &include->result;
+	}
+
+	void ReleaseInclude(shaderc_include_result *data) override
+	{
+		delete static_cast<IncludeData *>(data->user_data);
+	}
+
+  private:
+	struct IncludeData
+	{
+		shaderc_include_result result{};
+		std::string sourceName;
+		std::string content;
+	};
+
+	std::filesystem::path m_sourceDirectory;
+	std::vector<std::filesystem::path> &m_dependencies;
+};
+
+static bool getShaderKind(const std::filesystem::path &path, shaderc_shader_kind &kind)
+{
+	std::string extension = path.extension().string();
+	if (extension == ".vert")
+	{
+		kind = shaderc_vertex_shader;
+	}
+	else if (extension == ".frag")
+	{
+		kind = shaderc_fragment_shader;
+	}
+	else if (extension == ".comp")
+	{
+		kind = shaderc_compute_shader;
+	}
+	else if (extension == ".geom")
+	{
+		kind = shaderc_geometry_shader;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+static bool readSpirv(const std::filesystem::path &path, std::vector<uint32_t> &code)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	size_t fileSize = static_cast<size_t>(file.tellg());
+	if (fileSize == 0 || fileSize % sizeof(uint32_t) != 0)
+	{
+		return false;
+	}
+	code.resize(fileSize / sizeof(uint32_t));
+	file.seekg(0);
+	file.read(reinterpret_cast<char *>(code.data()), fileSize);
+	return file && code[0] == SPIRV_MAGIC;
+}
+
+ShaderLibrary &ShaderLibrary::getShaderLibrary()
+{
+	static ShaderLibrary shaderLibrary;
+	return shaderLibrary;
+}
+
+void ShaderLibrary::init(VkDevice device, const std::filesystem::path &sourceDirectory,
+						 const std::filesystem::path &cacheDirectory)
+{
+	m_device = device;
+	m_sourceDirectory = sourceDirectory.lexically_normal();
+	m_cacheDirectory = cacheDirectory;
+
+	std::error_code error;
+	std::filesystem::create_directories(m_cacheDirectory, error);
+	if (error)
+	{
+		AL_CORE_WARN("ShaderLibrary: could not create {0}, compiled shaders will not be cached",
+					 m_cacheDirectory.string());
+	}
+}
+
+void ShaderLibrary::cleanup()
+{
+	std::lock_guard lock(m_mutex);
+
+	for (auto &[key, shader] : m_shaders)
+	{
+		if (shader->module != VK_NULL_HANDLE)
+		{
+			vkDestroyShaderModule(m_device, shader->module, nullptr);
+		}
+	}
+	m_shaders.clear();
+}
+
+VkShaderModule ShaderLibrary::getShaderModule(const std::string &fileName, const ShaderDefines &defines)
+{
+	Shader *shader;
+	{
+		std::lock_guard lock(m_mutex);
+		std::unique_ptr<Shader> &entry = m_shaders[makeKey(fileName, defines)];
+		if (!entry)
+		{
+			entry = std::make_unique<Shader>();
+			entry->fileName = fileName;
+			entry->defines = defines;
+		}
+		shader = entry.get();
+	}
+
+	// 같은 shader 를 여러 worker 가 동시에 요청하면 한 번만 컴파일하고 나머지는 기다린다.
+	// 컴파일에 실패하면 예외가 나가고 다음 요청이 다시 시도한다.
+	std::call_once(shader->compiled, [this, shader]() {
+		std::vector<uint32_t> code;
+		std::vector<std::filesystem::path> dependencies;
+		std::string error;
+		if (!compile(shader->fileName, shader->defines, code, dependencies, error))
+		{
+			throw std::runtime_error("failed to compile shader " + shader->fileName + "!\n" + error);
+		}
+		shader->module = createShaderModule(code);
+		shader->lastWriteTime = getLastWriteTime(dependencies);
+		shader->dependencies = std::move(dependencies);
+	});
+	return shader->module;
+}
+
+std::set<std::string> ShaderLibrary::reloadChangedShaders()
+{
+	std::lock_guard lock(m_mutex);
+
+	std::set<std::string> changedShaders;
+	for (auto &[key, shader] : m_shaders)
+	{
+		if (shader->module == VK_NULL_HANDLE)
+		{
+			continue;
+		}
+
+		std::filesystem::file_time_type lastWriteTime = getLastWriteTime(shader->dependencies);
+		if (lastWriteTime <= shader->lastWriteTime)
+		{
+			continue;
+		}
+		// 실패해도 같은 수정으로 다시 시도하지 않도록 먼저 기록한다.
+		shader->lastWriteTime = lastWriteTime;
+
+		std::vector<uint32_t> code;
+		std::vector<std::filesystem::path> dependencies;
+		std::string error;
+		if (!compile(shader->fileName, shader->defines, code, dependencies, error))
+		{
+			AL_CORE_ERROR("ShaderLibrary: {0} failed to compile, keeping the previous module\n{1}", shader->fileName,
+						  error);
+			continue;
+		}
+
+		// 이미 만들어진 pipeline 은 shader module 을 참조하지 않으므로 바로 바꿔도 된다.
+		VkShaderModule module = createShaderModule(code);
+		vkDestroyShaderModule(m_device, shader->module, nullptr);
+		shader->module = module;
+		shader->dependencies = std::move(dependencies);
+		changedShaders.insert(shader->fileName);
+		m_reloadCount++;
+	}
+	return changedShaders;
+}
+
+ShaderLibraryStats ShaderLibrary::getStats()
+{
+	std::lock_guard lock(m_mutex);
+
+	ShaderLibraryStats stats;
+	stats.shaderCount = static_cast<uint32_t>(m_shaders.size());
+	stats.compileCount = m_compileCount.load();
+	stats.cacheHitCount = m_cacheHitCount.load();
+	stats.reloadCount = m_reloadCount;
+	return stats;
+}
+
+bool ShaderLibrary::compile(const std::string &fileName, const ShaderDefines &defines, std::vector<uint32_t> &code,
+							std::vector<std::filesystem::path> &dependencies, std::string &error)
+{
+	std::filesystem::path path = (m_sourceDirectory / fileName).lexically_normal();
+	shaderc_shader_kind kind;
+	if (!getShaderKind(path, kind))
+	{
+		error = "unknown shader stage " + path.extension().string();
+		return false;
+	}
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		error = "could not open " + path.generic_string();
+		return false;
+	}
+	std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	std::string sourceName = path.generic_string();
+
+	dependencies.clear();
+	dependencies.push_back(path);
+
+	shaderc::CompileOptions options;
+	options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_0);
+	options.SetOptimizationLevel(shaderc_optimization_level_performance);
+	options.SetIncluder(std::make_unique<ShaderIncluder>(m_sourceDirectory, dependencies));
+	for (const std::string &define : defines)
+	{
+		size_t separator = define.find('=');
+		if (separator == std::string::npos)
+		{
+			options.AddMacroDefinition(define);
+		}
+		else
+		{
+			options.AddMacroDefinition(define.substr(0, separator), define.substr(separator + 1));
+		}
+	}
+
+	// preprocess 결과에는 include 한 파일과 define 이 모두 반영되어 있으므로 이것의 hash 를 cache key 로 쓴다.
+	shaderc::PreprocessedSourceCompilationResult preprocessed =
+		m_compiler.PreprocessGlsl(source, kind, sourceName.c_str(), options);
+	if (preprocessed.GetCompilationStatus() != shaderc_compilation_status_success)
+	{
+		error = preprocessed.GetErrorMessage();
+		return false;
+	}
+
+	uint64_t hash = VulkanUtil::hashData(&SHADER_CACHE_VERSION, sizeof(SHADER_CACHE_VERSION));
+	hash = VulkanUtil::hashData(&kind, sizeof(kind), hash);
+	hash = VulkanUtil::hashData(preprocessed.cbegin(), preprocessed.cend() - preprocessed.cbegin(), hash);
+
+	char hashString[17];
+	std::snprintf(hashString, sizeof(hashString), "%016llx", static_cast<unsigned long long>(hash));
+	std::filesystem::path cachePath = m_cacheDirectory / (path.filename().string() + "." + hashString + ".spv");
+	if (readSpirv(cachePath, code))
+	{
+		m_cacheHitCount++;
+		return true;
+	}
+
+	shaderc::SpvCompilationResult result = m_compiler.CompileGlslToSpv(source, kind, sourceName.c_str(), options);
+	if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+	{
+		error = result.GetErrorMessage();
+		return false;
+	}
+	if (result.GetNumWarnings() > 0)
+	{
+		AL_CORE_WARN("ShaderLibrary: {0}\n{1}", fileName, result.GetErrorMessage());
+	}
+	code.assign(result.cbegin(), result.cend());
+	m_compileCount++;
+
+	// 같은 key 는 한 thread 만 컴파일하지만, 쓰다 만 파일을 다른 실행이 읽지 않도록 임시 파일에 쓰고 바꿔친다.
+	std::filesystem::path tempPath = cachePath;
+	tempPath += ".tmp";
+	{
+		std::ofstream cacheFile(tempPath, std::ios::binary | std::ios::trunc);
+		if (!cacheFile)
+		{
+			return true;
+		}
+		cacheFile.write(reinterpret_cast<const char *>(code.data()), code.size() * sizeof(uint32_t));
+	}
+	std::error_code renameError;
+	std::filesystem::rename(tempPath, cachePath, renameError);
+	return true;
+}
+
+VkShaderModule ShaderLibrary::createShaderModule(const std::vector<uint32_t> &code)
+{
+	VkShaderModuleCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	createInfo.codeSize = code.size() * sizeof(uint32_t);
+	createInfo.pCode = code.data();
+
+	VkShaderModule shaderModule;
+	if (vkCreateShaderModule(m_device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create shader module!");
+	}
+	return shaderModule;
+}
+
+std::string ShaderLibrary::makeKey(const std::string &fileName, const ShaderDefines &defines)
+{
+	std::string key = fileName;
+	for (const std::string &define : defines)
+	{
+		key += '|';
+		key += define;
+	}
+	return key;
+}
+
+std::filesystem::file_time_type ShaderLibrary::getLastWriteTime(const std::vector<std::filesystem::path> &dependencies)
+{
+	std::filesystem::file_time_type lastWriteTime = std::filesystem::file_time_type::min();
+	for (const std::filesystem::path &path : dependencies)
+	{
+		// editor 가 저장하는 도중이라 파일이 잠깐 없을 수 있다.
+		std::error_code error;
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+		if (!error)
+		{
+			lastWriteTime = std::max(lastWriteTime, writeTime);
+		}
+	}
+	return lastWriteTime;
+}
+
+} // namespace ale
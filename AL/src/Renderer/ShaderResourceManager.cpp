@@ -13,25 +13,6 @@ void ShaderResourceManager::cleanup()
 	}
 	m_uniformBuffers.clear();
 
-	if (!m_layerIndexUniformBuffers.empty())
-	{
-		for (size_t i = 0; i < m_layerIndexUniformBuffers.size(); i++)
-		{
-			m_layerIndexUniformBuffers[i]->cleanup();
-		}
-	}
-	m_layerIndexUniformBuffers.clear();
-
-	if (!m_vertexUniformBuffers.empty())
-
-	{
-		for (size_t i = 0; i < m_vertexUniformBuffers.size(); i++)
-		{
-			m_vertexUniformBuffers[i]->cleanup();
-		}
-	}
-	m_vertexUniformBuffers.clear();
-
 	if (!m_fragmentUniformBuffers.empty())
 	{
 		for (size_t i = 0; i < m_fragmentUniformBuffers.size(); i++)
@@ -63,263 +44,78 @@ void ShaderResourceManager::cleanup()
 	}
 }
 
-std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createGeometryPassShaderResourceManager(Model *model)
-
+std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createTextureArrayShaderResourceManager(
+	VkDescriptorSetLayout descriptorSetLayout, uint32_t textureCount, VkImageView defaultImageView,
+	VkSampler defaultSampler)
 {
 	std::unique_ptr<ShaderResourceManager> shaderResourceManager =
 		std::unique_ptr<ShaderResourceManager>(new ShaderResourceManager());
-	shaderResourceManager->initGeometryPassShaderResourceManager(model);
+	shaderResourceManager->initTextureArrayShaderResourceManager(descriptorSetLayout, textureCount, defaultImageView,
+																 defaultSampler);
 	return shaderResourceManager;
 }
 
-void ShaderResourceManager::initGeometryPassShaderResourceManager(Model *model)
-{
-	createGeometryPassUniformBuffers(model);
-	createGeometryPassDescriptorSets(model);
-}
-
-void ShaderResourceManager::createGeometryPassUniformBuffers(Model *model)
-{
-	size_t meshCount = model->getMeshCount();
-	if (meshCount == 0)
-	{
-		throw std::runtime_error("failed to create uniform buffers!");
-	}
-	// 유니폼 버퍼에 저장 될 구조체의 크기
-	VkDeviceSize vertexBufferSize = sizeof(GeometryPassVertexUniformBufferObject);
-	VkDeviceSize fragmentBufferSize = sizeof(GeometryPassFragmentUniformBufferObject);
-
-	// 각 요소들을 동시에 처리 가능한 최대 프레임 수만큼 만들어 둔다.
-	m_vertexUniformBuffers.resize(MAX_FRAMES_IN_FLIGHT * meshCount);
-	m_fragmentUniformBuffers.resize(MAX_FRAMES_IN_FLIGHT * meshCount);
-
-	for (size_t i = 0; i < meshCount; i++)
-	{
-		for (size_t j = 0; j < MAX_FRAMES_IN_FLIGHT; j++)
-		{
-			m_vertexUniformBuffers[i * MAX_FRAMES_IN_FLIGHT + j] = UniformBuffer::createUniformBuffer(vertexBufferSize);
-			m_fragmentUniformBuffers[i * MAX_FRAMES_IN_FLIGHT + j] =
-				UniformBuffer::createUniformBuffer(fragmentBufferSize);
-		}
-	}
-}
-
-void ShaderResourceManager::createGeometryPassDescriptorSets(Model *model)
+/*
+	프레임마다 texture 배열 하나짜리 디스크립터 셋을 만들고 모든 원소를 기본 texture 로 채운다.
+	shader 가 배열을 동적으로 index 하므로 (partially bound 없이) 빈 원소도 항상 유효한 image 를 가리켜야 한다.
+*/
+void ShaderResourceManager::initTextureArrayShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
+																  uint32_t textureCount, VkImageView defaultImageView,
+																  VkSampler defaultSampler)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 	VkDescriptorPool descriptorPool = context.getDescriptorPool();
-	VkDescriptorSetLayout descriptorSetLayout = context.getGeometryPassDescriptorSetLayout();
-
-	size_t meshCount = model->getMeshCount();
-	std::vector<std::shared_ptr<Mesh>> &meshes = model->getMeshes();
-	std::vector<std::shared_ptr<Material>> &materials = model->getMaterials();
-
-	if (meshCount == 0)
-	{
-		throw std::runtime_error("failed to create descriptor sets!");
-	}
-	// 디스크립터 셋 레이아웃 벡터 생성 (기존 만들어놨던 디스크립터 셋 레이아웃 객체 이용)
-	std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT * meshCount, descriptorSetLayout);
 
-	// 디스크립터 셋 할당에 필요한 정보를 설정하는 구조체
+	std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
 	VkDescriptorSetAllocateInfo allocInfo{};
 	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	allocInfo.descriptorPool = descriptorPool; // 디스크립터 셋을 할당할 디스크립터 풀 지정
-	allocInfo.descriptorSetCount =
-		static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * meshCount); // 할당할 디스크립터 셋 개수 지정
-	allocInfo.pSetLayouts = layouts.data();						 // 할당할 디스크립터 셋 의 레이아웃을 정의하는 배열
-
-	descriptorSets.resize(MAX_FRAMES_IN_FLIGHT * meshCount); // 디스크립터 셋을 저장할 벡터 크기 설정
+	allocInfo.descriptorPool = descriptorPool;
+	allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	allocInfo.pSetLayouts = layouts.data();
 
-	// 디스크립터 풀에 디스크립터 셋 할당
+	descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
 	if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
 	{
-		throw std::runtime_error("failed to allocate descriptor sets!");
+		throw std::runtime_error("failed to allocate texture array descriptor sets!");
 	}
 
-	for (size_t i = 0; i < meshCount; i++)
+	std::vector<VkDescriptorImageInfo> imageInfos(
+		textureCount, {defaultSampler, defaultImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL});
+	std::vector<VkWriteDescriptorSet> descriptorWrites(MAX_FRAMES_IN_FLIGHT);
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
 	{
-		for (size_t j = 0; j < MAX_FRAMES_IN_FLIGHT; j++)
-		{
-			auto &mesh = meshes[i];
-			auto &material = materials[i];
-			size_t index = i * MAX_FRAMES_IN_FLIGHT + j;
-
-			// Vertex Uniform Buffer
-			VkDescriptorBufferInfo vertexBufferInfo{};
-			vertexBufferInfo.buffer = m_vertexUniformBuffers[index]->getBuffer();
-			vertexBufferInfo.offset = 0;
-			vertexBufferInfo.range = sizeof(GeometryPassVertexUniformBufferObject);
-
-			// Fragment Uniform Buffer
-			VkDescriptorBufferInfo fragmentBufferInfo{};
-			fragmentBufferInfo.buffer = m_fragmentUniformBuffers[index]->getBuffer();
-			fragmentBufferInfo.offset = 0;
-			fragmentBufferInfo.range = sizeof(GeometryPassFragmentUniformBufferObject);
-
-			Albedo &albedo = material->getAlbedo();
-			NormalMap &normalMap = material->getNormalMap();
-			Roughness &roughness = material->getRoughness();
-			Metallic &metallic = material->getMetallic();
-			AOMap &aoMap = material->getAOMap();
-			HeightMap &heightMap = material->getHeightMap();
-
-			std::array<VkDescriptorImageInfo, 6> imageInfos{
-				VkDescriptorImageInfo{normalMap.normalTexture->getSampler(), normalMap.normalTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{roughness.roughnessTexture->getSampler(),
-									  roughness.roughnessTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{metallic.metallicTexture->getSampler(), metallic.metallicTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{aoMap.aoTexture->getSampler(), aoMap.aoTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{albedo.albedoTexture->getSampler(), albedo.albedoTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{heightMap.heightTexture->getSampler(), heightMap.heightTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}};
-
-			// Descriptor Writes
-			std::array<VkWriteDescriptorSet, 8> descriptorWrites{};
-
-			// Vertex UBO
-			descriptorWrites[0] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[index], 0,	   0, 1,
-								   VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,	   nullptr, &vertexBufferInfo,	   nullptr};
-
-			// Vertex Height Map
-			descriptorWrites[1] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-								   nullptr,
-								   descriptorSets[index],
-								   1,
-								   0,
-								   1,
-								   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-								   &imageInfos[5],
-								   nullptr,
-								   nullptr};
-
-			// Fragment UBO
-			descriptorWrites[2] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[index], 2,	   0, 1,
-								   VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,	   nullptr, &fragmentBufferInfo,   nullptr};
-
-			for (size_t k = 0; k < 5; k++)
-			{
-				descriptorWrites[3 + k] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-										   nullptr,
-										   descriptorSets[index],
-										   static_cast<uint32_t>(3 + k),
-										   0,
-										   1,
-										   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-										   &imageInfos[k],
-										   nullptr,
-										   nullptr};
-			}
-			// Descriptor Set 업데이트
-			vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-								   nullptr);
-		}
+		descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[i].dstSet = descriptorSets[i];
+		descriptorWrites[i].dstBinding = 0;
+		descriptorWrites[i].dstArrayElement = 0;
+		descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrites[i].descriptorCount = textureCount;
+		descriptorWrites[i].pImageInfo = imageInfos.data();
 	}
+	vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+						   nullptr);
 }
 
-void ShaderResourceManager::updateDescriptorSets(Model *model, std::vector<std::shared_ptr<Material>> materials)
+// frame 번째 texture 배열의 element 번 원소를 바꾼다. 해당 프레임의 GPU 작업이 끝난 뒤에만 호출해야 한다.
+void ShaderResourceManager::updateTextureArrayDescriptorSet(uint32_t frame, uint32_t element, VkImageView imageView,
+															 VkSampler sampler)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 
-	size_t meshCount = model->getMeshCount();
-	std::vector<std::shared_ptr<Mesh>> &meshes = model->getMeshes();
+	VkDescriptorImageInfo imageInfo{sampler, imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
 
-	if (meshCount == 0)
-	{
-		throw std::runtime_error("No meshes found in the model!");
-	}
-	vkDeviceWaitIdle(device);
+	VkWriteDescriptorSet descriptorWrite{};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = descriptorSets[frame];
+	descriptorWrite.dstBinding = 0;
+	descriptorWrite.dstArrayElement = element;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pImageInfo = &imageInfo;
 
-	for (size_t i = 0; i < meshCount; i++)
-	{
-		for (size_t j = 0; j < MAX_FRAMES_IN_FLIGHT; j++)
-		{
-			auto &mesh = meshes[i];
-			auto &material = materials[i];
-			size_t index = i * MAX_FRAMES_IN_FLIGHT + j;
-
-			// Vertex Uniform Buffer
-			VkDescriptorBufferInfo vertexBufferInfo{};
-			vertexBufferInfo.buffer = m_vertexUniformBuffers[index]->getBuffer();
-			vertexBufferInfo.offset = 0;
-			vertexBufferInfo.range = sizeof(GeometryPassVertexUniformBufferObject);
-
-			// Fragment Uniform Buffer
-			VkDescriptorBufferInfo fragmentBufferInfo{};
-			fragmentBufferInfo.buffer = m_fragmentUniformBuffers[index]->getBuffer();
-			fragmentBufferInfo.offset = 0;
-			fragmentBufferInfo.range = sizeof(GeometryPassFragmentUniformBufferObject);
-
-			Albedo &albedo = material->getAlbedo();
-			NormalMap &normalMap = material->getNormalMap();
-			Roughness &roughness = material->getRoughness();
-			Metallic &metallic = material->getMetallic();
-			AOMap &aoMap = material->getAOMap();
-			HeightMap &heightMap = material->getHeightMap();
-
-			std::array<VkDescriptorImageInfo, 6> imageInfos{
-				VkDescriptorImageInfo{normalMap.normalTexture->getSampler(), normalMap.normalTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{roughness.roughnessTexture->getSampler(),
-									  roughness.roughnessTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{metallic.metallicTexture->getSampler(), metallic.metallicTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{aoMap.aoTexture->getSampler(), aoMap.aoTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{albedo.albedoTexture->getSampler(), albedo.albedoTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
-				VkDescriptorImageInfo{heightMap.heightTexture->getSampler(), heightMap.heightTexture->getImageView(),
-									  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}};
-
-			// Descriptor Writes
-			std::array<VkWriteDescriptorSet, 8> descriptorWrites{};
-
-			// Vertex UBO
-			descriptorWrites[0] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[index], 0,	   0, 1,
-								   VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,	   nullptr, &vertexBufferInfo,	   nullptr};
-
-			// Vertex Height Map
-			descriptorWrites[1] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-								   nullptr,
-								   descriptorSets[index],
-								   1,
-								   0,
-								   1,
-								   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-								   &imageInfos[5],
-								   nullptr,
-								   nullptr};
-
-			// Fragment UBO
-			descriptorWrites[2] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, descriptorSets[index], 2,	   0, 1,
-								   VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,	   nullptr, &fragmentBufferInfo,   nullptr};
-
-			for (size_t k = 0; k < 5; k++)
-			{
-				descriptorWrites[3 + k] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-										   nullptr,
-										   descriptorSets[index],
-										   static_cast<uint32_t>(3 + k),
-										   0,
-										   1,
-										   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-										   &imageInfos[k],
-										   nullptr,
-										   nullptr};
-			}
-			// Descriptor Set 업데이트
-			vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-								   nullptr);
-		}
-	}
+	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
 }
 
 std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createLightingPassShaderResourceManager(
@@ -528,36 +324,24 @@ void ShaderResourceManager::createLightingPassDescriptorSets(
 	}
 }
 
-std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createShadowMapShaderResourceManager()
+std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createDynamicUniformShaderResourceManager(
+	VkDescriptorSetLayout descriptorSetLayout, std::vector<VkBuffer> &buffers, std::vector<VkDeviceSize> &ranges)
 {
 	std::unique_ptr<ShaderResourceManager> shaderResourceManager =
 		std::unique_ptr<ShaderResourceManager>(new ShaderResourceManager());
-	shaderResourceManager->initShadowMapShaderResourceManager();
+	shaderResourceManager->initDynamicUniformShaderResourceManager(descriptorSetLayout, buffers, ranges);
 	return shaderResourceManager;
 }
 
-void ShaderResourceManager::initShadowMapShaderResourceManager()
-{
-	createShadowMapUniformBuffers();
-	createShadowMapDescriptorSets();
-}
-
-void ShaderResourceManager::createShadowMapUniformBuffers()
-{
-	VkDeviceSize bufferSize = sizeof(ShadowMapUniformBufferObject);
-	m_uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-	{
-		m_uniformBuffers[i] = UniformBuffer::createUniformBuffer(bufferSize);
-	}
-}
-
-void ShaderResourceManager::createShadowMapDescriptorSets()
+void ShaderResourceManager::initDynamicUniformShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
+																	 std::vector<VkBuffer> &buffers,
+																	 std::vector<VkDeviceSize> &ranges)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 	VkDescriptorPool descriptorPool = context.getDescriptorPool();
-	VkDescriptorSetLayout descriptorSetLayout = context.getShadowMapDescriptorSetLayout();
+
+	m_dynamicUniformRanges = ranges;
 
 	std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
 	VkDescriptorSetAllocateInfo allocInfo{};
@@ -569,113 +353,96 @@ void ShaderResourceManager::createShadowMapDescriptorSets()
 	descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
 	if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to allocate shadow map descriptor sets!");
+		throw std::runtime_error("failed to allocate dynamic uniform descriptor sets!");
 	}
 
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
 	{
-		VkDescriptorBufferInfo bufferInfo{};
-		bufferInfo.buffer = m_uniformBuffers[i]->getBuffer();
-		bufferInfo.offset = 0;
-		bufferInfo.range = sizeof(ShadowMapUniformBufferObject);
-
-		VkWriteDescriptorSet descriptorWrite{};
-		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		descriptorWrite.dstSet = descriptorSets[i];
-		descriptorWrite.dstBinding = 0;
-		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		descriptorWrite.descriptorCount = 1;
-		descriptorWrite.pBufferInfo = &bufferInfo;
-
-		vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+		updateDynamicUniformDescriptorSet(i, buffers[i]);
 	}
 }
 
-std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createShadowCubeMapShaderResourceManager()
+std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createStorageBufferShaderResourceManager(
+	VkDescriptorSetLayout descriptorSetLayout)
 {
 	std::unique_ptr<ShaderResourceManager> shaderResourceManager =
 		std::unique_ptr<ShaderResourceManager>(new ShaderResourceManager());
-	shaderResourceManager->initShadowCubeMapShaderResourceManager();
+	shaderResourceManager->initStorageBufferShaderResourceManager(descriptorSetLayout);
 	return shaderResourceManager;
 }
 
-void ShaderResourceManager::initShadowCubeMapShaderResourceManager()
-{
-	createShadowCubeMapUniformBuffers();
-	createShadowCubeMapDescriptorSets();
-}
-
-void ShaderResourceManager::createShadowCubeMapUniformBuffers()
-{
-	VkDeviceSize uniformBufferSize = sizeof(ShadowCubeMapUniformBufferObject);
-	VkDeviceSize layerIndexBufferSize = sizeof(ShadowCubeMapLayerIndex);
-	m_uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-	m_layerIndexUniformBuffers.resize(MAX_FRAMES_IN_FLIGHT * 6);
-
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-	{
-		m_uniformBuffers[i] = UniformBuffer::createUniformBuffer(uniformBufferSize);
-		for (size_t j = 0; j < 6; j++)
-		{
-			m_layerIndexUniformBuffers[i * 6 + j] = UniformBuffer::createUniformBuffer(layerIndexBufferSize);
-		}
-	}
-}
-
-void ShaderResourceManager::createShadowCubeMapDescriptorSets()
+void ShaderResourceManager::initStorageBufferShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 	VkDescriptorPool descriptorPool = context.getDescriptorPool();
-	VkDescriptorSetLayout descriptorSetLayout = context.getShadowCubeMapDescriptorSetLayout();
 
-	std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT * 6, descriptorSetLayout);
+	std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
 	VkDescriptorSetAllocateInfo allocInfo{};
 	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 	allocInfo.descriptorPool = descriptorPool;
-	allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 6);
+	allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
 	allocInfo.pSetLayouts = layouts.data();
 
-	descriptorSets.resize(MAX_FRAMES_IN_FLIGHT * 6);
+	descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
 	if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to allocate shadow cube map descriptor sets!");
+		throw std::runtime_error("failed to allocate storage buffer descriptor sets!");
 	}
+}
 
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+/*
+	dynamic uniform 뒤에 오는 storage buffer binding 을 buffer 전체로 설정한다.
+	buffer 를 다시 만들었을 때도 해당 프레임의 GPU 작업이 끝난 뒤에 호출한다.
+*/
+void ShaderResourceManager::updateStorageBufferDescriptorSet(uint32_t frame, uint32_t binding, VkBuffer buffer)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	VkDescriptorBufferInfo bufferInfo{};
+	bufferInfo.buffer = buffer;
+	bufferInfo.offset = 0;
+	bufferInfo.range = VK_WHOLE_SIZE;
+
+	VkWriteDescriptorSet descriptorWrite{};
+	descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	descriptorWrite.dstSet = descriptorSets[frame];
+	descriptorWrite.dstBinding = binding;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pBufferInfo = &bufferInfo;
+
+	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+}
+
+/*
+	frame 번째 디스크립터 셋의 모든 binding 을 buffer 의 0 번 위치로 설정한다.
+	실제 위치는 bind 할 때 dynamic offset 으로 넘기며, 해당 프레임의 GPU 작업이 끝난 뒤에만 호출해야 한다.
+*/
+void ShaderResourceManager::updateDynamicUniformDescriptorSet(uint32_t frame, VkBuffer buffer)
+{
+	auto &context = VulkanContext::getContext();
+	VkDevice device = context.getDevice();
+
+	std::vector<VkDescriptorBufferInfo> bufferInfos(m_dynamicUniformRanges.size());
+	std::vector<VkWriteDescriptorSet> descriptorWrites(m_dynamicUniformRanges.size());
+	for (size_t i = 0; i < m_dynamicUniformRanges.size(); i++)
 	{
-		for (size_t j = 0; j < 6; j++)
-		{
-			VkDescriptorBufferInfo bufferInfo{};
-			bufferInfo.buffer = m_uniformBuffers[i]->getBuffer();
-			bufferInfo.offset = 0;
-			bufferInfo.range = sizeof(ShadowCubeMapUniformBufferObject);
-
-			VkDescriptorBufferInfo layerIndexBufferInfo{};
-			layerIndexBufferInfo.buffer = m_layerIndexUniformBuffers[i * 6 + j]->getBuffer();
-			layerIndexBufferInfo.offset = 0;
-			layerIndexBufferInfo.range = sizeof(ShadowCubeMapLayerIndex);
-
-			std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
-
-			descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrites[0].dstSet = descriptorSets[i * 6 + j];
-			descriptorWrites[0].dstBinding = 0;
-			descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			descriptorWrites[0].descriptorCount = 1;
-			descriptorWrites[0].pBufferInfo = &bufferInfo;
-
-			descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrites[1].dstSet = descriptorSets[i * 6 + j];
-			descriptorWrites[1].dstBinding = 1;
-			descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			descriptorWrites[1].descriptorCount = 1;
-			descriptorWrites[1].pBufferInfo = &layerIndexBufferInfo;
-
-			vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
-								   nullptr);
-		}
+		bufferInfos[i].buffer = buffer;
+		bufferInfos[i].offset = 0;
+		bufferInfos[i].range = m_dynamicUniformRanges[i];
+
+		descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[i].dstSet = descriptorSets[frame];
+		descriptorWrites[i].dstBinding = static_cast<uint32_t>(i);
+		descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		descriptorWrites[i].descriptorCount = 1;
+		descriptorWrites[i].pBufferInfo = &bufferInfos[i];
 	}
+
+	vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+						   nullptr);
 }
 
 std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createViewPortShaderResourceManager(
@@ -730,84 +497,74 @@ void ShaderResourceManager::createViewPortDescriptorSets(VkDescriptorSetLayout d
 	vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
 }
 
-std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createSphericalMapShaderResourceManager(
-	VkDescriptorSetLayout descriptorSetLayout, VkImageView sphericalMapImageView, VkSampler sphericalMapSampler)
+std::unique_ptr<ShaderResourceManager> ShaderResourceManager::createEnvironmentMapShaderResourceManager(
+	VkDescriptorSetLayout descriptorSetLayout, std::vector<VkImageView> &sourceImageViews, VkSampler sourceSampler,
+	std::vector<VkImageView> &outputImageViews)
 {
 	std::unique_ptr<ShaderResourceManager> shaderResourceManager =
 		std::unique_ptr<ShaderResourceManager>(new ShaderResourceManager());
-	shaderResourceManager->initSphericalMapShaderResourceManager(descriptorSetLayout, sphericalMapImageView,
-																 sphericalMapSampler);
+	shaderResourceManager->initEnvironmentMapShaderResourceManager(descriptorSetLayout, sourceImageViews, sourceSampler,
+																   outputImageViews);
 	return shaderResourceManager;
 }
 
-void ShaderResourceManager::initSphericalMapShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
-																  VkImageView sphericalMapImageView,
-																  VkSampler sphericalMapSampler)
-{
-	createSphericalMapUniformBuffers();
-	createSphericalMapDescriptorSets(descriptorSetLayout, sphericalMapImageView, sphericalMapSampler);
-}
-
-void ShaderResourceManager::createSphericalMapUniformBuffers()
+void ShaderResourceManager::initEnvironmentMapShaderResourceManager(VkDescriptorSetLayout descriptorSetLayout,
+																	std::vector<VkImageView> &sourceImageViews,
+																	VkSampler sourceSampler,
+																	std::vector<VkImageView> &outputImageViews)
 {
-	VkDeviceSize bufferSize = sizeof(SphericalMapUniformBufferObject);
-	m_uniformBuffers.resize(6);
-	for (size_t i = 0; i < 6; i++)
-	{
-		m_uniformBuffers[i] = UniformBuffer::createUniformBuffer(bufferSize);
-	}
+	createEnvironmentMapDescriptorSets(descriptorSetLayout, sourceImageViews, sourceSampler, outputImageViews);
 }
 
-void ShaderResourceManager::createSphericalMapDescriptorSets(VkDescriptorSetLayout descriptorSetLayout,
-															 VkImageView sphericalMapImageView,
-															 VkSampler sphericalMapSampler)
+void ShaderResourceManager::createEnvironmentMapDescriptorSets(VkDescriptorSetLayout descriptorSetLayout,
+															   std::vector<VkImageView> &sourceImageViews,
+															   VkSampler sourceSampler,
+															   std::vector<VkImageView> &outputImageViews)
 {
 	auto &context = VulkanContext::getContext();
 	VkDevice device = context.getDevice();
 	VkDescriptorPool descriptorPool = context.getDescriptorPool();
 
-	// **🔹 Descriptor Set 6개 할당 (각 큐브맵 레이어별)**
-	std::vector<VkDescriptorSetLayout> layouts(6, descriptorSetLayout);
+	std::vector<VkDescriptorSetLayout> layouts(outputImageViews.size(), descriptorSetLayout);
 	VkDescriptorSetAllocateInfo allocInfo{};
 	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 	allocInfo.descriptorPool = descriptorPool;
 	allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
 	allocInfo.pSetLayouts = layouts.data();
 
-	descriptorSets.resize(6);
+	descriptorSets.resize(layouts.size());
 	if (vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to allocate spherical map descriptor sets!");
+		throw std::runtime_error("Failed to allocate environment map descriptor sets!");
 	}
 
-	// **🔹 Descriptor Set 업데이트**
-	for (size_t i = 0; i < 6; i++)
+	for (size_t i = 0; i < descriptorSets.size(); i++)
 	{
-		VkDescriptorBufferInfo bufferInfo{};
-		bufferInfo.buffer = m_uniformBuffers[i]->getBuffer(); // **각 레이어에 맞는 UBO 설정**
-		bufferInfo.offset = 0;
-		bufferInfo.range = sizeof(SphericalMapUniformBufferObject);
+		// 입력은 sampler 로 읽고 (SHADER_READ_ONLY), 출력 mip 은 storage image 로 쓴다. (GENERAL)
+		VkDescriptorImageInfo sourceInfo{};
+		sourceInfo.imageView = sourceImageViews[i];
+		sourceInfo.sampler = sourceSampler;
+		sourceInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-		VkDescriptorImageInfo imageInfo{};
-		imageInfo.imageView = sphericalMapImageView;
-		imageInfo.sampler = sphericalMapSampler;
-		imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		VkDescriptorImageInfo outputInfo{};
+		outputInfo.imageView = outputImageViews[i];
+		outputInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
 		std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
 
 		descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		descriptorWrites[0].dstSet = descriptorSets[i];
 		descriptorWrites[0].dstBinding = 0;
-		descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		descriptorWrites[0].descriptorCount = 1;
-		descriptorWrites[0].pBufferInfo = &bufferInfo;
+		descriptorWrites[0].pImageInfo = &sourceInfo;
 
 		descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		descriptorWrites[1].dstSet = descriptorSets[i];
 		descriptorWrites[1].dstBinding = 1;
-		descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
 		descriptorWrites[1].descriptorCount = 1;
-		descriptorWrites[1].pImageInfo = &imageInfo;
+		descriptorWrites[1].pImageInfo = &outputInfo;
 
 		vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
 							   nullptr);
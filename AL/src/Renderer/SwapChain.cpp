@@ -46,7 +46,7 @@ void SwapChain::createSwapChain()
 	// 서피스 포맷 선택
 	VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
 	// 프레젠테이션 모드 선택
-	VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+	presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
 	// 스왑 범위 선택 (스왑 체인의 이미지 해상도 결정)
 	VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
 
@@ -258,7 +258,7 @@ VkPresentModeKHR SwapChain::chooseSwapPresentMode(const std::vector<VkPresentMod
 	for (const auto &availablePresentMode : availablePresentModes)
 	{
 		// 선호하는 mode가 존재하면 해당 mode 반환
-		if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+		if (availablePresentMode == preferredPresentMode)
 		{
 			return availablePresentMode;
 		}
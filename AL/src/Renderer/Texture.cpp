@@ -344,7 +344,7 @@ VkSampler Texture::createShadowCubeMapSampler()
 	return cubeMapSampler;
 }
 
-VkSampler Texture::createSphericalMapSampler()
+VkSampler Texture::createEnvironmentMapSampler()
 {
 	auto &context = VulkanContext::getContext();
 	auto device = context.getDevice();
@@ -354,12 +354,12 @@ VkSampler Texture::createSphericalMapSampler()
 	VkPhysicalDeviceProperties properties{};
 	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
 
-	// **Spherical Map 샘플러 생성 정보**
+	// **Environment Map 샘플러 생성 정보** (equirect 원본을 읽을 때 경도 방향은 이어지므로 U 는 반복)
 	VkSamplerCreateInfo samplerInfo{};
 	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
 	samplerInfo.magFilter = VK_FILTER_LINEAR;							// 확대 시 선형 필터링
 	samplerInfo.minFilter = VK_FILTER_LINEAR;							// 축소 시 선형 필터링
-	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;	// U축 클램핑
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;			// U축 반복
 	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;	// V축 클램핑
 	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;	// W축 클램핑
 	samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;		// 경계 색상
@@ -373,12 +373,12 @@ VkSampler Texture::createSphericalMapSampler()
 	samplerInfo.mipLodBias = 0.0f;										// Mipmap Bias 비활성화
 	samplerInfo.unnormalizedCoordinates = VK_FALSE;						// 정규화된 텍스처 좌표 사용
 
-	VkSampler sphericalMapSampler;
-	if (vkCreateSampler(device, &samplerInfo, nullptr, &sphericalMapSampler) != VK_SUCCESS)
+	VkSampler environmentMapSampler;
+	if (vkCreateSampler(device, &samplerInfo, nullptr, &environmentMapSampler) != VK_SUCCESS)
 	{
-		throw std::runtime_error("Failed to create spherical map sampler in Texture::createSphericalMapSampler");
+		throw std::runtime_error("Failed to create environment map sampler in Texture::createEnvironmentMapSampler");
 	}
-	return sphericalMapSampler;
+	return environmentMapSampler;
 }
 
 VkSampler Texture::createBackgroundSampler()
@@ -0,0 +1,600 @@
+#include "Renderer/UploadManager.h"
+#include "alpch.h"
+#include "Renderer/VulkanContext.h"
+
+namespace ale
+{
+static constexpr VkDeviceSize STAGING_RING_SIZE = 32ull * 1024 * 1024;
+// buffer -> image 복사의 bufferOffset 은 texel 크기의 배수여야 하므로 가장 큰 texel(16byte) 기준으로 정렬
+static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+// 2D texture 를 읽는 stage (HEIGHT_MAP permutation 의 GeometryPass.vert 는 vertex shader 에서 height map 을 읽는다)
+static constexpr VkPipelineStageFlags TEXTURE_READ_STAGES =
+	VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+UploadManager &UploadManager::getUploadManager()
+{
+	static UploadManager uploadManager;
+	return uploadManager;
+}
+
+void UploadManager::init()
+{
+	auto &context = VulkanContext::getContext();
+	m_device = context.getDevice();
+	m_physicalDevice = context.getPhysicalDevice();
+	m_graphicsQueue = context.getGraphicsQueue();
+	m_graphicsQueueFamily = context.getQueueFamily();
+	m_transferQueue = context.getTransferQueue();
+	m_transferQueueFamily = context.getTransferQueueFamily();
+
+	createCommandPool(m_graphicsQueueFamily, m_graphicsCommandPool);
+	createCommandPool(m_transferQueueFamily, m_transferCommandPool);
+
+	// staging ring buffer 는 한 번만 만들고 계속 map 해둔다.
+	m_ringSize = STAGING_RING_SIZE;
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = m_ringSize;
+	bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &m_ringBuffer) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create staging ring buffer!");
+	}
+	m_ringAllocation = MemoryAllocator::getAllocator().allocateBufferMemory(
+		m_ringBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	m_ringHead = 0;
+	m_ringTail = 0;
+
+	AL_CORE_INFO("UploadManager::init: {0} queue, {1} MB staging ring", hasTransferQueue() ? "transfer" : "graphics",
+				 m_ringSize / (1024 * 1024));
+}
+
+void UploadManager::cleanup()
+{
+	waitIdle();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto &batch : m_freeBatches)
+	{
+		vkDestroyFence(m_device, batch->fence, nullptr);
+		if (batch->transferSemaphore != VK_NULL_HANDLE)
+		{
+			vkDestroySemaphore(m_device, batch->transferSemaphore, nullptr);
+		}
+	}
+	m_freeBatches.clear();
+
+	// command buffer 는 pool 과 함께 해제된다.
+	vkDestroyCommandPool(m_device, m_graphicsCommandPool, nullptr);
+	vkDestroyCommandPool(m_device, m_transferCommandPool, nullptr);
+
+	vkDestroyBuffer(m_device, m_ringBuffer, nullptr);
+	MemoryAllocator::getAllocator().free(m_ringAllocation);
+	m_ringBuffer = VK_NULL_HANDLE;
+}
+
+void UploadManager::uploadBuffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkAccessFlags dstAccess,
+								 VkPipelineStageFlags dstStage, VkDeviceSize dstOffset)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	StagingRegion staging = allocateStaging(size);
+	memcpy(staging.mappedData, data, static_cast<size_t>(size));
+
+	UploadBatch &batch = getCurrentBatch();
+	VkBufferCopy copyRegion{};
+	copyRegion.srcOffset = staging.offset;
+	copyRegion.dstOffset = dstOffset;
+	copyRegion.size = size;
+	vkCmdCopyBuffer(batch.transferCommandBuffer, staging.buffer, buffer, 1, &copyRegion);
+
+	VkBufferMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.buffer = buffer;
+	barrier.offset = dstOffset;
+	barrier.size = size;
+	if (hasTransferQueue())
+	{
+		// transfer queue 에서 release, graphics queue 에서 acquire (두 barrier 의 범위와 queue family 가 같아야 한다)
+		barrier.srcQueueFamilyIndex = m_transferQueueFamily;
+		barrier.dstQueueFamilyIndex = m_graphicsQueueFamily;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = 0;
+		batch.releaseBufferBarriers.push_back(barrier);
+		barrier.srcAccessMask = 0;
+	}
+	else
+	{
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	}
+	barrier.dstAccessMask = dstAccess;
+	batch.acquireBufferBarriers.push_back(barrier);
+	batch.acquireDstStage |= dstStage;
+}
+
+void UploadManager::uploadImage(VkImage image, VkFormat format, const void *data, VkDeviceSize size, uint32_t width,
+								uint32_t height, uint32_t mipLevels)
+{
+	if (mipLevels > 1)
+	{
+		// 이미지 포맷이 선형 필터링을 사용한 Blit 작업을 지원하는지 확인
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(m_physicalDevice, format, &formatProperties);
+		if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+		{
+			throw std::runtime_error("texture image format does not support linear blitting!");
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	StagingRegion staging = allocateStaging(size);
+	memcpy(staging.mappedData, data, static_cast<size_t>(size));
+
+	UploadBatch &batch = getCurrentBatch();
+
+	// 모든 mip 을 복사 대상 layout 으로 전환
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.image = image;
+	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel = 0;
+	barrier.subresourceRange.levelCount = mipLevels;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount = 1;
+	vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						 VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	VkBufferImageCopy region{};
+	region.bufferOffset = staging.offset;
+	region.bufferRowLength = 0;
+	region.bufferImageHeight = 0;
+	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	region.imageSubresource.mipLevel = 0;
+	region.imageSubresource.baseArrayLayer = 0;
+	region.imageSubresource.layerCount = 1;
+	region.imageOffset = {0, 0, 0};
+	region.imageExtent = {width, height, 1};
+	vkCmdCopyBufferToImage(batch.transferCommandBuffer, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+						   &region);
+
+	// mipmap 을 만들 image 는 복사 대상 layout 그대로 graphics queue 로 넘기고, 아니면 바로 shader 읽기용으로 전환
+	bool generateMipmaps = mipLevels > 1;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout =
+		generateMipmaps ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	if (hasTransferQueue())
+	{
+		barrier.srcQueueFamilyIndex = m_transferQueueFamily;
+		barrier.dstQueueFamilyIndex = m_graphicsQueueFamily;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = 0;
+		batch.releaseImageBarriers.push_back(barrier);
+		barrier.srcAccessMask = 0;
+	}
+	else
+	{
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	}
+	barrier.dstAccessMask =
+		generateMipmaps ? VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT;
+	batch.acquireImageBarriers.push_back(barrier);
+	batch.acquireDstStage |= generateMipmaps ? VK_PIPELINE_STAGE_TRANSFER_BIT : TEXTURE_READ_STAGES;
+
+	if (generateMipmaps)
+	{
+		batch.mipmaps.push_back({image, static_cast<int32_t>(width), static_cast<int32_t>(height), mipLevels});
+	}
+}
+
+void UploadManager::uploadCubeImage(VkImage image, const void *data, VkDeviceSize size, uint32_t faceSize,
+									uint32_t mipLevels, uint32_t texelSize)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	StagingRegion staging = allocateStaging(size);
+	memcpy(staging.mappedData, data, static_cast<size_t>(size));
+
+	UploadBatch &batch = getCurrentBatch();
+
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.image = image;
+	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel = 0;
+	barrier.subresourceRange.levelCount = mipLevels;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount = 6;
+	vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						 VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	// mip 마다 6 layer 를 한 번에 복사한다.
+	std::vector<VkBufferImageCopy> regions(mipLevels);
+	VkDeviceSize offset = staging.offset;
+	for (uint32_t mip = 0; mip < mipLevels; mip++)
+	{
+		uint32_t mipSize = std::max(faceSize >> mip, 1u);
+		regions[mip].bufferOffset = offset;
+		regions[mip].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		regions[mip].imageSubresource.mipLevel = mip;
+		regions[mip].imageSubresource.baseArrayLayer = 0;
+		regions[mip].imageSubresource.layerCount = 6;
+		regions[mip].imageOffset = {0, 0, 0};
+		regions[mip].imageExtent = {mipSize, mipSize, 1};
+		offset += static_cast<VkDeviceSize>(mipSize) * mipSize * texelSize * 6;
+	}
+	if (offset - staging.offset > size)
+	{
+		throw std::runtime_error("cube image data is smaller than its mip chain!");
+	}
+	vkCmdCopyBufferToImage(batch.transferCommandBuffer, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+						   static_cast<uint32_t>(regions.size()), regions.data());
+
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	if (hasTransferQueue())
+	{
+		barrier.srcQueueFamilyIndex = m_transferQueueFamily;
+		barrier.dstQueueFamilyIndex = m_graphicsQueueFamily;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = 0;
+		batch.releaseImageBarriers.push_back(barrier);
+		barrier.srcAccessMask = 0;
+	}
+	else
+	{
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	}
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	batch.acquireImageBarriers.push_back(barrier);
+	batch.acquireDstStage |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+}
+
+void UploadManager::flush()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	collectCompletedBatches();
+	flushLocked();
+}
+
+void UploadManager::waitIdle()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	flushLocked();
+	while (!m_submittedBatches.empty())
+	{
+		waitOldestBatch();
+	}
+}
+
+UploadManager::UploadBatch &UploadManager::getCurrentBatch()
+{
+	if (m_currentBatch)
+	{
+		return *m_currentBatch;
+	}
+
+	if (!m_freeBatches.empty())
+	{
+		m_currentBatch = std::move(m_freeBatches.back());
+		m_freeBatches.pop_back();
+	}
+	else
+	{
+		m_currentBatch = std::make_unique<UploadBatch>();
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+		allocInfo.commandPool = m_transferCommandPool;
+		if (vkAllocateCommandBuffers(m_device, &allocInfo, &m_currentBatch->transferCommandBuffer) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to allocate upload command buffer!");
+		}
+		allocInfo.commandPool = m_graphicsCommandPool;
+		if (vkAllocateCommandBuffers(m_device, &allocInfo, &m_currentBatch->graphicsCommandBuffer) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to allocate upload command buffer!");
+		}
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		if (vkCreateFence(m_device, &fenceInfo, nullptr, &m_currentBatch->fence) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create upload fence!");
+		}
+
+		if (hasTransferQueue())
+		{
+			VkSemaphoreCreateInfo semaphoreInfo{};
+			semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			if (vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_currentBatch->transferSemaphore) != VK_SUCCESS)
+			{
+				throw std::runtime_error("failed to create upload semaphore!");
+			}
+		}
+	}
+
+	// pool 이 RESET_COMMAND_BUFFER 로 만들어졌으므로 begin 에서 이전 기록이 지워진다.
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(m_currentBatch->transferCommandBuffer, &beginInfo);
+	vkBeginCommandBuffer(m_currentBatch->graphicsCommandBuffer, &beginInfo);
+
+	return *m_currentBatch;
+}
+
+UploadManager::StagingRegion UploadManager::allocateStaging(VkDeviceSize size)
+{
+	// ring 의 절반보다 큰 업로드는 ring 을 오래 막지 않도록 임시 staging buffer 사용
+	if (size > m_ringSize / 2)
+	{
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VkBuffer stagingBuffer;
+		if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &stagingBuffer) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create staging buffer!");
+		}
+		MemoryAllocation stagingAllocation = MemoryAllocator::getAllocator().allocateBufferMemory(
+			stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			AllocationStrategy::LINEAR);
+		getCurrentBatch().dedicatedStagingBuffers.push_back({stagingBuffer, stagingAllocation});
+		return {stagingBuffer, 0, stagingAllocation.mappedData};
+	}
+
+	collectCompletedBatches();
+	while (true)
+	{
+		VkDeviceSize head = alignUp(m_ringHead, STAGING_ALIGNMENT);
+		VkDeviceSize offset = head % m_ringSize;
+		// ring 끝을 넘으면 처음부터
+		if (offset + size > m_ringSize)
+		{
+			head += m_ringSize - offset;
+			offset = 0;
+		}
+		if (head + size - m_ringTail <= m_ringSize)
+		{
+			m_ringHead = head + size;
+			return {m_ringBuffer, offset, static_cast<char *>(m_ringAllocation.mappedData) + offset};
+		}
+
+		// ring 이 가득 참: 제출된 batch 가 없으면 현재 batch 가 ring 을 다 쓰고 있으므로 먼저 제출
+		if (m_submittedBatches.empty())
+		{
+			if (!m_currentBatch)
+			{
+				m_ringTail = m_ringHead;
+				continue;
+			}
+			flushLocked();
+		}
+		waitOldestBatch();
+	}
+}
+
+void UploadManager::flushLocked()
+{
+	if (!m_currentBatch)
+	{
+		return;
+	}
+	UploadBatch &batch = *m_currentBatch;
+
+	if (!batch.releaseBufferBarriers.empty() || !batch.releaseImageBarriers.empty())
+	{
+		vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+							 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+							 static_cast<uint32_t>(batch.releaseBufferBarriers.size()),
+							 batch.releaseBufferBarriers.data(), static_cast<uint32_t>(batch.releaseImageBarriers.size()),
+							 batch.releaseImageBarriers.data());
+	}
+	vkEndCommandBuffer(batch.transferCommandBuffer);
+
+	// acquire barrier 는 모두 모아서 한 번에 기록하고, 그 뒤에 mipmap 생성
+	if (!batch.acquireBufferBarriers.empty() || !batch.acquireImageBarriers.empty())
+	{
+		VkPipelineStageFlags srcStage =
+			hasTransferQueue() ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT;
+		vkCmdPipelineBarrier(batch.graphicsCommandBuffer, srcStage, batch.acquireDstStage, 0, 0, nullptr,
+							 static_cast<uint32_t>(batch.acquireBufferBarriers.size()),
+							 batch.acquireBufferBarriers.data(), static_cast<uint32_t>(batch.acquireImageBarriers.size()),
+							 batch.acquireImageBarriers.data());
+	}
+	for (const PendingMipmap &mipmap : batch.mipmaps)
+	{
+		recordMipmaps(batch.graphicsCommandBuffer, mipmap);
+	}
+	vkEndCommandBuffer(batch.graphicsCommandBuffer);
+
+	if (hasTransferQueue())
+	{
+		VkSubmitInfo transferSubmitInfo{};
+		transferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		transferSubmitInfo.commandBufferCount = 1;
+		transferSubmitInfo.pCommandBuffers = &batch.transferCommandBuffer;
+		transferSubmitInfo.signalSemaphoreCount = 1;
+		transferSubmitInfo.pSignalSemaphores = &batch.transferSemaphore;
+		if (vkQueueSubmit(m_transferQueue, 1, &transferSubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to submit upload command buffer!");
+		}
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkSubmitInfo graphicsSubmitInfo{};
+		graphicsSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		graphicsSubmitInfo.waitSemaphoreCount = 1;
+		graphicsSubmitInfo.pWaitSemaphores = &batch.transferSemaphore;
+		graphicsSubmitInfo.pWaitDstStageMask = &waitStage;
+		graphicsSubmitInfo.commandBufferCount = 1;
+		graphicsSubmitInfo.pCommandBuffers = &batch.graphicsCommandBuffer;
+		if (vkQueueSubmit(m_graphicsQueue, 1, &graphicsSubmitInfo, batch.fence) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to submit upload command buffer!");
+		}
+	}
+	else
+	{
+		// 같은 queue 이므로 복사와 mipmap 생성을 한 번에 제출
+		VkCommandBuffer commandBuffers[] = {batch.transferCommandBuffer, batch.graphicsCommandBuffer};
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 2;
+		submitInfo.pCommandBuffers = commandBuffers;
+		if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, batch.fence) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to submit upload command buffer!");
+		}
+	}
+
+	batch.ringEnd = m_ringHead;
+	batch.releaseBufferBarriers.clear();
+	batch.releaseImageBarriers.clear();
+	batch.acquireBufferBarriers.clear();
+	batch.acquireImageBarriers.clear();
+	batch.acquireDstStage = 0;
+	batch.mipmaps.clear();
+	m_submittedBatches.push_back(std::move(m_currentBatch));
+}
+
+void UploadManager::waitOldestBatch()
+{
+	if (m_submittedBatches.empty())
+	{
+		return;
+	}
+	vkWaitForFences(m_device, 1, &m_submittedBatches.front()->fence, VK_TRUE, UINT64_MAX);
+	collectCompletedBatches();
+}
+
+void UploadManager::collectCompletedBatches()
+{
+	// batch 는 제출 순서대로 끝나므로 앞에서부터 끝난 것만 회수
+	while (!m_submittedBatches.empty())
+	{
+		std::unique_ptr<UploadBatch> &batch = m_submittedBatches.front();
+		if (vkGetFenceStatus(m_device, batch->fence) != VK_SUCCESS)
+		{
+			break;
+		}
+
+		m_ringTail = batch->ringEnd;
+		for (auto &[stagingBuffer, stagingAllocation] : batch->dedicatedStagingBuffers)
+		{
+			vkDestroyBuffer(m_device, stagingBuffer, nullptr);
+			MemoryAllocator::getAllocator().free(stagingAllocation);
+		}
+		batch->dedicatedStagingBuffers.clear();
+		vkResetFences(m_device, 1, &batch->fence);
+
+		m_freeBatches.push_back(std::move(batch));
+		m_submittedBatches.pop_front();
+	}
+}
+
+void UploadManager::recordMipmaps(VkCommandBuffer commandBuffer, const PendingMipmap &mipmap)
+{
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.image = mipmap.image;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount = 1;
+	barrier.subresourceRange.levelCount = 1;
+
+	int32_t mipWidth = mipmap.width;
+	int32_t mipHeight = mipmap.height;
+
+	for (uint32_t i = 1; i < mipmap.mipLevels; i++)
+	{
+		// 이전 단계의 mipmap 복사가 끝나야, 다음 단계 mipmap 복사가 시작되게 베리어 설정
+		barrier.subresourceRange.baseMipLevel = i - 1;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+							 nullptr, 0, nullptr, 1, &barrier);
+
+		VkImageBlit blit{};
+		blit.srcOffsets[0] = {0, 0, 0};
+		blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
+		blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.srcSubresource.mipLevel = i - 1;
+		blit.srcSubresource.baseArrayLayer = 0;
+		blit.srcSubresource.layerCount = 1;
+		blit.dstOffsets[0] = {0, 0, 0};
+		blit.dstOffsets[1] = {mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1};
+		blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.dstSubresource.mipLevel = i;
+		blit.dstSubresource.baseArrayLayer = 0;
+		blit.dstSubresource.layerCount = 1;
+		vkCmdBlitImage(commandBuffer, mipmap.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, mipmap.image,
+					   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+		// shader 단계에서 사용하기 전에 blit 단계가 끝나기를 기다림
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, TEXTURE_READ_STAGES, 0, 0, nullptr, 0,
+							 nullptr, 1, &barrier);
+
+		if (mipWidth > 1)
+			mipWidth /= 2;
+		if (mipHeight > 1)
+			mipHeight /= 2;
+	}
+
+	// 마지막 단계 miplevel 처리
+	barrier.subresourceRange.baseMipLevel = mipmap.mipLevels - 1;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, TEXTURE_READ_STAGES, 0, 0, nullptr, 0,
+						 nullptr, 1, &barrier);
+}
+
+void UploadManager::createCommandPool(uint32_t queueFamily, VkCommandPool &commandPool)
+{
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	poolInfo.queueFamilyIndex = queueFamily;
+	if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS)
+	{
+		throw std::runtime_error("failed to create upload command pool!");
+	}
+}
+
+} // namespace ale
@@ -1,5 +1,10 @@
 #include "Renderer/VulkanContext.h"
-#include "ALpch.h"
+#include "alpch.h"
+#include "Renderer/MemoryAllocator.h"
+#include "Renderer/MeshPool.h"
+#include "Renderer/PipelineCache.h"
+#include "Renderer/ShaderLibrary.h"
+#include "Renderer/UploadManager.h"
 
 namespace ale
 {
@@ -11,25 +16,43 @@ VulkanContext &VulkanContext::getContext()
 
 void VulkanContext::initContext(GLFWwindow *window)
 {
+	// window 가 없으면 headless: surface / swap chain 없이 offscreen image 에만 그린다.
+	headless = window == nullptr;
 	createInstance();
 	setupDebugMessenger();
-	createSurface(window);
+	if (!headless)
+	{
+		createSurface(window);
+	}
 	pickPhysicalDevice();
 	createLogicalDevice();
+	MemoryAllocator::getAllocator().init(device, physicalDevice);
+	PipelineCache::getPipelineCache().init(device, physicalDevice);
+	ShaderLibrary::getShaderLibrary().init(device);
 	createCommandPool();
 	createDescriptorPool();
+	UploadManager::getUploadManager().init();
+	MeshPool::getMeshPool().init();
 }
 
 void VulkanContext::cleanup()
 {
+	MeshPool::getMeshPool().cleanup();
+	UploadManager::getUploadManager().cleanup();
 	vkDestroyDescriptorPool(device, descriptorPool, nullptr);
 	vkDestroyCommandPool(device, commandPool, nullptr);
+	ShaderLibrary::getShaderLibrary().cleanup();
+	PipelineCache::getPipelineCache().cleanup();
+	MemoryAllocator::getAllocator().cleanup();
 	vkDestroyDevice(device, nullptr);
 	if (enableValidationLayers)
 	{
 		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
 	}
-	vkDestroySurfaceKHR(instance, surface, nullptr);
+	if (!headless)
+	{
+		vkDestroySurfaceKHR(instance, surface, nullptr);
+	}
 	vkDestroyInstance(instance, nullptr);
 }
 
@@ -129,10 +152,14 @@ GLFW 라이브러리에서 Vulkan 인스턴스를 생성할 때 필요한 인스
 */
 std::vector<const char *> VulkanContext::getRequiredExtensions()
 {
-	// 필요한 확장 목록 가져오기
-	uint32_t glfwExtensionCount = 0;
-	const char **glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-	std::vector<const char *> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	// 필요한 확장 목록 가져오기 (headless 는 surface 확장이 필요 없다)
+	std::vector<const char *> extensions;
+	if (!headless)
+	{
+		uint32_t glfwExtensionCount = 0;
+		const char **glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	// 디버깅 모드이면 VK_EXT_debug_utils 확장 추가 (메세지 콜백 확장)
 	if (enableValidationLayers)
@@ -215,6 +242,10 @@ void VulkanContext::createLogicalDevice()
 	QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
 	// 큐 패밀리의 인덱스들을 set으로 래핑
 	std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+	if (indices.transferFamily.has_value())
+	{
+		uniqueQueueFamilies.insert(indices.transferFamily.value());
+	}
 
 	// 큐 생성을 위한 정보 설정
 	std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
@@ -239,6 +270,14 @@ void VulkanContext::createLogicalDevice()
 	deviceFeatures.samplerAnisotropy = VK_TRUE; // 이방성 필터링 사용 설정
 	deviceFeatures.sampleRateShading = VK_TRUE; // 디바이스에 샘플 셰이딩 기능 활성화
 	deviceFeatures.multiViewport = VK_TRUE;		// 멀티 뷰포트 활성화
+	// geometry pass 의 전역 texture 배열을 material table 의 index 로 접근
+	deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+	// GPU culling 모드: 여러 draw 를 한 번의 indirect 호출로 제출하고, firstInstance 도 indirect command 에서 읽는다.
+	VkPhysicalDeviceFeatures supportedFeatures;
+	vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+	multiDrawIndirectSupported = supportedFeatures.multiDrawIndirect && supportedFeatures.drawIndirectFirstInstance;
+	deviceFeatures.multiDrawIndirect = multiDrawIndirectSupported ? VK_TRUE : VK_FALSE;
+	deviceFeatures.drawIndirectFirstInstance = multiDrawIndirectSupported ? VK_TRUE : VK_FALSE;
 
 	// 논리적 장치 생성을 위한 정보 등록
 	VkDeviceCreateInfo createInfo{};
@@ -248,8 +287,9 @@ void VulkanContext::createLogicalDevice()
 	createInfo.pEnabledFeatures = &deviceFeatures;
 
 	// 확장 설정
-	createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-	createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+	std::vector<const char *> extensions = getDeviceExtensions();
+	createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+	createInfo.ppEnabledExtensionNames = extensions.data();
 
 	// 구버전 호환을 위해 디버그 모드일 경우
 	// 검증 레이어를 포함 시키지만, 현대 시스템에서는 논리적 장치의 레이어를 안 씀
@@ -272,6 +312,10 @@ void VulkanContext::createLogicalDevice()
 	// 큐 핸들 가져오기
 	vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
 	vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+
+	// 업로드용 transfer 전용 queue (없으면 graphics queue 를 같이 쓴다)
+	transferQueueFamily = indices.transferFamily.value_or(indices.graphicsFamily.value());
+	vkGetDeviceQueue(device, transferQueueFamily, 0, &transferQueue);
 }
 
 /*
@@ -310,8 +354,12 @@ bool VulkanContext::isDeviceSuitable(VkPhysicalDevice device)
 	bool extensionsSupported = checkDeviceExtensionSupport(device);
 	bool swapChainAdequate = false;
 
-	// 스왑 체인 확장이 존재하는 경우
-	if (extensionsSupported)
+	// 스왑 체인 확장이 존재하는 경우 (headless 는 swap chain 을 만들지 않는다)
+	if (extensionsSupported && headless)
+	{
+		swapChainAdequate = true;
+	}
+	else if (extensionsSupported)
 	{
 		// 물리 디바이스와 surface가 호환하는 SwapChain 정보를 가져옴
 		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
@@ -319,11 +367,12 @@ bool VulkanContext::isDeviceSuitable(VkPhysicalDevice device)
 		swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
 	}
 
-	// GPU 에서 이방성 필터링을 지원하는지 확인
+	// GPU 에서 이방성 필터링 / sampler 배열 동적 index 를 지원하는지 확인
 	VkPhysicalDeviceFeatures supportedFeatures;
 	vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
-	return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+	return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy &&
+		   supportedFeatures.shaderSampledImageArrayDynamicIndexing;
 }
 
 // GPU와 surface가 호환하는 SwapChain 정보를 반환
@@ -406,7 +455,8 @@ bool VulkanContext::checkDeviceExtensionSupport(VkPhysicalDevice device)
 	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
 	// 스왑 체인 확장이 존재하는지 확인
-	std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+	std::vector<const char *> extensions = getDeviceExtensions();
+	std::set<std::string> requiredExtensions(extensions.begin(), extensions.end());
 	for (const auto &extension : availableExtensions)
 	{
 		// 지원 가능한 확장들 목록을 순회하며 제거
@@ -446,8 +496,16 @@ QueueFamilyIndices VulkanContext::findQueueFamilies(VkPhysicalDevice device)
 		}
 
 		// GPU의 i 인덱스 큐 패밀리가 surface에서 프레젠테이션을 지원하는지 확인
+		// (headless 는 present 하지 않으므로 graphics 큐 패밀리를 그대로 쓴다)
 		VkBool32 presentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+		if (headless)
+		{
+			presentSupport = indices.graphicsFamily.has_value();
+		}
+		else
+		{
+			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+		}
 
 		// 프레젠테이션 큐 패밀리 등록
 		if (presentSupport)
@@ -463,6 +521,22 @@ QueueFamilyIndices VulkanContext::findQueueFamilies(VkPhysicalDevice device)
 
 		i++;
 	}
+
+	// graphics / compute 를 지원하지 않는 transfer 전용 큐 패밀리 (보통 GPU 의 DMA 엔진)
+	// image 복사 단위(minImageTransferGranularity)가 1 texel 인 경우만 사용
+	for (uint32_t family = 0; family < queueFamilyCount; family++)
+	{
+		const VkQueueFamilyProperties &queueFamily = queueFamilies[family];
+		VkExtent3D granularity = queueFamily.minImageTransferGranularity;
+		if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+			!(queueFamily.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) && granularity.width == 1 &&
+			granularity.height == 1 && granularity.depth == 1)
+		{
+			indices.transferFamily = family;
+			break;
+		}
+	}
+
 	// 그래픽 큐 패밀리를 못 찾은 경우 값이 없는 채로 반환 됨
 	return indices;
 }
@@ -473,7 +547,7 @@ void VulkanContext::createDescriptorPool()
 	size_t MAX_OBJECTS = 10000;
 
 	// 디스크립터 풀의 타입별 디스크립터 개수를 설정하는 구조체
-	std::array<VkDescriptorPoolSize, 5> poolSizes{};
+	std::array<VkDescriptorPoolSize, 8> poolSizes{};
 	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; // 유니폼 버퍼 설정
 	poolSizes[0].descriptorCount =
 		static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * MAX_OBJECTS); // 유니폼 버퍼 디스크립터 최대 개수 설정
@@ -487,6 +561,15 @@ void VulkanContext::createDescriptorPool()
 	// image input attachment
 	poolSizes[4].type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
 	poolSizes[4].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * MAX_OBJECTS);
+	// UniformRingBuffer 를 가리키는 dynamic uniform buffer (프레임별 set 에만 쓰이므로 많지 않음)
+	poolSizes[5].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	poolSizes[5].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 16);
+	// skinning palette 같은 프레임별 storage buffer
+	poolSizes[6].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[6].descriptorCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * 16);
+	// skybox 전처리 compute pass 의 출력 (잠깐 쓰고 바로 해제)
+	poolSizes[7].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+	poolSizes[7].descriptorCount = 16;
 
 	// 디스크립터 풀을 생성할 때 필요한 설정 정보를 담는 구조체
 	VkDescriptorPoolCreateInfo poolInfo{};
@@ -516,6 +599,21 @@ VKAPI_ATTR VkBool32 VKAPI_CALL VulkanContext::debugCallback(VkDebugUtilsMessageS
 	return VK_FALSE;
 }
 
+// headless 는 swap chain 확장 없이 device 를 만든다.
+std::vector<const char *> VulkanContext::getDeviceExtensions()
+{
+	std::vector<const char *> extensions;
+	for (const char *extension : deviceExtensions)
+	{
+		if (headless && strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0)
+		{
+			continue;
+		}
+		extensions.push_back(extension);
+	}
+	return extensions;
+}
+
 uint32_t VulkanContext::getQueueFamily()
 {
 	QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
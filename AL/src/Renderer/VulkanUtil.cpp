@@ -2,11 +2,9 @@
 
 namespace ale
 {
-void VulkanUtil::createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
-							 VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
-							 VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory)
+static VkImage createImageHandle(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
+								 VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage)
 {
-
 	auto &context = VulkanContext::getContext();
 	auto device = context.getDevice();
 
@@ -30,10 +28,22 @@ void VulkanUtil::createImage(uint32_t width, uint32_t height, uint32_t mipLevels
 													   // 하나의 큐 패밀리에서만 접근 가능한 단일 큐 모드)
 
 	// 이미지 객체 생성
+	VkImage image;
 	if (vkCreateImage(device, &imageInfo, nullptr, &image) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to create image!");
 	}
+	return image;
+}
+
+void VulkanUtil::createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
+							 VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
+							 VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory)
+{
+	auto &context = VulkanContext::getContext();
+	auto device = context.getDevice();
+
+	image = createImageHandle(width, height, mipLevels, numSamples, format, tiling, usage);
 
 	// 이미지에 필요한 메모리 요구 사항을 조회
 	VkMemoryRequirements memRequirements;
@@ -55,6 +65,16 @@ void VulkanUtil::createImage(uint32_t width, uint32_t height, uint32_t mipLevels
 	vkBindImageMemory(device, image, imageMemory, 0);
 }
 
+void VulkanUtil::createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples,
+							 VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage,
+							 VkMemoryPropertyFlags properties, VkImage &image, MemoryAllocation &imageAllocation)
+{
+	image = createImageHandle(width, height, mipLevels, numSamples, format, tiling, usage);
+
+	// allocator 의 image 전용 block 에서 잘라 받은 뒤 bind
+	imageAllocation = MemoryAllocator::getAllocator().allocateImageMemory(image, properties);
+}
+
 /*
 	GPU와 buffer가 호환되는 메모리 유형중 properties에 해당하는 속성들을 갖는 메모리 유형 찾기
 */
@@ -168,6 +188,18 @@ std::vector<char> VulkanUtil::readFile(const std::string &filename)
 	return buffer;
 }
 
+uint64_t VulkanUtil::hashData(const void *data, size_t size, uint64_t seed)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	uint64_t hash = seed;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
 void VulkanUtil::insertImageMemoryBarrier(VkCommandBuffer cmdbuffer, VkImage image, VkAccessFlags srcAccessMask,
 										  VkAccessFlags dstAccessMask, VkImageLayout oldImageLayout,
 										  VkImageLayout newImageLayout, VkPipelineStageFlags srcStageMask,
@@ -389,10 +421,9 @@ ImTextureID VulkanUtil::createIconTexture(VkDevice device, VkDescriptorPool desc
 	return reinterpret_cast<ImTextureID>(descriptorSet);
 }
 
-void VulkanUtil::createCubeMapImage(uint32_t width, uint32_t height, uint32_t mipLevels,
-									VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling,
-									VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
-									VkDeviceMemory &imageMemory)
+static VkImage createCubeMapImageHandle(uint32_t width, uint32_t height, uint32_t mipLevels,
+									   VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling,
+									   VkImageUsageFlags usage)
 {
 	auto &context = VulkanContext::getContext();
 	auto device = context.getDevice();
@@ -415,10 +446,23 @@ void VulkanUtil::createCubeMapImage(uint32_t width, uint32_t height, uint32_t mi
 	imageInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
 
 	// 이미지 객체 생성
+	VkImage image;
 	if (vkCreateImage(device, &imageInfo, nullptr, &image) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to create cube image!");
 	}
+	return image;
+}
+
+void VulkanUtil::createCubeMapImage(uint32_t width, uint32_t height, uint32_t mipLevels,
+									VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling,
+									VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
+									VkDeviceMemory &imageMemory)
+{
+	auto &context = VulkanContext::getContext();
+	auto device = context.getDevice();
+
+	image = createCubeMapImageHandle(width, height, mipLevels, numSamples, format, tiling, usage);
 
 	// 이미지에 필요한 메모리 요구 사항 조회
 	VkMemoryRequirements memRequirements;
@@ -440,6 +484,17 @@ void VulkanUtil::createCubeMapImage(uint32_t width, uint32_t height, uint32_t mi
 	vkBindImageMemory(device, image, imageMemory, 0);
 }
 
+void VulkanUtil::createCubeMapImage(uint32_t width, uint32_t height, uint32_t mipLevels,
+									VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling,
+									VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
+									MemoryAllocation &imageAllocation)
+{
+	image = createCubeMapImageHandle(width, height, mipLevels, numSamples, format, tiling, usage);
+
+	// allocator 의 image 전용 block 에서 잘라 받은 뒤 bind
+	imageAllocation = MemoryAllocator::getAllocator().allocateImageMemory(image, properties);
+}
+
 VkImageView VulkanUtil::createCubeMapImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
 											   uint32_t mipLevels)
 {
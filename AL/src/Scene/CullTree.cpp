@@ -1,7 +1,15 @@
 #include "Scene/CullTree.h"
+#include "Core/JobSystem.h"
 #include "Core/Log.h"
 #include "Scene/Entity.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AL_CULL_SIMD 1
+#else
+#define AL_CULL_SIMD 0
+#endif
+
 namespace ale
 {
 
@@ -22,22 +30,44 @@ CullTree::CullTree()
 	m_freeNode = 0;
 }
 
-void CullTree::updateTree()
+void CullTree::updateTree(std::vector<entt::entity> &movedEntities)
 {
 	auto view = m_scene->getAllEntitiesWith<MeshRendererComponent, TransformComponent>();
-	for (auto entity : view)
-	{
-		TransformComponent &transformComponent = view.get<TransformComponent>(entity);
-		if (transformComponent.m_isMoved == true)
+
+	// 목록에 들어간 뒤 삭제되었거나 tree 에서 빠진 entity 는 제외
+	auto removed = std::remove_if(movedEntities.begin(), movedEntities.end(), [&](entt::entity entity) {
+		if (!view.contains(entity))
+			return true;
+
+		if (view.get<MeshRendererComponent>(entity).nodeId == NULL_NODE)
 		{
-			MeshRendererComponent &meshRendererComponent = view.get<MeshRendererComponent>(entity);
-			CullSphere newSphere(transformComponent.m_WorldTransform *
-									 glm::vec4(meshRendererComponent.cullSphere.center, 1.0f),
-								 transformComponent.getMaxScale() * meshRendererComponent.cullSphere.radius);
-			moveNode(meshRendererComponent.nodeId, newSphere);
-			transformComponent.m_isMoved = false;
+			view.get<TransformComponent>(entity).m_isMoved = false;
+			return true;
 		}
+		return false;
+	});
+	movedEntities.erase(removed, movedEntities.end());
+
+	// 새 bounding sphere 계산은 entity 마다 독립적이므로 병렬로 처리하고, tree 수정은 순서대로 한다.
+	std::vector<CullSphere> newSpheres(movedEntities.size());
+	JobSystem::parallelFor(static_cast<uint32_t>(movedEntities.size()), 256, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++)
+		{
+			TransformComponent &transformComponent = view.get<TransformComponent>(movedEntities[i]);
+			MeshRendererComponent &meshRendererComponent = view.get<MeshRendererComponent>(movedEntities[i]);
+			newSpheres[i] = CullSphere(transformComponent.m_WorldTransform *
+										   glm::vec4(meshRendererComponent.cullSphere.center, 1.0f),
+									   transformComponent.getMaxScale() * meshRendererComponent.cullSphere.radius);
+		}
+	});
+
+	for (size_t i = 0; i < movedEntities.size(); i++)
+	{
+		MeshRendererComponent &meshRendererComponent = view.get<MeshRendererComponent>(movedEntities[i]);
+		moveNode(meshRendererComponent.nodeId, newSpheres[i]);
+		view.get<TransformComponent>(movedEntities[i]).m_isMoved = false;
 	}
+	movedEntities.clear();
 }
 
 int32_t CullTree::allocateNode()
@@ -102,6 +132,29 @@ void CullTree::destroyNode(int32_t nodeId)
 
 bool CullTree::moveNode(int32_t nodeId, const CullSphere &newSphere)
 {
+	// 새 sphere 가 아직 부모 sphere 안에 있으면 조상은 그대로 유효하므로 leaf 만 고친다. (flat tree 도 그 자리만 갱신)
+	int32_t parent = m_nodes[nodeId].parent;
+	bool fitsParent = parent == NULL_NODE;
+	if (!fitsParent)
+	{
+		const CullSphere &parentSphere = m_nodes[parent].sphere;
+		fitsParent = glm::length(newSphere.center - parentSphere.center) + newSphere.radius <= parentSphere.radius;
+	}
+	if (fitsParent)
+	{
+		m_nodes[nodeId].sphere = newSphere;
+		if (!m_flatTreeDirty)
+		{
+			uint32_t index = m_flatIndex[nodeId];
+			m_flatTree.centerX[index] = newSphere.center.x;
+			m_flatTree.centerY[index] = newSphere.center.y;
+			m_flatTree.centerZ[index] = newSphere.center.z;
+			m_flatTree.radius[index] = newSphere.radius;
+		}
+		return false;
+	}
+
+	// 구조가 바뀌므로 다음 culling 때 flat tree 를 다시 만든다.
 	detachNode(nodeId);
 
 	m_nodes[nodeId].sphere = newSphere;
@@ -115,77 +168,242 @@ void CullTree::setScene(Scene *scene)
 	m_scene = scene;
 }
 
-void CullTree::setRenderEnable(int32_t nodeId)
+int32_t CullTree::getRootNodeId()
 {
-	CullTreeNode &node = m_nodes[nodeId];
+	return m_root;
+}
 
-	if (node.isLeaf() == true)
-	{
-		MeshRendererComponent &component =
-			m_scene->getComponent<MeshRendererComponent>(static_cast<entt::entity>(node.entityHandle));
-		component.cullState = (component.cullState | ECullState::RENDER);
-	}
-	else
+void CullTree::collectLeaves(std::vector<entt::entity> &entities, std::vector<CullSphere> &spheres)
+{
+	entities.clear();
+	spheres.clear();
+	if (m_root == NULL_NODE)
+		return;
+
+	if (m_flatTreeDirty)
+		buildFlatTree();
+
+	// 공간적으로 가까운 entity 가 이어지도록 flat tree 순서를 그대로 쓴다.
+	for (uint32_t index = 0; index < m_flatTree.size(); index++)
 	{
-		setRenderEnable(node.child1);
-		setRenderEnable(node.child2);
+		if (!m_flatTree.isLeaf(index))
+			continue;
+
+		CullSphere sphere;
+		sphere.center = glm::vec3(m_flatTree.centerX[index], m_flatTree.centerY[index], m_flatTree.centerZ[index]);
+		sphere.radius = m_flatTree.radius[index];
+		entities.push_back(static_cast<entt::entity>(m_flatTree.leafEntities[m_flatTree.leafBegin[index]]));
+		spheres.push_back(sphere);
 	}
 }
 
-void CullTree::setRenderDisable(int32_t nodeId)
+void CullTree::frustumCulling(const Frustum &frustum, std::vector<entt::entity> &visibleEntities)
 {
-	CullTreeNode &node = m_nodes[nodeId];
+	visibleEntities.clear();
+	if (m_root == NULL_NODE)
+		return;
+
+	if (m_flatTreeDirty)
+		buildFlatTree();
+
+	FrustumPlanesSoA planes(frustum);
+	uint32_t nodeCount = m_flatTree.size();
 
-	if (node.isLeaf() == true)
+	// 작은 tree 는 한 번에 처리
+	if (nodeCount < 2048 || !JobSystem::isInitialized())
 	{
-		MeshRendererComponent &component =
-			m_scene->getComponent<MeshRendererComponent>(static_cast<entt::entity>(node.entityHandle));
-		component.cullState = (component.cullState & ECullState::NONE);
+		std::vector<uint32_t> visible;
+		cullRange(planes, 0, nodeCount, visible);
+		visibleEntities.reserve(visible.size());
+		for (uint32_t handle : visible)
+		{
+			visibleEntities.push_back(static_cast<entt::entity>(handle));
+		}
+		return;
 	}
-	else
+
+	// 위쪽 몇 단계만 순서대로 검사해서 worker 수보다 넉넉한 개수의 subtree 로 나눈 뒤 병렬로 처리
+	uint32_t targetTaskCount = (JobSystem::getWorkerCount() + 1) * 4;
+	std::vector<uint32_t> insideNodes;
+	std::vector<uint32_t> frontier{0};
+
+	while (!frontier.empty() && frontier.size() < targetTaskCount)
 	{
-		setRenderDisable(node.child1);
-		setRenderDisable(node.child2);
+		std::vector<uint32_t> next;
+		for (uint32_t index : frontier)
+		{
+			CullSphere sphere;
+			sphere.center = glm::vec3(m_flatTree.centerX[index], m_flatTree.centerY[index], m_flatTree.centerZ[index]);
+			sphere.radius = m_flatTree.radius[index];
+
+			EFrustum result = frustum.cullingSphere(sphere);
+			if (result == EFrustum::OUTSIDE)
+				continue;
+
+			if (result == EFrustum::INSIDE)
+				insideNodes.push_back(index);
+			else if (m_flatTree.isLeaf(index))
+				insideNodes.push_back(index);
+			else
+			{
+				uint32_t child1 = index + 1;
+				next.push_back(child1);
+				next.push_back(m_flatTree.skipIndex[child1]);
+			}
+		}
+		frontier.swap(next);
 	}
-}
+	const std::vector<uint32_t> &tasks = frontier;
 
-int32_t CullTree::getRootNodeId()
-{
-	return m_root;
-}
-
-void CullTree::frustumCulling(const Frustum &frustum, int32_t nodeId)
-{
-	CullTreeNode &node = m_nodes[nodeId];
+	std::vector<std::vector<uint32_t>> taskResults(tasks.size());
+	JobSystem::parallelFor(static_cast<uint32_t>(tasks.size()), 1, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++)
+		{
+			cullRange(planes, tasks[i], m_flatTree.skipIndex[tasks[i]], taskResults[i]);
+		}
+	});
 
-	EFrustum result = frustum.cullingSphere(node.sphere);
+	// 완전히 안쪽인 subtree 는 leaf 구간을 그대로 복사
+	size_t visibleCount = 0;
+	for (uint32_t index : insideNodes)
+	{
+		visibleCount += m_flatTree.leafBegin[m_flatTree.skipIndex[index]] - m_flatTree.leafBegin[index];
+	}
+	for (const auto &result : taskResults)
+	{
+		visibleCount += result.size();
+	}
 
-	if (result == EFrustum::INSIDE)
+	visibleEntities.reserve(visibleCount);
+	for (uint32_t index : insideNodes)
 	{
-		// AL_CORE_INFO("node {} INSIDE!!", nodeId);
-		setRenderEnable(nodeId);
+		for (uint32_t leaf = m_flatTree.leafBegin[index]; leaf < m_flatTree.leafBegin[m_flatTree.skipIndex[index]];
+			 leaf++)
+		{
+			visibleEntities.push_back(static_cast<entt::entity>(m_flatTree.leafEntities[leaf]));
+		}
 	}
-	else if (result == EFrustum::INTERSECT)
+	for (const auto &result : taskResults)
 	{
-		// AL_CORE_INFO("node {} INTERSECT!!", nodeId);
-		if (node.isLeaf() == true)
+		for (uint32_t handle : result)
 		{
-			setRenderEnable(nodeId);
+			visibleEntities.push_back(static_cast<entt::entity>(handle));
+		}
+	}
+}
+
+void CullTree::cullRange(const FrustumPlanesSoA &planes, uint32_t begin, uint32_t end,
+						 std::vector<uint32_t> &visibleEntities) const
+{
+	const FlatCullTree &tree = m_flatTree;
+
+#if AL_CULL_SIMD
+	__m128 normalX0 = _mm_load_ps(planes.normalX);
+	__m128 normalX1 = _mm_load_ps(planes.normalX + 4);
+	__m128 normalY0 = _mm_load_ps(planes.normalY);
+	__m128 normalY1 = _mm_load_ps(planes.normalY + 4);
+	__m128 normalZ0 = _mm_load_ps(planes.normalZ);
+	__m128 normalZ1 = _mm_load_ps(planes.normalZ + 4);
+	__m128 distance0 = _mm_load_ps(planes.distance);
+	__m128 distance1 = _mm_load_ps(planes.distance + 4);
+#endif
+
+	uint32_t index = begin;
+	while (index < end)
+	{
+		int32_t outsideMask = 0;
+		int32_t intersectMask = 0;
+
+#if AL_CULL_SIMD
+		__m128 centerX = _mm_set1_ps(tree.centerX[index]);
+		__m128 centerY = _mm_set1_ps(tree.centerY[index]);
+		__m128 centerZ = _mm_set1_ps(tree.centerZ[index]);
+		__m128 radius = _mm_set1_ps(tree.radius[index]);
+
+		__m128 dot0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX0, centerX), _mm_mul_ps(normalY0, centerY)),
+								 _mm_mul_ps(normalZ0, centerZ));
+		__m128 dot1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX1, centerX), _mm_mul_ps(normalY1, centerY)),
+								 _mm_mul_ps(normalZ1, centerZ));
+
+		outsideMask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_sub_ps(dot0, radius), distance0)) |
+					  _mm_movemask_ps(_mm_cmpgt_ps(_mm_sub_ps(dot1, radius), distance1));
+		intersectMask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_add_ps(dot0, radius), distance0)) |
+						_mm_movemask_ps(_mm_cmpgt_ps(_mm_add_ps(dot1, radius), distance1));
+#else
+		for (int32_t i = 0; i < 6; ++i)
+		{
+			float dot = planes.normalX[i] * tree.centerX[index] + planes.normalY[i] * tree.centerY[index] +
+						planes.normalZ[i] * tree.centerZ[index];
+			outsideMask |= (dot - tree.radius[index] > planes.distance[i]) ? 1 : 0;
+			intersectMask |= (dot + tree.radius[index] > planes.distance[i]) ? 1 : 0;
+		}
+#endif
+
+		if (outsideMask != 0)
+		{
+			// OUTSIDE: subtree 전체를 건너뜀
+			index = tree.skipIndex[index];
+		}
+		else if (intersectMask == 0 || tree.isLeaf(index))
+		{
+			// INSIDE (또는 걸쳐 있는 leaf): subtree 의 leaf 를 전부 추가
+			visibleEntities.insert(visibleEntities.end(), tree.leafEntities.begin() + tree.leafBegin[index],
+								   tree.leafEntities.begin() + tree.leafBegin[tree.skipIndex[index]]);
+			index = tree.skipIndex[index];
 		}
 		else
 		{
-			frustumCulling(frustum, node.child1);
-			frustumCulling(frustum, node.child2);
+			// INTERSECT: 자식으로 내려감
+			index++;
 		}
 	}
+}
+
+void CullTree::buildFlatTree()
+{
+	m_flatTree.clear();
+	m_flatTree.reserve(m_nodeCount);
+	m_flatIndex.resize(m_nodes.size());
+
+	if (m_root != NULL_NODE)
+		flattenNode(m_root);
+
+	// 마지막 node 의 skipIndex 가 가리키는 위치에도 leafBegin 이 필요
+	m_flatTree.leafBegin.push_back(static_cast<uint32_t>(m_flatTree.leafEntities.size()));
+	m_flatTreeDirty = false;
+}
+
+uint32_t CullTree::flattenNode(int32_t nodeId)
+{
+	const CullTreeNode &node = m_nodes[nodeId];
+	uint32_t index = m_flatTree.size();
+	m_flatIndex[nodeId] = index;
+
+	m_flatTree.centerX.push_back(node.sphere.center.x);
+	m_flatTree.centerY.push_back(node.sphere.center.y);
+	m_flatTree.centerZ.push_back(node.sphere.center.z);
+	m_flatTree.radius.push_back(node.sphere.radius);
+	m_flatTree.skipIndex.push_back(0);
+	m_flatTree.leafBegin.push_back(static_cast<uint32_t>(m_flatTree.leafEntities.size()));
+
+	if (node.isLeaf())
+	{
+		m_flatTree.leafEntities.push_back(node.entityHandle);
+	}
 	else
 	{
-		// AL_CORE_INFO("node {} OUTSIDE!!",nodeId);
+		flattenNode(node.child1);
+		flattenNode(node.child2);
 	}
+
+	m_flatTree.skipIndex[index] = m_flatTree.size();
+	return index;
 }
 
 void CullTree::insertLeaf(int32_t leaf)
 {
+	m_flatTreeDirty = true;
+
 	if (m_root == NULL_NODE)
 	{
 		m_root = leaf;
@@ -302,6 +520,8 @@ void CullTree::insertLeaf(int32_t leaf)
 
 void CullTree::detachNode(int32_t nodeId)
 {
+	m_flatTreeDirty = true;
+
 	if (nodeId == m_root)
 	{
 		m_root = NULL_NODE;
@@ -528,6 +748,50 @@ int32_t CullTree::balance(int32_t iA)
 void CullTree::changeEntityHandle(int32_t nodeId, uint32_t entityHandle)
 {
 	m_nodes[nodeId].entityHandle = entityHandle;
+	m_flatTreeDirty = true;
+}
+
+FrustumPlanesSoA::FrustumPlanesSoA(const Frustum &frustum)
+{
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		if (i < 6)
+		{
+			normalX[i] = frustum.plane[i].normal.x;
+			normalY[i] = frustum.plane[i].normal.y;
+			normalZ[i] = frustum.plane[i].normal.z;
+			distance[i] = frustum.plane[i].distance;
+		}
+		else
+		{
+			normalX[i] = 0.0f;
+			normalY[i] = 0.0f;
+			normalZ[i] = 0.0f;
+			distance[i] = std::numeric_limits<float>::max();
+		}
+	}
+}
+
+void FlatCullTree::clear()
+{
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	radius.clear();
+	skipIndex.clear();
+	leafBegin.clear();
+	leafEntities.clear();
+}
+
+void FlatCullTree::reserve(size_t nodeCount)
+{
+	centerX.reserve(nodeCount);
+	centerY.reserve(nodeCount);
+	centerZ.reserve(nodeCount);
+	radius.reserve(nodeCount);
+	skipIndex.reserve(nodeCount);
+	leafBegin.reserve(nodeCount + 1);
+	leafEntities.reserve(nodeCount / 2 + 1);
 }
 
 ECullState operator&(ECullState state1, ECullState state2)
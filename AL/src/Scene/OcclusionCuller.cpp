@@ -0,0 +1,452 @@
+#include "Scene/OcclusionCuller.h"
+#include "Core/JobSystem.h"
+#include "Renderer/Mesh.h"
+#include "Renderer/RenderingComponent.h"
+#include "Scene/Component.h"
+#include "Scene/Scene.h"
+
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AL_CULL_SIMD 1
+#else
+#define AL_CULL_SIMD 0
+#endif
+
+namespace ale
+{
+// SceneHierarchyPanel 의 "Box" (mesh 가 bounding box 와 같으므로 항상 occluder 로 쓸 수 있다)
+static constexpr uint32_t BOX_MESH_TYPE = 1;
+// 화면에서 이보다 작게 보이는 (radius / 거리) occluder 는 가리는 양에 비해 비용이 커서 쓰지 않는다.
+static constexpr float MIN_OCCLUDER_SIZE = 0.02f;
+// 이보다 가까운 부분은 잘라낸다. (w 가 너무 작으면 pixel 좌표가 커져서 edge 계산의 정밀도가 떨어진다)
+static constexpr float NEAR_CLIP_W = 0.05f;
+// 가림 판정 여유 (1 / w 기준), 저해상도 depth 가 pixel 중심 값이라 경계에서 생기는 오차를 덮는다.
+static constexpr float OCCLUSION_BIAS = 0.999f;
+// rasterize 를 나눌 가로 띠의 높이 (띠마다 쓰는 pixel 이 겹치지 않아서 lock 이 필요 없다)
+static constexpr uint32_t BAND_HEIGHT = 8;
+// 가림 검사는 depth pyramid 에서 가로 세로 이 개수 이하의 texel 만 읽는 level 에서 한다.
+static constexpr uint32_t MAX_TEST_TEXELS = 4;
+
+static constexpr uint8_t FLAG_VISIBLE = 0;
+static constexpr uint8_t FLAG_OCCLUDED = 1;
+static constexpr uint8_t FLAG_OCCLUDER = 2;
+
+// box corner index 는 bit 0, 1, 2 가 각각 x, y, z 의 max 쪽, 면마다 triangle 2 개
+static constexpr uint8_t BOX_TRIANGLES[12][3] = {{0, 1, 3}, {0, 3, 2}, {4, 5, 7}, {4, 7, 6}, {0, 2, 6}, {0, 6, 4},
+												 {1, 3, 7}, {1, 7, 5}, {0, 1, 5}, {0, 5, 4}, {2, 3, 7}, {2, 7, 6}};
+
+static float elapsedMs(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void OcclusionCuller::cull(Scene &scene, std::vector<entt::entity> &visibleEntities)
+{
+	m_stats = Stats{};
+	if (!m_enabled || visibleEntities.empty())
+		return;
+
+	if (m_depthLevels.empty())
+	{
+		glm::uvec2 size(DEPTH_WIDTH, DEPTH_HEIGHT);
+		while (true)
+		{
+			m_levelSizes.push_back(size);
+			m_depthLevels.emplace_back(size.x * size.y);
+			if (size.x == 1 && size.y == 1)
+				break;
+			size = glm::max((size + 1u) / 2u, glm::uvec2(1));
+		}
+	}
+
+	auto rasterStart = std::chrono::steady_clock::now();
+	selectOccluders(scene, visibleEntities);
+	m_stats.occluderCount = static_cast<uint32_t>(m_occluders.size());
+	if (m_occluders.empty())
+		return;
+
+	setupTriangles();
+	rasterize();
+	buildDepthPyramid();
+	m_stats.triangleCount = static_cast<uint32_t>(m_triangles.size());
+	m_stats.rasterMs = elapsedMs(rasterStart);
+
+	// occluder 자신은 검사하지 않는다. (자기 box 에 가려진 것으로 나올 수 있다)
+	auto testStart = std::chrono::steady_clock::now();
+	uint32_t count = static_cast<uint32_t>(visibleEntities.size());
+	m_occludedFlags.assign(count, FLAG_VISIBLE);
+	for (const Occluder &occluder : m_occluders)
+	{
+		m_occludedFlags[occluder.visibleIndex] = FLAG_OCCLUDER;
+	}
+
+	auto view = scene.getAllEntitiesWith<MeshRendererComponent, TransformComponent>();
+	JobSystem::parallelFor(count, 256, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++)
+		{
+			if (m_occludedFlags[i] == FLAG_OCCLUDER)
+				continue;
+
+			MeshRendererComponent &mc = view.get<MeshRendererComponent>(visibleEntities[i]);
+			TransformComponent &tc = view.get<TransformComponent>(visibleEntities[i]);
+			if (isOccluded(tc.m_WorldTransform, mc.cullSphere))
+				m_occludedFlags[i] = FLAG_OCCLUDED;
+		}
+	});
+
+	// renderer 가 쓰는 순서 (flat tree 순서) 를 유지한 채로 앞으로 당긴다.
+	uint32_t visibleCount = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (m_occludedFlags[i] != FLAG_OCCLUDED)
+			visibleEntities[visibleCount++] = visibleEntities[i];
+	}
+	visibleEntities.resize(visibleCount);
+
+	m_stats.testedCount = count - m_stats.occluderCount;
+	m_stats.culledCount = count - visibleCount;
+	m_stats.testMs = elapsedMs(testStart);
+}
+
+void OcclusionCuller::selectOccluders(Scene &scene, const std::vector<entt::entity> &visibleEntities)
+{
+	m_occluders.clear();
+
+	auto view = scene.getAllEntitiesWith<MeshRendererComponent, TransformComponent>();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(visibleEntities.size()); i++)
+	{
+		MeshRendererComponent &mc = view.get<MeshRendererComponent>(visibleEntities[i]);
+		if (mc.m_RenderingComponent == nullptr || (mc.type != BOX_MESH_TYPE && !mc.occluder))
+			continue;
+
+		// 화면에서 차지하는 크기로 순위를 정한다.
+		TransformComponent &tc = view.get<TransformComponent>(visibleEntities[i]);
+		glm::vec3 center = tc.m_WorldTransform * glm::vec4(mc.cullSphere.center, 1.0f);
+		float radius = tc.getMaxScale() * mc.cullSphere.radius;
+		float priority = radius / std::max(glm::length(center - m_cameraPos), radius);
+		if (priority < MIN_OCCLUDER_SIZE)
+			continue;
+
+		Occluder occluder;
+		occluder.visibleIndex = i;
+		occluder.transform = tc.m_WorldTransform;
+		occluder.priority = priority;
+		m_occluders.push_back(occluder);
+	}
+
+	auto byPriority = [](const Occluder &a, const Occluder &b) { return a.priority > b.priority; };
+	if (m_occluders.size() > MAX_OCCLUDERS)
+	{
+		std::nth_element(m_occluders.begin(), m_occluders.begin() + MAX_OCCLUDERS, m_occluders.end(), byPriority);
+		m_occluders.resize(MAX_OCCLUDERS);
+	}
+
+	// 고른 occluder 만 mesh 의 bounding box 를 모은다.
+	auto removed = std::remove_if(m_occluders.begin(), m_occluders.end(), [&](Occluder &occluder) {
+		MeshRendererComponent &mc = view.get<MeshRendererComponent>(visibleEntities[occluder.visibleIndex]);
+		occluder.minPos = glm::vec3(FLT_MAX);
+		occluder.maxPos = glm::vec3(-FLT_MAX);
+		for (auto &mesh : mc.m_RenderingComponent->getModel()->getMeshes())
+		{
+			occluder.minPos = glm::min(occluder.minPos, mesh->getMinPos());
+			occluder.maxPos = glm::max(occluder.maxPos, mesh->getMaxPos());
+		}
+		if (glm::any(glm::greaterThan(occluder.minPos, occluder.maxPos)))
+			return true;
+
+		// camera 가 box 안에 있으면 box 가 화면 전체를 가려버리므로 쓰지 않는다.
+		glm::vec3 localCamera = glm::inverse(occluder.transform) * glm::vec4(m_cameraPos, 1.0f);
+		return glm::all(glm::greaterThanEqual(localCamera, occluder.minPos)) &&
+			   glm::all(glm::lessThanEqual(localCamera, occluder.maxPos));
+	});
+	m_occluders.erase(removed, m_occluders.end());
+}
+
+void OcclusionCuller::setupTriangles()
+{
+	m_occluderTriangles.resize(m_occluders.size());
+	JobSystem::parallelFor(static_cast<uint32_t>(m_occluders.size()), 16, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; i++)
+		{
+			const Occluder &occluder = m_occluders[i];
+			std::vector<ScreenTriangle> &triangles = m_occluderTriangles[i];
+			triangles.clear();
+
+			glm::mat4 mvp = m_viewProjection * occluder.transform;
+			glm::vec4 corners[8];
+			for (uint32_t c = 0; c < 8; c++)
+			{
+				glm::vec3 local((c & 1) ? occluder.maxPos.x : occluder.minPos.x,
+								(c & 2) ? occluder.maxPos.y : occluder.minPos.y,
+								(c & 4) ? occluder.maxPos.z : occluder.minPos.z);
+				corners[c] = mvp * glm::vec4(local, 1.0f);
+			}
+
+			// 닫힌 box 라서 winding 은 보지 않는다. (뒷면은 앞면보다 멀어서 depth 에 남지 않는다)
+			for (const auto &indices : BOX_TRIANGLES)
+			{
+				glm::vec4 clip[3] = {corners[indices[0]], corners[indices[1]], corners[indices[2]]};
+				clipAndEmitTriangle(clip, triangles);
+			}
+		}
+	});
+
+	m_triangles.clear();
+	for (const auto &triangles : m_occluderTriangles)
+	{
+		m_triangles.insert(m_triangles.end(), triangles.begin(), triangles.end());
+	}
+}
+
+void OcclusionCuller::clipAndEmitTriangle(const glm::vec4 *clip, std::vector<ScreenTriangle> &triangles) const
+{
+	// 세 점이 모두 화면 한쪽 바깥이면 버린다.
+	for (int32_t axis = 0; axis < 2; axis++)
+	{
+		if (clip[0][axis] > clip[0].w && clip[1][axis] > clip[1].w && clip[2][axis] > clip[2].w)
+			return;
+		if (clip[0][axis] < -clip[0].w && clip[1][axis] < -clip[1].w && clip[2][axis] < -clip[2].w)
+			return;
+	}
+
+	float distance[3] = {clip[0].w - NEAR_CLIP_W, clip[1].w - NEAR_CLIP_W, clip[2].w - NEAR_CLIP_W};
+	if (distance[0] >= 0.0f && distance[1] >= 0.0f && distance[2] >= 0.0f)
+	{
+		emitTriangle(clip[0], clip[1], clip[2], triangles);
+		return;
+	}
+
+	// near plane (w = NEAR_CLIP_W) 으로 잘라서 남은 다각형 (최대 4각형) 을 fan 으로 나눈다.
+	glm::vec4 polygon[4];
+	uint32_t vertexCount = 0;
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		uint32_t next = (i + 1) % 3;
+		if (distance[i] >= 0.0f)
+			polygon[vertexCount++] = clip[i];
+		if ((distance[i] >= 0.0f) != (distance[next] >= 0.0f))
+			polygon[vertexCount++] = glm::mix(clip[i], clip[next], distance[i] / (distance[i] - distance[next]));
+	}
+
+	for (uint32_t i = 1; i + 1 < vertexCount; i++)
+	{
+		emitTriangle(polygon[0], polygon[i], polygon[i + 1], triangles);
+	}
+}
+
+void OcclusionCuller::emitTriangle(const glm::vec4 &v0, const glm::vec4 &v1, const glm::vec4 &v2,
+								   std::vector<ScreenTriangle> &triangles) const
+{
+	ScreenTriangle triangle;
+	const glm::vec4 *vertices[3] = {&v0, &v1, &v2};
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		float invW = 1.0f / vertices[i]->w;
+		triangle.x[i] = (vertices[i]->x * invW * 0.5f + 0.5f) * DEPTH_WIDTH;
+		triangle.y[i] = (vertices[i]->y * invW * 0.5f + 0.5f) * DEPTH_HEIGHT;
+		triangle.z[i] = invW;
+	}
+
+	// rasterize 에서 edge 함수가 안쪽에서 양수가 되도록 방향을 맞춘다.
+	float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+				 (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+	if (std::abs(area) < 1e-6f)
+		return;
+	if (area < 0.0f)
+	{
+		std::swap(triangle.x[1], triangle.x[2]);
+		std::swap(triangle.y[1], triangle.y[2]);
+		std::swap(triangle.z[1], triangle.z[2]);
+	}
+
+	float minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+	float maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+	triangle.minY = static_cast<int32_t>(std::clamp(std::floor(minY), 0.0f, static_cast<float>(DEPTH_HEIGHT)));
+	triangle.maxY = static_cast<int32_t>(std::clamp(std::ceil(maxY), 0.0f, static_cast<float>(DEPTH_HEIGHT)));
+	if (triangle.minY < triangle.maxY)
+		triangles.push_back(triangle);
+}
+
+void OcclusionCuller::rasterize()
+{
+	// 0 은 아무것도 없는 곳 (무한히 먼 곳)
+	std::vector<float> &depth = m_depthLevels[0];
+	std::fill(depth.begin(), depth.end(), 0.0f);
+
+	uint32_t bandCount = (DEPTH_HEIGHT + BAND_HEIGHT - 1) / BAND_HEIGHT;
+	JobSystem::parallelFor(bandCount, 1, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t band = begin; band < end; band++)
+		{
+			int32_t bandBegin = static_cast<int32_t>(band * BAND_HEIGHT);
+			int32_t bandEnd = static_cast<int32_t>(std::min((band + 1) * BAND_HEIGHT, DEPTH_HEIGHT));
+			for (const ScreenTriangle &triangle : m_triangles)
+			{
+				if (triangle.maxY <= bandBegin || triangle.minY >= bandEnd)
+					continue;
+				rasterizeTriangle(triangle, std::max(bandBegin, triangle.minY), std::min(bandEnd, triangle.maxY));
+			}
+		}
+	});
+}
+
+/*
+	pixel 중심에서 세 edge 함수가 모두 0 이상이면 안쪽이다. 1 / w 는 화면에서 선형이므로 평면 식으로 보간하고
+	더 가까운 값 (큰 값) 만 남긴다. SIMD 면 한 줄에서 pixel 4 개씩 처리한다.
+*/
+void OcclusionCuller::rasterizeTriangle(const ScreenTriangle &triangle, int32_t rowBegin, int32_t rowEnd)
+{
+	const float *x = triangle.x;
+	const float *y = triangle.y;
+	const float *z = triangle.z;
+
+	// edge i 는 vertex i -> i + 1, E(p) = a * px + b * py + c
+	float a[3], b[3], c[3];
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		uint32_t next = (i + 1) % 3;
+		a[i] = y[i] - y[next];
+		b[i] = x[next] - x[i];
+		c[i] = x[i] * y[next] - y[i] * x[next];
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	float dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+	float dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+	float dzc = z[0] - x[0] * dzdx - y[0] * dzdy;
+
+	// 4 pixel 단위로 맞춘다. (DEPTH_WIDTH 는 4 의 배수)
+	float minX = std::min({x[0], x[1], x[2]});
+	float maxX = std::max({x[0], x[1], x[2]});
+	int32_t beginX = static_cast<int32_t>(std::clamp(std::floor(minX), 0.0f, static_cast<float>(DEPTH_WIDTH))) & ~3;
+	int32_t endX = static_cast<int32_t>(std::clamp(std::ceil(maxX), 0.0f, static_cast<float>(DEPTH_WIDTH)));
+	if (beginX >= endX)
+		return;
+
+	float *depth = m_depthLevels[0].data();
+	for (int32_t row = rowBegin; row < rowEnd; row++)
+	{
+		float py = static_cast<float>(row) + 0.5f;
+		float *line = depth + row * DEPTH_WIDTH;
+#if AL_CULL_SIMD
+		__m128 edgeA[3], edgeRow[3];
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			edgeA[i] = _mm_set1_ps(a[i]);
+			edgeRow[i] = _mm_set1_ps(b[i] * py + c[i]);
+		}
+		__m128 depthA = _mm_set1_ps(dzdx);
+		__m128 depthRow = _mm_set1_ps(dzdy * py + dzc);
+		__m128 zero = _mm_setzero_ps();
+		__m128 step = _mm_set1_ps(4.0f);
+		__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(beginX) + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+
+		for (int32_t column = beginX; column < endX; column += 4, px = _mm_add_ps(px, step))
+		{
+			__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], px), edgeRow[0]), zero);
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], px), edgeRow[1]), zero));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], px), edgeRow[2]), zero));
+			if (_mm_movemask_ps(inside) == 0)
+				continue;
+
+			// 바깥 pixel 은 0 이 되어 max 에서 기존 값이 남는다.
+			__m128 pixelDepth = _mm_and_ps(inside, _mm_add_ps(_mm_mul_ps(depthA, px), depthRow));
+			_mm_storeu_ps(line + column, _mm_max_ps(_mm_loadu_ps(line + column), pixelDepth));
+		}
+#else
+		for (int32_t column = beginX; column < endX; column++)
+		{
+			float px = static_cast<float>(column) + 0.5f;
+			if (a[0] * px + b[0] * py + c[0] < 0.0f || a[1] * px + b[1] * py + c[1] < 0.0f ||
+				a[2] * px + b[2] * py + c[2] < 0.0f)
+				continue;
+
+			line[column] = std::max(line[column], dzdx * px + dzdy * py + dzc);
+		}
+#endif
+	}
+}
+
+void OcclusionCuller::buildDepthPyramid()
+{
+	// 위 level 의 texel 은 아래 level 2x2 중 가장 먼 값, 홀수 크기의 끝은 마지막 texel 을 한 번 더 쓴다.
+	for (size_t level = 1; level < m_depthLevels.size(); level++)
+	{
+		const std::vector<float> &source = m_depthLevels[level - 1];
+		std::vector<float> &target = m_depthLevels[level];
+		glm::uvec2 sourceSize = m_levelSizes[level - 1];
+		glm::uvec2 targetSize = m_levelSizes[level];
+
+		for (uint32_t ty = 0; ty < targetSize.y; ty++)
+		{
+			uint32_t y0 = ty * 2;
+			uint32_t y1 = std::min(y0 + 1, sourceSize.y - 1);
+			for (uint32_t tx = 0; tx < targetSize.x; tx++)
+			{
+				uint32_t x0 = tx * 2;
+				uint32_t x1 = std::min(x0 + 1, sourceSize.x - 1);
+				target[ty * targetSize.x + tx] =
+					std::min(std::min(source[y0 * sourceSize.x + x0], source[y0 * sourceSize.x + x1]),
+							 std::min(source[y1 * sourceSize.x + x0], source[y1 * sourceSize.x + x1]));
+			}
+		}
+	}
+}
+
+/*
+	entity 의 local bounding sphere 를 감싸는 box 의 8 점을 화면에 투영해서, 덮는 pixel 범위와 가장 가까운 1 / w 를
+	구한다. 그 범위를 몇 texel 로 덮는 pyramid level 에서 가장 먼 occluder depth 보다도 멀면 가려진 것이다.
+*/
+bool OcclusionCuller::isOccluded(const glm::mat4 &transform, const CullSphere &sphere) const
+{
+	glm::mat4 mvp = m_viewProjection * transform;
+	glm::vec2 minScreen(FLT_MAX);
+	glm::vec2 maxScreen(-FLT_MAX);
+	float nearest = 0.0f;
+	for (uint32_t c = 0; c < 8; c++)
+	{
+		glm::vec3 offset((c & 1) ? sphere.radius : -sphere.radius, (c & 2) ? sphere.radius : -sphere.radius,
+						 (c & 4) ? sphere.radius : -sphere.radius);
+		glm::vec4 clip = mvp * glm::vec4(sphere.center + offset, 1.0f);
+		// camera 앞뒤에 걸쳐 있으면 범위를 알 수 없으므로 보이는 것으로 둔다.
+		if (clip.w <= NEAR_CLIP_W)
+			return false;
+
+		float invW = 1.0f / clip.w;
+		glm::vec2 screen((clip.x * invW * 0.5f + 0.5f) * DEPTH_WIDTH, (clip.y * invW * 0.5f + 0.5f) * DEPTH_HEIGHT);
+		minScreen = glm::min(minScreen, screen);
+		maxScreen = glm::max(maxScreen, screen);
+		nearest = std::max(nearest, invW);
+	}
+
+	int32_t x0 = std::max(static_cast<int32_t>(std::floor(minScreen.x)), 0);
+	int32_t y0 = std::max(static_cast<int32_t>(std::floor(minScreen.y)), 0);
+	int32_t x1 = std::min(static_cast<int32_t>(std::floor(maxScreen.x)), static_cast<int32_t>(DEPTH_WIDTH) - 1);
+	int32_t y1 = std::min(static_cast<int32_t>(std::floor(maxScreen.y)), static_cast<int32_t>(DEPTH_HEIGHT) - 1);
+	if (x0 > x1 || y0 > y1)
+		return false;
+
+	uint32_t level = 0;
+	while (level + 1 < m_depthLevels.size() &&
+		   ((x1 >> level) - (x0 >> level) >= static_cast<int32_t>(MAX_TEST_TEXELS) ||
+			(y1 >> level) - (y0 >> level) >= static_cast<int32_t>(MAX_TEST_TEXELS)))
+	{
+		level++;
+	}
+
+	const std::vector<float> &depth = m_depthLevels[level];
+	uint32_t width = m_levelSizes[level].x;
+	float farthest = FLT_MAX;
+	for (int32_t ty = y0 >> level; ty <= (y1 >> level); ty++)
+	{
+		for (int32_t tx = x0 >> level; tx <= (x1 >> level); tx++)
+		{
+			farthest = std::min(farthest, depth[ty * width + tx]);
+		}
+	}
+
+	return nearest < farthest * OCCLUSION_BIAS;
+}
+
+} // namespace ale
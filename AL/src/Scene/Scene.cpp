@@ -2,9 +2,11 @@
 #include "Scene/Component.h"
 #include "Scene/CullTree.h"
 #include "Scene/Entity.h"
+#include "Scene/OcclusionCuller.h"
 #include "Scene/ScriptableEntity.h"
 
 #include "Core/App.h"
+#include "Core/JobSystem.h"
 
 #include "Renderer/RenderingComponent.h"
 
@@ -93,6 +95,15 @@ std::shared_ptr<Scene> Scene::copyScene(std::shared_ptr<Scene> scene)
 	{
 		auto &mesh = dstRegistry.get<MeshRendererComponent>(entityHandle);
 		newScene->m_cullTree.changeEntityHandle(mesh.nodeId, static_cast<uint32_t>(entityHandle));
+
+		// 원본 scene 의 moved 목록은 복사되지 않으므로 새 scene 에서 다시 등록
+		auto &transform = dstRegistry.get<TransformComponent>(entityHandle);
+		transform.m_isMoved = false;
+		if (mesh.nodeId != NULL_NODE)
+		{
+			transform.m_isMoved = true;
+			newScene->m_MovedEntities.push_back(entityHandle);
+		}
 	}
 	newScene->initScene();
 	return newScene;
@@ -200,6 +211,7 @@ void Scene::onRuntimeStart()
 	m_IsRunning = true;
 
 	onPhysicsStart();
+	initRuntimeSystems();
 
 	{
 		ScriptingEngine::onRuntimeStart(this);
@@ -253,6 +265,7 @@ void Scene::onRuntimeStop()
 	m_IsRunning = false;
 
 	onPhysicsStop();
+	m_RuntimeSystems.clear();
 
 	ScriptingEngine::onRuntimeStop();
 
@@ -271,126 +284,216 @@ void Scene::onRuntimeStop()
 void Scene::onUpdateEditor(EditorCamera &camera)
 {
 	setCamPos(camera.getPosition());
+	m_TransformSystem.update();
 	findMoveObject();
 	renderScene(camera);
 }
 
 void Scene::onUpdateRuntime(Timestep ts)
 {
-	if (!m_IsPaused /*&& m_StepFrames-- > 0*/)
+	m_RuntimeTimestep = ts;
+	m_MainCamera = nullptr;
+
+	// scripts -> (physics | animations) -> camera -> cull 준비 순서로 의존 관계에 따라 실행
+	m_RuntimeSystems.execute();
+
+	if (m_MainCamera)
 	{
-		// update scripts
-		{
-			// Script
-			auto view = m_Registry.view<ScriptComponent>();
-			for (auto e : view)
-			{
-				Entity entity = {e, this};
-				ScriptingEngine::onUpdateEntity(entity, ts);
-			}
+		Renderer &renderer = App::get().getRenderer();
+		renderer.beginScene(this, *m_MainCamera);
+	}
+	else
+	{
+		// AL_CORE_ERROR("No Camera!");
+		Renderer &renderer = App::get().getRenderer();
+		renderer.biginNoCamScene();
+	}
 
-			// Native Script
-			m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto &nsc) {
-				if (!nsc.instance)
-				{
-					nsc.instance = nsc.instantiateScript();
-					nsc.instance->m_Entity = Entity{entity, this};
-					nsc.instance->onCreate();
-				}
-				nsc.instance->onUpdate(ts);
-			});
-		}
-		// update Physics
-		{
-			m_World->startFrame();
-			// Run physics
-			m_World->runPhysics(ts);
-			// set transforms of entity by body
-			auto view = m_Registry.view<RigidbodyComponent>();
-			for (auto e : view)
-			{
-				Entity entity = {e, this};
-				auto &tf = entity.getComponent<TransformComponent>();
-				auto &rb = entity.getComponent<RigidbodyComponent>();
-				auto &mr = entity.getComponent<MeshRendererComponent>();
+	// imguilayer::renderDrawData
+}
 
-				Rigidbody *body = (Rigidbody *)rb.body;
+void Scene::initRuntimeSystems()
+{
+	m_RuntimeSystems.clear();
+
+	// script 는 어떤 component 든 접근할 수 있으므로 전부 write 로 선언하고, Mono 때문에 main thread 에서 실행
+	m_RuntimeSystems
+		.addSystem("Scripts",
+				   [this]() {
+					   if (!m_IsPaused)
+						   updateScripts(m_RuntimeTimestep);
+				   })
+		.write<ScriptComponent, NativeScriptComponent, TransformComponent, RigidbodyComponent,
+			   SkeletalAnimatorComponent, CameraComponent, LightComponent, MeshRendererComponent>()
+		.mainThread();
+
+	m_RuntimeSystems
+		.addSystem("Physics",
+				   [this]() {
+					   if (!m_IsPaused)
+						   updatePhysics(m_RuntimeTimestep);
+				   })
+		.write<RigidbodyComponent, TransformComponent>();
+
+	m_RuntimeSystems
+		.addSystem("Animation",
+				   [this]() {
+					   if (!m_IsPaused)
+						   updateAnimations(m_RuntimeTimestep, true);
+				   })
+		.read<ScriptComponent>()
+		.write<SkeletalAnimatorComponent>();
+
+	m_RuntimeSystems.addSystem("Transform", [this]() { m_TransformSystem.update(); })
+		.read<RelationshipComponent>()
+		.write<TransformComponent>();
+
+	m_RuntimeSystems.addSystem("Camera", [this]() { m_MainCamera = findMainCamera(); })
+		.read<TransformComponent>()
+		.write<CameraComponent>();
+
+	m_RuntimeSystems.addSystem("CullPrepare", [this]() { findMoveObject(); })
+		.read<MeshRendererComponent>()
+		.write<TransformComponent>();
+
+	m_RuntimeSystems.compile();
+}
 
-				tf.m_Position = body->getTransform().position;
-				tf.m_Rotation = glm::eulerAngles(body->getTransform().orientation);
-				tf.m_WorldTransform = tf.getTransform();
-			}
-		}
+void Scene::updateScripts(Timestep ts)
+{
+	// Script
+	auto view = m_Registry.view<ScriptComponent>();
+	for (auto e : view)
+	{
+		Entity entity = {e, this};
+		ScriptingEngine::onUpdateEntity(entity, ts);
+	}
 
-		// update animations
+	// Native Script
+	m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto &nsc) {
+		if (!nsc.instance)
 		{
-			auto view = m_Registry.view<SkeletalAnimatorComponent>();
-			
-			for (auto e : view)
-			{
-				Entity entity = {e, this};
-				auto& sa = entity.getComponent<SkeletalAnimatorComponent>();
-
-				SAComponent* sac = sa.sac.get();
-				if (sa.m_IsPlaying)
-					sac->updateAnimation(ts * sa.m_SpeedFactor, 0);
-				else if (sa.m_IsTimelineDrag)
-					sac->updateAnimationWithoutTransition(ts * sa.m_SpeedFactor); // 배속이 필요하지 않음
-			}
+			nsc.instance = nsc.instantiateScript();
+			nsc.instance->m_Entity = Entity{entity, this};
+			nsc.instance->onCreate();
 		}
-	}
+		nsc.instance->onUpdate(ts);
+	});
+}
 
-	// find main camera
-	Camera *mainCamera = nullptr;
+void Scene::updatePhysics(Timestep ts)
+{
+	m_World->startFrame();
+	// Run physics
+	m_World->runPhysics(ts);
+	// set transforms of entity by body
+	// world transform 은 TransformSystem 에서 계층을 따라 다시 계산
+	auto view = m_Registry.view<RigidbodyComponent>();
+	for (auto e : view)
 	{
-		auto view = m_Registry.view<TransformComponent, CameraComponent>();
-		for (auto entity : view)
-		{
-			auto camera = view.get<CameraComponent>(entity);
+		Entity entity = {e, this};
+		auto &tf = entity.getComponent<TransformComponent>();
+		auto &rb = entity.getComponent<RigidbodyComponent>();
+		auto &relation = entity.getComponent<RelationshipComponent>();
 
-			if (camera.m_Primary)
-			{
-				auto &tc = view.get<TransformComponent>(entity);
-				camera.m_Camera.updateSceneCamera(tc.m_Position, tc.m_Rotation);
-				mainCamera = &camera.m_Camera;
-				break;
-			}
+		Rigidbody *body = (Rigidbody *)rb.body;
+
+		if (relation.parent != entt::null)
+		{
+			// body 는 world 기준이므로 부모 기준 local 값으로 변환
+			glm::mat4 world = glm::translate(glm::mat4(1.0f), body->getTransform().position) *
+							  glm::toMat4(body->getTransform().orientation) *
+							  glm::scale(glm::mat4(1.0f), tf.m_Scale);
+			glm::mat4 parentWorld = m_Registry.get<TransformComponent>(relation.parent).m_WorldTransform;
+			TransformSystem::setWorldTransform(tf, parentWorld, world);
+		}
+		else
+		{
+			tf.m_Position = body->getTransform().position;
+			tf.m_Rotation = glm::eulerAngles(body->getTransform().orientation);
+			tf.m_isDirty = true;
 		}
 	}
+}
 
-	if (mainCamera)
-	{
-		Renderer &renderer = App::get().getRenderer();
-		setCamPos(mainCamera->getPosition());
-		findMoveObject();
-		renderer.beginScene(this, *mainCamera);
-	}
-	else
+Camera *Scene::findMainCamera()
+{
+	auto view = m_Registry.view<TransformComponent, CameraComponent>();
+	for (auto entity : view)
 	{
-		// AL_CORE_ERROR("No Camera!");
-		Renderer &renderer = App::get().getRenderer();
-		renderer.biginNoCamScene();
-	}
+		auto &camera = view.get<CameraComponent>(entity);
 
-	// imguilayer::renderDrawData
+		if (camera.m_Primary)
+		{
+			auto &tc = view.get<TransformComponent>(entity);
+			camera.m_Camera.updateSceneCamera(tc.m_Position, tc.m_Rotation);
+			setCamPos(camera.m_Camera.getPosition());
+			return &camera.m_Camera;
+		}
+	}
+	return nullptr;
 }
 
 void Scene::preRenderEditor(const Timestep& ts)
 {
-		// update animations
+	// update animations
+	updateAnimations(ts, false);
+}
+
+void Scene::updateAnimations(Timestep ts, bool isRuntime)
+{
+	// 같은 Model 을 쓰는 entity 들은 skeleton / animation 데이터를 공유하므로 하나의 job 에서 순서대로 갱신한다.
+	struct AnimationGroup
 	{
-		auto view = m_Registry.view<SkeletalAnimatorComponent>();
-		
-		for (auto e : view)
-		{
-			Entity entity = {e, this};
-			auto& sa = entity.getComponent<SkeletalAnimatorComponent>();
+		std::vector<entt::entity> entities;
+		bool mainThread = false;
+	};
 
-			SAComponent* sac = sa.sac.get();
-			if (sa.m_IsPlaying || sa.m_IsTimelineDrag)
+	std::unordered_map<SkeletalAnimations *, AnimationGroup> groups;
+	auto view = m_Registry.view<SkeletalAnimatorComponent>();
+	for (auto e : view)
+	{
+		auto &sa = view.get<SkeletalAnimatorComponent>(e);
+		if (!sa.sac || !(sa.m_IsPlaying || sa.m_IsTimelineDrag))
+			continue;
+
+		auto &group = groups[sa.sac->getAnimations().get()];
+		group.entities.push_back(e);
+		// runtime 의 transition 조건은 Mono 메서드이므로 script 가 붙은 entity 는 main thread 에서 갱신
+		if (isRuntime && sa.m_IsPlaying && m_Registry.all_of<ScriptComponent>(e))
+			group.mainThread = true;
+	}
+
+	auto updateGroup = [this, ts, isRuntime](const AnimationGroup &group) {
+		for (auto e : group.entities)
+		{
+			auto &sa = m_Registry.get<SkeletalAnimatorComponent>(e);
+			SAComponent *sac = sa.sac.get();
+			if (isRuntime && sa.m_IsPlaying)
+				sac->updateAnimation(ts * sa.m_SpeedFactor, 0);
+			else
 				sac->updateAnimationWithoutTransition(ts * sa.m_SpeedFactor);
 		}
+	};
+
+	JobCounter counter;
+	for (auto &[animations, group] : groups)
+	{
+		if (!group.mainThread)
+			JobSystem::execute([&updateGroup, &group]() { updateGroup(group); }, &counter);
+	}
+	// runtime system graph 에서는 worker 에서 호출될 수 있으므로 main thread 로 넘겨서 실행
+	for (auto &[animations, group] : groups)
+	{
+		if (!group.mainThread)
+			continue;
+
+		if (JobSystem::isMainThread() || !JobSystem::isInitialized())
+			updateGroup(group);
+		else
+			JobSystem::executeOnMainThread([&updateGroup, &group]() { updateGroup(group); }, &counter);
 	}
+	JobSystem::wait(counter);
 }
 
 void Scene::onViewportResize(uint32_t width, uint32_t height)
@@ -416,6 +519,7 @@ Entity Scene::duplicateEntity(Entity entity)
 	std::string name = entity.getComponent<TagComponent>().m_Tag;
 	Entity newEntity = createEntity(name);
 	copyComponentIfExists(AllComponents{}, newEntity, entity);
+	newEntity.getComponent<TransformComponent>().m_isMoved = false;
 	return newEntity;
 }
 
@@ -446,6 +550,7 @@ void Scene::initScene()
 	m_cylinderModel = Model::createCylinderModel(m_defaultMaterial);
 
 	m_cullTree.setScene(this);
+	m_TransformSystem.setScene(this);
 }
 
 void Scene::renderScene(EditorCamera &camera)
@@ -675,6 +780,14 @@ void Scene::insertEntityInCullTree(Entity &entity)
 
 		mc.nodeId = m_cullTree.createNode(sphere, static_cast<uint32_t>(entity));
 		mc.cullState = ECullState::CULL;
+		mc.lastVisibleFrame = 0;
+
+		// 부모 계층이 반영된 world transform 으로 다음 culling 전에 다시 맞춤
+		if (!tc.m_isMoved)
+		{
+			tc.m_isMoved = true;
+			m_MovedEntities.push_back(entity);
+		}
 	}
 }
 
@@ -696,43 +809,85 @@ void Scene::removeEntityInCullTree(Entity &entity)
 	}
 }
 
-void Scene::frustumCulling(const Frustum &frustum)
+void Scene::frustumCulling(const Frustum &frustum, OcclusionCuller *occlusionCuller)
 {
-	m_cullTree.updateTree();
+	m_cullTree.updateTree(m_MovedEntities);
 
-	int32_t root = m_cullTree.getRootNodeId();
-	if (root != NULL_NODE)
-	{
-		m_cullTree.frustumCulling(frustum, root);
-	}
+	m_PrevVisibleEntities.swap(m_VisibleEntities);
+	m_cullTree.frustumCulling(frustum, m_VisibleEntities);
+	if (occlusionCuller)
+		occlusionCuller->cull(*this, m_VisibleEntities);
+	updateVisibleSet();
+}
+
+void Scene::collectCullCandidates(std::vector<CullSphere> &spheres)
+{
+	m_cullTree.updateTree(m_MovedEntities);
+
+	// 실제 검사는 GPU 에서 하므로 CPU 쪽 visible set 은 후보 전체가 된다.
+	m_PrevVisibleEntities.swap(m_VisibleEntities);
+	m_cullTree.collectLeaves(m_VisibleEntities, spheres);
+	updateVisibleSet();
+}
+
+void Scene::shadowCasterCulling(const Frustum &frustum, std::vector<entt::entity> &casters)
+{
+	// tree 는 camera culling 에서 이미 갱신했으므로 검사만 한다.
+	m_cullTree.frustumCulling(frustum, casters);
 }
 
-void Scene::initFrustumDrawFlag()
+void Scene::updateVisibleSet()
 {
-	int32_t root = m_cullTree.getRootNodeId();
-	if (root != NULL_NODE)
+	// 이전 frame 의 visible set 과 비교해서 바뀐 entity 의 cullState 만 갱신
+	m_CullFrame++;
+	m_EnteredEntities.clear();
+	m_ExitedEntities.clear();
+
+	for (auto e : m_VisibleEntities)
 	{
-		m_cullTree.setRenderDisable(root);
+		auto &mesh = m_Registry.get<MeshRendererComponent>(e);
+		if (mesh.lastVisibleFrame != m_CullFrame - 1)
+		{
+			mesh.cullState = (mesh.cullState | ECullState::RENDER);
+			m_EnteredEntities.push_back(e);
+		}
+		mesh.lastVisibleFrame = m_CullFrame;
+	}
+
+	for (auto e : m_PrevVisibleEntities)
+	{
+		auto *mesh = m_Registry.valid(e) ? m_Registry.try_get<MeshRendererComponent>(e) : nullptr;
+		if (mesh && mesh->lastVisibleFrame != m_CullFrame)
+		{
+			mesh->cullState = (mesh->cullState & ECullState::NONE);
+			m_ExitedEntities.push_back(e);
+		}
 	}
 }
 
 void Scene::findMoveObject()
 {
-	auto view = m_Registry.view<MeshRendererComponent, TransformComponent>();
-	for (auto e : view)
+	// TransformSystem 이 이번 frame 에 world transform 을 다시 계산한 entity 만 검사
+	for (auto e : m_TransformSystem.getChangedEntities())
 	{
-		auto &transform = view.get<TransformComponent>(e);
-		auto &mesh = view.get<MeshRendererComponent>(e);
-		if (mesh.m_RenderingComponent == nullptr)
+		auto *mesh = m_Registry.try_get<MeshRendererComponent>(e);
+		if (mesh == nullptr || mesh->m_RenderingComponent == nullptr)
 			continue;
 
-		float limit = transform.getMaxScale() * mesh.cullSphere.radius * 0.1f;
+		auto &transform = m_Registry.get<TransformComponent>(e);
+		float limit = transform.getMaxScale() * mesh->cullSphere.radius * 0.1f;
 		limit = limit * limit;
 
-		if (glm::length2(transform.m_Position - transform.m_LastPosition) > limit)
+		// 부모를 따라 움직인 경우도 감지하도록 world 위치로 비교
+		glm::vec3 worldPosition = glm::vec3(transform.m_WorldTransform[3]);
+		if (glm::length2(worldPosition - transform.m_LastPosition) > limit)
 		{
-			transform.m_LastPosition = transform.m_Position;
-			transform.m_isMoved = true;
+			transform.m_LastPosition = worldPosition;
+			if (!transform.m_isMoved)
+			{
+				transform.m_isMoved = true;
+				m_MovedEntities.push_back(e);
+			}
 		}
 	}
 }
@@ -812,7 +967,7 @@ template <> void Scene::onComponentAdded<LightComponent>(Entity entity, LightCom
 
 	component.m_Light = std::make_shared<Light>(Light{tc.m_Position, glm::vec3(0.0f, -1.0f, 0.0f),
 													  glm::vec3(1.0f, 1.0f, 1.0f), 1.0f, glm::cos(glm::radians(12.5f)),
-													  glm::cos(glm::radians(17.5f)), 1, 1, 0, glm::vec2(0.0f, 0.0f)});
+													  glm::cos(glm::radians(17.5f)), 1, 1, 0, 0.0f, 0.0f});
 }
 
 template <> void Scene::onComponentAdded<RigidbodyComponent>(Entity entity, RigidbodyComponent &component)
@@ -1,5 +1,5 @@
 #include "Scene/SceneCamera.h"
-#include "Alpch.h"
+#include "alpch.h"
 
 namespace ale
 {
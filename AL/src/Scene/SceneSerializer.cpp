@@ -295,6 +295,7 @@ static void serializeEntity(YAML::Emitter &out, Entity entity, Scene *scene)
 		}
 		out << YAML::Key << "MatPath" << YAML::Value << mc.matPath;
 		out << YAML::Key << "IsMatChanged" << YAML::Value << mc.isMatChanged;
+		out << YAML::Key << "Occluder" << YAML::Value << mc.occluder;
 
 		out << YAML::EndMap;
 	}
@@ -536,7 +537,7 @@ bool SceneSerializer::deserialize(const std::string &filepath)
 				tf.m_Position = tfComponent["Position"].as<glm::vec3>();
 				tf.m_Rotation = tfComponent["Rotation"].as<glm::vec3>();
 				tf.m_Scale = tfComponent["Scale"].as<glm::vec3>();
-				tf.m_WorldTransform = tf.getTransform();
+				tf.m_isDirty = true;
 			}
 
 			// RelationshipComponent
@@ -584,6 +585,9 @@ bool SceneSerializer::deserialize(const std::string &filepath)
 				// type에 따라 Primitive Mesh 생성
 				mc.type = meshComponent["MeshType"].as<uint32_t>();
 				mc.isMatChanged = meshComponent["IsMatChanged"].as<bool>();
+				// 이전에 저장한 scene 에는 없다.
+				if (meshComponent["Occluder"])
+					mc.occluder = meshComponent["Occluder"].as<bool>();
 				std::shared_ptr<Model> model;
 				switch (mc.type)
 				{
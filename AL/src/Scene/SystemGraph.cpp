@@ -0,0 +1,135 @@
+#include "Scene/SystemGraph.h"
+#include "alpch.h"
+
+#include "Core/JobSystem.h"
+
+namespace ale
+{
+SystemNode &SystemGraph::addSystem(const std::string &name, SystemFunction function)
+{
+	SystemNode node;
+	node.m_Name = name;
+	node.m_Function = std::move(function);
+	m_Nodes.push_back(std::move(node));
+	m_Compiled = false;
+	return m_Nodes.back();
+}
+
+void SystemGraph::compile()
+{
+	uint32_t nodeCount = static_cast<uint32_t>(m_Nodes.size());
+
+	m_Dependents.assign(nodeCount, {});
+	m_DependencyCounts.assign(nodeCount, 0);
+	m_PendingCounts = std::vector<std::atomic<uint32_t>>(nodeCount);
+	m_Timings.resize(nodeCount);
+
+	// 앞서 등록된 system 과 component 접근이 충돌하면 의존 관계를 만든다.
+	for (uint32_t after = 0; after < nodeCount; after++)
+	{
+		m_Timings[after].m_Name = m_Nodes[after].m_Name;
+		for (uint32_t before = 0; before < after; before++)
+		{
+			if (hasConflict(m_Nodes[before], m_Nodes[after]))
+			{
+				m_Dependents[before].push_back(after);
+				m_DependencyCounts[after]++;
+			}
+		}
+	}
+
+	m_Compiled = true;
+}
+
+void SystemGraph::execute()
+{
+	if (!m_Compiled)
+		compile();
+
+	uint32_t nodeCount = static_cast<uint32_t>(m_Nodes.size());
+	for (uint32_t i = 0; i < nodeCount; i++)
+	{
+		m_PendingCounts[i].store(m_DependencyCounts[i], std::memory_order_relaxed);
+	}
+
+	JobCounter counter;
+	m_Counter = &counter;
+	m_FrameStart = std::chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < nodeCount; i++)
+	{
+		if (m_DependencyCounts[i] == 0)
+			scheduleNode(i);
+	}
+	JobSystem::wait(counter);
+
+	m_Counter = nullptr;
+	m_TotalMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_FrameStart).count();
+}
+
+void SystemGraph::clear()
+{
+	m_Nodes.clear();
+	m_Dependents.clear();
+	m_DependencyCounts.clear();
+	m_PendingCounts.clear();
+	m_Timings.clear();
+	m_TotalMs = 0.0f;
+	m_Compiled = false;
+}
+
+void SystemGraph::scheduleNode(uint32_t index)
+{
+	auto job = [this, index]() { runNode(index); };
+
+	if (m_Nodes[index].m_MainThread)
+		JobSystem::executeOnMainThread(job, m_Counter);
+	else
+		JobSystem::execute(job, m_Counter);
+}
+
+void SystemGraph::runNode(uint32_t index)
+{
+	SystemNode &node = m_Nodes[index];
+	auto start = std::chrono::steady_clock::now();
+	{
+#if AL_PROFILE
+		InstrumentationTimer timer(node.m_Name.c_str());
+#endif
+		node.m_Function();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	SystemTiming &timing = m_Timings[index];
+	timing.m_StartMs = std::chrono::duration<float, std::milli>(start - m_FrameStart).count();
+	timing.m_DurationMs = std::chrono::duration<float, std::milli>(end - start).count();
+	timing.m_ThreadIndex = JobSystem::getThreadIndex();
+
+	// 이 job 이 끝나기 전에 후속 system 을 스케줄링하므로 counter 가 중간에 0 이 되지 않는다.
+	for (uint32_t dependent : m_Dependents[index])
+	{
+		if (m_PendingCounts[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			scheduleNode(dependent);
+	}
+}
+
+bool SystemGraph::hasConflict(const SystemNode &before, const SystemNode &after) const
+{
+	auto contains = [](const std::vector<entt::id_type> &ids, entt::id_type id) {
+		return std::find(ids.begin(), ids.end(), id) != ids.end();
+	};
+
+	for (entt::id_type id : before.m_Writes)
+	{
+		if (contains(after.m_Writes, id) || contains(after.m_Reads, id))
+			return true;
+	}
+	for (entt::id_type id : before.m_Reads)
+	{
+		if (contains(after.m_Writes, id))
+			return true;
+	}
+	return false;
+}
+
+} // namespace ale
@@ -0,0 +1,147 @@
+#include "Scene/TransformSystem.h"
+#include "alpch.h"
+
+#include "Core/JobSystem.h"
+#include "Scene/Component.h"
+#include "Scene/Scene.h"
+
+#include <glm/gtx/matrix_decompose.hpp>
+
+namespace ale
+{
+void TransformSystem::setScene(Scene *scene)
+{
+	if (m_Scene)
+	{
+		m_Scene->m_Registry.on_construct<RelationshipComponent>().disconnect(this);
+		m_Scene->m_Registry.on_update<RelationshipComponent>().disconnect(this);
+		m_Scene->m_Registry.on_destroy<RelationshipComponent>().disconnect(this);
+	}
+
+	m_Scene = scene;
+
+	// entity 생성 / 삭제 / component 교체 시 평탄화된 순서를 다시 만든다.
+	auto &registry = m_Scene->m_Registry;
+	registry.on_construct<RelationshipComponent>().connect<&TransformSystem::onRelationshipChanged>(*this);
+	registry.on_update<RelationshipComponent>().connect<&TransformSystem::onRelationshipChanged>(*this);
+	registry.on_destroy<RelationshipComponent>().connect<&TransformSystem::onRelationshipChanged>(*this);
+
+	m_HierarchyChanged = true;
+}
+
+void TransformSystem::update()
+{
+	if (m_HierarchyChanged)
+		rebuildOrder();
+
+	auto &registry = m_Scene->m_Registry;
+	uint32_t subtreeCount = static_cast<uint32_t>(m_SubtreeOffsets.size()) - 1;
+	uint32_t grainSize = 64;
+	uint32_t batchCount = (subtreeCount + grainSize - 1) / grainSize;
+	std::vector<std::vector<entt::entity>> changedBatches(batchCount);
+	bool forceUpdate = m_ForceUpdate;
+
+	m_Changed.assign(m_Order.size(), 0);
+
+	// subtree 안에서는 부모가 먼저 오므로 순서대로 처리하고, 서로 다른 root subtree 는 병렬로 처리
+	JobSystem::parallelFor(subtreeCount, grainSize, [&](uint32_t begin, uint32_t end) {
+		std::vector<entt::entity> &changed = changedBatches[begin / grainSize];
+		for (uint32_t subtree = begin; subtree < end; subtree++)
+		{
+			for (uint32_t i = m_SubtreeOffsets[subtree]; i < m_SubtreeOffsets[subtree + 1]; i++)
+			{
+				auto &transform = registry.get<TransformComponent>(m_Order[i]);
+				int32_t parent = m_ParentIndex[i];
+
+				if (!forceUpdate && !transform.m_isDirty && (parent < 0 || !m_Changed[parent]))
+					continue;
+
+				if (parent < 0)
+					transform.m_WorldTransform = transform.getTransform();
+				else
+					transform.m_WorldTransform =
+						registry.get<TransformComponent>(m_Order[parent]).m_WorldTransform * transform.getTransform();
+
+				transform.m_isDirty = false;
+				m_Changed[i] = 1;
+				changed.push_back(m_Order[i]);
+			}
+		}
+	});
+
+	m_ChangedEntities.clear();
+	for (const auto &changed : changedBatches)
+	{
+		m_ChangedEntities.insert(m_ChangedEntities.end(), changed.begin(), changed.end());
+	}
+	m_ForceUpdate = false;
+}
+
+void TransformSystem::setWorldTransform(TransformComponent &transform, const glm::mat4 &parentWorld,
+										const glm::mat4 &world)
+{
+	glm::mat4 local = glm::inverse(parentWorld) * world;
+
+	glm::vec3 scale;
+	glm::quat orientation;
+	glm::vec3 translation;
+	glm::vec3 skew;
+	glm::vec4 perspective;
+	if (!glm::decompose(local, scale, orientation, translation, skew, perspective))
+		return;
+
+	transform.m_Position = translation;
+	transform.m_Rotation = glm::eulerAngles(orientation);
+	transform.m_Scale = scale;
+	transform.m_isDirty = true;
+}
+
+void TransformSystem::rebuildOrder()
+{
+	auto &registry = m_Scene->m_Registry;
+
+	m_Order.clear();
+	m_ParentIndex.clear();
+	m_SubtreeOffsets.clear();
+
+	auto view = registry.view<TransformComponent>();
+	for (auto entity : view)
+	{
+		auto *relation = registry.try_get<RelationshipComponent>(entity);
+		if (relation && relation->parent != entt::null && registry.valid(relation->parent))
+			continue;
+
+		// root 부터 BFS 로 내려가며 깊이 순서대로 추가
+		m_SubtreeOffsets.push_back(static_cast<uint32_t>(m_Order.size()));
+		m_Order.push_back(entity);
+		m_ParentIndex.push_back(-1);
+
+		for (size_t i = m_SubtreeOffsets.back(); i < m_Order.size(); i++)
+		{
+			auto *nodeRelation = registry.try_get<RelationshipComponent>(m_Order[i]);
+			if (!nodeRelation)
+				continue;
+
+			for (auto child : nodeRelation->children)
+			{
+				if (!registry.valid(child) || !registry.all_of<TransformComponent>(child))
+					continue;
+
+				m_Order.push_back(child);
+				m_ParentIndex.push_back(static_cast<int32_t>(i));
+			}
+		}
+	}
+	m_SubtreeOffsets.push_back(static_cast<uint32_t>(m_Order.size()));
+
+	m_HierarchyChanged = false;
+	// 부모가 바뀌면 world transform 도 바뀌므로 한 번은 전부 다시 계산
+	m_ForceUpdate = true;
+}
+
+void TransformSystem::onRelationshipChanged(entt::registry &registry, entt::entity entity)
+{
+	m_HierarchyChanged = true;
+}
+
+} // namespace ale
@@ -129,7 +129,7 @@ static void TransformComponent_setPosition(UUID entityID, glm::vec3 *position)
 
 	auto &tc = entity.getComponent<TransformComponent>();
 	tc.m_Position = *position;
-	tc.m_WorldTransform = tc.getTransform();
+	tc.m_isDirty = true;
 }
 
 static void TransformComponent_getRotation(UUID entityID, glm::vec3 *outRotation)
@@ -147,7 +147,7 @@ static void TransformComponent_setRotation(UUID entityID, glm::vec3 *outRotation
 
 	auto &tc = entity.getComponent<TransformComponent>();
 	tc.m_Rotation = *outRotation;
-	tc.m_WorldTransform = tc.getTransform();
+	tc.m_isDirty = true;
 }
 
 // Input
@@ -177,7 +177,11 @@ void ScriptingEngine::shutDown()
 
 void ScriptingEngine::initMono()
 {
+	// Windows 는 같이 들고 있는 class library 를 쓰고, 그 밖에서는 링크한 system mono 의 것을 그대로 쓴다.
+	// (runtime 과 mscorlib 의 버전이 다르면 mono_jit_init 이 실패한다)
+#ifdef _WIN32
 	mono_set_assemblies_path("Sandbox/mono/lib");
+#endif
 
 	if (s_Data->enableDebugging)
 	{
@@ -0,0 +1,304 @@
+#include "BenchmarkLayer.h"
+#include "Scene/SceneSerializer.h"
+#include "Scripting/ScriptingEngine.h"
+
+#include "Project/Project.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <glm/gtc/constants.hpp>
+
+namespace ale
+{
+bool BenchmarkOptions::isBenchmark(const ApplicationCommandLineArgs &args)
+{
+	return args.count >= 2 && std::string(args[1]) == "--benchmark";
+}
+
+bool BenchmarkOptions::parse(const ApplicationCommandLineArgs &args, BenchmarkOptions &options)
+{
+	if (!isBenchmark(args) || args.count < 3)
+	{
+		AL_ERROR("Benchmark: usage: --benchmark <project.alproj> [options]");
+		return false;
+	}
+	options.m_ProjectPath = args[2];
+
+	for (int i = 3; i < args.count; i++)
+	{
+		std::string arg = args[i];
+		bool hasValue = i + 1 < args.count;
+		if (arg == "--gpu-culling")
+		{
+			options.m_GpuCulling = true;
+		}
+		else if (!hasValue)
+		{
+			AL_ERROR("Benchmark: missing value for {0}", arg);
+			return false;
+		}
+		else if (arg == "--scene")
+		{
+			options.m_ScenePath = args[++i];
+		}
+		else if (arg == "--frames")
+		{
+			options.m_Frames = std::max(1, std::atoi(args[++i]));
+		}
+		else if (arg == "--warmup")
+		{
+			options.m_WarmupFrames = std::max(0, std::atoi(args[++i]));
+		}
+		else if (arg == "--size")
+		{
+			uint32_t width = 0, height = 0;
+			if (std::sscanf(args[++i], "%ux%u", &width, &height) != 2 || width == 0 || height == 0)
+			{
+				AL_ERROR("Benchmark: invalid size {0} (expected WxH)", args[i]);
+				return false;
+			}
+			options.m_Width = width;
+			options.m_Height = height;
+		}
+		else if (arg == "--capture-dir")
+		{
+			options.m_CaptureDirectory = args[++i];
+		}
+		else if (arg == "--capture-every")
+		{
+			options.m_CaptureEvery = std::max(1, std::atoi(args[++i]));
+		}
+		else if (arg == "--report")
+		{
+			options.m_ReportPath = args[++i];
+		}
+		else
+		{
+			AL_ERROR("Benchmark: unknown option {0}", arg);
+			return false;
+		}
+	}
+	return true;
+}
+
+BenchmarkLayer::BenchmarkLayer(const BenchmarkOptions &options) : Layer("BenchmarkLayer"), m_Options(options)
+{
+	float aspect = static_cast<float>(options.m_Width) / static_cast<float>(options.m_Height);
+	m_Camera = EditorCamera(glm::radians(45.0f), aspect, 0.1f, 1000.0f);
+}
+
+void BenchmarkLayer::onAttach()
+{
+	if (!loadScene())
+	{
+		App::get().close();
+		return;
+	}
+
+	Renderer &renderer = App::get().getRenderer();
+	if (m_Options.m_GpuCulling)
+	{
+		if (renderer.isGpuCullingSupported())
+		{
+			renderer.setCullingMode(ECullingMode::GPU);
+		}
+		else
+		{
+			AL_WARN("Benchmark: GPU culling is not supported on this device, using CPU culling");
+		}
+	}
+
+	if (!m_Options.m_CaptureDirectory.empty())
+	{
+		std::filesystem::create_directories(m_Options.m_CaptureDirectory);
+	}
+
+	computeCameraPath();
+	m_Samples.reserve(m_Options.m_Frames);
+	AL_INFO("Benchmark: {0} frames ({1} warmup) at {2}x{3}", m_Options.m_Frames, m_Options.m_WarmupFrames,
+			m_Options.m_Width, m_Options.m_Height);
+}
+
+void BenchmarkLayer::onDetach()
+{
+	if (m_Scene)
+	{
+		m_Scene->cleanup();
+	}
+}
+
+void BenchmarkLayer::onUpdate(Timestep ts)
+{
+	uint32_t totalFrames = m_Options.m_WarmupFrames + m_Options.m_Frames;
+	if (!m_Scene || m_Frame > totalFrames)
+	{
+		return;
+	}
+
+	// frame time 은 이전 onUpdate 부터 이번 onUpdate 까지의 간격으로 잰다.
+	// (scene update, command 기록, submit, fence 대기, App loop 가 모두 들어가고 capture 시간만 뺀다)
+	auto now = std::chrono::steady_clock::now();
+	if (m_HasPendingSample)
+	{
+		float intervalMs = std::chrono::duration<float, std::milli>(now - m_FrameStart).count();
+		m_PendingSample.frameMs = intervalMs - m_CaptureMs;
+		m_Samples.push_back(m_PendingSample);
+		m_HasPendingSample = false;
+	}
+
+	if (m_Frame == totalFrames)
+	{
+		m_Frame++;
+		finish();
+		return;
+	}
+
+	bool warmup = m_Frame < m_Options.m_WarmupFrames;
+	uint32_t frame = warmup ? 0 : m_Frame - m_Options.m_WarmupFrames;
+	updateCamera(frame);
+
+	m_FrameStart = now;
+	m_CaptureMs = 0.0f;
+	m_Scene->onUpdateEditor(m_Camera);
+
+	if (!warmup)
+	{
+		Renderer &renderer = App::get().getRenderer();
+		m_PendingSample.recordMs = renderer.getRecordTimeMs();
+		// GpuProfiler 는 frames in flight 만큼 늦게 나오므로 최근 평균을 그대로 쓴다.
+		m_PendingSample.gpuMs = renderer.getGpuProfiler().getTotalMs();
+		m_HasPendingSample = true;
+
+		// capture 는 device 를 기다리므로 그 시간은 frame time 에서 뺀다.
+		if (!m_Options.m_CaptureDirectory.empty() && frame % m_Options.m_CaptureEvery == 0)
+		{
+			auto captureStart = std::chrono::steady_clock::now();
+			captureFrame(frame);
+			auto captureEnd = std::chrono::steady_clock::now();
+			m_CaptureMs = std::chrono::duration<float, std::milli>(captureEnd - captureStart).count();
+		}
+	}
+
+	m_Frame++;
+}
+
+bool BenchmarkLayer::loadScene()
+{
+	if (!Project::load(m_Options.m_ProjectPath))
+	{
+		AL_ERROR("Benchmark: could not load project {0}", m_Options.m_ProjectPath.string());
+		return false;
+	}
+	ScriptingEngine::init();
+
+	std::filesystem::path scenePath = m_Options.m_ScenePath;
+	if (scenePath.empty())
+	{
+		scenePath = Project::getAssetFileSystemPath(Project::getActive()->getConfig().m_StartScene);
+	}
+
+	std::shared_ptr<Scene> scene = Scene::createScene();
+	SceneSerializer serializer(scene);
+	if (!serializer.deserialize(scenePath.string()))
+	{
+		AL_ERROR("Benchmark: could not load scene {0}", scenePath.string());
+		return false;
+	}
+	m_Scene = scene;
+	return true;
+}
+
+// mesh 들의 world 위치로 중심과 반경을 잡고, 그 둘레를 한 바퀴 도는 경로를 쓴다. (실행마다 같은 경로)
+void BenchmarkLayer::computeCameraPath()
+{
+	m_Scene->getTransformSystem().update();
+
+	auto view = m_Scene->getAllEntitiesWith<MeshRendererComponent, TransformComponent>();
+	glm::vec3 minPos(std::numeric_limits<float>::max());
+	glm::vec3 maxPos(std::numeric_limits<float>::lowest());
+	uint32_t count = 0;
+	for (auto entity : view)
+	{
+		glm::vec3 position = glm::vec3(view.get<TransformComponent>(entity).m_WorldTransform[3]);
+		minPos = glm::min(minPos, position);
+		maxPos = glm::max(maxPos, position);
+		count++;
+	}
+
+	if (count > 0)
+	{
+		m_Center = (minPos + maxPos) * 0.5f;
+		m_Radius = std::max(glm::length(maxPos - minPos) * 0.75f, 5.0f);
+	}
+}
+
+void BenchmarkLayer::updateCamera(uint32_t frame)
+{
+	float angle = glm::two_pi<float>() * static_cast<float>(frame) / static_cast<float>(m_Options.m_Frames);
+	glm::vec3 position = m_Center + glm::vec3(std::cos(angle), 0.35f, std::sin(angle)) * m_Radius;
+	glm::vec3 direction = glm::normalize(m_Center - position);
+	glm::vec3 up(0.0f, 1.0f, 0.0f);
+
+	m_Camera.setPosition(position);
+	m_Camera.setViewMatrix(position, direction, up);
+}
+
+void BenchmarkLayer::captureFrame(uint32_t frame)
+{
+	char fileName[32];
+	std::snprintf(fileName, sizeof(fileName), "frame_%05u.png", frame);
+	App::get().getRenderer().captureViewPort((m_Options.m_CaptureDirectory / fileName).string());
+}
+
+void BenchmarkLayer::finish()
+{
+	std::vector<float> frameTimes;
+	frameTimes.reserve(m_Samples.size());
+	float recordSum = 0.0f, gpuSum = 0.0f;
+	for (const FrameSample &sample : m_Samples)
+	{
+		frameTimes.push_back(sample.frameMs);
+		recordSum += sample.recordMs;
+		gpuSum += sample.gpuMs;
+	}
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	float sum = 0.0f;
+	for (float frameTime : frameTimes)
+	{
+		sum += frameTime;
+	}
+	float count = static_cast<float>(frameTimes.size());
+	size_t p95 = std::min(frameTimes.size() - 1, static_cast<size_t>(frameTimes.size() * 0.95f));
+
+	AL_INFO("Benchmark: frame avg {0:.3f} ms, min {1:.3f} ms, max {2:.3f} ms, p95 {3:.3f} ms", sum / count,
+			frameTimes.front(), frameTimes.back(), frameTimes[p95]);
+	AL_INFO("Benchmark: cpu record avg {0:.3f} ms, gpu avg {1:.3f} ms", recordSum / count, gpuSum / count);
+
+	if (!m_Options.m_ReportPath.empty())
+	{
+		writeReport();
+	}
+	App::get().close();
+}
+
+void BenchmarkLayer::writeReport()
+{
+	std::ofstream out(m_Options.m_ReportPath);
+	if (!out)
+	{
+		AL_ERROR("Benchmark: could not write report {0}", m_Options.m_ReportPath.string());
+		return;
+	}
+
+	out << "frame,frame_ms,cpu_record_ms,gpu_ms\n";
+	for (size_t i = 0; i < m_Samples.size(); i++)
+	{
+		const FrameSample &sample = m_Samples[i];
+		out << i << ',' << sample.frameMs << ',' << sample.recordMs << ',' << sample.gpuMs << '\n';
+	}
+}
+
+} // namespace ale
@@ -0,0 +1,78 @@
+#ifndef BENCHMARKLAYER_H
+#define BENCHMARKLAYER_H
+
+#include "AL.h"
+#include "Renderer/EditorCamera.h"
+
+#include <chrono>
+
+namespace ale
+{
+/*
+	Sandbox --benchmark <project.alproj> [--scene <scene.ale>] [--frames N] [--warmup N] [--size WxH]
+		[--capture-dir <dir>] [--capture-every K] [--report <file.csv>] [--gpu-culling]
+*/
+struct BenchmarkOptions
+{
+	std::filesystem::path m_ProjectPath;
+	std::filesystem::path m_ScenePath; // 비어 있으면 project 의 start scene
+	uint32_t m_Frames = 600;
+	uint32_t m_WarmupFrames = 60;
+	uint32_t m_Width = 1280;
+	uint32_t m_Height = 720;
+	std::filesystem::path m_CaptureDirectory; // 비어 있으면 저장하지 않는다.
+	uint32_t m_CaptureEvery = 60;
+	std::filesystem::path m_ReportPath;
+	bool m_GpuCulling = false;
+
+	static bool isBenchmark(const ApplicationCommandLineArgs &args);
+	static bool parse(const ApplicationCommandLineArgs &args, BenchmarkOptions &options);
+};
+
+// window 없이 scene 을 정해진 camera 경로로 돌리면서 frame time 을 재고, 원하면 frame 을 png 로 저장한다.
+class BenchmarkLayer : public Layer
+{
+  public:
+	BenchmarkLayer(const BenchmarkOptions &options);
+	virtual ~BenchmarkLayer() = default;
+
+	void onAttach() override;
+	void onDetach() override;
+	void onUpdate(Timestep ts) override;
+
+  private:
+	struct FrameSample
+	{
+		float frameMs;
+		float recordMs;
+		float gpuMs;
+	};
+
+	bool loadScene();
+	void computeCameraPath();
+	void updateCamera(uint32_t frame);
+	void captureFrame(uint32_t frame);
+	void finish();
+	void writeReport();
+
+  private:
+	BenchmarkOptions m_Options;
+	EditorCamera m_Camera;
+	std::shared_ptr<Scene> m_Scene;
+
+	glm::vec3 m_Center = glm::vec3(0.0f);
+	float m_Radius = 10.0f;
+
+	uint32_t m_Frame = 0;
+	std::vector<FrameSample> m_Samples;
+
+	// frame time 은 다음 onUpdate 가 불릴 때 정해진다.
+	FrameSample m_PendingSample = {};
+	bool m_HasPendingSample = false;
+	std::chrono::steady_clock::time_point m_FrameStart;
+	float m_CaptureMs = 0.0f;
+};
+
+} // namespace ale
+
+#endif
@@ -1,4 +1,6 @@
 #include "EditorLayer.h"
+#include "Core/JobSystem.h"
+#include "Renderer/MemoryAllocator.h"
 #include "Renderer/RenderingComponent.h"
 #include "Scene/SceneSerializer.h"
 #include "Scripting/ScriptingEngine.h"
@@ -104,6 +106,133 @@ void EditorLayer::onImGuiRender()
 	m_ContentBrowserPanel->onImGuiRender();
 
 	// Stats - hovered entity, rendered entities
+	ImGui::Begin("Stats");
+	ImGui::Text("Transforms updated: %u", m_ActiveScene->getTransformSystem().getUpdatedCount());
+	ImGui::Text("Visible: %zu (+%zu / -%zu)", m_ActiveScene->getVisibleEntities().size(),
+				m_ActiveScene->getEnteredEntities().size(), m_ActiveScene->getExitedEntities().size());
+	Renderer &renderer = App::get().getRenderer();
+	ImGui::Text("Draw calls: %u (%u instances)", renderer.getDrawCallCount(), renderer.getInstanceCount());
+	bool gpuCulling = renderer.getCullingMode() == ECullingMode::GPU;
+	ImGui::BeginDisabled(!renderer.isGpuCullingSupported());
+	if (ImGui::Checkbox("GPU culling", &gpuCulling))
+	{
+		renderer.setCullingMode(gpuCulling ? ECullingMode::GPU : ECullingMode::CPU);
+	}
+	ImGui::EndDisabled();
+	if (gpuCulling)
+	{
+		ImGui::SameLine();
+		ImGui::Text("GPU visible: %u", renderer.getGpuVisibleInstanceCount());
+	}
+	OcclusionCuller &occlusionCuller = renderer.getOcclusionCuller();
+	bool occlusionCulling = occlusionCuller.isEnabled();
+	ImGui::BeginDisabled(gpuCulling);
+	if (ImGui::Checkbox("Occlusion culling", &occlusionCulling))
+	{
+		occlusionCuller.setEnabled(occlusionCulling);
+	}
+	ImGui::EndDisabled();
+	if (occlusionCulling && !gpuCulling)
+	{
+		const OcclusionCuller::Stats &occlusionStats = occlusionCuller.getStats();
+		ImGui::Text("Occlusion: %u / %u culled (%u occluders, %u triangles), raster %.3f ms, test %.3f ms",
+					occlusionStats.culledCount, occlusionStats.testedCount, occlusionStats.occluderCount,
+					occlusionStats.triangleCount, occlusionStats.rasterMs, occlusionStats.testMs);
+	}
+	ImGui::Text("Binds: %u / Draws: %u (shadow + geometry)", renderer.getBindCount(), renderer.getDrawCount());
+	ImGui::Text("Bone matrices: %u", renderer.getBoneMatrixCount());
+	ImGui::Text("Shadow maps: %u rendered / %u cached (%u caster instances)", renderer.getShadowRenderCount(),
+				renderer.getShadowCachedCount(), renderer.getShadowCasterCount());
+	ImGui::Text("Lights: %u (%u cluster light indices)", renderer.getLightCount(), renderer.getLightIndexCount());
+	ImGui::Text("Materials: %u (%u bindless textures)", renderer.getMaterialCount(),
+				renderer.getMaterialTextureCount());
+	ImGui::Text("Command recording: %.3f ms", renderer.getRecordTimeMs());
+	MemoryStats memoryStats = MemoryAllocator::getAllocator().getStats();
+	ImGui::Text("GPU memory: %.1f / %.1f MB (%u blocks, %u dedicated, %u allocations)",
+				memoryStats.usedBytes / (1024.0f * 1024.0f), memoryStats.blockBytes / (1024.0f * 1024.0f),
+				memoryStats.blockCount, memoryStats.dedicatedCount, memoryStats.allocationCount);
+	const RenderGraphStats &graphStats = renderer.getRenderGraphStats();
+	ImGui::Text("Render graph: %u passes (%u culled), attachments %.1f MB (%.1f MB unaliased, %.1f MB lazy)",
+				graphStats.passCount, graphStats.culledPassCount, graphStats.allocatedBytes / (1024.0f * 1024.0f),
+				graphStats.requestedBytes / (1024.0f * 1024.0f), graphStats.lazyBytes / (1024.0f * 1024.0f));
+	if (m_SceneState == ESceneState::PLAY)
+	{
+		const SystemGraph &systems = m_ActiveScene->getRuntimeSystems();
+		ImGui::Text("Runtime systems: %.3f ms", systems.getTotalMs());
+		for (const auto &timing : systems.getTimings())
+		{
+			ImGui::Text("  %-12s start %6.3f ms  %6.3f ms  (thread %u)", timing.m_Name.c_str(), timing.m_StartMs,
+						timing.m_DurationMs, timing.m_ThreadIndex);
+		}
+	}
+	ImGui::End();
+
+	// GPU pass 시간 - 최근 프레임 평균
+	GpuProfiler &gpuProfiler = renderer.getGpuProfiler();
+	ImGui::Begin("GPU Profiler");
+	if (!gpuProfiler.isSupported())
+	{
+		ImGui::Text("Timestamp queries are not supported on this device");
+	}
+	else
+	{
+		ImGui::Text("GPU frame: %.3f ms", gpuProfiler.getTotalMs());
+		for (const GpuTiming &timing : gpuProfiler.getTimings())
+		{
+			ImGui::Text("  %-16s %7.3f ms  (last %7.3f ms)", timing.name.c_str(), timing.averageMs, timing.lastMs);
+		}
+
+		// GPU 프레임 시간에 맞춰 내부 해상도를 조절한다.
+		DynamicResolution &dynamicResolution = renderer.getDynamicResolution();
+		bool dynamicResolutionEnabled = dynamicResolution.isEnabled();
+		if (ImGui::Checkbox("Dynamic resolution", &dynamicResolutionEnabled))
+		{
+			dynamicResolution.setEnabled(dynamicResolutionEnabled);
+		}
+		float targetMs = dynamicResolution.getTargetFrameMs();
+		if (ImGui::SliderFloat("Target GPU time", &targetMs, 4.0f, 33.3f, "%.1f ms"))
+		{
+			dynamicResolution.setTargetFrameMs(targetMs);
+		}
+		VkExtent2D renderExtent = renderer.getRenderExtent();
+		ImGui::Text("Render scale: %.2f (%u x %u), last GPU frame %.3f ms", dynamicResolution.getScale(),
+					renderExtent.width, renderExtent.height, gpuProfiler.getFrameMs());
+	}
+	ImGui::End();
+
+	// 지연 시간 / 처리량 - frames in flight, present mode, 목표 프레임 시간
+	FramePacer &framePacer = renderer.getFramePacer();
+	ImGui::Begin("Frame Pacing");
+	int framesInFlight = static_cast<int>(renderer.getFramesInFlight());
+	if (ImGui::SliderInt("Frames in flight", &framesInFlight, 1, MAX_FRAMES_IN_FLIGHT))
+	{
+		renderer.setFramesInFlight(static_cast<uint32_t>(framesInFlight));
+	}
+	const char *presentModeNames[] = {"Immediate", "Mailbox", "FIFO (vsync)"};
+	const VkPresentModeKHR presentModes[] = {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR,
+											 VK_PRESENT_MODE_FIFO_KHR};
+	int presentMode = 0;
+	while (presentMode < 2 && presentModes[presentMode] != renderer.getPresentMode())
+	{
+		presentMode++;
+	}
+	if (ImGui::Combo("Present mode", &presentMode, presentModeNames, IM_ARRAYSIZE(presentModeNames)))
+	{
+		renderer.setPresentMode(presentModes[presentMode]);
+	}
+	float targetFrameMs = framePacer.getTargetFrameMs();
+	if (ImGui::SliderFloat("Target frame time", &targetFrameMs, 0.0f, 33.3f, "%.1f ms (0 = unlimited)"))
+	{
+		framePacer.setTargetFrameMs(targetFrameMs);
+	}
+
+	const FrameLatencyStats &latency = framePacer.getStats();
+	ImGui::Text("Frame: %.3f ms (pacing sleep %.3f ms, fence wait %.3f ms)", latency.frameMs, latency.pacingSleepMs,
+				latency.fenceWaitMs);
+	ImGui::Text("Input -> submit:   %7.3f ms", latency.inputToSubmitMs);
+	ImGui::Text("Input -> present:  %7.3f ms", latency.inputToPresentMs);
+	ImGui::Text("Input -> GPU done: %7.3f ms", latency.inputToGpuDoneMs);
+	ImGui::End();
 
 	// viewport - texture descriptor set을 가져올 수 있는 방법 있으면 좋을듯
 
@@ -270,6 +399,14 @@ void EditorLayer::setMenuBar()
 			ImGui::EndMenu();
 		}
 
+		if (ImGui::BeginMenu("Debug"))
+		{
+			if (ImGui::MenuItem("Job System Benchmark"))
+				JobSystem::runSchedulingBenchmark();
+
+			ImGui::EndMenu();
+		}
+
 		ImGui::EndMenuBar();
 	}
 }
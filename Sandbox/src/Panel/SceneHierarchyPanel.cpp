@@ -166,7 +166,8 @@ void SceneHierarchyPanel::updateRelationship(Entity &newParent, Entity &child)
 	glm::mat4 childLocalMat = glm::inverse(parentWorld) * childWorld;
 
 	decomposeMatrix(childLocalMat, tc.m_Scale, tc.m_Rotation, tc.m_Position);
-	// updateTransforms(newParent);
+	tc.m_isDirty = true;
+	m_Context->getTransformSystem().invalidateHierarchy();
 }
 
 void SceneHierarchyPanel::updateRelationship(Entity &child)
@@ -180,25 +181,16 @@ void SceneHierarchyPanel::updateRelationship(Entity &child)
 		auto &siblings = oldParentRelation.children;
 		entt::entity e = (entt::entity)child;
 		siblings.erase(std::remove(siblings.begin(), siblings.end(), e), siblings.end());
+
+		// 부모 기준 local 값을 world 값으로 변환
+		auto &tc = child.getComponent<TransformComponent>();
+		decomposeMatrix(tc.m_WorldTransform, tc.m_Scale, tc.m_Rotation, tc.m_Position);
+		tc.m_isDirty = true;
 	}
 
 	// 부모가 없으므로 null로 설정 (최상위 엔티티)
 	childRelation.parent = entt::null;
-}
-
-void SceneHierarchyPanel::updateTransforms(Entity entity)
-{
-	entt::entity top = (entt::entity)entity;
-	while (true)
-	{
-		auto &parentRel = m_Context->m_Registry.get<RelationshipComponent>(top);
-		if (parentRel.parent == entt::null)
-			break;
-		top = parentRel.parent;
-	}
-
-	Entity t{top, m_Context.get()};
-	updateTransformRecursive(t, glm::mat4(1.0f));
+	m_Context->getTransformSystem().invalidateHierarchy();
 }
 
 void SceneHierarchyPanel::updateActiveInfo(Entity &entity, bool parentEffectiveActive)
@@ -216,28 +208,6 @@ void SceneHierarchyPanel::updateActiveInfo(Entity &entity, bool parentEffectiveA
 	}
 }
 
-void SceneHierarchyPanel::updateTransformRecursive(Entity entity, const glm::mat4 &parentWorldTransform)
-{
-	auto &transform = entity.getComponent<TransformComponent>();
-	auto &relation = entity.getComponent<RelationshipComponent>();
-
-	// 2. 로컬 행렬 계산
-	// if (relation.parent != entt::null)
-	// 	// 3. 월드 변환 = 부모 월드 변환 x 로컬 변환
-	// 	transform.m_WorldTransform = parentWorldTransform * transform.m_LocalTransform;
-	// else
-	// 	transform.m_WorldTransform = transform.getTransform();
-
-	transform.m_WorldTransform = parentWorldTransform * transform.getTransform();
-
-	// 4. 자식들 업데이트
-	for (auto child : relation.children)
-	{
-		Entity entity{child, m_Context.get()};
-		updateTransformRecursive(entity, transform.m_WorldTransform);
-	}
-}
-
 void SceneHierarchyPanel::setSelectedEntity(Entity entity)
 {
 	m_SelectionContext = entity;
@@ -586,7 +556,7 @@ void SceneHierarchyPanel::drawComponents(Entity entity)
 
 		char buffer[256];
 		memset(buffer, 0, sizeof(buffer));
-		strncpy_s(buffer, sizeof(buffer), tag.c_str(), sizeof(buffer));
+		strncpy(buffer, tag.c_str(), sizeof(buffer) - 1);
 
 		std::string label = "##Tag" + std::to_string(entity.getUUID());
 
@@ -656,14 +626,20 @@ void SceneHierarchyPanel::drawComponents(Entity entity)
 	}
 	ImGui::PopItemWidth();
 
-	drawComponent<TransformComponent>("Transform", entity, [this, entity](auto &component) mutable {
-		// Update Recursively
+	drawComponent<TransformComponent>("Transform", entity, [](auto &component) {
+		glm::vec3 position = component.m_Position;
+		glm::vec3 rotation = component.m_Rotation;
+		glm::vec3 scale = component.m_Scale;
+
 		drawVec3Control("Position", component.m_Position);
-		auto &rotation = glm::degrees(component.m_Rotation);
-		drawVec3Control("Rotation", rotation);
-		component.m_Rotation = glm::radians(rotation);
+		auto &degrees = glm::degrees(component.m_Rotation);
+		drawVec3Control("Rotation", degrees);
+		component.m_Rotation = glm::radians(degrees);
 		drawVec3Control("Scale", component.m_Scale, 1.0f);
-		updateTransforms(entity);
+
+		// 값이 바뀐 경우에만 TransformSystem 이 자손까지 다시 계산
+		if (position != component.m_Position || rotation != component.m_Rotation || scale != component.m_Scale)
+			component.m_isDirty = true;
 	});
 
 	drawComponent<CameraComponent>("Camera", entity, [](auto &component) {
@@ -1211,6 +1187,15 @@ void SceneHierarchyPanel::drawComponents(Entity entity)
 		}
 		ImGui::Columns(1);
 
+		// box primitive 는 항상 occluder 로 쓰이므로 model 등에만 의미가 있다.
+		ImGui::BeginDisabled(component.type == 1);
+		drawCheckBox("Occluder", component.occluder);
+		ImGui::EndDisabled();
+		if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+		{
+			ImGui::SetTooltip("Use the bounding box as a solid occluder for occlusion culling");
+		}
+
 		// Drag & Drop Model
 		// drawDragDropUI("Model");
 		ImGui::Button("Model", ImVec2(200.0f, 0.0f));
@@ -1339,7 +1324,11 @@ void SceneHierarchyPanel::drawComponents(Entity entity)
 		light->onShadowMap = onShadow == true ? 1 : 0;
 
 		drawVec3Control("Position", light->position);
-		tc.m_Position = light->position;
+		if (tc.m_Position != light->position)
+		{
+			tc.m_Position = light->position;
+			tc.m_isDirty = true;
+		}
 		drawVec3Control("Direction", light->direction);
 
 		ImGui::Spacing();
@@ -32,8 +32,6 @@ class SceneHierarchyPanel
 	void updateActiveInfo(Entity &entity, bool parentEffectiveActive);
 	void updateRelationship(Entity &newParent, Entity &child);
 	void updateRelationship(Entity &entity);
-	void updateTransforms(Entity entity);
-	void updateTransformRecursive(Entity entity, const glm::mat4 &parentWorldTransform);
 
   private:
 	std::shared_ptr<Scene> m_Context;
@@ -1,6 +1,7 @@
 #include "AL.h"
 #include "Core/EntryPoint.h"
 
+#include "BenchmarkLayer.h"
 #include "EditorLayer.h"
 
 namespace ale
@@ -13,6 +14,11 @@ class Sandbox : public App
 		pushLayer(new EditorLayer());
 	}
 
+	Sandbox(const ApplicationSpecification &spec, const BenchmarkOptions &options) : App(spec)
+	{
+		pushLayer(new BenchmarkLayer(options));
+	}
+
 	~Sandbox()
 	{
 	}
@@ -24,6 +30,19 @@ App *createApp(ApplicationCommandLineArgs args)
 	spec.m_Name = "ALEngine";
 	spec.m_CommandLineArgs = args;
 
+	if (BenchmarkOptions::isBenchmark(args))
+	{
+		BenchmarkOptions options;
+		if (!BenchmarkOptions::parse(args, options))
+		{
+			return nullptr;
+		}
+		spec.m_Headless = true;
+		spec.m_HeadlessWidth = options.m_Width;
+		spec.m_HeadlessHeight = options.m_Height;
+		return new Sandbox(spec, options);
+	}
+
 	return new Sandbox(spec);
 }
 
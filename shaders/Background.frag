@@ -3,8 +3,9 @@
 layout(location = 0) in vec3 viewDirection;
 layout(location = 0) out vec4 fragColor;
 
+// EnvironmentMap 의 specular cube (mip 0 = 원본, 나머지는 roughness 별 prefilter 결과)
 layout(binding = 1) uniform samplerCube skybox;
 
 void main() {
-    fragColor = texture(skybox, viewDirection);
+    fragColor = textureLod(skybox, viewDirection, 0.0);
 }
@@ -0,0 +1,54 @@
+// EnvironmentMap 전처리 compute shader (EquirectToCube / PrefilterEnvironment / IrradianceMap) 공용 정의
+// 출력 mip 은 image2DArray (layer 0 ~ 5 = +X, -X, +Y, -Y, +Z, -Z) 로 쓰고, thread 하나가 texel 하나를 채운다.
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+// Common.h 의 EnvironmentMapPushConstants
+layout(push_constant) uniform EnvironmentMapConstants {
+    uint faceSize;        // 출력 mip 의 한 변
+    float roughness;      // PrefilterEnvironment 만 사용
+    uint sampleCount;
+    float sourceFaceSize; // 입력 cube mip 0 의 한 변 (sample 이 덮는 입체각으로 mip 을 고를 때 사용)
+} env;
+
+const float PI = 3.14159265359;
+
+// Vulkan cube map 규약에서 (face = id.z) texel 중심이 가리키는 방향
+vec3 cubeDirection(uvec3 id, uint faceSize) {
+    vec2 uv = (vec2(id.xy) + 0.5) / float(faceSize) * 2.0 - 1.0;
+    switch (id.z) {
+    case 0u:
+        return normalize(vec3(1.0, -uv.y, -uv.x));
+    case 1u:
+        return normalize(vec3(-1.0, -uv.y, uv.x));
+    case 2u:
+        return normalize(vec3(uv.x, 1.0, uv.y));
+    case 3u:
+        return normalize(vec3(uv.x, -1.0, -uv.y));
+    case 4u:
+        return normalize(vec3(uv.x, -uv.y, 1.0));
+    default:
+        return normalize(vec3(-uv.x, -uv.y, -1.0));
+    }
+}
+
+// N 을 z 축으로 하는 tangent space -> world
+mat3 tangentBasis(vec3 N) {
+    vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 T = normalize(cross(up, N));
+    vec3 B = cross(N, T);
+    return mat3(T, B, N);
+}
+
+// 저불일치 수열 (i / count, radical inverse)
+vec2 hammersley(uint i, uint count) {
+    return vec2(float(i) / float(count), float(bitfieldReverse(i)) * 2.3283064365386963e-10);
+}
+
+// pdf 로 뽑은 sample 하나가 대표하는 입체각만큼 흐린 mip 의 lod (filtered importance sampling)
+// sample 이 원본 texel 보다 훨씬 넓은 영역을 대표할 때 생기는 반짝이는 점을 없앤다.
+float sampleLod(float pdf) {
+    float texelSolidAngle = 4.0 * PI / (6.0 * env.sourceFaceSize * env.sourceFaceSize);
+    float sampleSolidAngle = 1.0 / (float(env.sampleCount) * pdf + 0.0001);
+    return max(0.5 * log2(sampleSolidAngle / texelSolidAngle) + 1.0, 0.0);
+}
@@ -1,25 +1,42 @@
 #version 450
 
-// 통합 Uniform 구조체
-layout(binding = 2) uniform GeometryPassFragmentUniformBufferObject {
-    vec4 albedoValue;  // vec4는 16바이트 정렬이므로 먼저 배치
+// set 0 binding 1: 이번 프레임에 그릴 material 을 모은 table (Common.h 의 MaterialData 와 같은 배치)
+struct MaterialData {
+    vec4 albedoValue;
     float roughnessValue;
     float metallicValue;
     float aoValue;
+    float heightScale;
 
-    bool albedoFlag;
-    bool normalFlag;
-    bool roughnessFlag;
-    bool metallicFlag;
-    bool aoFlag;
-} ubo;
+    uint albedoTexture;
+    uint normalTexture;
+    uint roughnessTexture;
+    uint metallicTexture;
+    uint aoTexture;
+    uint heightTexture;
+    uint flags;
+    uint padding;
+};
 
-// Textures
-layout(binding = 3) uniform sampler2D normalTex;
-layout(binding = 4) uniform sampler2D roughnessTex;
-layout(binding = 5) uniform sampler2D metallicTex;
-layout(binding = 6) uniform sampler2D aoTex;
-layout(binding = 7) uniform sampler2D albedoTex;
+#define MATERIAL_ALBEDO_FLAG    (1u << 0)
+#define MATERIAL_NORMAL_FLAG    (1u << 1)
+#define MATERIAL_ROUGHNESS_FLAG (1u << 2)
+#define MATERIAL_METALLIC_FLAG  (1u << 3)
+#define MATERIAL_AO_FLAG        (1u << 4)
+#define MATERIAL_HEIGHT_FLAG    (1u << 5)
+
+layout(std430, set = 0, binding = 1) readonly buffer MaterialTable {
+    MaterialData materials[];
+};
+
+// set 1: 모든 material 이 공유하는 texture 배열 (크기는 pipeline 생성 시 specialization constant 로 정해진다)
+layout(constant_id = 0) const uint MAX_MATERIAL_TEXTURES = 1024;
+layout(set = 1, binding = 0) uniform sampler2D textures[MAX_MATERIAL_TEXTURES];
+
+// draw 마다 바뀌는 material table index (draw 안에서는 모든 invocation 이 같은 값)
+layout(push_constant) uniform DrawConstants {
+    uint materialIndex;
+} draw;
 
 // Inputs from Vertex Shader
 layout(location = 0) in vec3 fragPosition;
@@ -34,25 +51,33 @@ layout(location = 2) out vec4 outAlbedo;
 layout(location = 3) out vec4 outPBR;
 
 void main() {
+    MaterialData material = materials[draw.materialIndex];
+
     // Position Pass
     outPosition = vec4(fragPosition, 1.0);
 
     // Normal Pass (Texture or Vertex Shader 전달)
     vec3 normal = normalize(fragNormal);
-    if (ubo.normalFlag) {
-        vec3 normalTexValue = texture(normalTex, fragTexCoord).rgb * 2.0 - 1.0;
+    if ((material.flags & MATERIAL_NORMAL_FLAG) != 0u) {
+        vec3 normalTexValue = texture(textures[material.normalTexture], fragTexCoord).rgb * 2.0 - 1.0;
         normal = normalize(fragTBN * normalTexValue);
     }
     outNormal = vec4(normal, 1.0);
 
     // Albedo Pass
-    vec4 albedo = ubo.albedoFlag ? texture(albedoTex, fragTexCoord) : ubo.albedoValue;
+    vec4 albedo = (material.flags & MATERIAL_ALBEDO_FLAG) != 0u ? texture(textures[material.albedoTexture], fragTexCoord)
+                                                                : material.albedoValue;
     outAlbedo = albedo;
 
     // PBR Pass (Roughness, Metallic, AO)
-    float roughness = ubo.roughnessFlag ? texture(roughnessTex, fragTexCoord).g : ubo.roughnessValue;
-    float metallic = ubo.metallicFlag ? texture(metallicTex, fragTexCoord).r : ubo.metallicValue;
-    float ao = ubo.aoFlag ? texture(aoTex, fragTexCoord).r : ubo.aoValue;
+    float roughness = (material.flags & MATERIAL_ROUGHNESS_FLAG) != 0u
+                          ? texture(textures[material.roughnessTexture], fragTexCoord).g
+                          : material.roughnessValue;
+    float metallic = (material.flags & MATERIAL_METALLIC_FLAG) != 0u
+                         ? texture(textures[material.metallicTexture], fragTexCoord).r
+                         : material.metallicValue;
+    float ao = (material.flags & MATERIAL_AO_FLAG) != 0u ? texture(textures[material.aoTexture], fragTexCoord).r
+                                                         : material.aoValue;
 
     outPBR = vec4(roughness, metallic, ao, 1.0);
 }
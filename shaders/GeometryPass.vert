@@ -1,19 +1,76 @@
 #version 450
 
-layout(binding = 0) uniform GeometryPassVertexUniformBufferObject {
-    mat4 model;
+// ShaderLibrary 가 define 으로 만드는 permutation
+// SKINNED: bone 입력 (location 4, 5, 10) 과 skinning 계산을 넣는다. 없으면 static mesh 용
+// HEIGHT_MAP: height map 으로 vertex 를 밀어낸다. material flag 로 고른 pipeline 이라 flag 는 다시 검사하지 않는다.
+
+#ifdef SKINNED
+#include "../AL/include/Renderer/Animation/Bones.h"
+#endif
+
+// set 0: 프레임별 uniform ring buffer (dynamic offset) + bone storage buffer (SKINNED 만 읽는다)
+layout(set = 0, binding = 0) uniform GeometryPassCameraUniformBufferObject {
     mat4 view;
     mat4 proj;
-    bool heightFlag;
+} camera;
+
+// set 0 binding 1: 이번 프레임에 그릴 material 을 모은 table (Common.h 의 MaterialData 와 같은 배치)
+struct MaterialData {
+    vec4 albedoValue;
+    float roughnessValue;
+    float metallicValue;
+    float aoValue;
     float heightScale;
-} ubo;
 
-layout(binding = 1) uniform sampler2D heightMap;
+    uint albedoTexture;
+    uint normalTexture;
+    uint roughnessTexture;
+    uint metallicTexture;
+    uint aoTexture;
+    uint heightTexture;
+    uint flags;
+    uint padding;
+};
+
+#define MATERIAL_ALBEDO_FLAG    (1u << 0)
+#define MATERIAL_NORMAL_FLAG    (1u << 1)
+#define MATERIAL_ROUGHNESS_FLAG (1u << 2)
+#define MATERIAL_METALLIC_FLAG  (1u << 3)
+#define MATERIAL_AO_FLAG        (1u << 4)
+#define MATERIAL_HEIGHT_FLAG    (1u << 5)
+
+layout(std430, set = 0, binding = 1) readonly buffer MaterialTable {
+    MaterialData materials[];
+};
+
+#ifdef SKINNED
+// skeleton 마다 실제 bone 개수만큼 쌓인 skinning 행렬, instance 의 boneOffset 부터 자기 palette
+layout(std430, set = 0, binding = 2) readonly buffer BonePalette {
+    mat4 finalJointsMatrices[];
+} bones;
+#endif
+
+// set 1: 모든 material 이 공유하는 texture 배열 (크기는 pipeline 생성 시 specialization constant 로 정해진다)
+layout(constant_id = 0) const uint MAX_MATERIAL_TEXTURES = 1024;
+layout(set = 1, binding = 0) uniform sampler2D textures[MAX_MATERIAL_TEXTURES];
+
+// draw 마다 바뀌는 material table index (draw 안에서는 모든 invocation 이 같은 값)
+layout(push_constant) uniform DrawConstants {
+    uint materialIndex;
+} draw;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inTangent;
+#ifdef SKINNED
+layout(location = 4) in ivec4 inBoneIds;
+layout(location = 5) in vec4 inWeights;
+#endif
+layout(location = 6) in mat4 inModel;   // instance 별 model 행렬 (location 6 ~ 9)
+#ifdef SKINNED
+layout(location = 10) in uint inBoneOffset;
+#endif
 
 layout(location = 0) out vec3 fragPosition;
 layout(location = 1) out vec3 fragNormal;
@@ -21,17 +78,48 @@ layout(location = 2) out vec2 fragTexCoord;
 layout(location = 3) out mat3 fragTBN;
 
 void main() {
-    vec3 position = inPosition;
-
-    if (ubo.heightFlag) {
-        float height = texture(heightMap, inTexCoord).r;
-        position += inNormal * (height * ubo.heightScale);
+#ifdef SKINNED
+    vec4 animatedPosition = vec4(0.0f);
+	mat4 boneTransform = mat4(0.0f);
+	for (int i = 0; i < MAX_BONE_INFLUENCE; ++i)
+	{
+		if (inWeights[i] == 0)
+			continue;
+		if (inBoneIds[i] >= MAX_BONES) 
+		{
+			animatedPosition = vec4(inPosition, 1.0f);
+			boneTransform = mat4(1.0f);
+			break;
+		}
+		mat4 jointMatrix = bones.finalJointsMatrices[inBoneOffset + uint(inBoneIds[i])];
+		vec4 localPosition  = jointMatrix * vec4(inPosition, 1.0f);
+		animatedPosition += localPosition * inWeights[i];
+		boneTransform += jointMatrix * inWeights[i];
+	}
+    if (animatedPosition == vec4(0.0f) && determinant(mat3(boneTransform)) == 0.0)
+    {
+        animatedPosition = vec4(inPosition, 1.0f);
+        boneTransform = mat4(1.0f);
     }
+#else
+    vec4 animatedPosition = vec4(inPosition, 1.0);
+#endif
+
+#ifdef HEIGHT_MAP
+    MaterialData material = materials[draw.materialIndex];
+    float height = texture(textures[material.heightTexture], inTexCoord).r;
+    animatedPosition += vec4(inNormal * (height * material.heightScale), 0.0f);
+#endif
 
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(position, 1.0);
-    fragPosition = vec3(ubo.model * vec4(position, 1.0));
+    vec4 positionWorld = inModel * animatedPosition;
+    gl_Position = camera.proj * camera.view * positionWorld;
+    fragPosition = positionWorld.xyz;
 
-    mat3 normalMatrix = mat3(transpose(inverse(ubo.model)));
+#ifdef SKINNED
+    mat3 normalMatrix = transpose(inverse(mat3(inModel) * mat3(boneTransform)));
+#else
+    mat3 normalMatrix = transpose(inverse(mat3(inModel)));
+#endif
     fragNormal = normalMatrix * inNormal;
 
     fragTexCoord = inTexCoord;
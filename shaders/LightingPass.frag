@@ -14,15 +14,18 @@ struct Light {
     float outerCutoff;
     uint type;
     uint onShadowMap;
-    uint padding;
-    vec2 padding2;
+    uint shadowMapIndex;
+    float range;
+    float padding;
 };
 
 layout(binding = 4) uniform LightingInfo {
-    Light lights[16];
+    mat4 cameraView;
     vec3 cameraPos;
     mat4 view[4][6];
     mat4 proj[4];
+    uvec4 clusterGrid;   // x, y, z 개수 / 모든 pixel 이 계산하는 light 수
+    vec4 clusterParams;  // tile 크기(pixel) x, y / depth slice scale, bias
     uint numLights;
     float ambientStrength;
     vec2 padding;
@@ -31,6 +34,17 @@ layout(binding = 4) uniform LightingInfo {
 layout(binding = 5) uniform sampler2DShadow shadowMap[4];
 layout(binding = 6) uniform samplerCube shadowCubeMap[4];
 layout(binding = 7) uniform sampler2D background;
+
+// directional / shadow map light 가 앞쪽에 오고, 나머지는 cluster 별 index 목록으로 참조한다.
+layout(std430, binding = 8) readonly buffer LightBuffer {
+    Light lights[];
+};
+layout(std430, binding = 9) readonly buffer ClusterBuffer {
+    uvec2 clusters[]; // lightIndices 의 offset, count
+};
+layout(std430, binding = 10) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
 // layout(binding = 8) uniform samplerCube skybox;
 
 
@@ -142,6 +156,98 @@ uint getCubeFace(vec3 L) {
 }
 
 const float FLT_MAX = 3.4028235e+38 - 1; 
+const uint NO_SHADOW_MAP = 0xFFFFFFFFu;
+
+// range 에서 0 이 되도록 감쇠를 내린다. (cluster 경계에서 끊기지 않게)
+float rangeAttenuation(float distance, float range) {
+    float constant = 1.0;
+    float linear = 0.09;
+    float quadratic = 0.032;
+    float attenuation = 1.0 / (constant + linear * distance + quadratic * (distance * distance));
+    float rangeAttenuation = 1.0 / (constant + linear * range + quadratic * (range * range));
+    return max(attenuation - rangeAttenuation, 0.0) / (1.0 - rangeAttenuation);
+}
+
+// shadow map 은 모든 pixel 이 같은 순서로 도는 light (index 가 dynamically uniform) 에서만 샘플링한다.
+vec3 shadeLight(uint i, bool sampleShadow, vec3 fragPosition, vec3 N, vec3 V, vec3 albedo, float roughness,
+                float metallic) {
+    vec3 L;
+    float attenuation = 1.0;
+    uint shadowMapIndex = lights[i].shadowMapIndex;
+
+    if (lights[i].type == 0) { // Point Light
+        float distance = length(lights[i].position - fragPosition);
+        if (distance >= lights[i].range) {
+            return vec3(0.0);
+        }
+        L = normalize(lights[i].position - fragPosition);
+        attenuation = rangeAttenuation(distance, lights[i].range);
+
+        // Shadow Cube Map 샘플링
+        if (sampleShadow && shadowMapIndex < 4) {
+            uint faceIndex = getCubeFace(-L);
+            mat4 lightView = view[shadowMapIndex][faceIndex];
+            mat4 lightProj = proj[shadowMapIndex];
+            mat4 lightViewProj = lightProj * lightView;
+            vec4 lightSpacePosition = lightViewProj * vec4(fragPosition, 1.0);
+            float currentDepth = lightSpacePosition.z / lightSpacePosition.w;
+            attenuation *= PCFShadowCube(shadowCubeMap[shadowMapIndex], -L, currentDepth);
+        }
+    }
+    else if (lights[i].type == 1) { // Spot Light
+        float distance = length(lights[i].position - fragPosition);
+        if (distance >= lights[i].range) {
+            return vec3(0.0);
+        }
+        L = normalize(lights[i].position - fragPosition);
+        attenuation = rangeAttenuation(distance, lights[i].range);
+
+        float theta = dot(L, normalize(-lights[i].direction));
+        float epsilon = max(lights[i].innerCutoff - lights[i].outerCutoff, 0.001);
+        attenuation *= clamp((theta - lights[i].outerCutoff) / epsilon, 0.0, 1.0);
+
+        if (sampleShadow && shadowMapIndex < 4) {
+            mat4 lightViewProj = proj[shadowMapIndex] * view[shadowMapIndex][0];
+            vec4 lightSpacePosition = lightViewProj * vec4(fragPosition, 1.0);
+            vec3 shadowCoord = lightSpacePosition.xyz / lightSpacePosition.w; // NDC 변환
+            shadowCoord.xy = shadowCoord.xy * 0.5 + 0.5;
+            attenuation *= PCFShadow(shadowMap[shadowMapIndex], shadowCoord, shadowCoord.z);
+        }
+    }
+    else { // Directional Light
+        L = normalize(-lights[i].direction);
+        attenuation = 1.0;
+
+        if (sampleShadow && shadowMapIndex < 4) {
+            mat4 lightViewProj = proj[shadowMapIndex] * view[shadowMapIndex][0];
+            vec4 lightSpacePosition = lightViewProj * vec4(fragPosition, 1.0);
+            vec3 shadowCoord = lightSpacePosition.xyz / lightSpacePosition.w; // NDC 변환
+            shadowCoord.xy = shadowCoord.xy * 0.5 + 0.5;
+            attenuation *= PCFShadow(shadowMap[shadowMapIndex], shadowCoord, shadowCoord.z);
+        }
+    }
+
+    vec3 H = normalize(V + L);
+    vec3 F0 = mix(vec3(0.04), albedo, metallic);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    float NDF = distributionGGX(N, H, roughness);
+    float G = geometrySmith(N, V, L, roughness);
+
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.001;
+    vec3 specular = numerator / denominator;
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    float NdotL = max(dot(N, L), 0.05);
+    vec3 diffuse = kD * albedo / 3.14159265359;
+    vec3 radiance = lights[i].color * lights[i].intensity * NdotL * attenuation;
+
+    return (diffuse + specular) * radiance;
+}
 
 void main() {
     vec3 fragPosition = subpassLoad(positionAttachment).rgb;
@@ -161,113 +267,27 @@ void main() {
     vec3 ambient = ambientStrength * albedo * ao;
     finalColor += ambient;
 
-    float shadowFactor = 1.0;
-
-    uint shadowMapIndex = 0;
-
     if (fragPosition.x >= FLT_MAX) {
-        outColor = texture(background, fragTexCoord);
+        // background 는 같은 내부 해상도로 image 왼쪽 위에 그려져 있으므로 pixel 위치로 읽는다.
+        outColor = texelFetch(background, ivec2(gl_FragCoord.xy), 0);
         return;
     }
 
-    for (uint i = 0; i < numLights; ++i) {
-        vec3 L;
-        float attenuation = 1.0;
-
-        if (lights[i].type == 0) { // Point Light
-            L = normalize(lights[i].position - fragPosition);
-            float distance = length(lights[i].position - fragPosition);
-            float constant = 1.0;
-            float linear = 0.09;
-            float quadratic = 0.032;
-            attenuation = 1.0 / (constant + linear * distance + quadratic * (distance * distance));
-
-            // Shadow Cube Map 샘플링
-            if (lights[i].onShadowMap == 1) {
-                float closestDepth = texture(shadowCubeMap[shadowMapIndex], -L).r; // -L: light 방향
-                uint faceIndex = getCubeFace(-L);
-                mat4 lightView = view[shadowMapIndex][faceIndex];
-                mat4 lightProj = proj[shadowMapIndex];
-                mat4 lightViewProj = lightProj * lightView;
-                vec4 lightSpacePosition = lightViewProj * vec4(fragPosition, 1.0);
-                float currentDepth = lightSpacePosition.z / lightSpacePosition.w;
-                float bias = 0.005;
-                // shadowFactor = currentDepth - bias > closestDepth ? 0.0 : 1.0;  
-                shadowFactor = PCFShadowCube(shadowCubeMap[shadowMapIndex], -L, currentDepth);
-                attenuation *= shadowFactor;
-                shadowMapIndex++;
-            }
-        }
-        else if (lights[i].type == 1) { // Spot Light
-            L = normalize(lights[i].position - fragPosition);
-            float distance = length(lights[i].position - fragPosition);
-            float constant = 1.0;
-            float linear = 0.09;
-            float quadratic = 0.032;
-            attenuation = 1.0 / (constant + linear * distance + quadratic * (distance * distance));
-
-            float theta = dot(L, normalize(-lights[i].direction));
-            float epsilon = max(lights[i].innerCutoff - lights[i].outerCutoff, 0.001);
-            attenuation *= clamp((theta - lights[i].outerCutoff) / epsilon, 0.0, 1.0);
-
-
-            if (lights[i].onShadowMap == 1 && shadowMapIndex < 4) {
-                mat4 lightViewProj = proj[shadowMapIndex] * view[shadowMapIndex][0];
-                vec4 lightSpacePosition = lightViewProj * vec4(fragPosition, 1.0);
-                vec3 shadowCoord = lightSpacePosition.xyz / lightSpacePosition.w; // NDC 변환
-                shadowCoord.xy = shadowCoord.xy * 0.5 + 0.5;
-
-                float closestDepth = texture(shadowMap[shadowMapIndex], shadowCoord);
-                float currentDepth = shadowCoord.z;
-                float bias = 0.005;
-                // shadowFactor = currentDepth - bias > closestDepth ? 0.0 : 1.0;
-
-                shadowFactor = PCFShadow(shadowMap[shadowMapIndex], shadowCoord, shadowCoord.z);
-                attenuation *= shadowFactor;
-                shadowMapIndex++;
-            }
-        }
-        else { // Directional Light
-            L = normalize(-lights[i].direction);
-            attenuation = 1.0;
-
-            if (lights[i].onShadowMap == 1 && shadowMapIndex < 4) {
-                mat4 lightViewProj = proj[shadowMapIndex] * view[shadowMapIndex][0];
-                vec4 lightSpacePosition = lightViewProj * vec4(fragPosition, 1.0);
-                vec3 shadowCoord = lightSpacePosition.xyz / lightSpacePosition.w; // NDC 변환
-                shadowCoord.xy = shadowCoord.xy * 0.5 + 0.5;
-
-                float closestDepth = texture(shadowMap[shadowMapIndex], shadowCoord);
-                float currentDepth = shadowCoord.z;
-                float bias = 0.005;
-                // shadowFactor = currentDepth - bias > closestDepth ? 0.0 : 1.0;
-
-                shadowFactor = PCFShadow(shadowMap[shadowMapIndex], shadowCoord, shadowCoord.z);
-                attenuation *= shadowFactor;
-                shadowMapIndex++;
-            }
-        }
-
-        vec3 H = normalize(V + L);
-        vec3 F0 = mix(vec3(0.04), albedo, metallic);
-        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
-
-        float NDF = distributionGGX(N, H, roughness);
-        float G = geometrySmith(N, V, L, roughness);
-
-        vec3 numerator = NDF * G * F;
-        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.001;
-        vec3 specular = numerator / denominator;
-
-        vec3 kS = F;
-        vec3 kD = vec3(1.0) - kS;
-        kD *= 1.0 - metallic;
-
-        float NdotL = max(dot(N, L), 0.05);
-        vec3 diffuse = kD * albedo / 3.14159265359;
-        vec3 radiance = lights[i].color * lights[i].intensity * NdotL * attenuation;
+    // directional / shadow map light 는 모든 pixel 에서 계산
+    for (uint i = 0; i < clusterGrid.w; ++i) {
+        finalColor += shadeLight(i, true, fragPosition, N, V, albedo, roughness, metallic);
+    }
 
-        finalColor += (diffuse + specular) * radiance;
+    // 나머지는 이 pixel 이 속한 cluster 에 배정된 light 만 계산
+    float depth = -(cameraView * vec4(fragPosition, 1.0)).z;
+    uvec3 cluster;
+    cluster.xy = min(uvec2(gl_FragCoord.xy / clusterParams.xy), clusterGrid.xy - 1u);
+    cluster.z = uint(clamp(floor(log(max(depth, 1e-4)) * clusterParams.z + clusterParams.w), 0.0,
+                           float(clusterGrid.z - 1u)));
+    uvec2 range = clusters[cluster.x + cluster.y * clusterGrid.x + cluster.z * clusterGrid.x * clusterGrid.y];
+    for (uint j = 0; j < range.y; ++j) {
+        finalColor += shadeLight(lightIndices[range.x + j], false, fragPosition, N, V, albedo, roughness, metallic);
     }
+
     outColor = vec4(clamp(finalColor, 0.0, 1.0), 1.0);
 }
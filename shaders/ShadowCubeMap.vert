@@ -5,11 +5,11 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inTangent;
+layout(location = 6) in mat4 inModel;   // instance 별 model 행렬 (location 6 ~ 9)
 
 layout(binding = 0) uniform ShadowUniformBufferObject {
     mat4 proj;
     mat4 view[6];
-    mat4 model;
 } ubo;
 
 layout(binding = 1) uniform LayerIndex {
@@ -18,5 +18,5 @@ layout(binding = 1) uniform LayerIndex {
 
 void main() {
     gl_Layer = int(layerData.layerIndex);
-    gl_Position = ubo.proj * ubo.view[gl_Layer] * ubo.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.proj * ubo.view[gl_Layer] * inModel * vec4(inPosition, 1.0);
 }
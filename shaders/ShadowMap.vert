@@ -4,11 +4,11 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inTangent;
+layout(location = 6) in mat4 model;     // instance 별 model 행렬 (location 6 ~ 9)
 
 layout(binding = 0) uniform ShadowUniformBufferObject {
     mat4 proj;
     mat4 view;
-    mat4 model;         // 모델의 변환 행렬
 };
 
 void main() {
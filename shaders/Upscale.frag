@@ -0,0 +1,58 @@
+#version 450
+
+// 내부 해상도로 그린 scene color (render graph 의 고정 크기 image 왼쪽 위 영역만 유효)
+layout(binding = 0) uniform sampler2D sceneColor;
+
+layout(push_constant) uniform UpscaleInfo {
+    vec2 uvScale;   // 내부 해상도 / image 크기
+    vec2 texelSize; // 1 / image 크기
+} upscale;
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+// 유효 영역 밖 (이전 프레임의 더 큰 내용) 을 읽지 않도록 texel 중심 범위로 자른다.
+vec4 sampleClamped(vec2 uv) {
+    vec2 uvMax = upscale.uvScale - 0.5 * upscale.texelSize;
+    return texture(sceneColor, clamp(uv, 0.5 * upscale.texelSize, uvMax));
+}
+
+// Catmull-Rom bicubic 을 bilinear sample 9번으로 계산한다. (가운데 2x2 는 weight 를 합쳐서 한 번에 읽는다)
+// 확대할 때 bilinear 보다 경계가 덜 뭉개지고, scale 이 1 이면 texel 중심만 읽어서 원본과 같다.
+vec4 sampleCatmullRom(vec2 uv) {
+    vec2 samplePos = uv / upscale.texelSize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 offset12 = w2 / w12;
+
+    vec2 texPos0 = (texPos1 - 1.0) * upscale.texelSize;
+    vec2 texPos3 = (texPos1 + 2.0) * upscale.texelSize;
+    vec2 texPos12 = (texPos1 + offset12) * upscale.texelSize;
+
+    vec4 result = vec4(0.0);
+    result += sampleClamped(vec2(texPos0.x, texPos0.y)) * w0.x * w0.y;
+    result += sampleClamped(vec2(texPos12.x, texPos0.y)) * w12.x * w0.y;
+    result += sampleClamped(vec2(texPos3.x, texPos0.y)) * w3.x * w0.y;
+
+    result += sampleClamped(vec2(texPos0.x, texPos12.y)) * w0.x * w12.y;
+    result += sampleClamped(vec2(texPos12.x, texPos12.y)) * w12.x * w12.y;
+    result += sampleClamped(vec2(texPos3.x, texPos12.y)) * w3.x * w12.y;
+
+    result += sampleClamped(vec2(texPos0.x, texPos3.y)) * w0.x * w3.y;
+    result += sampleClamped(vec2(texPos12.x, texPos3.y)) * w12.x * w3.y;
+    result += sampleClamped(vec2(texPos3.x, texPos3.y)) * w3.x * w3.y;
+
+    // 음의 lobe 때문에 범위를 넘는 값은 자른다. (ringing)
+    return clamp(result, 0.0, 1.0);
+}
+
+void main() {
+    outColor = sampleCatmullRom(fragTexCoord * upscale.uvScale);
+}
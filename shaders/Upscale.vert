@@ -0,0 +1,9 @@
+#version 450
+
+// viewport 전체를 덮는 삼각형 하나 (uv 는 display 영역 기준 0 ~ 1)
+layout(location = 0) out vec2 fragTexCoord;
+
+void main() {
+    fragTexCoord = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(fragTexCoord * 2.0 - 1.0, 0.0, 1.0);
+}